@@ -361,7 +361,7 @@ namespace lyric_assembler {
 
     class StoreDataInstruction: public AbstractInstruction {
     public:
-        explicit StoreDataInstruction(AbstractSymbol *symbol);
+        explicit StoreDataInstruction(AbstractSymbol *symbol, bool initialStore = false);
         InstructionType getType() const override;
         tempo_utils::Status touch(ObjectWriter &writer) const override;
         tempo_utils::Status apply(
@@ -373,8 +373,10 @@ namespace lyric_assembler {
             tu_uint16 &patchOffset) const override;
         std::string toString() const override;
         AbstractSymbol *getSymbol() const;
+        bool isInitialStore() const;
     private:
         AbstractSymbol *m_symbol;
+        bool m_initialStore;
     };
 
     class LabelInstruction : public AbstractInstruction {
@@ -1020,8 +1020,9 @@ lyric_assembler::LoadTypeInstruction::toString() const
     return absl::StrCat("Load Type: typeDef=", m_typeHandle->getTypeDef().toString());
 }
 
-lyric_assembler::StoreDataInstruction::StoreDataInstruction(AbstractSymbol *symbol)
-    : m_symbol(symbol)
+lyric_assembler::StoreDataInstruction::StoreDataInstruction(AbstractSymbol *symbol, bool initialStore)
+    : m_symbol(symbol),
+      m_initialStore(initialStore)
 {
     TU_ASSERT (m_symbol != nullptr);
 }
@@ -1066,6 +1067,11 @@ lyric_assembler::StoreDataInstruction::apply(
         case SymbolType::LOCAL:
             address = cast_symbol_to_local(m_symbol)->getOffset();
             flags = lyric_object::STORE_LOCAL;
+            // an initial store begins a new binding, so a closure which captured the previous binding of the
+            // local (for example in a previous loop iteration) does not observe the new value
+            if (m_initialStore) {
+                flags |= lyric_object::STORE_INITIAL;
+            }
             break;
         case SymbolType::LEXICAL:
             address = cast_symbol_to_lexical(m_symbol)->getOffset();
@@ -1104,6 +1110,12 @@ lyric_assembler::StoreDataInstruction::getSymbol() const
     return m_symbol;
 }
 
+bool
+lyric_assembler::StoreDataInstruction::isInitialStore() const
+{
+    return m_initialStore;
+}
+
 lyric_assembler::LabelInstruction::LabelInstruction(std::string_view name)
     : m_name(name)
 {
@@ -462,16 +462,16 @@ lyric_assembler::CodeFragment::storeRef(const DataReference &ref, bool initialSt
             if (!initialStore)
                 return AssemblerStatus::forCondition(AssemblerCondition::kInvalidBinding,
                     "cannot store to value {}", ref.symbolUrl.toString());
-            statement.instruction = std::make_shared<StoreDataInstruction>(symbol);
+            statement.instruction = std::make_shared<StoreDataInstruction>(symbol, initialStore);
             break;
         case ReferenceType::Variable:
-            statement.instruction = std::make_shared<StoreDataInstruction>(symbol);
+            statement.instruction = std::make_shared<StoreDataInstruction>(symbol, initialStore);
             break;
         case ReferenceType::Descriptor:
             if (!symbol_is_mutable_static(symbol))
                 return AssemblerStatus::forCondition(AssemblerCondition::kInvalidBinding,
                     "cannot store to {}", ref.symbolUrl.toString());
-            statement.instruction = std::make_shared<StoreDataInstruction>(symbol);
+            statement.instruction = std::make_shared<StoreDataInstruction>(symbol, initialStore);
             break;
         default:
             return AssemblerStatus::forCondition(
@@ -264,7 +264,7 @@ static tempo_utils::Status
 apply_store(const lyric_object::OpCell &op, ImportProcData &data)
 {
     const auto &operands = op.operands.flags_u8_address_u32;
-    switch (operands.flags) {
+    switch (operands.flags & lyric_object::STORE_TYPE_MASK) {
 
         case lyric_object::STORE_ARGUMENT: {
             auto name = absl::StrCat("arg", operands.address);
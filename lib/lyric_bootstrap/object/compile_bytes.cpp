@@ -117,6 +117,71 @@ build_core_Bytes(BuilderState &state, const PreludeSymbols &preludeSymbols)
     }
 }
 
+/**
+ * Defines the search methods of Bytes. These are defined after the Seq struct, which is the return type
+ * of Split.
+ */
+void
+build_core_BytesSearch(BuilderState &state, const PreludeSymbols &preludeSymbols)
+{
+    auto *BoolType = preludeSymbols.BoolExistential->existentialType;
+    auto *I64Type = preludeSymbols.I64Existential->existentialType;
+    auto *BytesType = preludeSymbols.BytesExistential->existentialType;
+    auto *UndefType = preludeSymbols.UndefExistential->existentialType;
+    auto *SeqType = preludeSymbols.SeqStruct->structType;
+
+    auto *IntOrUndefType = state.addUnionType({I64Type,UndefType});
+    {
+        lyric_object::BytecodeBuilder code;
+        state.writeTrap(code, "BytesFind");
+        TU_RAISE_IF_NOT_OK(code.writeOpcode(lyric_object::Opcode::OP_RETURN));
+        state.addExistentialMethod("Find",
+            preludeSymbols.BytesExistential,
+            lyo1::CallFlags::NONE,
+            {
+                make_list_param("needle", BytesType),
+            },
+            code, IntOrUndefType);
+    }
+    {
+        lyric_object::BytecodeBuilder code;
+        state.writeTrap(code, "BytesContains");
+        TU_RAISE_IF_NOT_OK(code.writeOpcode(lyric_object::Opcode::OP_RETURN));
+        state.addExistentialMethod("Contains",
+            preludeSymbols.BytesExistential,
+            lyo1::CallFlags::NONE,
+            {
+                make_list_param("needle", BytesType),
+            },
+            code, BoolType);
+    }
+    {
+        lyric_object::BytecodeBuilder code;
+        state.writeTrap(code, "BytesStartsWith");
+        TU_RAISE_IF_NOT_OK(code.writeOpcode(lyric_object::Opcode::OP_RETURN));
+        state.addExistentialMethod("StartsWith",
+            preludeSymbols.BytesExistential,
+            lyo1::CallFlags::NONE,
+            {
+                make_list_param("prefix", BytesType),
+            },
+            code, BoolType);
+    }
+    {
+        lyric_object::BytecodeBuilder code;
+        TU_RAISE_IF_NOT_OK(code.loadStruct(preludeSymbols.SeqStruct->struct_index));
+        state.writeTrap(code, "BytesSplit");
+        TU_RAISE_IF_NOT_OK(code.writeOpcode(lyric_object::Opcode::OP_RETURN));
+        state.addExistentialMethod("Split",
+            preludeSymbols.BytesExistential,
+            lyo1::CallFlags::NONE,
+            {
+                make_list_param("separator", BytesType),
+            },
+            code, SeqType);
+    }
+}
+
 CoreInstance *
 build_core_BytesInstance(BuilderState &state, const PreludeSymbols &preludeSymbols)
 {
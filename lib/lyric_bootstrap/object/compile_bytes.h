@@ -6,6 +6,7 @@
 
 CoreExistential *declare_core_Bytes(BuilderState &state, const PreludeSymbols &preludeSymbols);
 void build_core_Bytes(BuilderState &state, const PreludeSymbols &preludeSymbols);
+void build_core_BytesSearch(BuilderState &state, const PreludeSymbols &preludeSymbols);
 
 CoreInstance *build_core_BytesInstance(BuilderState &state, const PreludeSymbols &preludeSymbols);
 
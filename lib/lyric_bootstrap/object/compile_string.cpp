@@ -103,18 +103,6 @@ build_core_String(BuilderState &state, const PreludeSymbols &preludeSymbols)
             },
             code, StringType);
     }
-    // {
-    //     lyric_object::BytecodeBuilder code;
-    //     state.writeTrap(code, "StringSplit");
-    //     TU_RAISE_IF_NOT_OK(code.writeOpcode(lyric_object::Opcode::OP_RETURN));
-    //     state.addExistentialMethod("Split",
-    //         StringExistential,
-    //         lyo1::CallFlags::NONE,
-    //         {
-    //             make_list_param("index", I64Type),
-    //         },
-    //         code, StringType);
-    // }
     {
         lyric_object::BytecodeBuilder code;
         state.writeTrap(code, "StringSubstring");
@@ -130,6 +118,71 @@ build_core_String(BuilderState &state, const PreludeSymbols &preludeSymbols)
     }
 }
 
+/**
+ * Defines the search methods of String. These are defined after the Seq struct, which is the return type
+ * of Split.
+ */
+void
+build_core_StringSearch(BuilderState &state, const PreludeSymbols &preludeSymbols)
+{
+    auto *BoolType = preludeSymbols.BoolExistential->existentialType;
+    auto *I64Type = preludeSymbols.I64Existential->existentialType;
+    auto *StringType = preludeSymbols.StringExistential->existentialType;
+    auto *UndefType = preludeSymbols.UndefExistential->existentialType;
+    auto *SeqType = preludeSymbols.SeqStruct->structType;
+
+    auto *IntOrUndefType = state.addUnionType({I64Type,UndefType});
+    {
+        lyric_object::BytecodeBuilder code;
+        state.writeTrap(code, "StringFind");
+        TU_RAISE_IF_NOT_OK(code.writeOpcode(lyric_object::Opcode::OP_RETURN));
+        state.addExistentialMethod("Find",
+            preludeSymbols.StringExistential,
+            lyo1::CallFlags::NONE,
+            {
+                make_list_param("needle", StringType),
+            },
+            code, IntOrUndefType);
+    }
+    {
+        lyric_object::BytecodeBuilder code;
+        state.writeTrap(code, "StringContains");
+        TU_RAISE_IF_NOT_OK(code.writeOpcode(lyric_object::Opcode::OP_RETURN));
+        state.addExistentialMethod("Contains",
+            preludeSymbols.StringExistential,
+            lyo1::CallFlags::NONE,
+            {
+                make_list_param("needle", StringType),
+            },
+            code, BoolType);
+    }
+    {
+        lyric_object::BytecodeBuilder code;
+        state.writeTrap(code, "StringStartsWith");
+        TU_RAISE_IF_NOT_OK(code.writeOpcode(lyric_object::Opcode::OP_RETURN));
+        state.addExistentialMethod("StartsWith",
+            preludeSymbols.StringExistential,
+            lyo1::CallFlags::NONE,
+            {
+                make_list_param("prefix", StringType),
+            },
+            code, BoolType);
+    }
+    {
+        lyric_object::BytecodeBuilder code;
+        TU_RAISE_IF_NOT_OK(code.loadStruct(preludeSymbols.SeqStruct->struct_index));
+        state.writeTrap(code, "StringSplit");
+        TU_RAISE_IF_NOT_OK(code.writeOpcode(lyric_object::Opcode::OP_RETURN));
+        state.addExistentialMethod("Split",
+            preludeSymbols.StringExistential,
+            lyo1::CallFlags::NONE,
+            {
+                make_list_param("separator", StringType),
+            },
+            code, SeqType);
+    }
+}
+
 CoreInstance *
 build_core_StringInstance(BuilderState &state, const PreludeSymbols &preludeSymbols)
 {
@@ -6,6 +6,7 @@
 
 CoreExistential *declare_core_String(BuilderState &state, const PreludeSymbols &preludeSymbols);
 void build_core_String(BuilderState &state, const PreludeSymbols &preludeSymbols);
+void build_core_StringSearch(BuilderState &state, const PreludeSymbols &preludeSymbols);
 
 CoreInstance *build_core_StringInstance(BuilderState &state, const PreludeSymbols &preludeSymbols);
 
@@ -239,7 +239,11 @@ main(int argc, char *argv[])
 
     // define Seq struct
     preludeSymbols.SeqIteratorClass = build_core_SeqIterator(state, preludeSymbols);
-    build_core_Seq(state, preludeSymbols);
+    preludeSymbols.SeqStruct = build_core_Seq(state, preludeSymbols);
+
+    // define String and Bytes search methods, which return Seq
+    build_core_StringSearch(state, preludeSymbols);
+    build_core_BytesSearch(state, preludeSymbols);
 
     // define Map struct
     preludeSymbols.MapIteratorClass = build_core_MapIterator(state, preludeSymbols);
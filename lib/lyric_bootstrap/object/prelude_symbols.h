@@ -91,6 +91,7 @@ struct PreludeSymbols {
     CoreStruct *OkStruct = nullptr;
     CoreStruct *ErrorStruct = nullptr;
     CoreStruct *PairStruct = nullptr;
+    CoreStruct *SeqStruct = nullptr;
 
     /*
      * classes
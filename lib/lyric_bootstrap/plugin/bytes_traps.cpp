@@ -1,9 +1,13 @@
+#include <algorithm>
+#include <string_view>
 
 #include <lyric_runtime/interpreter_state.h>
 #include <lyric_runtime/bytes_ref.h>
+#include <lyric_runtime/internal/text_kernels.h>
 #include <tempo_utils/log_stream.h>
 
 #include "bytes_traps.h"
+#include "seq_ref.h"
 
 tempo_utils::Status
 bytes_at(
@@ -200,6 +204,170 @@ bytes_subspan(
     const auto &arg1 = frame.getArgument(1);
     TU_ASSERT(arg1.getI64(count));
 
+    // a view of shared bytes is sliced without copying
+    if (bytes->isShared()) {
+        tu_int64 size = bytes->getBytesSize();
+        offset = std::clamp<tu_int64>(offset, 0, size);
+        count = std::clamp<tu_int64>(count, 0, size - offset);
+        return heapManager->loadBytesOntoStack(bytes->toImmutableBytes(), offset, count);
+    }
+
     auto rope = bytes->getBytesData().subspan(offset, count);;
     return heapManager->loadBytesOntoStack(rope);
 }
+
+/**
+ * Returns the contents of `bytes` as a contiguous buffer, suitable for the search kernels. A view of
+ * shared bytes is returned without copying, otherwise the rope is copied into `storage`.
+ */
+static std::string_view
+flatten_bytes(const lyric_runtime::BytesRef *bytes, std::string &storage)
+{
+    if (bytes->isShared()) {
+        auto span = bytes->getSharedSpan();
+        return std::string_view(reinterpret_cast<const char *>(span.data()), span.size());
+    }
+    storage.resize(bytes->getBytesSize());
+    bytes->rawCopy(0, storage.data(), static_cast<tu_int32>(storage.size()));
+    return storage;
+}
+
+tempo_utils::Status
+bytes_find(
+    lyric_runtime::BytecodeInterpreter *interp,
+    lyric_runtime::InterpreterState *state,
+    const lyric_runtime::VirtualTable *vtable)
+{
+    auto *currentCoro = state->currentCoro();
+
+    auto &frame = currentCoro->currentCallOrThrow();
+    auto receiver = frame.getReceiver();
+    lyric_runtime::BytesRef *bytes;
+    TU_ASSERT (receiver.getBytes(bytes));
+
+    lyric_runtime::BytesRef *needle;
+    TU_ASSERT (frame.numArguments() == 1);
+    const auto &arg0 = frame.getArgument(0);
+    TU_ASSERT (arg0.getBytes(needle));
+
+    std::string haystackStorage, patternStorage;
+    auto haystack = flatten_bytes(bytes, haystackStorage);
+    auto pattern = flatten_bytes(needle, patternStorage);
+    auto offset = lyric_runtime::internal::find_bytes(
+        haystack.data(), haystack.size(), pattern.data(), pattern.size());
+    if (offset == lyric_runtime::internal::kNotFound)
+        return currentCoro->pushData(lyric_runtime::Operand::undef());
+    return currentCoro->pushData(lyric_runtime::Operand::fromI64(static_cast<tu_int64>(offset)));
+}
+
+tempo_utils::Status
+bytes_contains(
+    lyric_runtime::BytecodeInterpreter *interp,
+    lyric_runtime::InterpreterState *state,
+    const lyric_runtime::VirtualTable *vtable)
+{
+    auto *currentCoro = state->currentCoro();
+
+    auto &frame = currentCoro->currentCallOrThrow();
+    auto receiver = frame.getReceiver();
+    lyric_runtime::BytesRef *bytes;
+    TU_ASSERT (receiver.getBytes(bytes));
+
+    lyric_runtime::BytesRef *needle;
+    TU_ASSERT (frame.numArguments() == 1);
+    const auto &arg0 = frame.getArgument(0);
+    TU_ASSERT (arg0.getBytes(needle));
+
+    std::string haystackStorage, patternStorage;
+    auto haystack = flatten_bytes(bytes, haystackStorage);
+    auto pattern = flatten_bytes(needle, patternStorage);
+    auto offset = lyric_runtime::internal::find_bytes(
+        haystack.data(), haystack.size(), pattern.data(), pattern.size());
+    return currentCoro->pushData(lyric_runtime::Operand::fromBool(offset != lyric_runtime::internal::kNotFound));
+}
+
+tempo_utils::Status
+bytes_starts_with(
+    lyric_runtime::BytecodeInterpreter *interp,
+    lyric_runtime::InterpreterState *state,
+    const lyric_runtime::VirtualTable *vtable)
+{
+    auto *currentCoro = state->currentCoro();
+
+    auto &frame = currentCoro->currentCallOrThrow();
+    auto receiver = frame.getReceiver();
+    lyric_runtime::BytesRef *bytes;
+    TU_ASSERT (receiver.getBytes(bytes));
+
+    lyric_runtime::BytesRef *other;
+    TU_ASSERT (frame.numArguments() == 1);
+    const auto &arg0 = frame.getArgument(0);
+    TU_ASSERT (arg0.getBytes(other));
+
+    return currentCoro->pushData(lyric_runtime::Operand::fromBool(bytes->startsWith(other)));
+}
+
+tempo_utils::Status
+bytes_split(
+    lyric_runtime::BytecodeInterpreter *interp,
+    lyric_runtime::InterpreterState *state,
+    const lyric_runtime::VirtualTable *vtable)
+{
+    auto *currentCoro = state->currentCoro();
+    auto *heapManager = state->heapManager();
+
+    auto &frame = currentCoro->currentCallOrThrow();
+    auto receiver = frame.getReceiver();
+    lyric_runtime::BytesRef *bytes;
+    TU_ASSERT (receiver.getBytes(bytes));
+
+    lyric_runtime::BytesRef *separator;
+    TU_ASSERT (frame.numArguments() == 1);
+    const auto &arg0 = frame.getArgument(0);
+    TU_ASSERT (arg0.getBytes(separator));
+
+    // the Seq descriptor is pushed onto the stack before the trap
+    lyric_runtime::Operand descriptor;
+    TU_RETURN_IF_NOT_OK (currentCoro->popData(descriptor));
+
+    lyric_runtime::InterpreterStatus status;
+    vtable = state->segmentManager()->resolveStructVirtualTable(descriptor, status);
+    if (vtable == nullptr)
+        return status;
+
+    std::string haystackStorage, patternStorage;
+    auto haystack = flatten_bytes(bytes, haystackStorage);
+    auto pattern = flatten_bytes(separator, patternStorage);
+
+    // each element shares the contents of the receiver, either as a view of the shared bytes or
+    // as a subspan of the receiver rope
+    std::shared_ptr<const tempo_utils::ImmutableBytes> shared;
+    tempo_utils::Rope<tu_uint8> rope;
+    if (bytes->isShared()) {
+        shared = bytes->toImmutableBytes();
+    } else {
+        rope = bytes->getBytesData();
+    }
+    auto allocateElement = [&](size_t offset, size_t count) {
+        if (shared != nullptr)
+            return heapManager->allocateBytes(shared, offset, count);
+        return heapManager->allocateBytes(rope.subspan(offset, count));
+    };
+
+    SeqVector vector;
+    size_t start = 0;
+    if (!pattern.empty()) {
+        for (;;) {
+            auto offset = lyric_runtime::internal::find_bytes(
+                haystack.data() + start, haystack.size() - start, pattern.data(), pattern.size());
+            if (offset == lyric_runtime::internal::kNotFound)
+                break;
+            vector.append(allocateElement(start, offset));
+            start += offset + pattern.size();
+        }
+    }
+    vector.append(allocateElement(start, haystack.size() - start));
+
+    auto seq = heapManager->allocateRef<SeqRef>(vtable, std::move(vector));
+    return currentCoro->pushData(seq);
+}
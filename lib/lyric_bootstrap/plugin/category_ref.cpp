@@ -67,14 +67,6 @@ CategoryRef::setMembersReachable()
     }
 }
 
-void
-CategoryRef::clearMembersReachable()
-{
-    for (auto &cell : m_fields) {
-        cell.clearReachable();
-    }
-}
-
 tempo_utils::Status
 category_alloc(
     lyric_runtime::BytecodeInterpreter *interp,
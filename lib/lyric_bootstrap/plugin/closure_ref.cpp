@@ -1,8 +1,10 @@
 #include <absl/strings/substitute.h>
+#include <absl/container/inlined_vector.h>
 
 #include <lyric_object/bytecode_iterator.h>
 #include <lyric_object/proc_utils.h>
 #include <lyric_runtime/interpreter_state.h>
+#include <lyric_runtime/subroutine_manager.h>
 #include <tempo_utils/log_stream.h>
 
 #include "closure_ref.h"
@@ -12,14 +14,14 @@ ClosureRef::ClosureRef(const lyric_runtime::VirtualTable *vtable)
       m_segmentIndex(lyric_runtime::INVALID_ADDRESS_U32),
       m_callIndex(lyric_runtime::INVALID_ADDRESS_U32),
       m_procOffset(lyric_runtime::INVALID_ADDRESS_U32),
-      m_lexicals()
+      m_upvalues()
 {
 }
 
 ClosureRef::~ClosureRef()
 {
     TU_LOG_VV << "free" << ClosureRef::toString();
-    m_lexicals.clear();
+    m_upvalues.clear();
 }
 
 bool
@@ -54,8 +56,9 @@ ClosureRef::applyClosure(
             lyric_runtime::InterpreterStatus::forCondition(
                 lyric_runtime::InterpreterCondition::kRuntimeInvariant, "invalid proc offset"));
 
-    lyric_object::ActivationInfo activationInfo;
-    TU_RAISE_IF_NOT_OK (lyric_object::parse_proc_activation(bytecode, procOffset, activationInfo));
+    const lyric_runtime::ProcMetadata *procMetadata;
+    TU_RAISE_IF_NOT_OK (segment->getProcMetadata(procOffset, &procMetadata));
+    const auto &activationInfo = procMetadata->getProcInfo();
 
     // maximum number of args is 2^16
     if (activationInfo.num_arguments != args.size())
@@ -69,19 +72,19 @@ ClosureRef::applyClosure(
         activationInfo.num_arguments, /* numRest= */ 0, activationInfo.num_locals,
         activationInfo.num_lexicals, args);
 
-    if (this->numLexicals() != activationInfo.num_lexicals)
+    if (this->numUpvalues() != activationInfo.num_lexicals)
         throw tempo_utils::StatusException(
             lyric_runtime::InterpreterStatus::forCondition(
                 lyric_runtime::InterpreterCondition::kRuntimeInvariant, "not enough arguments"));
 
-    // import each lexical from the instance into the stack
+    // bind each lexical in the frame to the corresponding upvalue cell of the closure
     for (tu_uint16 i = 0; i < activationInfo.num_lexicals; i++) {
-        frame.setLexical(i, lexicalAt(i));
+        frame.bindLexical(i, upvalueAt(i));
     }
 
     // push the lambda onto the call stack
     auto ip = getIP();
-    currentCoro->pushCall(frame, ip, segment);
+    currentCoro->pushCall(std::move(frame), ip, segment);
     TU_LOG_VV << "moved ip to " << ip;
 
     return true;
@@ -154,39 +157,31 @@ ClosureRef::setIP(lyric_object::BytecodeIterator ip)
     m_IP = ip;
 }
 
-lyric_runtime::Operand
-ClosureRef::lexicalAt(int index) const
+lyric_runtime::UpvalueCellPtr
+ClosureRef::upvalueAt(int index) const
 {
-    if (0 <= index && std::cmp_less(index, m_lexicals.size()))
-        return m_lexicals[index];
-    return lyric_runtime::Operand();
+    if (0 <= index && std::cmp_less(index, m_upvalues.size()))
+        return m_upvalues[index];
+    return {};
 }
 
 void
-ClosureRef::lexicalAppend(const lyric_runtime::Operand &value)
+ClosureRef::upvalueAppend(lyric_runtime::UpvalueCellPtr upvalue)
 {
-    m_lexicals.push_back(value);
+    m_upvalues.push_back(std::move(upvalue));
 }
 
 int
-ClosureRef::numLexicals() const
+ClosureRef::numUpvalues() const
 {
-    return m_lexicals.size();
+    return m_upvalues.size();
 }
 
 void
 ClosureRef::setMembersReachable()
 {
-    for (auto &cell : m_lexicals) {
-        cell.setReachable();
-    }
-}
-
-void
-ClosureRef::clearMembersReachable()
-{
-    for (auto &cell : m_lexicals) {
-        cell.clearReachable();
+    for (auto &upvalue : m_upvalues) {
+        upvalue->setReachable();
     }
 }
 
@@ -234,10 +229,9 @@ closure_ctor(
     auto descriptor = object.getCall(callDescriptor->getDescriptorIndex());
     auto procOffset = descriptor.getProcOffset();
 
-    // parse the proc
-    auto bytecode = segment->getBytecode();
-    lyric_object::ProcInfo procInfo;
-    TU_RETURN_IF_NOT_OK (lyric_object::parse_proc_info(bytecode, procOffset, procInfo));
+    // get the decoded proc metadata
+    const lyric_runtime::ProcMetadata *procMetadata;
+    TU_RETURN_IF_NOT_OK (segment->getProcMetadata(procOffset, &procMetadata));
 
     // set the proc offset
     closure->setProcOffset(procOffset);
@@ -245,43 +239,17 @@ closure_ctor(
     // set returnsValue flag
     closure->setReturnsValue(!descriptor.isNoReturn());
 
-    std::vector<lyric_object::ProcLexical> lexicals;
-    TU_RETURN_IF_NOT_OK (lyric_object::parse_lexicals_table(procInfo, lexicals));
-
-    // import each lexical from the latest activation and add it to the closure instance
+    // capture each lexical from the frame which is constructing the closure. the constructor frame is
+    // on the top of the call stack, so the enclosing frame is immediately below it.
+    auto lexicals = procMetadata->getLexicals();
     for (int i = 0; i < lexicals.size(); i++) {
-        const auto &lexical = lexicals.at(i);
-
-        // starting from the top of the stack, work our way down until we find the activation
-        bool found = false;
-        for (auto iterator = currentCoro->callsBegin(); iterator != currentCoro->callsEnd(); iterator++) {
-            const auto &ancestor = *iterator;
-
-            if (ancestor.getCallSegment() != segment->getSegmentIndex())    // frame does not match the segment index
-                continue;
-            if (ancestor.getCallIndex() != lexical.activation_call)         // frame does not match activation call
-                continue;
-            switch (lexical.lexical_target) {
-                case lyric_object::LEXICAL_ARGUMENT:
-                    closure->lexicalAppend(ancestor.getArgument(lexical.target_offset));
-                    break;
-                case lyric_object::LEXICAL_LOCAL:
-                    closure->lexicalAppend(ancestor.getLocal(lexical.target_offset));
-                    break;
-                default:
-                    return lyric_runtime::InterpreterStatus::forCondition(
-                        lyric_runtime::InterpreterCondition::kRuntimeInvariant, "invalid lexical target");
-            }
-            found = true;   // we found the lexical, break loop early
-            break;
-        }
-        if (!found)
-            return lyric_runtime::InterpreterStatus::forCondition(
-                lyric_runtime::InterpreterCondition::kRuntimeInvariant, "missing lexical");
+        lyric_runtime::UpvalueCellPtr upvalue;
+        TU_RETURN_IF_NOT_OK (lyric_runtime::capture_lexical(lexicals[i], currentCoro, segment, -2, upvalue));
+        closure->upvalueAppend(std::move(upvalue));
     }
 
     // push the lambda onto the call stack
-    lyric_object::BytecodeIterator ip(procInfo.code);
+    lyric_object::BytecodeIterator ip(procMetadata->getCode());
     closure->setIP(ip);
 
     return {};
@@ -323,8 +291,9 @@ closure_apply(
     auto returnIP = frame.getReturnIP();
     auto stackGuard = currentCoro->dataStackSize();
 
-    lyric_object::ActivationInfo activationInfo;
-    TU_RETURN_IF_NOT_OK (lyric_object::parse_proc_activation(bytecode, procOffset, activationInfo));
+    const lyric_runtime::ProcMetadata *procMetadata;
+    TU_RETURN_IF_NOT_OK (segment->getProcMetadata(procOffset, &procMetadata));
+    const auto &activationInfo = procMetadata->getProcInfo();
 
     // maximum number of args is 2^16
     if (std::numeric_limits<tu_uint16>::max() <= frame.numArguments())
@@ -337,7 +306,8 @@ closure_apply(
     auto numRest = frame.numRest();
 
     // copy the args (including rest args) from the enclosing frame
-    std::vector<lyric_runtime::Operand> args(frame.numArguments() + frame.numRest());
+    absl::InlinedVector<lyric_runtime::Operand,lyric_runtime::kNumInlineFrameSlots> args(
+        frame.numArguments() + frame.numRest());
     for (int i = 0; i < frame.numArguments(); i++) {
         args[i] = frame.getArgument(i);
     }
@@ -351,18 +321,18 @@ closure_apply(
         activationInfo.num_arguments, numRest, activationInfo.num_locals, activationInfo.num_lexicals,
         args, receiver);
 
-    if (closure->numLexicals() != activationInfo.num_lexicals)
+    if (closure->numUpvalues() != activationInfo.num_lexicals)
         return lyric_runtime::InterpreterStatus::forCondition(
             lyric_runtime::InterpreterCondition::kRuntimeInvariant, "not enough arguments");
 
-    // import each lexical from the instance into the stack
+    // bind each lexical in the frame to the corresponding upvalue cell of the closure
     for (tu_uint16 i = 0; i < activationInfo.num_lexicals; i++) {
-        trampoline.setLexical(i, closure->lexicalAt(i));
+        trampoline.bindLexical(i, closure->upvalueAt(i));
     }
 
     // push the lambda onto the call stack
     auto ip = closure->getIP();
-    currentCoro->pushCall(trampoline, ip, segment);
+    currentCoro->pushCall(std::move(trampoline), ip, segment);
     TU_LOG_VV << "moved ip to " << ip;
 
     return {};
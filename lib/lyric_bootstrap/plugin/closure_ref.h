@@ -29,13 +29,12 @@ public:
     lyric_object::BytecodeIterator getIP() const;
     void setIP(lyric_object::BytecodeIterator ip);
 
-    lyric_runtime::Operand lexicalAt(int index) const;
-    void lexicalAppend(const lyric_runtime::Operand &value);
-    int numLexicals() const;
+    lyric_runtime::UpvalueCellPtr upvalueAt(int index) const;
+    void upvalueAppend(lyric_runtime::UpvalueCellPtr upvalue);
+    int numUpvalues() const;
 
 protected:
     void setMembersReachable() override;
-    void clearMembersReachable() override;
 
 private:
     tu_uint32 m_segmentIndex;
@@ -43,7 +42,7 @@ private:
     tu_uint32 m_procOffset;
     bool m_returnsValue;
     lyric_object::BytecodeIterator m_IP;
-    std::vector<lyric_runtime::Operand> m_lexicals;
+    std::vector<lyric_runtime::UpvalueCellPtr> m_upvalues;
 };
 
 tempo_utils::Status closure_alloc(
@@ -149,4 +149,74 @@ H AbslHashValue(H h, const MapKey &key)
     }
 }
 
+template<class ValueType>
+inline bool is_equal_value(const lyric_runtime::Operand &lhs, const lyric_runtime::Operand &rhs)
+{
+    ValueType l, r;
+    if (!lyric_runtime::operand_to_value(lhs, l))
+        return false;
+    if (!lyric_runtime::operand_to_value(rhs, r))
+        return false;
+    return l == r;
+}
+
+inline bool
+is_equal(const lyric_runtime::Operand &lhs, const lyric_runtime::Operand &rhs)
+{
+    if (lhs.getType() != rhs.getType())
+        return false;
+    switch (lhs.getType()) {
+        case lyric_runtime::OperandType::Nil:
+        case lyric_runtime::OperandType::Undef:
+            return true;
+        case lyric_runtime::OperandType::Bool:
+            return is_equal_value<bool>(lhs, rhs);
+        case lyric_runtime::OperandType::Int8:
+            return is_equal_value<tu_int8>(lhs, rhs);
+        case lyric_runtime::OperandType::Int16:
+            return is_equal_value<tu_int16>(lhs, rhs);
+        case lyric_runtime::OperandType::Int32:
+            return is_equal_value<tu_int32>(lhs, rhs);
+        case lyric_runtime::OperandType::Int64:
+            return is_equal_value<tu_int64>(lhs, rhs);
+        case lyric_runtime::OperandType::UInt8:
+            return is_equal_value<tu_uint8>(lhs, rhs);
+        case lyric_runtime::OperandType::UInt16:
+            return is_equal_value<tu_uint16>(lhs, rhs);
+        case lyric_runtime::OperandType::UInt32:
+            return is_equal_value<tu_uint32>(lhs, rhs);
+        case lyric_runtime::OperandType::UInt64:
+            return is_equal_value<tu_uint64>(lhs, rhs);
+        case lyric_runtime::OperandType::Float32:
+            return is_equal_value<float>(lhs, rhs);
+        case lyric_runtime::OperandType::Float64:
+            return is_equal_value<double>(lhs, rhs);
+        case lyric_runtime::OperandType::Char32:
+            return is_equal_value<char32_t>(lhs, rhs);
+
+        case lyric_runtime::OperandType::Ref: {
+            lyric_runtime::BaseRef *l, *r;
+            TU_ASSERT (lhs.getRef(l));
+            TU_ASSERT (rhs.getRef(r));
+            if (l->getVirtualTable() != r->getVirtualTable())
+                return false;
+            return l->equals(r);
+        }
+        case lyric_runtime::OperandType::String: {
+            lyric_runtime::StringRef *l, *r;
+            TU_ASSERT (lhs.getString(l));
+            TU_ASSERT (rhs.getString(r));
+            return l->equals(r);
+        }
+        case lyric_runtime::OperandType::Bytes: {
+            lyric_runtime::BytesRef *l, *r;
+            TU_ASSERT (lhs.getBytes(l));
+            TU_ASSERT (rhs.getBytes(r));
+            return l->equals(r);
+        }
+        default:
+            return false;
+    }
+}
+
 #endif // LYRIC_BOOTSTRAP_MAP_KEY_H
\ No newline at end of file
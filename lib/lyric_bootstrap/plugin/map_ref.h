@@ -1,80 +1,33 @@
 #ifndef LYRIC_BOOTSTRAP_MAP_REF_H
 #define LYRIC_BOOTSTRAP_MAP_REF_H
 
-#include <stack>
-
 #include <lyric_runtime/base_ref.h>
 #include <lyric_runtime/bytecode_interpreter.h>
 #include <lyric_runtime/interpreter_state.h>
 
-enum class MapNodeType {
-    VALUE,
-    INDEX,
-};
-
-struct MapNode {
-    MapNodeType type;
-    int refcount;
-};
-
-struct ValueMapNode : public MapNode {
-    lyric_runtime::Operand key;
-    lyric_runtime::Operand value;
-    tu_uint32 hash;
-};
-
-struct ChainMapNode : public MapNode {
-    lyric_runtime::Operand key;
-    lyric_runtime::Operand value;
-    ChainMapNode *next;
-};
-
-constexpr int BITS_PER_LEVEL = 4;
-
-constexpr int table_slots(int bitsPerLevel) {
-    int numSlots = 1;
-    for (int i = 0; i < bitsPerLevel; i++) {
-        numSlots *= 2;
-    }
-    return numSlots;
-}
-
-typedef std::array<MapNode *,table_slots(BITS_PER_LEVEL)> IndexMapNodeTable;
-
-struct IndexMapNode : public MapNode {
-    IndexMapNodeTable table;
-};
-
-struct NodePointer {
-    MapNode *node;
-    int index;
-};
+#include "map_trie.h"
 
 class MapRef : public lyric_runtime::BaseRef {
 
 public:
     explicit MapRef(const lyric_runtime::VirtualTable *vtable);
+    MapRef(const lyric_runtime::VirtualTable *vtable, MapTrie trie);
     ~MapRef() override;
 
     std::string toString() const override;
 
-    MapNode *getNode() const;
-    void setNode(MapNode *node);
+    const MapTrie &getTrie() const;
+    void setTrie(MapTrie trie);
 
     int mapSize() const;
     bool mapContains(const lyric_runtime::Operand &key) const;
     lyric_runtime::Operand mapGet(const lyric_runtime::Operand &key) const;
-    MapNode *mapUpdate(const lyric_runtime::Operand &key, const lyric_runtime::Operand &value) const;
-    MapNode *mapRemove(const lyric_runtime::Operand &key) const;
 
 protected:
     void setMembersReachable() override;
-    void clearMembersReachable() override;
 
 private:
-    MapNode *m_node;
-
-    friend void init_node_pointer_stack(std::stack<NodePointer> &stack, MapRef *map);
+    MapTrie m_trie;
 };
 
 class MapIterator : public lyric_runtime::BaseRef {
@@ -90,13 +43,10 @@ public:
 
 protected:
     void setMembersReachable() override;
-    void clearMembersReachable() override;
 
 private:
-    std::stack<NodePointer> m_stack;
+    MapCursor m_cursor;
     MapRef *m_map;
-
-    friend void init_node_pointer_stack(std::stack<NodePointer> &stack, MapRef *map);
 };
 
 tempo_utils::Status map_alloc(
@@ -0,0 +1,504 @@
+
+#include <bit>
+
+#include <absl/hash/hash.h>
+
+#include "map_key.h"
+#include "map_trie.h"
+
+static tu_uint32
+hash_key(const lyric_runtime::Operand &key)
+{
+    return static_cast<tu_uint32>(absl::HashOf(MapKey{key}));
+}
+
+static tu_uint32
+fragment_bit(tu_uint32 hash, int shift)
+{
+    return 1u << ((hash >> shift) & kMapNodeMask);
+}
+
+static int
+bitmap_index(tu_uint32 bitmap, tu_uint32 bit)
+{
+    return std::popcount(bitmap & (bit - 1));
+}
+
+static MapNode *
+new_node(MapNodeType type, int numEntries, int numChildren)
+{
+    auto *node = new MapNode();
+    node->type = type;
+    node->refcount = 1;
+    node->datamap = 0;
+    node->nodemap = 0;
+    node->numEntries = numEntries;
+    node->numChildren = numChildren;
+    node->entries = numEntries > 0 ? new MapEntry[numEntries] : nullptr;
+    node->children = numChildren > 0 ? new MapNode*[numChildren] : nullptr;
+    return node;
+}
+
+static void
+retain_node(MapNode *node)
+{
+    TU_ASSERT (node != nullptr);
+    node->refcount++;
+}
+
+static void
+release_node(MapNode *node)
+{
+    TU_ASSERT (node != nullptr);
+    node->refcount--;
+    if (node->refcount > 0)
+        return;
+
+    for (int i = 0; i < node->numChildren; i++) {
+        release_node(node->children[i]);
+    }
+    delete[] node->entries;
+    delete[] node->children;
+    delete node;
+}
+
+/**
+ * Returns a node which may be modified in place by the holder of the reference to `node`. If the holder
+ * is the sole owner then the node itself is returned, otherwise the reference is transferred to a copy
+ * which shares the children of the node.
+ */
+static MapNode *
+unique_node(MapNode *node)
+{
+    if (node->refcount == 1)
+        return node;
+    auto *copy = new_node(node->type, node->numEntries, node->numChildren);
+    copy->datamap = node->datamap;
+    copy->nodemap = node->nodemap;
+    for (int i = 0; i < node->numEntries; i++) {
+        copy->entries[i] = node->entries[i];
+    }
+    for (int i = 0; i < node->numChildren; i++) {
+        copy->children[i] = node->children[i];
+        retain_node(copy->children[i]);
+    }
+    node->refcount--;
+    return copy;
+}
+
+static void
+insert_entry_at(MapNode *node, int index, const MapEntry &entry)
+{
+    auto *entries = new MapEntry[node->numEntries + 1];
+    for (int i = 0; i < index; i++) {
+        entries[i] = std::move(node->entries[i]);
+    }
+    entries[index] = entry;
+    for (int i = index; i < node->numEntries; i++) {
+        entries[i + 1] = std::move(node->entries[i]);
+    }
+    delete[] node->entries;
+    node->entries = entries;
+    node->numEntries++;
+}
+
+static void
+erase_entry_at(MapNode *node, int index)
+{
+    MapEntry *entries = nullptr;
+    if (node->numEntries > 1) {
+        entries = new MapEntry[node->numEntries - 1];
+        for (int i = 0, j = 0; i < node->numEntries; i++) {
+            if (i != index) {
+                entries[j++] = std::move(node->entries[i]);
+            }
+        }
+    }
+    delete[] node->entries;
+    node->entries = entries;
+    node->numEntries--;
+}
+
+static void
+insert_child_at(MapNode *node, int index, MapNode *child)
+{
+    auto *children = new MapNode*[node->numChildren + 1];
+    for (int i = 0; i < index; i++) {
+        children[i] = node->children[i];
+    }
+    children[index] = child;
+    for (int i = index; i < node->numChildren; i++) {
+        children[i + 1] = node->children[i];
+    }
+    delete[] node->children;
+    node->children = children;
+    node->numChildren++;
+}
+
+static void
+erase_child_at(MapNode *node, int index)
+{
+    MapNode **children = nullptr;
+    if (node->numChildren > 1) {
+        children = new MapNode*[node->numChildren - 1];
+        for (int i = 0, j = 0; i < node->numChildren; i++) {
+            if (i != index) {
+                children[j++] = node->children[i];
+            }
+        }
+    }
+    delete[] node->children;
+    node->children = children;
+    node->numChildren--;
+}
+
+/**
+ * Returns a new subtree at level `shift` containing the entries `e1` and `e2`, whose keys differ but
+ * whose hashes are identical in all fragments above `shift`.
+ */
+static MapNode *
+merge_entries(const MapEntry &e1, const MapEntry &e2, int shift)
+{
+    if (kMapHashBits <= shift) {
+        auto *node = new_node(MapNodeType::COLLISION, 2, 0);
+        node->entries[0] = e1;
+        node->entries[1] = e2;
+        return node;
+    }
+
+    auto bit1 = fragment_bit(e1.hash, shift);
+    auto bit2 = fragment_bit(e2.hash, shift);
+    if (bit1 == bit2) {
+        auto *node = new_node(MapNodeType::BITMAP, 0, 1);
+        node->nodemap = bit1;
+        node->children[0] = merge_entries(e1, e2, shift + kMapNodeBits);
+        return node;
+    }
+
+    auto *node = new_node(MapNodeType::BITMAP, 2, 0);
+    node->datamap = bit1 | bit2;
+    node->entries[bit1 < bit2 ? 0 : 1] = e1;
+    node->entries[bit1 < bit2 ? 1 : 0] = e2;
+    return node;
+}
+
+/**
+ * Inserts `entry` into the subtree referenced by `slot` at level `shift`, replacing the value of an
+ * existing entry with an equal key. Nodes along the path are copied unless uniquely owned, and `slot` is
+ * updated to reference the modified subtree.
+ *
+ * @return true if a new entry was added, or false if an existing entry was replaced.
+ */
+static bool
+insert_entry(MapNode *&slot, const MapEntry &entry, int shift)
+{
+    if (slot->type == MapNodeType::COLLISION) {
+        auto *node = unique_node(slot);
+        slot = node;
+        for (int i = 0; i < node->numEntries; i++) {
+            if (is_equal(node->entries[i].key, entry.key)) {
+                node->entries[i] = entry;
+                return false;
+            }
+        }
+        insert_entry_at(node, node->numEntries, entry);
+        return true;
+    }
+
+    auto bit = fragment_bit(entry.hash, shift);
+
+    if (slot->datamap & bit) {
+        auto index = bitmap_index(slot->datamap, bit);
+        const auto &existing = slot->entries[index];
+        auto *node = unique_node(slot);
+        slot = node;
+        if (existing.hash == entry.hash && is_equal(existing.key, entry.key)) {
+            node->entries[index] = entry;
+            return false;
+        }
+        // push the existing entry and the new entry down into a new subtree
+        auto *child = merge_entries(node->entries[index], entry, shift + kMapNodeBits);
+        erase_entry_at(node, index);
+        node->datamap ^= bit;
+        node->nodemap |= bit;
+        insert_child_at(node, bitmap_index(node->nodemap, bit), child);
+        return true;
+    }
+
+    auto *node = unique_node(slot);
+    slot = node;
+
+    if (node->nodemap & bit) {
+        auto index = bitmap_index(node->nodemap, bit);
+        return insert_entry(node->children[index], entry, shift + kMapNodeBits);
+    }
+
+    node->datamap |= bit;
+    insert_entry_at(node, bitmap_index(node->datamap, bit), entry);
+    return true;
+}
+
+/**
+ * Removes the entry with the specified `key` from the subtree referenced by `slot` at level `shift`. The
+ * key must be present in the subtree. If removal leaves a child with a single entry and no children then
+ * the entry is moved into the parent, so that the trie remains in canonical form.
+ */
+static void
+remove_entry(MapNode *&slot, const lyric_runtime::Operand &key, tu_uint32 hash, int shift)
+{
+    auto *node = unique_node(slot);
+    slot = node;
+
+    if (node->type == MapNodeType::COLLISION) {
+        for (int i = 0; i < node->numEntries; i++) {
+            if (is_equal(node->entries[i].key, key)) {
+                erase_entry_at(node, i);
+                return;
+            }
+        }
+        TU_UNREACHABLE();
+    }
+
+    auto bit = fragment_bit(hash, shift);
+
+    if (node->datamap & bit) {
+        erase_entry_at(node, bitmap_index(node->datamap, bit));
+        node->datamap ^= bit;
+        return;
+    }
+
+    TU_ASSERT (node->nodemap & bit);
+    auto index = bitmap_index(node->nodemap, bit);
+    remove_entry(node->children[index], key, hash, shift + kMapNodeBits);
+
+    auto *child = node->children[index];
+    if (child->numEntries == 1 && child->numChildren == 0) {
+        MapEntry entry = child->entries[0];
+        release_node(child);
+        erase_child_at(node, index);
+        node->nodemap ^= bit;
+        node->datamap |= bit;
+        insert_entry_at(node, bitmap_index(node->datamap, bit), entry);
+    }
+}
+
+static void
+set_reachable(const MapNode *node)
+{
+    for (int i = 0; i < node->numEntries; i++) {
+        node->entries[i].key.setReachable();
+        node->entries[i].value.setReachable();
+    }
+    for (int i = 0; i < node->numChildren; i++) {
+        set_reachable(node->children[i]);
+    }
+}
+
+MapTrie::MapTrie()
+    : m_root(nullptr),
+      m_size(0)
+{
+}
+
+MapTrie::MapTrie(const MapTrie &other)
+    : m_root(other.m_root),
+      m_size(other.m_size)
+{
+    if (m_root != nullptr) {
+        retain_node(m_root);
+    }
+}
+
+MapTrie::MapTrie(MapTrie &&other) noexcept
+    : m_root(other.m_root),
+      m_size(other.m_size)
+{
+    other.m_root = nullptr;
+    other.m_size = 0;
+}
+
+MapTrie::~MapTrie()
+{
+    release();
+}
+
+MapTrie &
+MapTrie::operator=(const MapTrie &other)
+{
+    if (this != &other) {
+        if (other.m_root != nullptr) {
+            retain_node(other.m_root);
+        }
+        release();
+        m_root = other.m_root;
+        m_size = other.m_size;
+    }
+    return *this;
+}
+
+MapTrie &
+MapTrie::operator=(MapTrie &&other) noexcept
+{
+    if (this != &other) {
+        release();
+        m_root = other.m_root;
+        m_size = other.m_size;
+        other.m_root = nullptr;
+        other.m_size = 0;
+    }
+    return *this;
+}
+
+void
+MapTrie::release()
+{
+    if (m_root != nullptr) {
+        release_node(m_root);
+        m_root = nullptr;
+    }
+    m_size = 0;
+}
+
+int
+MapTrie::size() const
+{
+    return m_size;
+}
+
+bool
+MapTrie::isEmpty() const
+{
+    return m_size == 0;
+}
+
+/**
+ * Returns a pointer to the value associated with the specified `key`, or nullptr if the key is not
+ * present in the map.
+ */
+const lyric_runtime::Operand *
+MapTrie::find(const lyric_runtime::Operand &key) const
+{
+    if (m_root == nullptr)
+        return nullptr;
+
+    auto hash = hash_key(key);
+    const MapNode *node = m_root;
+    int shift = 0;
+
+    while (node->type == MapNodeType::BITMAP) {
+        auto bit = fragment_bit(hash, shift);
+        if (node->datamap & bit) {
+            const auto &entry = node->entries[bitmap_index(node->datamap, bit)];
+            if (entry.hash == hash && is_equal(entry.key, key))
+                return &entry.value;
+            return nullptr;
+        }
+        if (!(node->nodemap & bit))
+            return nullptr;
+        node = node->children[bitmap_index(node->nodemap, bit)];
+        shift += kMapNodeBits;
+    }
+
+    for (int i = 0; i < node->numEntries; i++) {
+        if (is_equal(node->entries[i].key, key))
+            return &node->entries[i].value;
+    }
+    return nullptr;
+}
+
+/**
+ * Associates `value` with the specified `key`, replacing the existing value if the key is present.
+ */
+void
+MapTrie::insert(const lyric_runtime::Operand &key, const lyric_runtime::Operand &value)
+{
+    MapEntry entry{key, value, hash_key(key)};
+
+    if (m_root == nullptr) {
+        m_root = new_node(MapNodeType::BITMAP, 1, 0);
+        m_root->datamap = fragment_bit(entry.hash, 0);
+        m_root->entries[0] = entry;
+        m_size = 1;
+        return;
+    }
+
+    if (insert_entry(m_root, entry, 0)) {
+        m_size++;
+    }
+}
+
+/**
+ * Removes the specified `key` from the map.
+ *
+ * @return true if the key was removed, or false if the key was not present.
+ */
+bool
+MapTrie::remove(const lyric_runtime::Operand &key)
+{
+    if (find(key) == nullptr)
+        return false;
+
+    remove_entry(m_root, key, hash_key(key), 0);
+    m_size--;
+
+    if (m_size == 0) {
+        release_node(m_root);
+        m_root = nullptr;
+    }
+    return true;
+}
+
+void
+MapTrie::setReachable() const
+{
+    if (m_root != nullptr) {
+        set_reachable(m_root);
+    }
+}
+
+MapCursor::MapCursor()
+    : m_stack(),
+      m_depth(0),
+      m_remaining(0)
+{
+}
+
+MapCursor::MapCursor(const MapTrie &trie)
+    : m_trie(trie),
+      m_stack(),
+      m_depth(0),
+      m_remaining(trie.size())
+{
+    if (m_trie.m_root != nullptr) {
+        m_stack[m_depth++] = {m_trie.m_root, 0, 0};
+    }
+}
+
+bool
+MapCursor::isValid() const
+{
+    return m_remaining > 0;
+}
+
+/**
+ * Returns the next entry, or nullptr if all entries have been visited.
+ */
+const MapEntry *
+MapCursor::next()
+{
+    while (m_depth > 0) {
+        auto &frame = m_stack[m_depth - 1];
+        if (frame.entryIndex < frame.node->numEntries) {
+            m_remaining--;
+            return &frame.node->entries[frame.entryIndex++];
+        }
+        if (frame.childIndex < frame.node->numChildren) {
+            TU_ASSERT (m_depth < kMapMaxDepth);
+            auto *child = frame.node->children[frame.childIndex++];
+            m_stack[m_depth++] = {child, 0, 0};
+            continue;
+        }
+        m_depth--;
+    }
+    return nullptr;
+}
@@ -0,0 +1,110 @@
+#ifndef LYRIC_BOOTSTRAP_MAP_TRIE_H
+#define LYRIC_BOOTSTRAP_MAP_TRIE_H
+
+#include <array>
+
+#include <lyric_runtime/operand.h>
+
+constexpr int kMapNodeBits = 5;
+constexpr tu_uint32 kMapNodeMask = (1u << kMapNodeBits) - 1;
+constexpr int kMapHashBits = 32;
+
+/**
+ * The maximum depth of the trie: one level for each group of hash bits, plus the collision level.
+ */
+constexpr int kMapMaxDepth = (kMapHashBits + kMapNodeBits - 1) / kMapNodeBits + 1;
+
+enum class MapNodeType {
+    BITMAP,
+    COLLISION,
+};
+
+struct MapEntry {
+    lyric_runtime::Operand key;
+    lyric_runtime::Operand value;
+    tu_uint32 hash;                                     /**< Cached hash of the key. */
+};
+
+/**
+ * A node in the trie. A bitmap node stores the entries and the child nodes for each 5-bit fragment of
+ * the key hash in two compressed arrays: bit i of the datamap is set if the fragment i maps to an inline
+ * entry, and bit i of the nodemap is set if the fragment maps to a child node. The position in the array
+ * is the number of set bits below bit i. A collision node stores entries whose keys have identical hashes.
+ */
+struct MapNode {
+    MapNodeType type;
+    int refcount;
+    tu_uint32 datamap;
+    tu_uint32 nodemap;
+    int numEntries;
+    int numChildren;
+    MapEntry *entries;
+    MapNode **children;
+};
+
+/**
+ * Persistent hash map of operands implemented as a compressed hash-array mapped prefix trie (CHAMP).
+ * Entries are stored inline in the node arrays rather than boxed individually, and each entry caches the
+ * hash of its key so that keys are never rehashed when the trie is restructured. Entries whose hashes
+ * are identical are stored in a collision node below the last level of the trie.
+ *
+ * Nodes are reference counted and shared between maps. Copying a map is constant-time; a map modifies a
+ * node in place only while it holds the sole reference to the node, so inserting a batch of entries into
+ * a newly constructed map does not copy any nodes.
+ */
+class MapTrie {
+
+public:
+    MapTrie();
+    MapTrie(const MapTrie &other);
+    MapTrie(MapTrie &&other) noexcept;
+    ~MapTrie();
+
+    MapTrie &operator=(const MapTrie &other);
+    MapTrie &operator=(MapTrie &&other) noexcept;
+
+    int size() const;
+    bool isEmpty() const;
+
+    const lyric_runtime::Operand *find(const lyric_runtime::Operand &key) const;
+    void insert(const lyric_runtime::Operand &key, const lyric_runtime::Operand &value);
+    bool remove(const lyric_runtime::Operand &key);
+
+    void setReachable() const;
+
+private:
+    MapNode *m_root;
+    int m_size;
+
+    void release();
+
+    friend class MapCursor;
+};
+
+/**
+ * Cursor which iterates the entries of a MapTrie. The cursor visits the inline entries of a node before
+ * descending into its children, using a fixed-size stack bounded by the depth of the trie.
+ */
+class MapCursor {
+
+public:
+    MapCursor();
+    explicit MapCursor(const MapTrie &trie);
+
+    bool isValid() const;
+    const MapEntry *next();
+
+private:
+    struct Frame {
+        const MapNode *node;
+        int entryIndex;
+        int childIndex;
+    };
+
+    MapTrie m_trie;
+    std::array<Frame,kMapMaxDepth> m_stack;
+    int m_depth;
+    int m_remaining;
+};
+
+#endif // LYRIC_BOOTSTRAP_MAP_TRIE_H
@@ -16,7 +16,7 @@
 #include "status_traps.h"
 #include "string_traps.h"
 
-std::array<lyric_runtime::NativeTrap,68> kPreludeTraps = {{
+std::array<lyric_runtime::NativeTrap,76> kPreludeTraps = {{
     {bytes_at, "BytesAt", 0},
     { bytes_compare, "BytesCompare", 0 },
     { bytes_length, "BytesLength", 0 },
@@ -26,6 +26,10 @@ std::array<lyric_runtime::NativeTrap,68> kPreludeTraps = {{
     { bytes_insert, "BytesInsert", 0 },
     { bytes_remove, "BytesRemove", 0 },
     { bytes_subspan, "BytesSubspan", 0 },
+    { bytes_find, "BytesFind", 0 },
+    { bytes_contains, "BytesContains", 0 },
+    { bytes_starts_with, "BytesStartsWith", 0 },
+    { bytes_split, "BytesSplit", 0 },
     { category_alloc, "CategoryAlloc", 0 },
     { closure_alloc, "ClosureAlloc", 0 },
     { closure_apply, "ClosureApply", 0 },
@@ -85,6 +89,10 @@ std::array<lyric_runtime::NativeTrap,68> kPreludeTraps = {{
     { string_insert, "StringInsert", 0 },
     { string_remove, "StringRemove", 0 },
     { string_substring, "StringSubstring", 0 },
+    { string_find, "StringFind", 0 },
+    { string_contains, "StringContains", 0 },
+    { string_starts_with, "StringStartsWith", 0 },
+    { string_split, "StringSplit", 0 },
 }};
 
 bool
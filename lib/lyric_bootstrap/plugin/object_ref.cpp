@@ -20,14 +20,10 @@ bool
 ObjectRef::getField(const lyric_runtime::Operand &field, lyric_runtime::Operand &value) const
 {
     auto *vtable = getVirtualTable();
-    auto *member = vtable->getMember(field);
-    if (member == nullptr)
+    auto offset = vtable->getMemberSlot(field);
+    if (offset == lyric_runtime::INVALID_ADDRESS_U32)
         return false;
-    auto offset = member->getLayoutOffset();
-    if (m_fields.size() <= offset)
-        return false;
-    value = m_fields.at(offset);
-    return true;
+    return getFieldAt(offset, value);
 }
 
 bool
@@ -37,14 +33,45 @@ ObjectRef::setField(
     lyric_runtime::Operand *prev)
 {
     auto *vtable = getVirtualTable();
-    auto *member = vtable->getMember(field);
-    if (member == nullptr)
+    auto offset = vtable->getMemberSlot(field);
+    if (offset == lyric_runtime::INVALID_ADDRESS_U32)
+        return false;
+    return setFieldAt(offset, value, prev);
+}
+
+/**
+ * Loads the field at the specified layout `offset` without resolving a field descriptor. The offset
+ * is the member slot of the field in the vtable of the object.
+ *
+ * @param offset The layout offset of the field.
+ * @param value The field value.
+ * @return true if the offset is valid, otherwise false.
+ */
+bool
+ObjectRef::getFieldAt(tu_uint32 offset, lyric_runtime::Operand &value) const
+{
+    if (m_fields.size() <= offset)
         return false;
-    auto offset = member->getLayoutOffset();
+    value = m_fields[offset];
+    return true;
+}
+
+/**
+ * Stores the field at the specified layout `offset` without resolving a field descriptor. If `prev`
+ * is not nullptr then the previous value of the field is stored in `prev`.
+ *
+ * @param offset The layout offset of the field.
+ * @param value The new field value.
+ * @param prev The previous field value, or nullptr.
+ * @return true if the offset is valid, otherwise false.
+ */
+bool
+ObjectRef::setFieldAt(tu_uint32 offset, const lyric_runtime::Operand &value, lyric_runtime::Operand *prev)
+{
     if (m_fields.size() <= offset)
         return false;
     if (prev != nullptr) {
-        *prev = m_fields.at(offset);
+        *prev = m_fields[offset];
     }
     m_fields[offset] = value;
     return true;
@@ -67,14 +94,6 @@ ObjectRef::setMembersReachable()
     }
 }
 
-void
-ObjectRef::clearMembersReachable()
-{
-    for (auto &cell : m_fields) {
-        cell.clearReachable();
-    }
-}
-
 tempo_utils::Status
 object_alloc(
     lyric_runtime::BytecodeInterpreter *interp,
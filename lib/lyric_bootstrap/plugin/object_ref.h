@@ -17,11 +17,12 @@ public:
         const lyric_runtime::Operand &field,
         const lyric_runtime::Operand &value,
         lyric_runtime::Operand *prev) override;
+    bool getFieldAt(tu_uint32 offset, lyric_runtime::Operand &value) const;
+    bool setFieldAt(tu_uint32 offset, const lyric_runtime::Operand &value, lyric_runtime::Operand *prev);
     std::string toString() const override;
 
 protected:
     void setMembersReachable() override;
-    void clearMembersReachable() override;
 
 private:
     std::vector<lyric_runtime::Operand> m_fields;
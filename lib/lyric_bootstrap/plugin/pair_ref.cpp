@@ -58,13 +58,6 @@ PairRef::setMembersReachable()
     m_second.setReachable();
 }
 
-void
-PairRef::clearMembersReachable()
-{
-    m_first.clearReachable();
-    m_second.clearReachable();
-}
-
 tempo_utils::Status
 pair_alloc(
     lyric_runtime::BytecodeInterpreter *interp,
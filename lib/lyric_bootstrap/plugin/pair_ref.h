@@ -21,7 +21,6 @@ public:
 
 protected:
     void setMembersReachable() override;
-    void clearMembersReachable() override;
 
 private:
     lyric_runtime::Operand m_first;
@@ -67,14 +67,6 @@ RecordRef::setMembersReachable()
     }
 }
 
-void
-RecordRef::clearMembersReachable()
-{
-    for (auto &cell : m_fields) {
-        cell.clearReachable();
-    }
-}
-
 tempo_utils::Status
 record_alloc(
     lyric_runtime::BytecodeInterpreter *interp,
@@ -21,7 +21,6 @@ public:
 
 protected:
     void setMembersReachable() override;
-    void clearMembersReachable() override;
 
 private:
     std::vector<lyric_runtime::Operand> m_fields;
@@ -51,12 +51,6 @@ RestIterator::setMembersReachable()
     m_rest->setReachable();
 }
 
-void
-RestIterator::clearMembersReachable()
-{
-    m_rest->clearReachable();
-}
-
 tempo_utils::Status
 rest_iterator_alloc(
     lyric_runtime::BytecodeInterpreter *interp,
@@ -19,7 +19,6 @@ public:
 
 protected:
     void setMembersReachable() override;
-    void clearMembersReachable() override;
 
 private:
     int m_curr;
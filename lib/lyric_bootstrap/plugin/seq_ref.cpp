@@ -1,5 +1,3 @@
-#include <queue>
-#include <stack>
 
 #include <absl/strings/substitute.h>
 
@@ -8,44 +6,21 @@
 #include "seq_ref.h"
 
 SeqRef::SeqRef(const lyric_runtime::VirtualTable *vtable)
-    : BaseRef(vtable),
-      m_node(nullptr)
+    : BaseRef(vtable)
 {
     TU_ASSERT (vtable != nullptr);
 }
 
-static void
-free_node(SeqNode *node)
+SeqRef::SeqRef(const lyric_runtime::VirtualTable *vtable, SeqVector vector)
+    : BaseRef(vtable),
+      m_vector(std::move(vector))
 {
-    TU_ASSERT (node != nullptr);
-    node->refcount--;
-    if (node->refcount > 0)
-        return;
-
-    switch (node->type) {
-        case SeqNodeType::LEAF: {
-            auto *leaf = static_cast<LeafSeqNode *>(node);
-            delete[] leaf->values;
-            break;
-        }
-        case SeqNodeType::CONCAT: {
-            auto *concat = static_cast<ConcatSeqNode *>(node);
-            free_node(concat->left);
-            free_node(concat->right);
-            break;
-        }
-        default:
-            break;
-    }
-    delete node;
+    TU_ASSERT (vtable != nullptr);
 }
 
 SeqRef::~SeqRef()
 {
     TU_LOG_VV << "free " << SeqRef::toString();
-    if (m_node != nullptr) {
-        free_node(m_node);
-    }
 }
 
 std::string
@@ -54,25 +29,22 @@ SeqRef::toString() const
     return absl::Substitute("<$0: SeqRef>", this);
 }
 
-SeqNode *
-SeqRef::getNode() const
+const SeqVector &
+SeqRef::getVector() const
 {
-    return m_node;
+    return m_vector;
 }
 
 void
-SeqRef::setNode(SeqNode *node)
+SeqRef::setVector(SeqVector vector)
 {
-    TU_ASSERT (node != nullptr);
-    TU_ASSERT (m_node == nullptr);
-    m_node = node;
-    m_node->refcount++;
+    m_vector = std::move(vector);
 }
 
 size_t
 SeqRef::numElements() const
 {
-    return m_node != nullptr? m_node->count : 0;
+    return m_vector.size();
 }
 
 lyric_runtime::Operand
@@ -81,37 +53,16 @@ SeqRef::seqGet(const lyric_runtime::Operand &index) const
     tu_int64 i;
     TU_ASSERT (index.getI64(i));
 
-    // special case: empty seq returns invalid cell
-    if (m_node == nullptr)
-        return {};
-
     // if i is negative, then index from the end of the seq
     if (i < 0) {
-        i = m_node->count + i;
+        i = m_vector.size() + i;
     }
 
     // special case: index is out of range
-    if (i < 0 || m_node->count <= i)
+    if (i < 0 || m_vector.size() <= i)
         return {};
 
-    const SeqNode *curr = m_node;
-    while (curr != nullptr) {
-        if (curr->type == SeqNodeType::CONCAT) {
-            auto *concat = static_cast<const ConcatSeqNode *>(curr);
-            if (i < concat->left->count) {
-                curr = concat->left;
-            } else {
-                i -= concat->left->count;
-                curr = concat->right;
-            }
-        } else {
-            auto *leaf = static_cast<const LeafSeqNode *>(curr);
-            TU_ASSERT (0 <= i && i < leaf->count);
-            return leaf->values[i];
-        }
-    }
-
-    return {};
+    return m_vector.get(i);
 }
 
 lyric_runtime::Operand
@@ -120,156 +71,51 @@ SeqRef::seqSize() const
     return lyric_runtime::Operand::fromI64(numElements());
 }
 
-static SeqNode *
-slice(SeqNode *node, int start, int length)
-{
-    TU_ASSERT (node != nullptr);
-
-    // case 1: we are slicing a leaf
-    if (node->type == SeqNodeType::LEAF) {
-        auto *leaf = static_cast<LeafSeqNode *>(node);
-
-        // special case: if we use the entire leaf, then don't copy, just update the refcount
-        if (start == 0 && leaf->count == length) {
-            leaf->refcount++;
-            return leaf;
-        }
-
-        // copy the contributing elements into a new leaf and return it
-        auto *sliced = new LeafSeqNode();
-        sliced->type = SeqNodeType::LEAF;
-        sliced->refcount = 0;
-        sliced->count = length;
-        sliced->values = new lyric_runtime::Operand[sliced->count];
-        for (int i = 0; i < length; i++) {
-            sliced->values[i] = leaf->values[start + 1];
-        }
-        return sliced;
-    }
-
-    auto *concat = static_cast<ConcatSeqNode *>(node);
-
-    // case 2: only elements in the left branch contribute to the slice
-    if (start + length <= concat->left->count)
-        return slice(concat->left, start, length);
-
-    // case 3: no elements in the left branch contribute to the slice
-    if (concat->left->count <= start)
-        return slice(concat->right, start - concat->left->count, length);
-
-    // case 4: left and right branches contribute to the slice, so create a new concat node
-    auto *sliced = new ConcatSeqNode();
-    sliced->type = SeqNodeType::CONCAT;
-    sliced->refcount = 0;
-
-    auto *left = slice(concat->left, start, concat->left->count - start);
-    left->refcount++;
-    int lheight = left->type == SeqNodeType::CONCAT? static_cast<ConcatSeqNode *>(left)->height : 1;
-
-    auto *right = slice(concat->right, 0, length - (concat->left->count - start));
-    right->refcount++;
-    int rheight = right->type == SeqNodeType::CONCAT? static_cast<ConcatSeqNode *>(right)->height : 1;
-
-    sliced->left = left;
-    sliced->right = right;
-    sliced->count = length;
-    sliced->height = std::max(lheight, rheight) + 1;
-
-    return sliced;
-}
-
-SeqNode *
+SeqVector
 SeqRef::seqSlice(const lyric_runtime::Operand &start, const lyric_runtime::Operand &length) const
 {
-    if (m_node == nullptr)
-        return nullptr;
-
     tu_int64 s, l;
     TU_ASSERT (start.getI64(s));
     TU_ASSERT (length.getI64(l));
 
+    tu_int64 count = m_vector.size();
+    if (l <= 0)
+        return {};                          // non-positive length indicates empty slice
+
     if (s < 0) {                            // negative start indicates reverse slice starting from end of seq
-        if (m_node->count <= l) {
-            return m_node;                  // if length is equal or larger than seq size, then return existing seq
+        if (count <= l) {
+            return m_vector;                // if length is equal or larger than seq size, then return existing seq
         } else {
-            s = m_node->count - l;          // otherwise recalculate start index
+            s = count - l;                  // otherwise recalculate start index
         }
     } else {                                // positive start indicates slice starting from beginning of seq
-        if (m_node->count <= s)
-            return nullptr;                 // if start is past end of seq, then indicate empty slice
-        if (m_node->count <= s + l)
-            l = m_node->count - s;          // shrink length if necessary so it doesn't run past the end of seq
+        if (count <= s)
+            return {};                      // if start is past end of seq, then indicate empty slice
+        if (count <= s + l)
+            l = count - s;                  // shrink length if necessary so it doesn't run past the end of seq
     }
 
-    return slice(m_node, s, l);
-}
-
-static void
-set_reachable(SeqNode *node)
-{
-    TU_ASSERT (node != nullptr);
-    if (node->type == SeqNodeType::LEAF) {
-        auto *leaf = static_cast<const LeafSeqNode *>(node);
-        for (int i = 0; i < leaf->count; i++) {
-            auto &cell = leaf->values[i];
-            cell.setReachable();
-        }
-    } else {
-        auto *concat = static_cast<const ConcatSeqNode *>(node);
-        set_reachable(concat->left);
-        set_reachable(concat->right);
-    }
+    return m_vector.slice(s, l);
 }
 
 void
 SeqRef::setMembersReachable()
 {
-    if (m_node == nullptr)
-        return;
-    set_reachable(m_node);
-}
-
-static void
-clear_reachable(SeqNode *node)
-{
-    TU_ASSERT (node != nullptr);
-    if (node->type == SeqNodeType::LEAF) {
-        auto *leaf = static_cast<const LeafSeqNode *>(node);
-        for (int i = 0; i < leaf->count; i++) {
-            auto &cell = leaf->values[i];
-            cell.clearReachable();
-        }
-    } else {
-        auto *concat = static_cast<const ConcatSeqNode *>(node);
-        set_reachable(concat->left);
-        set_reachable(concat->right);
-    }
-}
-
-void
-SeqRef::clearMembersReachable()
-{
-    if (m_node == nullptr)
-        return;
-    clear_reachable(m_node);
+    m_vector.setReachable();
 }
 
 SeqIterator::SeqIterator(const lyric_runtime::VirtualTable *vtable)
     : BaseRef(vtable),
-      m_curr(0),
-      m_size(0),
       m_seq(nullptr)
 {
 }
 
 SeqIterator::SeqIterator(const lyric_runtime::VirtualTable *vtable, SeqRef *seq)
     : BaseRef(vtable),
-      m_curr(0),
-      m_size(0),
+      m_cursor(seq->getVector()),
       m_seq(seq)
 {
     TU_ASSERT (m_seq != nullptr);
-    m_size = m_seq->numElements();
 }
 
 std::string
@@ -281,16 +127,14 @@ SeqIterator::toString() const
 bool
 SeqIterator::iteratorValid()
 {
-    return m_curr < m_size;
+    return m_cursor.isValid();
 }
 
 bool
 SeqIterator::iteratorNext(lyric_runtime::Operand &cell)
 {
-    if (m_curr < m_size) {
-        cell = m_seq->seqGet(lyric_runtime::Operand::fromI64(static_cast<int64_t>(m_curr++)));
+    if (m_cursor.next(cell))
         return true;
-    }
     cell = lyric_runtime::Operand();
     return false;
 }
@@ -298,13 +142,9 @@ SeqIterator::iteratorNext(lyric_runtime::Operand &cell)
 void
 SeqIterator::setMembersReachable()
 {
-    m_seq->setReachable();
-}
-
-void
-SeqIterator::clearMembersReachable()
-{
-    m_seq->clearReachable();
+    if (m_seq != nullptr) {
+        m_seq->setReachable();
+    }
 }
 
 tempo_utils::Status
@@ -334,17 +174,12 @@ seq_ctor(
     TU_ASSERT(receiver.getRef(ref));
     auto *seq = static_cast<SeqRef *>(ref);
 
-    if (frame.numRest() > 0) {
-        auto *node = new LeafSeqNode();
-        node->type = SeqNodeType::LEAF;
-        node->refcount = 0;
-        node->count = frame.numRest();
-        node->values = new lyric_runtime::Operand[node->count];
-        for (uint16_t i = 0; i < frame.numRest(); i++) {
-            node->values[i] = frame.getRest(i);
-        }
-        seq->setNode(node);
+    // build the vector in place, since it is not shared until it is assigned to the seq
+    SeqVector vector;
+    for (uint16_t i = 0; i < frame.numRest(); i++) {
+        vector.append(frame.getRest(i));
     }
+    seq->setVector(std::move(vector));
 
     return {};
 }
@@ -411,36 +246,17 @@ seq_append(
     const auto &arg0 = frame.getArgument(0);
     TU_ASSERT(arg0.isValid());
 
-    auto *left = seq->getNode();
-    TU_ASSERT (left != nullptr);
-    left->refcount++;
-    int lheight = left->type == SeqNodeType::CONCAT? static_cast<ConcatSeqNode *>(left)->height : 1;
-
-    auto *right = new LeafSeqNode();
-    right->type = SeqNodeType::LEAF;
-    right->refcount = 1;
-    right->count = frame.numRest() + 1;
-    right->values = new lyric_runtime::Operand[right->count];
-    right->values[0] = arg0;
+    // the first append copies the tail of the receiver, the remaining appends modify the copy in place
+    auto vector = seq->getVector();
+    vector.append(arg0);
     for (uint16_t i = 0; i < frame.numRest(); i++) {
-        right->values[i+1] = frame.getRest(i);
+        vector.append(frame.getRest(i));
     }
 
     vtable = seq->getVirtualTable();
     TU_ASSERT(vtable != nullptr);
 
-    auto *node = new ConcatSeqNode();
-    node->type = SeqNodeType::CONCAT;
-    node->refcount = 0;
-    node->left = left;
-    node->right = right;
-    node->count = left->count + right->count;
-    node->height = lheight + 1;
-
-    auto copy = state->heapManager()->allocateRef<SeqRef>(vtable);
-    TU_ASSERT (copy.getRef(ref));
-    auto *seqcopy = static_cast<SeqRef *>(ref);
-    seqcopy->setNode(node);
+    auto copy = state->heapManager()->allocateRef<SeqRef>(vtable, std::move(vector));
     return currentCoro->pushData(copy);
 }
 
@@ -463,31 +279,13 @@ seq_extend(
     TU_ASSERT(arg0.getRef(ref));
     auto *other = static_cast<SeqRef *>(ref);
 
-    auto *left = seq->getNode();
-    TU_ASSERT (left != nullptr);
-    left->refcount++;
-    int lheight = left->type == SeqNodeType::CONCAT? static_cast<ConcatSeqNode *>(left)->height : 1;
-
-    auto *right = other->getNode();
-    TU_ASSERT (right != nullptr);
-    right->refcount++;
-    int rheight = right->type == SeqNodeType::CONCAT? static_cast<ConcatSeqNode *>(right)->height : 1;
+    auto vector = seq->getVector();
+    vector.extend(other->getVector());
 
     vtable = seq->getVirtualTable();
     TU_ASSERT(vtable != nullptr);
 
-    auto *node = new ConcatSeqNode();
-    node->type = SeqNodeType::CONCAT;
-    node->refcount = 1;
-    node->left = left;
-    node->right = right;
-    node->count = left->count + right->count;
-    node->height = std::max(lheight, rheight) + 1;
-
-    auto copy = state->heapManager()->allocateRef<SeqRef>(vtable);
-    TU_ASSERT (copy.getRef(ref));
-    auto *seqcopy = static_cast<SeqRef *>(ref);
-    seqcopy->setNode(node);
+    auto copy = state->heapManager()->allocateRef<SeqRef>(vtable, std::move(vector));
     return currentCoro->pushData(copy);
 }
 
@@ -509,18 +307,13 @@ seq_slice(
     const auto &arg0 = frame.getArgument(0);
     const auto &arg1 = frame.getArgument(1);
 
-    auto *node = seq->seqSlice(arg0, arg1);
-    if (node != nullptr) {
-        vtable = seq->getVirtualTable();
-        node->refcount++;
-        auto copy = state->heapManager()->allocateRef<SeqRef>(vtable);
-        TU_ASSERT (copy.getRef(ref));
-        auto *seqcopy = static_cast<SeqRef *>(ref);
-        seqcopy->setNode(node);
-        return currentCoro->pushData(copy);
-    } else {
+    auto vector = seq->seqSlice(arg0, arg1);
+    if (vector.size() == seq->numElements())
         return currentCoro->pushData(receiver);
-    }
+
+    vtable = seq->getVirtualTable();
+    auto copy = state->heapManager()->allocateRef<SeqRef>(vtable, std::move(vector));
+    return currentCoro->pushData(copy);
 }
 
 tempo_utils::Status
@@ -5,50 +5,30 @@
 #include <lyric_runtime/bytecode_interpreter.h>
 #include <lyric_runtime/interpreter_state.h>
 
-enum class SeqNodeType {
-    INVALID,
-    LEAF,
-    CONCAT,
-};
-
-struct SeqNode {
-    SeqNodeType type;
-    int refcount;
-    int count;
-};
-
-struct LeafSeqNode : public SeqNode {
-    lyric_runtime::Operand *values;
-};
-
-struct ConcatSeqNode : public SeqNode {
-    SeqNode *left;
-    SeqNode *right;
-    int height;
-};
+#include "seq_vector.h"
 
 class SeqRef : public lyric_runtime::BaseRef {
 
 public:
     explicit SeqRef(const lyric_runtime::VirtualTable *vtable);
+    SeqRef(const lyric_runtime::VirtualTable *vtable, SeqVector vector);
     ~SeqRef() override;
 
     std::string toString() const override;
 
-    SeqNode *getNode() const;
-    void setNode(SeqNode *node);
+    const SeqVector &getVector() const;
+    void setVector(SeqVector vector);
 
     size_t numElements() const;
     lyric_runtime::Operand seqSize() const;
     lyric_runtime::Operand seqGet(const lyric_runtime::Operand &index) const;
-    SeqNode *seqSlice(const lyric_runtime::Operand &start, const lyric_runtime::Operand &length) const;
+    SeqVector seqSlice(const lyric_runtime::Operand &start, const lyric_runtime::Operand &length) const;
 
 protected:
     void setMembersReachable() override;
-    void clearMembersReachable() override;
 
 private:
-    SeqNode *m_node;
+    SeqVector m_vector;
 };
 
 class SeqIterator : public lyric_runtime::BaseRef {
@@ -64,11 +44,9 @@ public:
 
 protected:
     void setMembersReachable() override;
-    void clearMembersReachable() override;
 
 private:
-    size_t m_curr;
-    size_t m_size;
+    SeqCursor m_cursor;
     SeqRef *m_seq;
 };
 
@@ -0,0 +1,723 @@
+
+#include <algorithm>
+
+#include <tempo_utils/log_stream.h>
+
+#include "seq_vector.h"
+
+static LeafSeqNode *
+new_leaf()
+{
+    auto *leaf = new LeafSeqNode();
+    leaf->type = SeqNodeType::LEAF;
+    leaf->refcount = 1;
+    leaf->count = 0;
+    return leaf;
+}
+
+static BranchSeqNode *
+new_branch()
+{
+    auto *branch = new BranchSeqNode();
+    branch->type = SeqNodeType::BRANCH;
+    branch->refcount = 1;
+    branch->count = 0;
+    branch->numChildren = 0;
+    branch->relaxed = false;
+    return branch;
+}
+
+static void
+retain_node(SeqNode *node)
+{
+    TU_ASSERT (node != nullptr);
+    node->refcount++;
+}
+
+static void
+release_node(SeqNode *node)
+{
+    TU_ASSERT (node != nullptr);
+    node->refcount--;
+    if (node->refcount > 0)
+        return;
+
+    switch (node->type) {
+        case SeqNodeType::LEAF:
+            delete static_cast<LeafSeqNode *>(node);
+            break;
+        case SeqNodeType::BRANCH: {
+            auto *branch = static_cast<BranchSeqNode *>(node);
+            for (int i = 0; i < branch->numChildren; i++) {
+                release_node(branch->children[i]);
+            }
+            delete branch;
+            break;
+        }
+        default:
+            TU_UNREACHABLE();
+    }
+}
+
+/**
+ * Recalculates the element count, the cumulative size table, and the relaxed flag of the specified
+ * `branch` at level `shift` from its children.
+ */
+static void
+update_branch(BranchSeqNode *branch, int shift)
+{
+    const int full = 1 << shift;
+    int count = 0;
+    bool relaxed = false;
+    for (int i = 0; i < branch->numChildren; i++) {
+        const auto *child = branch->children[i];
+        count += child->count;
+        branch->sizes[i] = count;
+        if (i < branch->numChildren - 1 && child->count != full) {
+            relaxed = true;
+        }
+    }
+    branch->count = count;
+    branch->relaxed = relaxed;
+}
+
+/**
+ * Returns a leaf which may be modified in place by the holder of the reference to `leaf`. If the holder
+ * is the sole owner then the leaf itself is returned, otherwise the reference is transferred to a copy.
+ */
+static LeafSeqNode *
+unique_leaf(LeafSeqNode *leaf)
+{
+    if (leaf->refcount == 1)
+        return leaf;
+    auto *copy = new_leaf();
+    copy->count = leaf->count;
+    for (int i = 0; i < leaf->count; i++) {
+        copy->values[i] = leaf->values[i];
+    }
+    leaf->refcount--;
+    return copy;
+}
+
+/**
+ * Returns a branch which may be modified in place by the holder of the reference to `branch`. If the
+ * holder is the sole owner then the branch itself is returned, otherwise the reference is transferred to
+ * a copy which shares the children of the branch.
+ */
+static BranchSeqNode *
+unique_branch(BranchSeqNode *branch)
+{
+    if (branch->refcount == 1)
+        return branch;
+    auto *copy = new_branch();
+    copy->count = branch->count;
+    copy->numChildren = branch->numChildren;
+    copy->relaxed = branch->relaxed;
+    for (int i = 0; i < branch->numChildren; i++) {
+        copy->children[i] = branch->children[i];
+        copy->sizes[i] = branch->sizes[i];
+        retain_node(copy->children[i]);
+    }
+    branch->refcount--;
+    return copy;
+}
+
+/**
+ * Wraps `node` at level `nodeShift` in single-child branches until it reaches level `shift`.
+ */
+static SeqNode *
+new_path(SeqNode *node, int nodeShift, int shift)
+{
+    while (nodeShift < shift) {
+        auto *branch = new_branch();
+        nodeShift += kSeqNodeBits;
+        branch->children[0] = node;
+        branch->numChildren = 1;
+        update_branch(branch, nodeShift);
+        node = branch;
+    }
+    return node;
+}
+
+static bool
+has_room(const SeqNode *node)
+{
+    if (node->type == SeqNodeType::LEAF)
+        return false;
+    auto *branch = static_cast<const BranchSeqNode *>(node);
+    if (branch->numChildren < kSeqNodeWidth)
+        return true;
+    return has_room(branch->children[branch->numChildren - 1]);
+}
+
+/**
+ * Appends `leaf` to the rightmost edge of the uniquely owned `branch` at level `shift`. The caller must
+ * ensure the branch has room for the leaf.
+ */
+static void
+push_leaf(BranchSeqNode *branch, int shift, SeqNode *leaf)
+{
+    if (kSeqNodeBits < shift) {
+        auto *last = branch->children[branch->numChildren - 1];
+        if (has_room(last)) {
+            auto *child = unique_branch(static_cast<BranchSeqNode *>(last));
+            branch->children[branch->numChildren - 1] = child;
+            push_leaf(child, shift - kSeqNodeBits, leaf);
+            update_branch(branch, shift);
+            return;
+        }
+    }
+    TU_ASSERT (branch->numChildren < kSeqNodeWidth);
+    branch->children[branch->numChildren++] = new_path(leaf, 0, shift - kSeqNodeBits);
+    update_branch(branch, shift);
+}
+
+/**
+ * Inserts the subtree `node` at level `nodeShift` at the rightmost edge of the uniquely owned `branch` at
+ * level `shift`. If there is no room for the subtree then returns a new sibling of the branch containing
+ * the subtree, otherwise returns nullptr.
+ */
+static SeqNode *
+insert_right(BranchSeqNode *branch, int shift, SeqNode *node, int nodeShift)
+{
+    SeqNode *overflow = node;
+    if (nodeShift < shift - kSeqNodeBits) {
+        auto *last = unique_branch(static_cast<BranchSeqNode *>(branch->children[branch->numChildren - 1]));
+        branch->children[branch->numChildren - 1] = last;
+        overflow = insert_right(last, shift - kSeqNodeBits, node, nodeShift);
+    }
+    if (overflow != nullptr) {
+        if (branch->numChildren < kSeqNodeWidth) {
+            branch->children[branch->numChildren++] = overflow;
+            overflow = nullptr;
+        } else {
+            overflow = new_path(overflow, shift - kSeqNodeBits, shift);
+        }
+    }
+    update_branch(branch, shift);
+    return overflow;
+}
+
+/**
+ * Inserts the subtree `node` at level `nodeShift` at the leftmost edge of the uniquely owned `branch` at
+ * level `shift`. If there is no room for the subtree then returns a new sibling of the branch containing
+ * the subtree, otherwise returns nullptr.
+ */
+static SeqNode *
+insert_left(BranchSeqNode *branch, int shift, SeqNode *node, int nodeShift)
+{
+    SeqNode *overflow = node;
+    if (nodeShift < shift - kSeqNodeBits) {
+        auto *first = unique_branch(static_cast<BranchSeqNode *>(branch->children[0]));
+        branch->children[0] = first;
+        overflow = insert_left(first, shift - kSeqNodeBits, node, nodeShift);
+    }
+    if (overflow != nullptr) {
+        if (branch->numChildren < kSeqNodeWidth) {
+            for (int i = branch->numChildren; i > 0; i--) {
+                branch->children[i] = branch->children[i - 1];
+            }
+            branch->children[0] = overflow;
+            branch->numChildren++;
+            overflow = nullptr;
+        } else {
+            overflow = new_path(overflow, shift - kSeqNodeBits, shift);
+        }
+    }
+    update_branch(branch, shift);
+    return overflow;
+}
+
+/**
+ * Joins the subtrees `left` and `right` which are both at level `shift`. If both subtrees are branches
+ * whose children fit in a single branch then the children are merged and the result is at level `shift`,
+ * otherwise the result is a new branch at the next level up.
+ */
+static SeqNode *
+join_nodes(SeqNode *left, SeqNode *right, int shift, int &joinedShift)
+{
+    if (left->type == SeqNodeType::BRANCH && right->type == SeqNodeType::BRANCH) {
+        auto *rbranch = static_cast<BranchSeqNode *>(right);
+        if (static_cast<BranchSeqNode *>(left)->numChildren + rbranch->numChildren <= kSeqNodeWidth) {
+            auto *lbranch = unique_branch(static_cast<BranchSeqNode *>(left));
+            for (int i = 0; i < rbranch->numChildren; i++) {
+                lbranch->children[lbranch->numChildren++] = rbranch->children[i];
+                retain_node(rbranch->children[i]);
+            }
+            release_node(rbranch);
+            update_branch(lbranch, shift);
+            joinedShift = shift;
+            return lbranch;
+        }
+    }
+
+    auto *branch = new_branch();
+    branch->children[0] = left;
+    branch->children[1] = right;
+    branch->numChildren = 2;
+    joinedShift = shift + kSeqNodeBits;
+    update_branch(branch, joinedShift);
+    return branch;
+}
+
+/**
+ * Returns a subtree containing the elements in the range [start, end) of `node` at level `shift`. The
+ * returned subtree is at the same level as `node` and shares all nodes which are entirely contained in
+ * the range.
+ */
+static SeqNode *
+slice_node(SeqNode *node, int shift, int start, int end)
+{
+    if (start == 0 && end == node->count) {
+        retain_node(node);
+        return node;
+    }
+
+    if (node->type == SeqNodeType::LEAF) {
+        auto *leaf = static_cast<LeafSeqNode *>(node);
+        auto *sliced = new_leaf();
+        for (int i = start; i < end; i++) {
+            sliced->values[sliced->count++] = leaf->values[i];
+        }
+        return sliced;
+    }
+
+    auto *branch = static_cast<BranchSeqNode *>(node);
+    auto *sliced = new_branch();
+    int lo = 0;
+    for (int i = 0; i < branch->numChildren && lo < end; i++) {
+        auto *child = branch->children[i];
+        int hi = lo + child->count;
+        if (start < hi) {
+            sliced->children[sliced->numChildren++] = slice_node(child, shift - kSeqNodeBits,
+                std::max(start, lo) - lo, std::min(end, hi) - lo);
+        }
+        lo = hi;
+    }
+    update_branch(sliced, shift);
+    return sliced;
+}
+
+/**
+ * Returns the height of the shortest tree which can hold `size` elements.
+ */
+static int
+minimum_height(int size)
+{
+    int height = 1;
+    tu_int64 capacity = kSeqNodeWidth;
+    while (capacity < size) {
+        capacity <<= kSeqNodeBits;
+        height++;
+    }
+    return height;
+}
+
+static void
+set_reachable(const SeqNode *node)
+{
+    if (node->type == SeqNodeType::LEAF) {
+        auto *leaf = static_cast<const LeafSeqNode *>(node);
+        for (int i = 0; i < leaf->count; i++) {
+            leaf->values[i].setReachable();
+        }
+    } else {
+        auto *branch = static_cast<const BranchSeqNode *>(node);
+        for (int i = 0; i < branch->numChildren; i++) {
+            set_reachable(branch->children[i]);
+        }
+    }
+}
+
+SeqVector::SeqVector()
+    : m_root(nullptr),
+      m_tail(nullptr),
+      m_shift(0),
+      m_size(0)
+{
+}
+
+SeqVector::SeqVector(const SeqVector &other)
+    : m_root(other.m_root),
+      m_tail(other.m_tail),
+      m_shift(other.m_shift),
+      m_size(other.m_size)
+{
+    if (m_root != nullptr) {
+        retain_node(m_root);
+    }
+    if (m_tail != nullptr) {
+        retain_node(m_tail);
+    }
+}
+
+SeqVector::SeqVector(SeqVector &&other) noexcept
+    : m_root(other.m_root),
+      m_tail(other.m_tail),
+      m_shift(other.m_shift),
+      m_size(other.m_size)
+{
+    other.m_root = nullptr;
+    other.m_tail = nullptr;
+    other.m_shift = 0;
+    other.m_size = 0;
+}
+
+SeqVector::~SeqVector()
+{
+    release();
+}
+
+SeqVector &
+SeqVector::operator=(const SeqVector &other)
+{
+    if (this != &other) {
+        if (other.m_root != nullptr) {
+            retain_node(other.m_root);
+        }
+        if (other.m_tail != nullptr) {
+            retain_node(other.m_tail);
+        }
+        release();
+        m_root = other.m_root;
+        m_tail = other.m_tail;
+        m_shift = other.m_shift;
+        m_size = other.m_size;
+    }
+    return *this;
+}
+
+SeqVector &
+SeqVector::operator=(SeqVector &&other) noexcept
+{
+    if (this != &other) {
+        release();
+        m_root = other.m_root;
+        m_tail = other.m_tail;
+        m_shift = other.m_shift;
+        m_size = other.m_size;
+        other.m_root = nullptr;
+        other.m_tail = nullptr;
+        other.m_shift = 0;
+        other.m_size = 0;
+    }
+    return *this;
+}
+
+void
+SeqVector::release()
+{
+    if (m_root != nullptr) {
+        release_node(m_root);
+        m_root = nullptr;
+    }
+    if (m_tail != nullptr) {
+        release_node(m_tail);
+        m_tail = nullptr;
+    }
+    m_shift = 0;
+    m_size = 0;
+}
+
+int
+SeqVector::size() const
+{
+    return m_size;
+}
+
+bool
+SeqVector::isEmpty() const
+{
+    return m_size == 0;
+}
+
+/**
+ * Returns the number of levels in the tree, not including the tail.
+ */
+int
+SeqVector::height() const
+{
+    return m_root != nullptr? (m_shift / kSeqNodeBits) + 1 : 0;
+}
+
+int
+SeqVector::tailOffset() const
+{
+    return m_size - (m_tail != nullptr? m_tail->count : 0);
+}
+
+/**
+ * Returns the element at the specified `index`, which must be within the bounds of the vector.
+ */
+const lyric_runtime::Operand &
+SeqVector::get(int index) const
+{
+    int leafStart;
+    auto *leaf = leafFor(index, leafStart);
+    return leaf->values[index - leafStart];
+}
+
+/**
+ * Returns the leaf containing the element at the specified `index`, and sets `leafStart` to the index of
+ * the first element in the leaf. Radix branches are descended by shifting the index; relaxed branches
+ * start from the radix guess and scan forward in the size table.
+ */
+const LeafSeqNode *
+SeqVector::leafFor(int index, int &leafStart) const
+{
+    TU_ASSERT (0 <= index && index < m_size);
+
+    auto offset = tailOffset();
+    if (offset <= index) {
+        leafStart = offset;
+        return m_tail;
+    }
+
+    const SeqNode *node = m_root;
+    int shift = m_shift;
+    int start = 0;
+    while (node->type == SeqNodeType::BRANCH) {
+        auto *branch = static_cast<const BranchSeqNode *>(node);
+        int i = index - start;
+        int idx = i >> shift;
+        if (branch->relaxed) {
+            while (branch->sizes[idx] <= i) {
+                idx++;
+            }
+        }
+        TU_ASSERT (idx < branch->numChildren);
+        if (idx > 0) {
+            start += branch->sizes[idx - 1];
+        }
+        node = branch->children[idx];
+        shift -= kSeqNodeBits;
+    }
+
+    leafStart = start;
+    return static_cast<const LeafSeqNode *>(node);
+}
+
+/**
+ * Moves the tail leaf into the tree. The tail may be partially filled, in which case the branches
+ * along the right edge of the tree become relaxed once another leaf is pushed after it.
+ */
+void
+SeqVector::pushTail()
+{
+    TU_ASSERT (m_tail != nullptr);
+    SeqNode *leaf = m_tail;
+    m_tail = nullptr;
+
+    if (m_root == nullptr) {
+        m_root = leaf;
+        m_shift = 0;
+        return;
+    }
+
+    BranchSeqNode *root;
+    if (has_room(m_root)) {
+        root = unique_branch(static_cast<BranchSeqNode *>(m_root));
+    } else {
+        root = new_branch();
+        root->children[0] = m_root;
+        root->numChildren = 1;
+        m_shift += kSeqNodeBits;
+    }
+    push_leaf(root, m_shift, leaf);
+    m_root = root;
+}
+
+/**
+ * Appends `value` to the end of the vector. The tail is modified in place if the vector is its sole
+ * owner, and the tree is only modified when a full tail is pushed into it.
+ */
+void
+SeqVector::append(const lyric_runtime::Operand &value)
+{
+    if (m_tail != nullptr && m_tail->count == kSeqNodeWidth) {
+        pushTail();
+    }
+    if (m_tail == nullptr) {
+        m_tail = new_leaf();
+    } else {
+        m_tail = unique_leaf(m_tail);
+    }
+    m_tail->values[m_tail->count++] = value;
+    m_size++;
+}
+
+/**
+ * Appends all elements of `other` to the end of the vector. Small vectors are appended element by
+ * element, otherwise the tree of `other` is joined to the tree of this vector along the edge of the
+ * shorter tree, sharing all nodes of `other` which are not on the joined edge.
+ */
+void
+SeqVector::extend(const SeqVector &other)
+{
+    if (other.m_size == 0)
+        return;
+    if (m_size == 0) {
+        *this = other;
+        return;
+    }
+
+    SeqVector rhs(other);
+
+    if (rhs.m_size <= kSeqNodeWidth) {
+        for (int i = 0; i < rhs.m_size;) {
+            int leafStart;
+            auto *leaf = rhs.leafFor(i, leafStart);
+            for (int j = i - leafStart; j < leaf->count; j++, i++) {
+                append(leaf->values[j]);
+            }
+        }
+        return;
+    }
+
+    if (m_tail != nullptr) {
+        pushTail();
+    }
+
+    auto *right = rhs.m_root;
+    retain_node(right);
+
+    if (rhs.m_shift < m_shift) {
+        auto *root = unique_branch(static_cast<BranchSeqNode *>(m_root));
+        auto *overflow = insert_right(root, m_shift, right, rhs.m_shift);
+        m_root = overflow != nullptr? join_nodes(root, overflow, m_shift, m_shift) : root;
+    } else if (m_shift < rhs.m_shift) {
+        auto *root = unique_branch(static_cast<BranchSeqNode *>(right));
+        auto *overflow = insert_left(root, rhs.m_shift, m_root, m_shift);
+        m_root = overflow != nullptr? join_nodes(overflow, root, rhs.m_shift, m_shift) : root;
+        if (overflow == nullptr) {
+            m_shift = rhs.m_shift;
+        }
+    } else {
+        m_root = join_nodes(m_root, right, m_shift, m_shift);
+    }
+
+    if (rhs.m_tail != nullptr) {
+        retain_node(rhs.m_tail);
+        m_tail = rhs.m_tail;
+    }
+    m_size += rhs.m_size;
+
+    rebalance();
+}
+
+/**
+ * Returns a vector containing `length` elements starting at `start`. The range must be within the
+ * bounds of the vector. The slice shares every node which lies entirely within the range.
+ */
+SeqVector
+SeqVector::slice(int start, int length) const
+{
+    TU_ASSERT (0 <= start && 0 <= length && start + length <= m_size);
+
+    SeqVector sliced;
+    if (length == 0)
+        return sliced;
+    if (start == 0 && length == m_size)
+        return *this;
+
+    int end = start + length;
+    int offset = tailOffset();
+
+    if (start < offset) {
+        auto *root = slice_node(m_root, m_shift, start, std::min(end, offset));
+        int shift = m_shift;
+        // collapse single-child branches at the top of the sliced tree
+        while (root->type == SeqNodeType::BRANCH && static_cast<BranchSeqNode *>(root)->numChildren == 1) {
+            auto *branch = static_cast<BranchSeqNode *>(root);
+            root = branch->children[0];
+            retain_node(root);
+            release_node(branch);
+            shift -= kSeqNodeBits;
+        }
+        sliced.m_root = root;
+        sliced.m_shift = shift;
+    }
+
+    if (offset < end) {
+        int tailStart = std::max(start, offset) - offset;
+        int tailEnd = end - offset;
+        if (tailStart == 0 && tailEnd == m_tail->count) {
+            retain_node(m_tail);
+            sliced.m_tail = m_tail;
+        } else {
+            sliced.m_tail = static_cast<LeafSeqNode *>(slice_node(m_tail, 0, tailStart, tailEnd));
+        }
+    }
+
+    sliced.m_size = length;
+    sliced.rebalance();
+    return sliced;
+}
+
+/**
+ * Rebuilds the tree if it has become more than one level taller than necessary to hold its elements.
+ * Joining and slicing do not redistribute elements between leaves, so a sequence of extends and slices
+ * can leave sparse leaves and relaxed branches behind; rebuilding restores a dense radix tree.
+ */
+void
+SeqVector::rebalance()
+{
+    if (m_root == nullptr || height() <= minimum_height(m_root->count) + 1)
+        return;
+
+    SeqVector rebuilt;
+    SeqCursor cursor(*this);
+    lyric_runtime::Operand value;
+    while (cursor.next(value)) {
+        rebuilt.append(value);
+    }
+    *this = std::move(rebuilt);
+}
+
+void
+SeqVector::setReachable() const
+{
+    if (m_root != nullptr) {
+        set_reachable(m_root);
+    }
+    if (m_tail != nullptr) {
+        set_reachable(m_tail);
+    }
+}
+
+SeqCursor::SeqCursor()
+    : m_leaf(nullptr),
+      m_leafStart(0),
+      m_leafEnd(0),
+      m_curr(0)
+{
+}
+
+SeqCursor::SeqCursor(const SeqVector &vector)
+    : m_vector(vector),
+      m_leaf(nullptr),
+      m_leafStart(0),
+      m_leafEnd(0),
+      m_curr(0)
+{
+}
+
+bool
+SeqCursor::isValid() const
+{
+    return m_curr < m_vector.size();
+}
+
+bool
+SeqCursor::next(lyric_runtime::Operand &value)
+{
+    if (m_vector.size() <= m_curr)
+        return false;
+    if (m_leaf == nullptr || m_leafEnd <= m_curr) {
+        m_leaf = m_vector.leafFor(m_curr, m_leafStart);
+        m_leafEnd = m_leafStart + m_leaf->count;
+    }
+    value = m_leaf->values[m_curr - m_leafStart];
+    m_curr++;
+    return true;
+}
@@ -0,0 +1,102 @@
+#ifndef LYRIC_BOOTSTRAP_SEQ_VECTOR_H
+#define LYRIC_BOOTSTRAP_SEQ_VECTOR_H
+
+#include <lyric_runtime/operand.h>
+
+constexpr int kSeqNodeBits = 5;
+constexpr int kSeqNodeWidth = 1 << kSeqNodeBits;
+constexpr int kSeqNodeMask = kSeqNodeWidth - 1;
+
+enum class SeqNodeType {
+    INVALID,
+    LEAF,
+    BRANCH,
+};
+
+struct SeqNode {
+    SeqNodeType type;
+    int refcount;
+    int count;                                          /**< Number of elements contained in the subtree. */
+};
+
+struct LeafSeqNode : public SeqNode {
+    lyric_runtime::Operand values[kSeqNodeWidth];
+};
+
+struct BranchSeqNode : public SeqNode {
+    int numChildren;
+    bool relaxed;                                       /**< True if any child other than the last is not full. */
+    SeqNode *children[kSeqNodeWidth];
+    int sizes[kSeqNodeWidth];                           /**< Cumulative element count of each child. */
+};
+
+/**
+ * Persistent vector of operands implemented as a relaxed radix balanced tree. Elements are stored in
+ * leaves holding up to kSeqNodeWidth elements, and the last leaf is kept outside the tree as the tail so
+ * that appends only touch the tree once per kSeqNodeWidth elements. Branches whose children are all full
+ * (except possibly the last) are indexed by radix; branches produced by concatenation and slicing are
+ * relaxed and are indexed using their cumulative size table.
+ *
+ * Nodes are reference counted and shared between vectors. Copying a vector is constant-time; a vector
+ * modifies a node in place only while it holds the sole reference to the node, and otherwise copies the
+ * node first. Appending a batch of elements to a vector therefore copies the path to the tail once and
+ * mutates the freshly copied nodes in place for the remainder of the batch.
+ */
+class SeqVector {
+
+public:
+    SeqVector();
+    SeqVector(const SeqVector &other);
+    SeqVector(SeqVector &&other) noexcept;
+    ~SeqVector();
+
+    SeqVector &operator=(const SeqVector &other);
+    SeqVector &operator=(SeqVector &&other) noexcept;
+
+    int size() const;
+    bool isEmpty() const;
+    int height() const;
+
+    const lyric_runtime::Operand &get(int index) const;
+    const LeafSeqNode *leafFor(int index, int &leafStart) const;
+
+    void append(const lyric_runtime::Operand &value);
+    void extend(const SeqVector &other);
+    SeqVector slice(int start, int length) const;
+
+    void setReachable() const;
+
+private:
+    SeqNode *m_root;
+    LeafSeqNode *m_tail;
+    int m_shift;
+    int m_size;
+
+    int tailOffset() const;
+    void pushTail();
+    void rebalance();
+    void release();
+};
+
+/**
+ * Cursor which iterates the elements of a SeqVector in order. The cursor caches the current leaf, so
+ * advancing the cursor is constant-time except when crossing into the next leaf.
+ */
+class SeqCursor {
+
+public:
+    SeqCursor();
+    explicit SeqCursor(const SeqVector &vector);
+
+    bool isValid() const;
+    bool next(lyric_runtime::Operand &value);
+
+private:
+    SeqVector m_vector;
+    const LeafSeqNode *m_leaf;
+    int m_leafStart;
+    int m_leafEnd;
+    int m_curr;
+};
+
+#endif // LYRIC_BOOTSTRAP_SEQ_VECTOR_H
@@ -67,14 +67,6 @@ SingletonRef::setMembersReachable()
     }
 }
 
-void
-SingletonRef::clearMembersReachable()
-{
-    for (auto &cell : m_fields) {
-        cell.clearReachable();
-    }
-}
-
 tempo_utils::Status
 singleton_alloc(
     lyric_runtime::BytecodeInterpreter *interp,
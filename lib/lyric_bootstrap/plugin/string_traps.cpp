@@ -1,10 +1,62 @@
 
+#include <lyric_runtime/internal/text_kernels.h>
 #include <lyric_runtime/interpreter_state.h>
 #include <lyric_runtime/string_ref.h>
 #include <tempo_utils/log_stream.h>
 
+#include "seq_ref.h"
 #include "string_traps.h"
 
+/**
+ * Allocates a string containing `rope` and pushes it onto the stack. If `index` is valid then it becomes
+ * the code point index of the new string, otherwise the index is built on first use.
+ */
+static tempo_utils::Status
+push_string(
+    lyric_runtime::InterpreterState *state,
+    tempo_utils::Rope<char> rope,
+    lyric_runtime::StringIndex index)
+{
+    auto *currentCoro = state->currentCoro();
+    auto *heapManager = state->heapManager();
+
+    auto operand = heapManager->allocateString(std::move(rope), /* isPermanent= */ false);
+    lyric_runtime::StringRef *string;
+    TU_ASSERT (operand.getString(string));
+    if (index.isValid() && index.getSize() == string->getStringSize()) {
+        string->setStringIndex(std::move(index));
+    }
+    return currentCoro->pushData(operand);
+}
+
+/**
+ * Returns the index of the concatenation of `lhs` and `rhs` if both strings are already indexed, otherwise
+ * returns an invalid index.
+ */
+static lyric_runtime::StringIndex
+concat_index(const lyric_runtime::StringRef *lhs, const lyric_runtime::StringRef *rhs)
+{
+    if (lhs->hasStringIndex() && rhs->hasStringIndex())
+        return lyric_runtime::StringIndex::concat(lhs->getStringIndex(), rhs->getStringIndex());
+    return lyric_runtime::StringIndex::invalid();
+}
+
+/**
+ * Returns the index of a string whose contents are derived from the contents of `string` and `other`
+ * (if not nullptr) by byte offset, if all of the source strings are already indexed and ASCII-only. The
+ * contents of ASCII-only strings remain ASCII-only when spliced at any byte offset, so the index of the
+ * result follows from its size. Otherwise returns an invalid index.
+ */
+static lyric_runtime::StringIndex
+ascii_index(const lyric_runtime::StringRef *string, const lyric_runtime::StringRef *other, tu_int32 size)
+{
+    if (!string->hasStringIndex() || !string->getStringIndex().isAscii())
+        return lyric_runtime::StringIndex::invalid();
+    if (other != nullptr && (!other->hasStringIndex() || !other->getStringIndex().isAscii()))
+        return lyric_runtime::StringIndex::invalid();
+    return lyric_runtime::StringIndex::forAscii(size);
+}
+
 tempo_utils::Status
 string_at(
     lyric_runtime::BytecodeInterpreter *interp,
@@ -89,7 +141,6 @@ string_append(
     const lyric_runtime::VirtualTable *vtable)
 {
     auto *currentCoro = state->currentCoro();
-    auto *heapManager = state->heapManager();
 
     auto &frame = currentCoro->currentCallOrThrow();
     auto receiver = frame.getReceiver();
@@ -101,8 +152,8 @@ string_append(
     const auto &arg0 = frame.getArgument(0);
     TU_ASSERT(arg0.getString(other));
 
-    auto rope = string->getStringData().append(other->getStringData());;
-    return heapManager->loadStringOntoStack(rope);
+    auto rope = string->getStringData().append(other->getStringData());
+    return push_string(state, std::move(rope), concat_index(string, other));
 }
 
 tempo_utils::Status
@@ -112,7 +163,6 @@ string_prepend(
     const lyric_runtime::VirtualTable *vtable)
 {
     auto *currentCoro = state->currentCoro();
-    auto *heapManager = state->heapManager();
 
     auto &frame = currentCoro->currentCallOrThrow();
     auto receiver = frame.getReceiver();
@@ -124,8 +174,8 @@ string_prepend(
     const auto &arg0 = frame.getArgument(0);
     TU_ASSERT(arg0.getString(other));
 
-    auto rope = string->getStringData().prepend(other->getStringData());;
-    return heapManager->loadStringOntoStack(rope);
+    auto rope = string->getStringData().prepend(other->getStringData());
+    return push_string(state, std::move(rope), concat_index(other, string));
 }
 
 tempo_utils::Status
@@ -135,7 +185,6 @@ string_insert(
     const lyric_runtime::VirtualTable *vtable)
 {
     auto *currentCoro = state->currentCoro();
-    auto *heapManager = state->heapManager();
 
     auto &frame = currentCoro->currentCallOrThrow();
     auto receiver = frame.getReceiver();
@@ -150,8 +199,9 @@ string_insert(
     const auto &arg1 = frame.getArgument(1);
     TU_ASSERT(arg1.getString(other));
 
-    auto rope = string->getStringData().insert(offset, other->getStringData());;
-    return heapManager->loadStringOntoStack(rope);
+    auto rope = string->getStringData().insert(offset, other->getStringData());
+    auto size = static_cast<tu_int32>(rope.numElements());
+    return push_string(state, std::move(rope), ascii_index(string, other, size));
 }
 
 tempo_utils::Status
@@ -161,7 +211,6 @@ string_remove(
     const lyric_runtime::VirtualTable *vtable)
 {
     auto *currentCoro = state->currentCoro();
-    auto *heapManager = state->heapManager();
 
     auto &frame = currentCoro->currentCallOrThrow();
     auto receiver = frame.getReceiver();
@@ -175,8 +224,9 @@ string_remove(
     const auto &arg1 = frame.getArgument(1);
     TU_ASSERT(arg1.getI64(count));
 
-    auto rope = string->getStringData().remove(offset, count);;
-    return heapManager->loadStringOntoStack(rope);
+    auto rope = string->getStringData().remove(offset, count);
+    auto size = static_cast<tu_int32>(rope.numElements());
+    return push_string(state, std::move(rope), ascii_index(string, nullptr, size));
 }
 
 tempo_utils::Status
@@ -186,7 +236,6 @@ string_substring(
     const lyric_runtime::VirtualTable *vtable)
 {
     auto *currentCoro = state->currentCoro();
-    auto *heapManager = state->heapManager();
 
     auto &frame = currentCoro->currentCallOrThrow();
     auto receiver = frame.getReceiver();
@@ -200,6 +249,148 @@ string_substring(
     const auto &arg1 = frame.getArgument(1);
     TU_ASSERT(arg1.getI64(count));
 
-    auto rope = string->getStringData().subspan(offset, count);;
-    return heapManager->loadStringOntoStack(rope);
+    auto rope = string->getStringData().subspan(offset, count);
+    auto size = static_cast<tu_int32>(rope.numElements());
+    return push_string(state, std::move(rope), ascii_index(string, nullptr, size));
+}
+
+/**
+ * Returns the contents of `string` as a contiguous buffer, suitable for the search kernels.
+ */
+static std::string
+flatten_string(const lyric_runtime::StringRef *string)
+{
+    std::string utf8;
+    string->utf8Value(utf8);
+    return utf8;
+}
+
+tempo_utils::Status
+string_find(
+    lyric_runtime::BytecodeInterpreter *interp,
+    lyric_runtime::InterpreterState *state,
+    const lyric_runtime::VirtualTable *vtable)
+{
+    auto *currentCoro = state->currentCoro();
+
+    auto &frame = currentCoro->currentCallOrThrow();
+    auto receiver = frame.getReceiver();
+    lyric_runtime::StringRef *string;
+    TU_ASSERT (receiver.getString(string));
+
+    lyric_runtime::StringRef *needle;
+    TU_ASSERT (frame.numArguments() == 1);
+    const auto &arg0 = frame.getArgument(0);
+    TU_ASSERT (arg0.getString(needle));
+
+    auto haystack = flatten_string(string);
+    auto pattern = flatten_string(needle);
+    auto offset = lyric_runtime::internal::find_bytes(
+        haystack.data(), haystack.size(), pattern.data(), pattern.size());
+    if (offset == lyric_runtime::internal::kNotFound)
+        return currentCoro->pushData(lyric_runtime::Operand::undef());
+    return currentCoro->pushData(lyric_runtime::Operand::fromI64(static_cast<tu_int64>(offset)));
+}
+
+tempo_utils::Status
+string_contains(
+    lyric_runtime::BytecodeInterpreter *interp,
+    lyric_runtime::InterpreterState *state,
+    const lyric_runtime::VirtualTable *vtable)
+{
+    auto *currentCoro = state->currentCoro();
+
+    auto &frame = currentCoro->currentCallOrThrow();
+    auto receiver = frame.getReceiver();
+    lyric_runtime::StringRef *string;
+    TU_ASSERT (receiver.getString(string));
+
+    lyric_runtime::StringRef *needle;
+    TU_ASSERT (frame.numArguments() == 1);
+    const auto &arg0 = frame.getArgument(0);
+    TU_ASSERT (arg0.getString(needle));
+
+    auto haystack = flatten_string(string);
+    auto pattern = flatten_string(needle);
+    auto offset = lyric_runtime::internal::find_bytes(
+        haystack.data(), haystack.size(), pattern.data(), pattern.size());
+    return currentCoro->pushData(lyric_runtime::Operand::fromBool(offset != lyric_runtime::internal::kNotFound));
+}
+
+tempo_utils::Status
+string_starts_with(
+    lyric_runtime::BytecodeInterpreter *interp,
+    lyric_runtime::InterpreterState *state,
+    const lyric_runtime::VirtualTable *vtable)
+{
+    auto *currentCoro = state->currentCoro();
+
+    auto &frame = currentCoro->currentCallOrThrow();
+    auto receiver = frame.getReceiver();
+    lyric_runtime::StringRef *string;
+    TU_ASSERT (receiver.getString(string));
+
+    lyric_runtime::StringRef *other;
+    TU_ASSERT (frame.numArguments() == 1);
+    const auto &arg0 = frame.getArgument(0);
+    TU_ASSERT (arg0.getString(other));
+
+    // compare the prefix of the receiver chunk by chunk, without flattening either rope
+    auto size = other->getStringSize();
+    if (string->getStringSize() < size)
+        return currentCoro->pushData(lyric_runtime::Operand::fromBool(false));
+    auto head = string->getStringData().subspan(0, size);
+    auto cmp = lyric_runtime::internal::compare_ropes(head, other->getStringData());
+    return currentCoro->pushData(lyric_runtime::Operand::fromBool(cmp == 0));
+}
+
+tempo_utils::Status
+string_split(
+    lyric_runtime::BytecodeInterpreter *interp,
+    lyric_runtime::InterpreterState *state,
+    const lyric_runtime::VirtualTable *vtable)
+{
+    auto *currentCoro = state->currentCoro();
+    auto *heapManager = state->heapManager();
+
+    auto &frame = currentCoro->currentCallOrThrow();
+    auto receiver = frame.getReceiver();
+    lyric_runtime::StringRef *string;
+    TU_ASSERT (receiver.getString(string));
+
+    lyric_runtime::StringRef *separator;
+    TU_ASSERT (frame.numArguments() == 1);
+    const auto &arg0 = frame.getArgument(0);
+    TU_ASSERT (arg0.getString(separator));
+
+    // the Seq descriptor is pushed onto the stack before the trap
+    lyric_runtime::Operand descriptor;
+    TU_RETURN_IF_NOT_OK (currentCoro->popData(descriptor));
+
+    lyric_runtime::InterpreterStatus status;
+    vtable = state->segmentManager()->resolveStructVirtualTable(descriptor, status);
+    if (vtable == nullptr)
+        return status;
+
+    auto haystack = flatten_string(string);
+    auto pattern = flatten_string(separator);
+    auto rope = string->getStringData();
+
+    // each element shares the contents of the receiver rope
+    SeqVector vector;
+    size_t start = 0;
+    if (!pattern.empty()) {
+        for (;;) {
+            auto offset = lyric_runtime::internal::find_bytes(
+                haystack.data() + start, haystack.size() - start, pattern.data(), pattern.size());
+            if (offset == lyric_runtime::internal::kNotFound)
+                break;
+            vector.append(heapManager->allocateString(rope.subspan(start, offset), /* isPermanent= */ false));
+            start += offset + pattern.size();
+        }
+    }
+    vector.append(heapManager->allocateString(rope.subspan(start, haystack.size() - start), /* isPermanent= */ false));
+
+    auto seq = heapManager->allocateRef<SeqRef>(vtable, std::move(vector));
+    return currentCoro->pushData(seq);
 }
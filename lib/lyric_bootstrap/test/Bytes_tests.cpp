@@ -159,3 +159,21 @@ TEST_F(BytesTests, TestEvaluateBytesGreaterOrEqual)
 
     ASSERT_THAT (result, tempo_test::ContainsResult(RunModule(OperandBool(true))));
 }
+
+TEST_F(BytesTests, TestEvaluateBytesFindNotFound)
+{
+    auto result = runModule(R"(
+        "hello world".ToBytes().Find("xyz".ToBytes())
+    )");
+
+    ASSERT_THAT (result, tempo_test::ContainsResult(RunModule(OperandUndef())));
+}
+
+TEST_F(BytesTests, TestEvaluateBytesContains)
+{
+    auto result = runModule(R"(
+        "hello world".ToBytes().Contains(" wo".ToBytes())
+    )");
+
+    ASSERT_THAT (result, tempo_test::ContainsResult(RunModule(OperandBool(true))));
+}
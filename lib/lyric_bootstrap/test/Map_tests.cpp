@@ -125,3 +125,23 @@ TEST_F(MapTests, TestEvaluateMapIterateImpl)
 
     ASSERT_THAT (result, tempo_test::ContainsResult(RunModule(OperandInt(3))));
 }
+
+TEST_F(MapTests, TestEvaluateMapUpdateAndRemoveManyEntries)
+{
+    auto result = runModule(R"(
+        var numbers: Map = Map{}
+        var i: I64 = 0
+        while i < 1000 {
+            numbers = numbers.Update(i, i)
+            i += 1
+        }
+        i = 0
+        while i < 1000 {
+            numbers = numbers.Remove(i)
+            i += 2
+        }
+        numbers.Size()
+    )");
+
+    ASSERT_THAT (result, tempo_test::ContainsResult(RunModule(OperandInt(500))));
+}
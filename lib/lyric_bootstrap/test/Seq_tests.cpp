@@ -87,3 +87,39 @@ TEST_F(SeqTests, TestEvaluateSeqIterateImpl)
 
     ASSERT_THAT (result, tempo_test::ContainsResult(RunModule(OperandInt(6))));
 }
+
+TEST_F(SeqTests, TestEvaluateLargeSeqAppendAndIterate)
+{
+    auto result = runModule(R"(
+        var seq: Seq = Seq{}
+        var count: I64 = 0
+        while count < 1000 {
+            count = count + 1
+            seq = seq.Append(count)
+        }
+        var sum: I64 = 0
+        for n: Any in seq {
+            sum += 1
+        }
+        sum + seq.Size()
+    )");
+
+    ASSERT_THAT (result, tempo_test::ContainsResult(RunModule(OperandInt(2000))));
+}
+
+TEST_F(SeqTests, TestEvaluateLargeSeqExtendAndSlice)
+{
+    auto result = runModule(R"(
+        var seq: Seq = Seq{}
+        var count: I64 = 0
+        while count < 100 {
+            count = count + 1
+            seq = seq.Append(count)
+        }
+        val extended: Seq = seq.Extend(seq)
+        val sliced: Seq = extended.Slice(90, 20)
+        sliced.GetOrElse(15, 0)
+    )");
+
+    ASSERT_THAT (result, tempo_test::ContainsResult(RunModule(OperandInt(6))));
+}
@@ -168,3 +168,69 @@ TEST_F(StringTests, TestEvaluateStringGreaterOrEqual)
 
     ASSERT_THAT (result, tempo_test::ContainsResult(RunModule(OperandBool(true))));
 }
+
+TEST_F(StringTests, TestEvaluateStringAtMultibyteCharacter)
+{
+    auto result = runModule(R"(
+        val string: String = "héllo wörld"
+        string.At(7)
+    )");
+
+    ASSERT_THAT (result, tempo_test::ContainsResult(RunModule(OperandChar(static_cast<char32_t>(0xF6)))));
+}
+
+TEST_F(StringTests, TestEvaluateStringLengthAfterAppend)
+{
+    auto result = runModule(R"(
+        val string1: String = "héllo"
+        val string2: String = string1.Append(" wörld")
+        string1.Length() + string2.Length()
+    )");
+
+    ASSERT_THAT (result, tempo_test::ContainsResult(RunModule(OperandInt(16))));
+}
+
+TEST_F(StringTests, TestEvaluateStringFind)
+{
+    auto result = runModule(R"(
+        "hello world".Find("world")
+    )");
+
+    ASSERT_THAT (result, tempo_test::ContainsResult(RunModule(OperandInt(6))));
+}
+
+TEST_F(StringTests, TestEvaluateStringFindNotFound)
+{
+    auto result = runModule(R"(
+        "hello world".Find("xyz")
+    )");
+
+    ASSERT_THAT (result, tempo_test::ContainsResult(RunModule(OperandUndef())));
+}
+
+TEST_F(StringTests, TestEvaluateStringContains)
+{
+    auto result = runModule(R"(
+        "hello world".Contains("xyz")
+    )");
+
+    ASSERT_THAT (result, tempo_test::ContainsResult(RunModule(OperandBool(false))));
+}
+
+TEST_F(StringTests, TestEvaluateStringStartsWith)
+{
+    auto result = runModule(R"(
+        "hello world".StartsWith("hello")
+    )");
+
+    ASSERT_THAT (result, tempo_test::ContainsResult(RunModule(OperandBool(true))));
+}
+
+TEST_F(StringTests, TestEvaluateStringSplit)
+{
+    auto result = runModule(R"(
+        "a,b,c".Split(",").Size()
+    )");
+
+    ASSERT_THAT (result, tempo_test::ContainsResult(RunModule(OperandInt(3))));
+}
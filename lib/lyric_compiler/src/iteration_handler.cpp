@@ -381,8 +381,8 @@ lyric_compiler::ForBody::decide(
             "expected Next method to return {}; found {}",
             m_iteration->targetType.toString(), nextReturnType.toString());
 
-    // store the next value in the target variable
-    TU_RETURN_IF_NOT_OK (m_fragment->storeRef(targetRef));
+    // bind the next value to the target variable, each iteration begins a new binding of the target
+    TU_RETURN_IF_NOT_OK (m_fragment->storeRef(targetRef, /* initialStore= */ true));
 
     auto group = std::make_unique<BlockHandler>(
         std::move(m_iteration->forBlock), /* requiresResult= */ false, /* isSideEffect= */ true,
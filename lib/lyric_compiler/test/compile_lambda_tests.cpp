@@ -117,3 +117,56 @@ TEST_F(CompileLambda, CompileInvokeLambdaClosureOverPrivateVariableFails)
         CompileModule(
             tempo_test::SpansetContainsError(lyric_assembler::AssemblerCondition::kInvalidBinding))));
 }
+
+TEST_F(CompileLambda, EvaluateInvokeLambdaClosureObservesUpdatedVariable)
+{
+    auto result = m_tester->runModule(R"(
+        var x: I64 = 1
+        val f: Function1[I64,I64] = lambda (n: I64): I64 {
+          n + x
+        }
+        x = 10
+        f.Apply(2)
+    )");
+
+    ASSERT_THAT (result, tempo_test::ContainsResult(RunModule(OperandInt(12))));
+}
+
+TEST_F(CompileLambda, EvaluateInvokeLambdaClosureAfterDefiningFrameReturns)
+{
+    auto result = m_tester->runModule(R"(
+        def makeAdder(n: I64): Function1[I64,I64] {
+          val m: I64 = n
+          lambda (p: I64): I64 {
+            p + m
+          }
+        }
+        val add3: Function1[I64,I64] = makeAdder(3)
+        add3.Apply(2)
+    )");
+
+    ASSERT_THAT (result, tempo_test::ContainsResult(RunModule(OperandInt(5))));
+}
+
+TEST_F(CompileLambda, EvaluateLambdasCreatedInLoopCaptureEachIteration)
+{
+    auto result = m_tester->runModule(R"(
+        var count: I64 = 0
+        var first: Function1[I64,I64] = lambda (n: I64): I64 { n }
+        var second: Function1[I64,I64] = lambda (n: I64): I64 { n }
+        while count < 2 {
+          count = count + 1
+          val captured: I64 = count * 10
+          val f: Function1[I64,I64] = lambda (n: I64): I64 {
+            n + captured
+          }
+          do {
+            when count == 1 { first = f }
+            when count == 2 { second = f }
+          }
+        }
+        first.Apply(1) + second.Apply(2)
+    )");
+
+    ASSERT_THAT (result, tempo_test::ContainsResult(RunModule(OperandInt(33))));
+}
@@ -176,6 +176,32 @@ TEST_F(CompileMatch, EvaluateMatchClass)
     ASSERT_THAT (result, tempo_test::ContainsResult(RunModule(OperandInt(3))));
 }
 
+TEST_F(CompileMatch, EvaluateMatchClassHierarchy)
+{
+    auto result = m_tester->runModule(R"(
+        defclass Shape {}
+        defclass Polygon from Shape {
+            init() {}
+        }
+        defclass Square from Polygon {
+            init() {}
+        }
+        defclass Circle from Shape {
+            init() {}
+        }
+
+        val x: Any = Square{}
+        match x {
+            when c: Circle  -> 1
+            when p: Polygon -> 2
+            when s: Shape   -> 3
+            else            -> nil
+        }
+    )");
+
+    ASSERT_THAT (result, tempo_test::ContainsResult(RunModule(OperandInt(2))));
+}
+
 TEST_F(CompileMatch, EvaluateMatchEnum)
 {
     auto result = m_tester->runModule(R"(
@@ -129,4 +129,24 @@ TEST_F(CompileTry, EvaluateReraiseExceptionInCatch)
 
     ASSERT_THAT (result, tempo_test::ContainsResult(
         RunModule(OperandInt(4))));
-}
\ No newline at end of file
+}
+
+TEST_F(CompileTry, EvaluateCatchExceptionRaisedInCallee)
+{
+    auto result = m_tester->runModule(R"(
+        def fail(): I64 {
+            raise Internal{message="something failed"}
+            0
+        }
+        var x: I64 = 0
+        try {
+            x = fail()
+        } catch {
+            when ex: Internal { x = 2 }
+        }
+        x
+    )");
+
+    ASSERT_THAT (result, tempo_test::ContainsResult(
+        RunModule(OperandInt(2))));
+}
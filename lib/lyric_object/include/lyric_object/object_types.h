@@ -34,6 +34,10 @@ namespace lyric_object {
     constexpr tu_uint8 STORE_FIELD                  = 0x04;
     constexpr tu_uint8 STORE_STATIC                 = 0x05;
 
+    // store flags
+    constexpr tu_uint8 STORE_INITIAL                = 0x80;     // the store begins a new binding of a local
+    constexpr tu_uint8 STORE_TYPE_MASK              = 0x7F;
+
     // descriptor type enum
 
     // call flags
@@ -1,21 +1,42 @@
 #ifndef LYRIC_RUNTIME_ABSTRACT_HEAP_H
 #define LYRIC_RUNTIME_ABSTRACT_HEAP_H
 
+#include <cstddef>
+
 #include "abstract_ref.h"
 
 namespace lyric_runtime {
 
+    /**
+     * The minimum alignment of the storage returned by AbstractHeap::allocateMemory.
+     */
+    constexpr std::size_t kMaxInstanceAlignment = 16;
+
     class AbstractHeap {
 
     public:
         virtual ~AbstractHeap() = default;
 
+        virtual void *allocateMemory(std::size_t size) = 0;
+
         virtual uint32_t insertInstance(AbstractRef *instance) = 0;
 
+        virtual void insertPermanentInstance(AbstractRef *instance) = 0;
+
+        virtual tu_uint32 numPermanentInstances() const = 0;
+
         virtual void clearReachable() = 0;
 
         virtual void deleteUnreachable() = 0;
 
+        virtual tu_uint32 numInstances() const = 0;
+
+        virtual void beginSweep() = 0;
+
+        virtual bool sweepUnreachable(tu_uint32 maxInstances) = 0;
+
+        virtual bool isSweeping() const = 0;
+
         virtual void *createHandle(AbstractRef *instance) = 0;
 
         virtual void incrementHandle(void *priv) = 0;
@@ -194,12 +194,13 @@ namespace lyric_runtime {
         virtual bool isReachable() const = 0;
 
         /**
-         * Sets the ref as reachable.
+         * Sets the ref as reachable and marks the refs reachable from its members. If the ref is already
+         * marked reachable then its members must not be visited again.
          */
         virtual void setReachable() = 0;
 
         /**
-         * Clears the reachable status.
+         * Clears the reachable status of the ref. Only the ref itself is cleared, its members are not visited.
          */
         virtual void clearReachable() = 0;
 
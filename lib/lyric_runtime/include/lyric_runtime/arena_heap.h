@@ -0,0 +1,86 @@
+#ifndef LYRIC_RUNTIME_ARENA_HEAP_H
+#define LYRIC_RUNTIME_ARENA_HEAP_H
+
+#include <array>
+
+#include <absl/container/flat_hash_set.h>
+
+#include "gc_heap.h"
+
+namespace lyric_runtime {
+
+    /**
+     * The size in bytes of a single arena. Arenas are aligned to their size so the arena containing an
+     * instance can be found by masking the instance address.
+     */
+    constexpr std::size_t kArenaSize = 64 * 1024;
+
+    /**
+     * The size in bytes of an arena page. Each page holds instances of a single size class, so size
+     * classes share arenas and a heap which uses few instances of each size class needs few arenas.
+     */
+    constexpr std::size_t kArenaPageSize = 4 * 1024;
+
+    constexpr std::size_t kNumArenaPages = kArenaSize / kArenaPageSize;
+
+    /**
+     * The granularity in bytes of the arena size classes.
+     */
+    constexpr std::size_t kArenaSizeClassGranularity = kMaxInstanceAlignment;
+
+    /**
+     * The size in bytes of the largest instance which is allocated from an arena. Larger instances are
+     * allocated from the global allocator.
+     */
+    constexpr std::size_t kMaxArenaInstanceSize = 512;
+
+    constexpr std::size_t kNumArenaSizeClasses = kMaxArenaInstanceSize / kArenaSizeClassGranularity;
+
+    /**
+     * Heap which allocates instances from arenas shared by all size classes. Arenas are allocated on
+     * demand and divided into pages, and each page holds instances of a single size class; storage of
+     * swept instances is returned to the free list of its size class and reused by subsequent allocations.
+     * Arenas are only released when the heap is destroyed, after the destructors of any remaining
+     * instances have run.
+     */
+    class ArenaHeap : public GCHeap {
+    public:
+        ~ArenaHeap() override;
+
+        void *allocateMemory(std::size_t size) override;
+
+        int numArenas() const;
+        int numLargeInstances() const;
+
+        static std::shared_ptr<ArenaHeap> create();
+
+    protected:
+        void releaseInstance(AbstractRef *instance) override;
+
+    private:
+        struct FreeSlot {
+            FreeSlot *next;
+        };
+
+        struct ArenaHeader {
+            std::array<tu_uint8,kNumArenaPages> pageSizeClasses;
+        };
+
+        struct SizeClass {
+            FreeSlot *freeList;
+            char *bumpCurr;
+            char *bumpEnd;
+        };
+
+        std::array<SizeClass,kNumArenaSizeClasses> m_sizeClasses;
+        std::vector<void *> m_arenas;
+        tu_uint32 m_nextPage;
+        absl::flat_hash_set<void *> m_largeInstances;
+
+        ArenaHeap();
+
+        bool allocatePage(tu_uint32 sizeClass);
+    };
+}
+
+#endif // LYRIC_RUNTIME_ARENA_HEAP_H
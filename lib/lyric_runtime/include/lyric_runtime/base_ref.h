@@ -48,7 +48,6 @@ namespace lyric_runtime {
         const VirtualTable *m_vtable;
 
         virtual void setMembersReachable();
-        virtual void clearMembersReachable();
 
     private:
         absl::flat_hash_map<OperandIdentity,Operand> m_fields;
@@ -22,6 +22,15 @@ namespace lyric_runtime {
         tu_uint64 instructionCount;                 /**< Total count of instructions executed by the interpreter. */
     };
 
+    /**
+     * The reason a preemptible run of the interpreter returned control to the caller.
+     */
+    enum class InterpreterYield {
+        Halted,                                     /**< The program halted and the interpreter exit is set. */
+        Preempted,                                  /**< The quantum of time slices was exhausted. */
+        Blocked,                                    /**< No task is ready, so the interpreter must wait for an event. */
+    };
+
     struct InterpreterStats {
         tu_uint64 instructionCount;
         std::unique_ptr<tempo_utils::HdrHistogram> instructionsPerSlice;
@@ -37,6 +46,7 @@ namespace lyric_runtime {
         AbstractInspector *interpreterInspector() const;
 
         tempo_utils::Result<InterpreterExit> run();
+        tempo_utils::Result<InterpreterYield> runQuantum(int numSlices, InterpreterExit &interpreterExit);
         tempo_utils::Result<Operand> runSubinterpreter();
         tempo_utils::Status interrupt();
 
@@ -53,10 +63,18 @@ namespace lyric_runtime {
         tu_uint16 m_sliceCounter;
         tu_uint64 m_instructionCounter;
         int m_recursionDepth;
+        int m_quantum;
+        int m_slicesRemaining;
+        bool m_resuming;
+        InterpreterYield m_yield;
+
+        template <bool Inspected>
+        tempo_utils::Result<Operand> runLoop();
 
         tempo_utils::Status onInterrupt(const Operand &cell);
         tempo_utils::Result<Operand> onError(const lyric_object::OpCell &op, const tempo_utils::Status &status);
         tempo_utils::Result<Operand> onHalt(const lyric_object::OpCell &op);
+        tempo_utils::Result<Operand> onYield(InterpreterYield yield);
     };
 
     class RecursionLocker {
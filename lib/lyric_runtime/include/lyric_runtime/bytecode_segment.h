@@ -1,11 +1,16 @@
 #ifndef LYRIC_RUNTIME_BYTECODE_SEGMENT_H
 #define LYRIC_RUNTIME_BYTECODE_SEGMENT_H
 
+#include <absl/container/flat_hash_map.h>
+
 #include <lyric_object/lyric_object.h>
 
 #include "abstract_plugin.h"
+#include "call_site_cache.h"
 #include "descriptor_entry.h"
 #include "operand.h"
+#include "predecoded_proc.h"
+#include "proc_metadata.h"
 #include "runtime_types.h"
 #include "type_entry.h"
 
@@ -59,8 +64,20 @@ namespace lyric_runtime {
         Operand getNamespace(tu_uint32 index) const;
         bool setNamespace(tu_uint32 index, const Operand &value);
 
+        Operand getStringLiteral(tu_uint32 index) const;
+        bool setStringLiteral(tu_uint32 index, const Operand &value);
+
+        Operand getBytesLiteral(tu_uint32 index) const;
+        bool setBytesLiteral(tu_uint32 index, const Operand &value);
+
         const NativeTrap *getTrap(tu_uint32 address) const;
 
+        void setReachable() const;
+
+        tempo_utils::Status getProcMetadata(tu_uint32 procOffset, const ProcMetadata **procMetadata);
+        const PredecodedProc *getPredecodedProc(const lyric_object::BytecodeIterator &ip);
+        CallSiteCache *getCallSiteCache(const lyric_object::BytecodeIterator &returnIP);
+
         void *getData() const;
         void setData(void *data);
 
@@ -94,6 +111,10 @@ namespace lyric_runtime {
         Operand *m_namespaces;
         tu_uint32 m_numNamespaces;
 
+        Operand *m_stringLiterals;
+        Operand *m_bytesLiterals;
+        tu_uint32 m_numLiterals;
+
         const NativeTrap* *m_traps;
         tu_uint32 m_numTraps;
 
@@ -110,6 +131,10 @@ namespace lyric_runtime {
         DescriptorTable m_staticDescriptors;
         DescriptorTable m_structDescriptors;
         TypeTable m_types;
+
+        absl::flat_hash_map<tu_uint32,std::unique_ptr<ProcMetadata>> m_procMetadata;
+        absl::flat_hash_map<tu_uint32,std::unique_ptr<PredecodedProc>> m_predecodedProcs;
+        absl::flat_hash_map<tu_uint32,std::unique_ptr<CallSiteCache>> m_callSiteCaches;
     };
 }
 
@@ -1,6 +1,7 @@
 #ifndef LYRIC_RUNTIME_BYTES_REF_H
 #define LYRIC_RUNTIME_BYTES_REF_H
 
+#include <tempo_utils/immutable_bytes.h>
 #include <tempo_utils/rope.h>
 
 #include "abstract_ref.h"
@@ -12,6 +13,11 @@ namespace lyric_runtime {
         BytesRef(const ExistentialTable *etable, std::string_view literal);
         BytesRef(const ExistentialTable *etable, const tu_uint8 *data, int32_t size);
         BytesRef(const ExistentialTable *etable, tempo_utils::Rope<tu_uint8> rope);
+        BytesRef(
+            const ExistentialTable *etable,
+            std::shared_ptr<const tempo_utils::ImmutableBytes> shared,
+            tu_uint32 offset,
+            tu_uint32 size);
         ~BytesRef() override;
 
         const DescriptorEntry *getDescriptorEntry() const override;
@@ -32,11 +38,17 @@ namespace lyric_runtime {
         Operand byteAt(int index) const;
         Operand bytesCompare(BytesRef *other) const;
         Operand bytesLength() const;
+        bool startsWith(const BytesRef *other) const;
 
         std::vector<tu_uint8> getBytes() const;
         tempo_utils::Rope<tu_uint8> getBytesData() const;
         int32_t getBytesSize() const;
 
+        bool isShared() const;
+        std::span<const tu_uint8> getSharedSpan() const;
+        std::shared_ptr<const tempo_utils::ImmutableBytes> toImmutableBytes() const;
+
+        void setPermanent();
         bool isReachable() const override;
         void setReachable() override;
         void clearReachable() override;
@@ -58,7 +70,10 @@ namespace lyric_runtime {
     private:
         const ExistentialTable *m_etable;
         tempo_utils::Rope<tu_uint8> m_rope;
+        std::shared_ptr<const tempo_utils::ImmutableBytes> m_shared;
+        tu_uint32 m_sharedOffset;
         int32_t m_size;
+        bool m_permanent;
         bool m_reachable;
     };
 }
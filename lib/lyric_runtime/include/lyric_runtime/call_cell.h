@@ -1,15 +1,26 @@
 #ifndef LYRIC_RUNTIME_CALL_CELL_H
 #define LYRIC_RUNTIME_CALL_CELL_H
 
+#include <span>
+
+#include <absl/container/inlined_vector.h>
+
 #include <tempo_utils/log_message.h>
 
 #include <lyric_object/bytecode_iterator.h>
 
 #include "runtime_types.h"
+#include "upvalue_cell.h"
 #include "virtual_table.h"
 
 namespace lyric_runtime {
 
+    /**
+     * The number of frame slots (arguments, rest, locals, and lexicals) which are stored inline in the
+     * CallCell. Frames which need more slots than this spill to the heap.
+     */
+    constexpr int kNumInlineFrameSlots = 8;
+
     class CallCell final {
 
     public:
@@ -26,7 +37,7 @@ namespace lyric_runtime {
             tu_uint16 numRest,
             tu_uint16 numLocals,
             tu_uint16 numLexicals,
-            const std::vector<Operand> &data,
+            std::span<const Operand> data,
             const VirtualTable *vtable);
         CallCell(
             tu_uint32 callIndex,
@@ -40,7 +51,7 @@ namespace lyric_runtime {
             tu_uint16 numRest,
             tu_uint16 numLocals,
             tu_uint16 numLexicals,
-            const std::vector<Operand> &data,
+            std::span<const Operand> data,
             Operand receiver);
         CallCell(
             tu_uint32 callIndex,
@@ -54,7 +65,7 @@ namespace lyric_runtime {
             tu_uint16 numRest,
             tu_uint16 numLocals,
             tu_uint16 numLexicals,
-            const std::vector<Operand> &data);
+            std::span<const Operand> data);
         CallCell(const CallCell &other);
         CallCell(CallCell &&other) noexcept;
 
@@ -75,14 +86,19 @@ namespace lyric_runtime {
 
         Operand getArgument(int index) const;
         void setArgument(int index, const Operand &cell);
+        UpvalueCellPtr captureArgument(int index);
         tu_uint16 numArguments() const;
 
         Operand getLocal(int index) const;
         void setLocal(int index, const Operand &cell);
+        void rebindLocal(int index, const Operand &cell);
+        UpvalueCellPtr captureLocal(int index);
         tu_uint16 numLocals() const;
 
         Operand getLexical(int index) const;
         void setLexical(int index, const Operand &cell);
+        UpvalueCellPtr captureLexical(int index);
+        void bindLexical(int index, UpvalueCellPtr cell);
         tu_uint16 numLexicals() const;
 
         Operand getRest(int index) const;
@@ -109,9 +125,14 @@ namespace lyric_runtime {
         tu_uint16 m_numRest;
         tu_uint16 m_numLocals;
         tu_uint16 m_numLexicals;
-        std::vector<Operand> m_data;
+        absl::InlinedVector<Operand,kNumInlineFrameSlots> m_data;
+        std::vector<UpvalueCellPtr> m_upvalues;         // empty unless a slot has been captured
         Operand m_receiver;
         const VirtualTable *m_vtable;
+
+        Operand loadSlot(int slot) const;
+        void storeSlot(int slot, const Operand &cell);
+        UpvalueCellPtr captureSlot(int slot);
     };
 
     tempo_utils::LogMessage&& operator<<(tempo_utils::LogMessage &&message, const CallCell &cell);
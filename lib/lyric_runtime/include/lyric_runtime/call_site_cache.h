@@ -0,0 +1,65 @@
+#ifndef LYRIC_RUNTIME_CALL_SITE_CACHE_H
+#define LYRIC_RUNTIME_CALL_SITE_CACHE_H
+
+#include <array>
+
+#include "operand.h"
+#include "runtime_types.h"
+
+namespace lyric_runtime {
+
+    // forward declarations
+    class VirtualMethod;
+
+    /**
+     * The maximum number of receivers which are cached for a single call site. Once a call site has seen
+     * more distinct receivers than this then the call site is considered megamorphic and always falls back
+     * to the full method lookup.
+     */
+    constexpr int kMaxCallSiteEntries = 4;
+
+    /**
+     * A single cached method resolution. The receiver key identifies the resolver (the vtable or the
+     * existential table) which the method was resolved from, and the aux key disambiguates resolutions
+     * which depend on more than the resolver (such as the concept descriptor of a concept call).
+     */
+    struct CallSiteEntry {
+        const void *receiverKey;            /**< Identity of the resolver the method was resolved from. */
+        const void *auxKey;                 /**< Additional lookup key, or nullptr if unused. */
+        const VirtualMethod *method;        /**< The resolved method. */
+    };
+
+    /**
+     * Inline cache for a single virtual, stub, concept, or existential call site. The cache is bound to
+     * the linkage section and address of the call and holds the resolved descriptor for the address along
+     * with up to kMaxCallSiteEntries method resolutions keyed by receiver, so that calls through a
+     * monomorphic or polymorphic call site skip both the descriptor resolution and the vtable walk. The
+     * section is part of the binding because the same address indexes different descriptors in the Call
+     * and Action sections.
+     */
+    class CallSiteCache {
+
+    public:
+        CallSiteCache();
+
+        bool isBoundTo(lyric_object::LinkageSection section, tu_uint32 address) const;
+        Operand getDescriptor() const;
+        void bind(lyric_object::LinkageSection section, tu_uint32 address, const Operand &descriptor);
+
+        const VirtualMethod *lookup(const void *receiverKey, const void *auxKey = nullptr) const;
+        void insert(const void *receiverKey, const void *auxKey, const VirtualMethod *method);
+
+        int numEntries() const;
+        bool isMegamorphic() const;
+
+    private:
+        lyric_object::LinkageSection m_section;
+        tu_uint32 m_address;
+        Operand m_descriptor;
+        std::array<CallSiteEntry,kMaxCallSiteEntries> m_entries;
+        tu_uint8 m_numEntries;
+        bool m_megamorphic;
+    };
+}
+
+#endif // LYRIC_RUNTIME_CALL_SITE_CACHE_H
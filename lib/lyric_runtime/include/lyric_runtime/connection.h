@@ -9,6 +9,9 @@
 
 namespace lyric_runtime {
 
+    // forward declarations
+    class BytesRef;
+
     enum class ConnectionState {
         Initial,
         Connecting,
@@ -59,6 +62,7 @@ namespace lyric_runtime {
             std::shared_ptr<AbstractReceiveCompleter> completer);
 
         tempo_utils::Status send(std::shared_ptr<const tempo_utils::ImmutableBytes> payload);
+        tempo_utils::Status send(const BytesRef *bytes);
 
         tempo_utils::Status shutdown();
 
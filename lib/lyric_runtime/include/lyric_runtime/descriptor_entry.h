@@ -18,11 +18,15 @@ namespace lyric_runtime {
         lyric_object::LinkageSection getLinkageSection() const;
         tu_uint32 getDescriptorIndex() const;
 
+        tu_uint32 getSlot() const;
+        void setSlot(tu_uint32 slot);
+
         lyric_common::SymbolUrl getSymbolUrl() const;
 
     private:
         DescriptorTable *m_descriptorTable;
         tu_uint32 m_index;
+        tu_uint32 m_slot;
     };
 
     class DescriptorTable {
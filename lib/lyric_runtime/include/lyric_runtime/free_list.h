@@ -0,0 +1,82 @@
+#ifndef LYRIC_RUNTIME_FREE_LIST_H
+#define LYRIC_RUNTIME_FREE_LIST_H
+
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace lyric_runtime {
+
+    /**
+     * The default maximum number of released blocks retained by a FreeList.
+     */
+    constexpr int kDefaultFreeListCapacity = 1024;
+
+    /**
+     * A free list of uninitialized storage blocks for objects of type T. Released blocks are retained
+     * for reuse up to the capacity of the free list, and any blocks released beyond the capacity are
+     * returned to the allocator. The free list is not thread-safe.
+     *
+     * @tparam T The type of object stored in each block.
+     */
+    template <typename T>
+    class FreeList {
+    public:
+        explicit FreeList(int capacity = kDefaultFreeListCapacity)
+            : m_capacity(capacity)
+        {
+        }
+
+        ~FreeList()
+        {
+            for (auto *block : m_blocks) {
+                std::free(block);
+            }
+        }
+
+        FreeList(const FreeList &other) = delete;
+        FreeList& operator=(const FreeList &other) = delete;
+
+        /**
+         * Returns an uninitialized block, reusing a released block if one is available. Throws
+         * std::bad_alloc if a new block cannot be allocated, in the same way as operator new.
+         */
+        T *allocate()
+        {
+            if (m_blocks.empty()) {
+                auto *block = static_cast<T *>(std::malloc(sizeof(T)));
+                if (block == nullptr)
+                    throw std::bad_alloc();
+                return block;
+            }
+            auto *block = m_blocks.back();
+            m_blocks.pop_back();
+            return block;
+        }
+
+        /**
+         * Releases the block. Any object stored in the block must already have been destroyed.
+         */
+        void release(T *block)
+        {
+            if (block == nullptr)
+                return;
+            if (static_cast<int>(m_blocks.size()) < m_capacity) {
+                m_blocks.push_back(block);
+            } else {
+                std::free(block);
+            }
+        }
+
+        int numFree() const
+        {
+            return static_cast<int>(m_blocks.size());
+        }
+
+    private:
+        int m_capacity;
+        std::vector<T *> m_blocks;
+    };
+}
+
+#endif // LYRIC_RUNTIME_FREE_LIST_H
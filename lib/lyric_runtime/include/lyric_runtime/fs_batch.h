@@ -0,0 +1,109 @@
+#ifndef LYRIC_RUNTIME_FS_BATCH_H
+#define LYRIC_RUNTIME_FS_BATCH_H
+
+#include <memory>
+#include <vector>
+
+#include <uv.h>
+
+#include <tempo_utils/immutable_bytes.h>
+#include <tempo_utils/integer_types.h>
+
+namespace lyric_runtime {
+
+    // forward declarations
+    class SystemScheduler;
+    class Waiter;
+
+    void on_batch_complete(uv_fs_t *req);
+    void on_read_file_stat(uv_fs_t *req);
+    void on_read_file_read(uv_fs_t *req);
+
+    /**
+     * A single read or write in a batch of fs operations. The buffers must stay valid until the batch
+     * has completed.
+     */
+    struct FsOperation {
+        enum class Kind {
+            Read,
+            Write,
+        };
+
+        Kind kind = Kind::Read;
+        uv_file file = -1;
+        std::vector<uv_buf_t> bufs;
+        tu_int64 offset = -1;
+
+        static FsOperation read(uv_file file, std::vector<uv_buf_t> bufs, tu_int64 offset = -1);
+        static FsOperation write(uv_file file, std::vector<uv_buf_t> bufs, tu_int64 offset = -1);
+    };
+
+    /**
+     * A batch of fs operations which are submitted together and complete a single waiter once every
+     * operation has finished. The fs requests for the batch are allocated together, and all operations
+     * are outstanding at the same time.
+     */
+    class FsBatch {
+    public:
+        explicit FsBatch(int numOperations);
+
+        int numOperations() const;
+        int numPending() const;
+        tu_int64 getResult(int index) const;
+        bool hasError() const;
+
+    private:
+        std::unique_ptr<uv_fs_t[]> m_reqs;
+        std::vector<tu_int64> m_results;
+        int m_numOperations;
+        int m_numPending;
+        Waiter *m_waiter;
+
+        friend class SystemScheduler;
+        friend void on_batch_complete(uv_fs_t *req);
+    };
+
+    /**
+     * The largest file in bytes which can be read by FsReadFile, which is limited by the size of
+     * ImmutableBytes.
+     */
+    constexpr tu_uint64 kMaxReadFileSize = 0xFFFFFFFF;
+
+    /**
+     * Reads the entire contents of a file. The file is sized with fstat and read into a single buffer,
+     * issuing further reads only if the file is read short. If fstat reports a size of zero, which is the
+     * case for pipes and for many special files, then the file is read until end of file into a buffer
+     * which grows as needed.
+     */
+    class FsReadFile {
+    public:
+        FsReadFile(uv_loop_t *loop, uv_file file);
+
+        int getResult() const;
+        tu_uint64 getSize() const;
+        std::shared_ptr<tu_uint8[]> getData() const;
+        std::shared_ptr<const tempo_utils::ImmutableBytes> getBytes() const;
+
+    private:
+        uv_fs_t m_req;
+        uv_loop_t *m_loop;
+        uv_file m_file;
+        std::shared_ptr<tu_uint8[]> m_data;
+        tu_uint64 m_capacity;
+        tu_uint64 m_size;
+        tu_uint64 m_offset;
+        bool m_untilEof;
+        int m_result;
+        bool m_inFlight;
+        Waiter *m_waiter;
+
+        int readNext();
+        bool growBuffer();
+
+        friend class SystemScheduler;
+        friend void on_read_file_stat(uv_fs_t *req);
+        friend void on_read_file_read(uv_fs_t *req);
+    };
+}
+
+#endif // LYRIC_RUNTIME_FS_BATCH_H
@@ -12,9 +12,16 @@ namespace lyric_runtime {
     public:
         ~GCHeap() override;
 
+        void *allocateMemory(std::size_t size) override;
         uint32_t insertInstance(AbstractRef *instance) override;
+        void insertPermanentInstance(AbstractRef *instance) override;
+        tu_uint32 numPermanentInstances() const override;
         void clearReachable() override;
         void deleteUnreachable() override;
+        tu_uint32 numInstances() const override;
+        void beginSweep() override;
+        bool sweepUnreachable(tu_uint32 maxInstances) override;
+        bool isSweeping() const override;
         void *createHandle(AbstractRef *instance) override;
         void incrementHandle(void *priv) override;
         void decrementHandle(void *priv) override;
@@ -22,8 +29,20 @@ namespace lyric_runtime {
 
         static std::shared_ptr<GCHeap> create();
 
+    protected:
+        GCHeap();
+
+        virtual void releaseInstance(AbstractRef *instance);
+        void releaseInstances();
+        void releasePermanentInstances();
+
     private:
         std::vector<AbstractRef *> m_instances;
+        std::vector<AbstractRef *> m_permanentInstances;
+        tu_uint32 m_numInstances;
+        tu_uint32 m_sweepCursor;
+        tu_uint32 m_sweepLimit;
+        bool m_sweeping;
 
         struct HandlePriv {
             AbstractRef *instance;
@@ -33,8 +52,6 @@ namespace lyric_runtime {
         };
 
         HandlePriv *m_handles;
-
-        GCHeap();
     };
 }
 
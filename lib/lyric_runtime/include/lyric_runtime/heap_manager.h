@@ -1,9 +1,12 @@
 #ifndef LYRIC_RUNTIME_HEAP_MANAGER_H
 #define LYRIC_RUNTIME_HEAP_MANAGER_H
 
+#include <new>
+
 #include <lyric_runtime/abstract_heap.h>
 #include <lyric_runtime/segment_manager.h>
 #include <lyric_runtime/system_scheduler.h>
+#include <tempo_utils/immutable_bytes.h>
 #include <tempo_utils/rope.h>
 
 namespace lyric_runtime {
@@ -35,13 +38,27 @@ namespace lyric_runtime {
         const VirtualTable *UnknownTable = nullptr;
     };
 
+    struct CollectorOptions {
+        /**
+         * The number of instances which may be allocated after a collection before the next collection is
+         * triggered automatically. If zero then garbage is only collected when explicitly requested.
+         */
+        tu_uint32 allocationBudget = 65536;
+        /**
+         * The maximum time in microseconds that a single incremental collection step may spend sweeping
+         * unreachable instances. If zero then each sweep runs to completion.
+         */
+        tu_uint32 maxPauseMicros = 1000;
+    };
+
     class HeapManager {
     public:
         HeapManager(
             PreludeTables preludeTables,
             SegmentManager *segmentManager,
             SystemScheduler *systemScheduler,
-            std::shared_ptr<AbstractHeap> heap);
+            std::shared_ptr<AbstractHeap> heap,
+            const CollectorOptions &collectorOptions = {});
         virtual ~HeapManager() = default;
 
         virtual Operand allocateI64(tu_int64 i64);
@@ -56,9 +73,18 @@ namespace lyric_runtime {
 
         virtual Operand allocateBytes(std::span<const tu_uint8> bytes);
         virtual Operand allocateBytes(tempo_utils::Rope<tu_uint8> rope);
+        virtual Operand allocateBytes(std::shared_ptr<const tempo_utils::ImmutableBytes> bytes);
+        virtual Operand allocateBytes(
+            std::shared_ptr<const tempo_utils::ImmutableBytes> bytes,
+            tu_uint32 offset,
+            tu_uint32 size);
         virtual tempo_utils::Status loadLiteralBytesOntoStack(tu_uint32 address);
         virtual tempo_utils::Status loadBytesOntoStack(std::span<const tu_uint8> bytes);
         virtual tempo_utils::Status loadBytesOntoStack(tempo_utils::Rope<tu_uint8> rope);
+        virtual tempo_utils::Status loadBytesOntoStack(
+            std::shared_ptr<const tempo_utils::ImmutableBytes> bytes,
+            tu_uint32 offset,
+            tu_uint32 size);
 
         virtual Operand allocateStatus(const VirtualTable *vtable);
         virtual Operand allocateStatus(
@@ -78,12 +104,34 @@ namespace lyric_runtime {
         virtual tempo_utils::Status loadNamespaceOntoStack(const Operand &descriptor);
 
         virtual tempo_utils::Status collectGarbage();
+        virtual tempo_utils::Status collectGarbageStep();
 
     private:
         PreludeTables m_preludeTables;
         SegmentManager *m_segmentManager;
         SystemScheduler *m_systemScheduler;
         std::shared_ptr<AbstractHeap> m_heap;
+        CollectorOptions m_collectorOptions;
+        tu_uint32 m_collectionThreshold;
+
+        void markReachable();
+        void sweepWithinPause();
+        void resetCollectionThreshold();
+
+        /**
+         * Allocate uninitialized storage from the heap for an instance of RefType. The instance must be
+         * constructed in the storage using placement new and then inserted into the heap.
+         *
+         * @tparam RefType
+         * @return
+         */
+        template <class RefType>
+        void *allocateStorage()
+        {
+            static_assert(alignof(RefType) <= kMaxInstanceAlignment,
+                "instance alignment exceeds the alignment guaranteed by the heap");
+            return m_heap->allocateMemory(sizeof(RefType));
+        }
 
     public:
         /**
@@ -96,7 +144,7 @@ namespace lyric_runtime {
         template <class RefType>
         Operand allocateRef(const VirtualTable *vtable)
         {
-            auto *instance = new RefType(vtable);
+            auto *instance = new (allocateStorage<RefType>()) RefType(vtable);
             m_heap->insertInstance(instance);
             return Operand::fromRef(instance);
         }
@@ -113,7 +161,7 @@ namespace lyric_runtime {
         template <class RefType, class Arg0>
         Operand allocateRef(const VirtualTable *vtable, Arg0&& arg0)
         {
-            auto *instance = new RefType(vtable, std::forward<Arg0>(arg0));
+            auto *instance = new (allocateStorage<RefType>()) RefType(vtable, std::forward<Arg0>(arg0));
             m_heap->insertInstance(instance);
             return Operand::fromRef(instance);
         }
@@ -135,7 +183,9 @@ namespace lyric_runtime {
             Arg0&& arg0,
             Arg1&& arg1)
         {
-            auto *instance = new RefType(vtable, std::forward<Arg0>(arg0), std::forward<Arg1>(arg1));
+            auto *instance = new (allocateStorage<RefType>()) RefType(vtable,
+                std::forward<Arg0>(arg0),
+                std::forward<Arg1>(arg1));
             m_heap->insertInstance(instance);
             return Operand::fromRef(instance);
         }
@@ -160,7 +210,7 @@ namespace lyric_runtime {
             Arg1&& arg1,
             Arg2&& arg2)
         {
-            auto *instance = new RefType(vtable,
+            auto *instance = new (allocateStorage<RefType>()) RefType(vtable,
                 std::forward<Arg0>(arg0),
                 std::forward<Arg1>(arg1),
                 std::forward<Arg2>(arg2));
@@ -191,7 +241,7 @@ namespace lyric_runtime {
             Arg2&& arg2,
             Arg3&& arg3)
         {
-            auto *instance = new RefType(vtable,
+            auto *instance = new (allocateStorage<RefType>()) RefType(vtable,
                 std::forward<Arg0>(arg0),
                 std::forward<Arg1>(arg1),
                 std::forward<Arg2>(arg2),
@@ -226,7 +276,7 @@ namespace lyric_runtime {
             Arg3&& arg3,
             Arg4&& arg4)
         {
-            auto *instance = new RefType(vtable,
+            auto *instance = new (allocateStorage<RefType>()) RefType(vtable,
                 std::forward<Arg0>(arg0),
                 std::forward<Arg1>(arg1),
                 std::forward<Arg2>(arg2),
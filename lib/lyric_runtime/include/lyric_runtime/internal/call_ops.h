@@ -18,28 +18,32 @@ namespace lyric_runtime::internal {
         SubroutineManager *subroutineManager,
         tu_uint32 address,
         tu_uint16 placement,
-        tu_uint8 flags);
+        tu_uint8 flags,
+        CallSiteCache *callSite);
 
     tempo_utils::Status call_stub(
         StackfulCoroutine *currentCoro,
         SubroutineManager *subroutineManager,
         tu_uint32 address,
         tu_uint16 placement,
-        tu_uint8 flags);
+        tu_uint8 flags,
+        CallSiteCache *callSite);
 
     tempo_utils::Status call_concept(
         StackfulCoroutine *currentCoro,
         SubroutineManager *subroutineManager,
         tu_uint32 address,
         tu_uint16 placement,
-        tu_uint8 flags);
+        tu_uint8 flags,
+        CallSiteCache *callSite);
 
     tempo_utils::Status call_existential(
         StackfulCoroutine *currentCoro,
         SubroutineManager *subroutineManager,
         tu_uint32 address,
         tu_uint16 placement,
-        tu_uint8 flags);
+        tu_uint8 flags,
+        CallSiteCache *callSite);
 }
 
 #endif // LYRIC_RUNTIME_INTERNAL_CALL_OPS_H
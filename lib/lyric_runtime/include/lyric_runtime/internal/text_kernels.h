@@ -0,0 +1,120 @@
+#ifndef LYRIC_RUNTIME_INTERNAL_TEXT_KERNELS_H
+#define LYRIC_RUNTIME_INTERNAL_TEXT_KERNELS_H
+
+#include <algorithm>
+#include <cstddef>
+
+#include <tempo_utils/rope.h>
+
+namespace lyric_runtime::internal {
+
+    /**
+     * Vectorized kernels operating on contiguous byte ranges, used by the String and Bytes types. On
+     * x86-64 each kernel has SSE2 and AVX2 implementations, and the AVX2 implementation is selected at
+     * runtime if the processor supports it. On other architectures the scalar implementation is used.
+     */
+
+    constexpr size_t kNotFound = static_cast<size_t>(-1);
+
+    size_t mismatch_bytes(const char *lhs, const char *rhs, size_t size);
+
+    size_t ascii_prefix_length(const char *data, size_t size);
+
+    size_t count_code_points(const char *data, size_t size);
+
+    size_t find_byte(const char *data, size_t size, char byte);
+
+    size_t find_bytes(const char *data, size_t size, const char *needle, size_t needleSize);
+
+    const char *text_kernels_implementation();
+
+    /**
+     * Compares the contents of `lhs` and `rhs` lexicographically by unsigned byte value, comparing each
+     * overlapping pair of chunks with mismatch_bytes. For well-formed UTF-8 contents the byte order is
+     * the same as the code point order.
+     *
+     * @return -1 if lhs is less than rhs, 1 if lhs is greater than rhs, otherwise 0.
+     */
+    template<typename ElementType>
+    int compare_ropes(const tempo_utils::Rope<ElementType> &lhs, const tempo_utils::Rope<ElementType> &rhs)
+    {
+        static_assert(sizeof(ElementType) == 1);
+
+        auto lhsChunks = lhs.iterateChunks();
+        auto rhsChunks = rhs.iterateChunks();
+        tempo_utils::RopeChunk<ElementType> lhsChunk, rhsChunk;
+        const char *lhsIt = nullptr, *lhsEnd = nullptr;
+        const char *rhsIt = nullptr, *rhsEnd = nullptr;
+        bool lhsActive = true, rhsActive = true;
+
+        for (;;) {
+            while (lhsActive && lhsIt == lhsEnd) {
+                lhsActive = lhsChunks.getNext(lhsChunk);
+                lhsIt = reinterpret_cast<const char *>(lhsChunk.data());
+                lhsEnd = lhsIt + lhsChunk.size();
+            }
+            while (rhsActive && rhsIt == rhsEnd) {
+                rhsActive = rhsChunks.getNext(rhsChunk);
+                rhsIt = reinterpret_cast<const char *>(rhsChunk.data());
+                rhsEnd = rhsIt + rhsChunk.size();
+            }
+            if (!lhsActive || !rhsActive)
+                break;
+
+            auto size = static_cast<size_t>(std::min(lhsEnd - lhsIt, rhsEnd - rhsIt));
+            auto offset = mismatch_bytes(lhsIt, rhsIt, size);
+            if (offset < size) {
+                auto l = static_cast<unsigned char>(lhsIt[offset]);
+                auto r = static_cast<unsigned char>(rhsIt[offset]);
+                return l < r? -1 : 1;
+            }
+            lhsIt += size;
+            rhsIt += size;
+        }
+
+        // the contents are equal up to the end of the shorter rope
+        if (lhsActive)
+            return 1;
+        if (rhsActive)
+            return -1;
+        return 0;
+    }
+
+    /**
+     * Compares the contiguous contents `lhs` of `lhsSize` bytes and the contents of the rope `rhs`
+     * lexicographically by unsigned byte value, comparing `lhs` against each chunk of `rhs` in turn with
+     * mismatch_bytes.
+     *
+     * @return -1 if lhs is less than rhs, 1 if lhs is greater than rhs, otherwise 0.
+     */
+    template<typename ElementType>
+    int compare_bytes_to_rope(const char *lhs, size_t lhsSize, const tempo_utils::Rope<ElementType> &rhs)
+    {
+        static_assert(sizeof(ElementType) == 1);
+
+        auto rhsChunks = rhs.iterateChunks();
+        tempo_utils::RopeChunk<ElementType> rhsChunk;
+        const char *lhsIt = lhs, *lhsEnd = lhs + lhsSize;
+
+        while (rhsChunks.getNext(rhsChunk)) {
+            auto *rhsIt = reinterpret_cast<const char *>(rhsChunk.data());
+            auto rhsSize = static_cast<size_t>(rhsChunk.size());
+            auto size = std::min(static_cast<size_t>(lhsEnd - lhsIt), rhsSize);
+            auto offset = mismatch_bytes(lhsIt, rhsIt, size);
+            if (offset < size) {
+                auto l = static_cast<unsigned char>(lhsIt[offset]);
+                auto r = static_cast<unsigned char>(rhsIt[offset]);
+                return l < r? -1 : 1;
+            }
+            // lhs ended before the end of the chunk, so rhs is longer
+            if (size < rhsSize)
+                return -1;
+            lhsIt += size;
+        }
+
+        // the contents are equal up to the end of the rope
+        return lhsIt < lhsEnd? 1 : 0;
+    }
+}
+
+#endif // LYRIC_RUNTIME_INTERNAL_TEXT_KERNELS_H
@@ -0,0 +1,113 @@
+#ifndef LYRIC_RUNTIME_INTERPRETER_EXECUTOR_H
+#define LYRIC_RUNTIME_INTERPRETER_EXECUTOR_H
+
+#include <deque>
+#include <future>
+
+#include <absl/synchronization/mutex.h>
+#include <uv.h>
+
+#include "bytecode_interpreter.h"
+#include "interpreter_state.h"
+
+namespace lyric_runtime {
+
+    // forward declarations
+    class InterpreterExecutor;
+    struct ParkedJob;
+
+    struct ExecutorOptions {
+        /**
+         * The number of worker threads which run interpreters. If zero then one worker is started for
+         * each available cpu.
+         */
+        int numWorkers = 0;
+        /**
+         * The number of time slices an interpreter runs before it is preempted and the worker moves on
+         * to the next runnable interpreter.
+         */
+        int slicesPerQuantum = 16;
+    };
+
+    typedef tempo_utils::Result<InterpreterExit> ExecutorResult;
+
+    /**
+     * A loaded InterpreterState submitted to the executor, along with the interpreter which drives it.
+     * A job is owned by at most one worker at a time.
+     */
+    struct ExecutorJob {
+        std::shared_ptr<InterpreterState> state;
+        std::unique_ptr<BytecodeInterpreter> interp;
+        std::promise<ExecutorResult> promise;
+    };
+
+    /**
+     * A worker thread and its queue of runnable jobs. The worker pops jobs from the front of its own
+     * queue and idle workers steal jobs from the back.
+     */
+    struct ExecutorWorker {
+        InterpreterExecutor *executor = nullptr;
+        int index = -1;
+        uv_thread_t tid;
+        absl::Mutex lock;
+        std::deque<ExecutorJob *> queue ABSL_GUARDED_BY(lock);
+    };
+
+    /**
+     * The InterpreterExecutor multiplexes many InterpreterStates over a fixed pool of worker threads.
+     * Each state is driven by exactly one worker at a time, and is preempted after a quantum of time
+     * slices so that a long-running program cannot starve the other states assigned to its worker.
+     * A state which has no ready task is parked on the reactor thread until its system loop has a
+     * pending event, rather than blocking a worker.
+     */
+    class InterpreterExecutor {
+    public:
+        explicit InterpreterExecutor(const ExecutorOptions &options = {});
+        ~InterpreterExecutor();
+
+        int numWorkers() const;
+        int numOutstanding() const;
+
+        tempo_utils::Status start();
+        tempo_utils::Status shutdown();
+
+        tempo_utils::Status submit(
+            std::shared_ptr<InterpreterState> state,
+            std::future<ExecutorResult> &future);
+
+    private:
+        ExecutorOptions m_options;
+        std::vector<std::unique_ptr<ExecutorWorker>> m_workers;
+        uv_thread_t m_reactorTid;
+        uv_loop_t m_reactorLoop;
+        uv_async_t m_reactorAsync;
+
+        mutable absl::Mutex m_lock;
+        absl::CondVar m_runnableWaiter;
+        absl::CondVar m_outstandingWaiter;
+        bool m_running ABSL_GUARDED_BY(m_lock);
+        bool m_stopping ABSL_GUARDED_BY(m_lock);
+        int m_numRunnable ABSL_GUARDED_BY(m_lock);
+        int m_numOutstanding ABSL_GUARDED_BY(m_lock);
+        int m_nextWorker ABSL_GUARDED_BY(m_lock);
+
+        absl::Mutex m_parkLock;
+        std::vector<ExecutorJob *> m_parkRequests ABSL_GUARDED_BY(m_parkLock);
+        bool m_reactorStopping ABSL_GUARDED_BY(m_parkLock);
+
+        void enqueue(ExecutorJob *job, ExecutorWorker *worker = nullptr);
+        ExecutorJob *dequeue(ExecutorWorker *worker);
+        void park(ExecutorJob *job);
+        void complete(ExecutorJob *job, ExecutorResult result);
+        void runWorker(ExecutorWorker *worker);
+        void runReactor();
+        void processParkRequests();
+
+        friend void executor_worker_thread(void *arg);
+        friend void executor_reactor_thread(void *arg);
+        friend void on_reactor_async(uv_async_t *async);
+        friend void on_parked_job_ready(ParkedJob *parked);
+    };
+}
+
+#endif // LYRIC_RUNTIME_INTERPRETER_EXECUTOR_H
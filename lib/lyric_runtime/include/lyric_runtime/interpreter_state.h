@@ -26,7 +26,8 @@ namespace lyric_runtime {
          */
         lyric_common::ModuleLocation preludeLocation = {};
         /**
-         *
+         * The heap which stores instances allocated by the interpreter. If not specified then an
+         * ArenaHeap is allocated.
          */
         std::shared_ptr<AbstractHeap> heap = {};
         /**
@@ -37,6 +38,28 @@ namespace lyric_runtime {
          *
          */
         std::vector<std::string> mainArguments = {};
+        /**
+         * If true then the bytecode of each proc is translated once into a predecoded instruction stream
+         * and the interpreter dispatches from the predecoded stream instead of decoding each instruction
+         * as it is executed.
+         */
+        bool enablePredecodedDispatch = false;
+        /**
+         * The storage layout of the operand stack of each task. The slotted layout uses more memory than
+         * the packed layout but provides constant-time access to any operand on the stack.
+         */
+        OperandStackLayout operandStackLayout = OperandStackLayout::Packed;
+        /**
+         * The number of heap instances which may be allocated after a garbage collection before the
+         * interpreter automatically starts the next collection. If zero then automatic collection is
+         * disabled and garbage is only collected when explicitly requested.
+         */
+        tu_uint32 gcAllocationBudget = 65536;
+        /**
+         * The maximum time in microseconds the interpreter may pause to sweep unreachable instances at
+         * each time slice. If zero then each collection runs to completion.
+         */
+        tu_uint32 gcMaxPauseMicros = 1000;
     };
 
     class InterpreterState : public std::enable_shared_from_this<InterpreterState> {
@@ -48,6 +71,7 @@ namespace lyric_runtime {
         tu_uint64 getLoadEpochMillis() const;
         tempo_utils::StatusCode getStatusCode() const;
         bool isActive() const;
+        bool isPredecodedDispatchEnabled() const;
 
         Operand getMainArgument(int index) const;
         int numMainArguments() const;
@@ -84,6 +108,8 @@ namespace lyric_runtime {
         std::shared_ptr<AbstractLoader> m_systemLoader;
         std::shared_ptr<AbstractLoader> m_applicationLoader;
         std::shared_ptr<AbstractHeap> m_heap;
+        bool m_predecodedDispatch;
+        CollectorOptions m_collectorOptions;
 
         // set in initialize method
         std::unique_ptr<SegmentManager> m_segmentManager;
@@ -0,0 +1,41 @@
+#ifndef LYRIC_RUNTIME_MARK_STACK_H
+#define LYRIC_RUNTIME_MARK_STACK_H
+
+#include <vector>
+
+#include <tempo_utils/integer_types.h>
+
+#include "abstract_ref.h"
+
+namespace lyric_runtime {
+
+    /**
+     * Explicit worklist for the mark phase of a collection. While a mark stack is active on the current
+     * thread, marking an operand pushes the referenced instance onto the stack instead of recursing into
+     * the members of the instance, so the depth of the native stack does not depend on the shape of the
+     * object graph. Each instance is traced at most once per mark phase, so cycles terminate.
+     */
+    class MarkStack {
+
+    public:
+        MarkStack();
+        ~MarkStack();
+
+        MarkStack(const MarkStack &other) = delete;
+        MarkStack& operator=(const MarkStack &other) = delete;
+
+        tu_uint64 getEpoch() const;
+
+        void push(AbstractRef *instance);
+        void drain();
+
+        static MarkStack *active();
+
+    private:
+        std::vector<AbstractRef *> m_pending;
+        MarkStack *m_prev;
+        tu_uint64 m_epoch;
+    };
+}
+
+#endif // LYRIC_RUNTIME_MARK_STACK_H
@@ -35,6 +35,7 @@ namespace lyric_runtime {
         SmallValue,
         LargeValue,
         Pointer,
+        WideValue,
     };
 
     enum class OperandType : uint8_t {
@@ -125,6 +126,8 @@ namespace lyric_runtime {
 
         std::string toString() const;
 
+        Operand unboxed() const;
+
         static Operand fromBool(bool b);
         static Operand fromI8(tu_int8 i8);
         static Operand fromI16(tu_int16 i16);
@@ -158,14 +161,14 @@ namespace lyric_runtime {
         static size_t parseSize(const tu_uint8 &infoByte);
 
     private:
-        std::array<tu_uint8,8> m_bytes;
+        tu_uint64 m_wide;                   // payload for the wide value overlay
+        std::array<tu_uint8,8> m_bytes;     // tagged value, the info byte is stored in the last byte
 
         explicit Operand(std::array<tu_uint8,8> bytes);
+        Operand(tu_uint8 widetag, tu_uint64 wide);
 
         static Operand fromPointer(void *ptr, tu_uint8 pointertag);
         void *getPointer(tu_uint8 pointertag) const;
-
-        friend void value_to_operand(double v, Operand &op, HeapManager *heapManager);
     };
 
     bool operand_to_value(const Operand &op, bool &v);
@@ -10,10 +10,19 @@ namespace lyric_runtime {
 
     class OperandStackIterator;
 
+    /**
+     * The storage layout of an OperandStack.
+     */
+    enum class OperandStackLayout {
+        Packed,         /**< Operands are stored as variable-length byte records. */
+        Slotted,        /**< Each operand occupies one fixed-width slot. */
+    };
 
     class OperandStack {
     public:
-        explicit OperandStack(size_t stackSize = 8192);
+        explicit OperandStack(size_t stackSize = 8192, OperandStackLayout layout = OperandStackLayout::Packed);
+
+        OperandStackLayout getLayout() const;
 
         bool isEmpty() const;
 
@@ -31,7 +40,9 @@ namespace lyric_runtime {
         float getUtilization() const;
 
     private:
+        OperandStackLayout m_layout;
         std::vector<tu_uint8> m_stack;
+        std::vector<Operand> m_slots;
         size_t m_last = 0;
         size_t m_depth = 0;
     };
@@ -46,9 +57,11 @@ namespace lyric_runtime {
 
     private:
         const tu_uint8 *m_stack;
+        const Operand *m_slots;
         size_t m_curr;
 
         explicit OperandStackIterator(const tu_uint8 *stack, size_t last);
+        explicit OperandStackIterator(const Operand *slots, size_t depth);
 
         friend class OperandStack;
     };
@@ -0,0 +1,80 @@
+#ifndef LYRIC_RUNTIME_PREDECODED_PROC_H
+#define LYRIC_RUNTIME_PREDECODED_PROC_H
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <lyric_object/bytecode_iterator.h>
+
+#include "call_site_cache.h"
+#include "runtime_types.h"
+
+namespace lyric_runtime {
+
+    /**
+     * A common sequence of instructions which the interpreter executes as a single fused instruction.
+     */
+    enum class Superinstruction : tu_uint8 {
+        None,                           /**< The instruction is not fused with the following instruction. */
+        LoadLocalPair,                  /**< LOAD(local) followed by LOAD(local). */
+        CompareBranch,                  /**< CMP followed by IF_ZERO, IF_NOTZERO, IF_GT, IF_GE, IF_LT, or IF_LE. */
+        DupStoreLocal,                  /**< DUP followed by STORE(local). */
+    };
+
+    /**
+     * A single instruction which has been decoded ahead of time. In addition to the decoded OpCell, the
+     * predecoded op contains the offset of the following instruction and, for branch instructions, the
+     * absolute offset of the branch target and the index of the target in the predecoded stream. For virtual,
+     * stub, concept, and existential calls the predecoded op points to the inline cache for the call site, so
+     * a cache hit costs no lookup. If the instruction begins a superinstruction then the remaining instructions
+     * of the sequence immediately follow the op in the predecoded stream.
+     */
+    struct PredecodedOp {
+        lyric_object::OpCell op;        /**< The decoded instruction. */
+        tu_uint32 next;                 /**< Offset of the following instruction relative to the start of the code. */
+        tu_uint32 target;               /**< Offset of the jump target, or INVALID_ADDRESS_U32 if not a branch. */
+        tu_uint32 targetIndex;          /**< Index of the op at the jump target, or INVALID_ADDRESS_U32 if none. */
+        Superinstruction fused;         /**< The superinstruction beginning at this op, or None. */
+        tu_uint32 fusedNext;            /**< Offset of the instruction following the superinstruction. */
+        CallSiteCache *callSite;        /**< Inline cache for the call site, or nullptr if not a dispatched call. */
+    };
+
+    /**
+     * The predecoded instruction stream for the code section of a single proc. The code is decoded exactly
+     * once when the PredecodedProc is constructed. The interpreter steps through the stream by op index,
+     * following the precomputed target index for branches, so fetching an instruction by its offset
+     * relative to the start of the code is only needed when control enters the proc.
+     */
+    class PredecodedProc {
+
+    public:
+        explicit PredecodedProc(std::span<const tu_uint8> code);
+
+        PredecodedProc(const PredecodedProc &other) = delete;
+        PredecodedProc& operator=(const PredecodedProc &other) = delete;
+
+        const tu_uint8 *getCodeBase() const;
+        tu_uint32 getCodeSize() const;
+        bool isComplete() const;
+
+        int numOps() const;
+        int numSuperinstructions() const;
+        int numCallSites() const;
+        const PredecodedOp *getOp(tu_uint32 offset) const;
+        std::span<const PredecodedOp> getOps() const;
+
+    private:
+        std::span<const tu_uint8> m_code;
+        std::vector<PredecodedOp> m_ops;
+        std::unique_ptr<CallSiteCache[]> m_callSites;
+        int m_numSuperinstructions;
+        int m_numCallSites;
+        bool m_complete;
+
+        int findOp(tu_uint32 offset) const;
+        void fuseSuperinstructions();
+    };
+}
+
+#endif // LYRIC_RUNTIME_PREDECODED_PROC_H
@@ -0,0 +1,71 @@
+#ifndef LYRIC_RUNTIME_PROC_METADATA_H
+#define LYRIC_RUNTIME_PROC_METADATA_H
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <lyric_object/proc_utils.h>
+
+namespace lyric_runtime {
+
+    /**
+     * A catch handler which is active within a handler range.
+     */
+    struct ProcHandler {
+        tu_uint32 exception_type;       /**< index of the exception type in the types section of the object. */
+        tu_uint32 catch_offset;         /**< offset from the start of the proc code of the catch handler. */
+        tu_uint16 exception_local;      /**< offset of the local variable where the exception ref is stored. */
+    };
+
+    /**
+     * A range of proc code within which the same set of catch handlers is active.
+     */
+    struct ProcHandlerRange {
+        tu_uint32 range_start;          /**< offset of the start of the range (inclusive). */
+        tu_uint32 range_end;            /**< offset of the end of the range (exclusive). */
+        tu_uint32 first_handler;        /**< index of the first handler for the range. */
+        tu_uint32 num_handlers;         /**< the number of handlers for the range. */
+    };
+
+    /**
+     * The decoded metadata for a single proc: the proc header, the lexicals table, the checks and
+     * exceptions tables from the proc trailer, and the handler table derived from the checks. Proc
+     * metadata is decoded once per proc and cached by the segment containing the proc, so calls and
+     * raises do not parse the proc header and tables each time.
+     */
+    class ProcMetadata {
+
+    public:
+        const lyric_object::ProcInfo &getProcInfo() const;
+        tu_uint16 numArguments() const;
+        tu_uint16 numLocals() const;
+        tu_uint16 numLexicals() const;
+        std::span<const tu_uint8> getCode() const;
+
+        std::span<const lyric_object::ProcLexical> getLexicals() const;
+        std::span<const lyric_object::ProcCheck> getChecks() const;
+        std::span<const lyric_object::ProcException> getExceptions() const;
+
+        std::span<const ProcHandler> findHandlers(tu_uint32 offset) const;
+
+        static tempo_utils::Status parse(
+            std::span<const tu_uint8> bytecode,
+            tu_uint32 procOffset,
+            std::unique_ptr<ProcMetadata> &procMetadata);
+
+    private:
+        lyric_object::ProcInfo m_procInfo;
+        std::vector<lyric_object::ProcLexical> m_lexicals;
+        std::vector<lyric_object::ProcCheck> m_checks;
+        std::vector<lyric_object::ProcException> m_exceptions;
+        std::vector<ProcHandlerRange> m_handlerRanges;
+        std::vector<ProcHandler> m_handlers;
+
+        ProcMetadata() = default;
+
+        void buildHandlerTable();
+    };
+}
+
+#endif // LYRIC_RUNTIME_PROC_METADATA_H
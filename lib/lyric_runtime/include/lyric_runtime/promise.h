@@ -67,6 +67,7 @@ namespace lyric_runtime {
             Waiting,    /**< The promise is being awaited. */
             Completed,  /**< The promise was completed. */
             Rejected,   /**< The promise was rejected. */
+            Cancelled,  /**< The promise was cancelled before it was resolved. */
         };
 
         State getState() const;
@@ -77,6 +78,7 @@ namespace lyric_runtime {
 
         tempo_utils::Status await(SystemScheduler *systemScheduler);
         tempo_utils::Status forward(std::shared_ptr<Promise> &target);
+        tempo_utils::Status cancel(SystemScheduler *systemScheduler);
 
         void accept(const Waiter *waiter, InterpreterState *state);
 
@@ -95,6 +97,9 @@ namespace lyric_runtime {
         Operand m_result;
 
         tempo_utils::Status notify();
+        void detachWaiter(const Waiter *waiter);
+
+        friend class SystemScheduler;
     };
 }
 
@@ -34,6 +34,8 @@ namespace lyric_runtime {
         virtual BytecodeSegment *getSegment(tu_uint32 segmentIndex);
         virtual BytecodeSegment *getSegment(const lyric_common::ModuleLocation &location);
 
+        virtual void setReachable() const;
+
         virtual BytecodeSegment *getOrLoadSegment(const lyric_common::ModuleLocation &location, bool useSystemLoader);
 
         virtual bool hasResource(
@@ -0,0 +1,48 @@
+#ifndef LYRIC_RUNTIME_SHARED_BYTES_H
+#define LYRIC_RUNTIME_SHARED_BYTES_H
+
+#include <memory>
+
+#include <tempo_utils/immutable_bytes.h>
+
+namespace lyric_runtime {
+
+    /**
+     * ImmutableBytes view of a range within another ImmutableBytes. The slice shares ownership of the
+     * parent rather than copying the range.
+     */
+    class BytesSlice : public tempo_utils::ImmutableBytes {
+    public:
+        BytesSlice(std::shared_ptr<const tempo_utils::ImmutableBytes> parent, tu_uint32 offset, tu_uint32 size);
+
+        const tu_uint8 *getData() const override;
+        tu_uint32 getSize() const override;
+
+        static std::shared_ptr<const tempo_utils::ImmutableBytes> create(
+            std::shared_ptr<const tempo_utils::ImmutableBytes> parent,
+            tu_uint32 offset,
+            tu_uint32 size);
+
+    private:
+        std::shared_ptr<const tempo_utils::ImmutableBytes> m_parent;
+        tu_uint32 m_offset;
+        tu_uint32 m_size;
+    };
+
+    /**
+     * ImmutableBytes which shares ownership of an array, such as the buffer of a whole-file read.
+     */
+    class SharedArrayBytes : public tempo_utils::ImmutableBytes {
+    public:
+        SharedArrayBytes(std::shared_ptr<const tu_uint8[]> data, tu_uint32 size);
+
+        const tu_uint8 *getData() const override;
+        tu_uint32 getSize() const override;
+
+    private:
+        std::shared_ptr<const tu_uint8[]> m_data;
+        tu_uint32 m_size;
+    };
+}
+
+#endif // LYRIC_RUNTIME_SHARED_BYTES_H
@@ -6,15 +6,19 @@
 #include "bytecode_segment.h"
 #include "call_cell.h"
 #include "operand_stack.h"
+#include "predecoded_proc.h"
 
 namespace lyric_runtime {
 
     class StackfulCoroutine {
     public:
-        StackfulCoroutine();
+        explicit StackfulCoroutine(OperandStackLayout layout = OperandStackLayout::Packed);
 
         bool nextOp(lyric_object::OpCell &op);
+        bool nextPredecodedOp(const PredecodedOp *&op);
+        const PredecodedProc *peekPredecoded() const;
         bool moveIP(int16_t offset);
+        bool jumpIP(tu_uint32 address);
         BytecodeSegment *peekSP() const;
         lyric_object::BytecodeIterator peekIP() const;
 
@@ -27,6 +31,10 @@ namespace lyric_runtime {
             const CallCell &value,
             const lyric_object::BytecodeIterator &ip,
             BytecodeSegment *sp);
+        tempo_utils::Status pushCall(
+            CallCell &&value,
+            const lyric_object::BytecodeIterator &ip,
+            BytecodeSegment *sp);
         tempo_utils::Status popCall(CallCell &value);
         tempo_utils::Status peekCall(const CallCell **valueptr, int offset = -1) const;
         tempo_utils::Status peekCall(CallCell **valueptr, int offset = -1);
@@ -43,6 +51,7 @@ namespace lyric_runtime {
         tempo_utils::Status peekData(Operand &value, int offset = 0) const;
         tempo_utils::Status dropData(int offset = 0);
         tempo_utils::Status resizeDataStack(int count);
+        std::vector<Operand>& argumentWindow();
 
         bool dataStackEmpty() const;
         int dataStackSize() const;
@@ -62,6 +71,8 @@ namespace lyric_runtime {
         std::vector<CallCell> m_callStack;          // call frame stack
         OperandStack m_operandStack;                // data cell stack
         std::vector<int> m_guardStack;              // subinterpreter guard stack
+        std::vector<Operand> m_argumentWindow;      // reusable buffer for outgoing call arguments
+        const PredecodedProc *m_predecoded;         // predecoded code for the current IP
     };
 }
 
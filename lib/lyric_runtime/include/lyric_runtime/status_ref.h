@@ -28,7 +28,6 @@ namespace lyric_runtime {
 
     protected:
         void setMembersReachable() override;
-        void clearMembersReachable() override;
 
     private:
         tempo_utils::StatusCode m_statusCode;
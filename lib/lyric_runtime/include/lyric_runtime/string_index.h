@@ -0,0 +1,63 @@
+#ifndef LYRIC_RUNTIME_STRING_INDEX_H
+#define LYRIC_RUNTIME_STRING_INDEX_H
+
+#include <vector>
+
+#include <tempo_utils/integer_types.h>
+#include <tempo_utils/rope.h>
+
+namespace lyric_runtime {
+
+    /**
+     * The number of code points between consecutive checkpoints in a StringIndex.
+     */
+    constexpr tu_int32 kStringIndexStride = 64;
+
+    /**
+     * The maximum number of bytes spanned by the code points between consecutive checkpoints.
+     */
+    constexpr tu_int32 kStringIndexMaxSpan = kStringIndexStride * 4;
+
+    struct StringCheckpoint {
+        tu_int32 index;                                 /**< Code point index of the checkpoint. */
+        tu_int32 offset;                                /**< Byte offset of the code point. */
+    };
+
+    /**
+     * Code point metadata for the UTF-8 contents of a string rope: the number of code points, whether
+     * the contents are ASCII-only, and a sparse index which maps every kStringIndexStride-th code point to
+     * its byte offset. Locating a code point is a binary search over the checkpoints followed by decoding
+     * at most kStringIndexStride code points. ASCII-only contents need no checkpoints, since the code point
+     * index is the byte offset.
+     */
+    class StringIndex {
+
+    public:
+        StringIndex();
+
+        bool isValid() const;
+        bool isAscii() const;
+        tu_int32 getLength() const;
+        tu_int32 getSize() const;
+        tu_int32 numCheckpoints() const;
+
+        bool locate(tu_int32 index, StringCheckpoint &checkpoint, tu_int32 &end) const;
+
+        static StringIndex build(const tempo_utils::Rope<char> &rope);
+        static StringIndex forAscii(tu_int32 length);
+        static StringIndex invalid();
+        static StringIndex concat(const StringIndex &lhs, const StringIndex &rhs);
+
+    private:
+        bool m_valid;
+        bool m_ascii;
+        tu_int32 m_length;
+        tu_int32 m_size;
+        std::vector<StringCheckpoint> m_checkpoints;
+
+        void indexRun(const char *data, tu_int32 size);
+        void appendCheckpoints(const StringIndex &other, tu_int32 indexBase, tu_int32 offsetBase);
+    };
+}
+
+#endif // LYRIC_RUNTIME_STRING_INDEX_H
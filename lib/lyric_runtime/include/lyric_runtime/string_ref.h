@@ -4,6 +4,7 @@
 #include <tempo_utils/rope.h>
 
 #include "abstract_ref.h"
+#include "string_index.h"
 
 namespace lyric_runtime {
 
@@ -37,6 +38,10 @@ namespace lyric_runtime {
         tempo_utils::Rope<char> getStringData() const;
         int32_t getStringSize() const;
 
+        const StringIndex &getStringIndex() const;
+        bool hasStringIndex() const;
+        void setStringIndex(StringIndex index);
+
         void setPermanent();
         bool isReachable() const override;
         void setReachable() override;
@@ -60,6 +65,9 @@ namespace lyric_runtime {
         const ExistentialTable *m_etable;
         tempo_utils::Rope<char> m_rope;
         int32_t m_size;
+        mutable std::unique_ptr<StringIndex> m_index;
+        bool m_hashed;
+        size_t m_hash;
         bool m_permanent;
         bool m_reachable;
     };
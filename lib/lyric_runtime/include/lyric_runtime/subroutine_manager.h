@@ -37,14 +37,16 @@ namespace lyric_runtime {
             tu_uint32 callAddress,
             std::vector<Operand> &args,
             StackfulCoroutine *currentCoro,
-            tempo_utils::Status &status);
+            tempo_utils::Status &status,
+            CallSiteCache *callSite = nullptr);
 
         bool callStub(
             const Operand &receiver,
             tu_uint32 actionAddress,
             std::vector<Operand> &args,
             StackfulCoroutine *currentCoro,
-            tempo_utils::Status &status);
+            tempo_utils::Status &status,
+            CallSiteCache *callSite = nullptr);
 
         bool callConcept(
             const Operand &receiver,
@@ -52,7 +54,8 @@ namespace lyric_runtime {
             tu_uint32 address,
             std::vector<Operand> &args,
             StackfulCoroutine *currentCoro,
-            tempo_utils::Status &status);
+            tempo_utils::Status &status,
+            CallSiteCache *callSite = nullptr);
 
         bool callExistential(
             const Operand &receiver,
@@ -60,7 +63,8 @@ namespace lyric_runtime {
             tu_uint32 methodAddress,
             std::vector<Operand> &args,
             StackfulCoroutine *currentCoro,
-            tempo_utils::Status &status);
+            tempo_utils::Status &status,
+            CallSiteCache *callSite = nullptr);
 
         bool initStatic(
             tu_uint32 address,
@@ -73,6 +77,13 @@ namespace lyric_runtime {
 
     private:
         SegmentManager *m_segmentManager;
+
+        Operand resolveCallSiteDescriptor(
+            BytecodeSegment *sp,
+            CallSiteCache *cache,
+            lyric_object::LinkageSection section,
+            tu_uint32 address,
+            tempo_utils::Status &status);
     };
 
     tempo_utils::Status process_arguments(
@@ -80,10 +91,17 @@ namespace lyric_runtime {
         const std::vector<Operand> &args,
         tu_uint16 &numRest);
 
+    tempo_utils::Status capture_lexical(
+        const lyric_object::ProcLexical &lexical,
+        StackfulCoroutine *currentCoro,
+        BytecodeSegment *segment,
+        int frameOffset,
+        UpvalueCellPtr &cell);
+
     tempo_utils::Status import_lexicals_into_frame(
-        const lyric_object::ProcInfo &procInfo,
-        const StackfulCoroutine *currentCoro,
-        const BytecodeSegment *segment,
+        const ProcMetadata &procMetadata,
+        StackfulCoroutine *currentCoro,
+        BytecodeSegment *segment,
         CallCell &frame);
 
 }
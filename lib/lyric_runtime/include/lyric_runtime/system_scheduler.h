@@ -1,11 +1,17 @@
 #ifndef LYRIC_RUNTIME_SYSTEM_SCHEDULER_H
 #define LYRIC_RUNTIME_SYSTEM_SCHEDULER_H
 
+#include <new>
+#include <vector>
+
 #include <uv.h>
 
+#include "free_list.h"
+#include "fs_batch.h"
 #include "promise.h"
 #include "stackful_coroutine.h"
 #include "task.h"
+#include "timer_wheel.h"
 
 namespace lyric_runtime {
 
@@ -30,10 +36,9 @@ namespace lyric_runtime {
         uv_close_cb m_cb ABSL_GUARDED_BY(*m_lock);
         bool m_pending ABSL_GUARDED_BY(*m_lock);
 
-        void close();
+        void close(void *closeData);
 
         friend class SystemScheduler;
-        friend class Waiter;
     };
 
     /**
@@ -41,13 +46,14 @@ namespace lyric_runtime {
      */
     class Waiter final {
     public:
-        ~Waiter();
-
         enum class Type {
             Invalid,
             Async,
             Handle,
             Req,
+            Timer,
+            Batch,
+            ReadFile,
         };
 
         Type getType() const;
@@ -57,6 +63,9 @@ namespace lyric_runtime {
         const AsyncHandle *peekAsync() const;
         const uv_handle_t *peekHandle() const;
         const uv_fs_t *peekReq() const;
+        const TimerEntry *peekTimer() const;
+        const FsBatch *peekBatch() const;
+        const FsReadFile *peekReadFile() const;
 
         Waiter *prevWaiter() const;
         Waiter *nextWaiter() const;
@@ -68,14 +77,24 @@ namespace lyric_runtime {
         Waiter *m_next = nullptr;
 
         Type m_type;
-        std::variant<std::nullptr_t, std::shared_ptr<AsyncHandle>, uv_handle_t *, uv_fs_t *> m_waitee;
-        // TODO: uv_timer_t *m_deadline = nullptr;
+        std::variant<
+            std::nullptr_t,
+            std::shared_ptr<AsyncHandle>,
+            uv_handle_t *,
+            uv_fs_t *,
+            TimerEntry *,
+            FsBatch *,
+            FsReadFile *> m_waitee;
         Task *m_task = nullptr;
         std::shared_ptr<Promise> m_promise;
 
         Waiter(std::shared_ptr<AsyncHandle> async, std::shared_ptr<Promise> promise);
         Waiter(uv_handle_t *handle, std::shared_ptr<Promise> promise);
         Waiter(uv_fs_t *req, std::shared_ptr<Promise> promise);
+        Waiter(TimerEntry *timer, std::shared_ptr<Promise> promise);
+        Waiter(FsBatch *batch, std::shared_ptr<Promise> promise);
+        Waiter(FsReadFile *fileRead, std::shared_ptr<Promise> promise);
+        ~Waiter() = default;
 
         void assignTask(Task *task);
         void complete(InterpreterState *state);
@@ -83,10 +102,13 @@ namespace lyric_runtime {
         friend class SystemScheduler;
 
         friend void on_async_complete(uv_async_t *async);
-        friend void on_timer_complete(uv_timer_t *timer);
+        friend void on_timer_complete(TimerEntry *timer, void *data);
         friend void on_worker_complete(uv_async_t *monitor);
         friend void on_read_complete(uv_fs_t *req);
         friend void on_write_complete(uv_fs_t *req);
+        friend void on_batch_complete(uv_fs_t *req);
+        friend void on_read_file_stat(uv_fs_t *req);
+        friend void on_read_file_read(uv_fs_t *req);
     };
 
     /**
@@ -95,10 +117,11 @@ namespace lyric_runtime {
      */
     class SystemScheduler {
     public:
-        explicit SystemScheduler(uv_loop_t *loop);
+        explicit SystemScheduler(uv_loop_t *loop, OperandStackLayout operandStackLayout = OperandStackLayout::Packed);
         ~SystemScheduler();
 
         uv_loop_t *systemLoop() const;
+        OperandStackLayout getOperandStackLayout() const;
 
         Task *mainTask() const;
         StackfulCoroutine *mainCoro() const;
@@ -129,31 +152,71 @@ namespace lyric_runtime {
             uv_buf_t buf,
             std::shared_ptr<Promise> promise,
             tu_int64 offset = -1);
+        tempo_utils::Status registerRead(
+            uv_file file,
+            const uv_buf_t bufs[],
+            unsigned int nbufs,
+            std::shared_ptr<Promise> promise,
+            tu_int64 offset = -1);
+        tempo_utils::Status registerReadFile(uv_file file, std::shared_ptr<Promise> promise);
         tempo_utils::Status registerWrite(
             uv_file file,
             const uv_buf_t bufs[],
             unsigned int nbufs,
             std::shared_ptr<Promise> promise,
             tu_int64 offset = -1);
+        tempo_utils::Status registerBatch(
+            const std::vector<FsOperation> &operations,
+            std::shared_ptr<Promise> promise);
 
+        tempo_utils::Status cancelWaiter(Waiter *waiter);
         void destroyWaiter(Waiter *waiter);
 
         Waiter *firstWaiter() const;
         Waiter *lastWaiter() const;
 
+        const TimerWheel *timerWheel() const;
+
         bool poll();
         bool blockingPoll();
 
     private:
         uv_loop_t *m_loop;
+        OperandStackLayout m_operandStackLayout;
         Task *m_readyQueue;
         Task *m_waitQueue;
         Task *m_doneQueue;
         Task *m_currentTask;
         Task *m_mainTask;
         Waiter *m_waiters;
-
+        bool m_tearingDown;
+
+        // storage pools, waitee storage is only released back to its pool once libuv is done with it
+        FreeList<Waiter> m_waiterPool;
+        FreeList<uv_any_handle> m_handlePool;
+        FreeList<uv_fs_t> m_reqPool;
+        FreeList<TimerEntry> m_timerPool;
+
+        // all timers are scheduled in the timer wheel, which is driven by a single uv timer
+        TimerWheel m_timerWheel;
+        uv_timer_t *m_wheelTimer;
+        tu_uint64 m_wheelWakeup;
+
+        template <typename... Args>
+        Waiter *allocateWaiter(Args&&... args)
+        {
+            return new (m_waiterPool.allocate()) Waiter(std::forward<Args>(args)...);
+        }
+
+        uv_async_t *allocateAsync(uv_async_cb cb);
+        uv_fs_t *allocateReq();
+        void closeHandle(uv_handle_t *handle);
+        void releaseWaitee(Waiter *waiter);
         void attachWaiter(Waiter *waiter);
+        void armWheelTimer();
+
+        friend void on_pooled_handle_close(uv_handle_t *handle);
+        friend void on_wheel_timer(uv_timer_t *timer);
     };
 }
 
@@ -0,0 +1,74 @@
+#ifndef LYRIC_RUNTIME_TIMER_WHEEL_H
+#define LYRIC_RUNTIME_TIMER_WHEEL_H
+
+#include <tempo_utils/integer_types.h>
+
+namespace lyric_runtime {
+
+    /**
+     * Intrusive list link for a timer entry. An unlinked entry has null prev and next pointers.
+     */
+    struct TimerLink {
+        TimerLink *prev = nullptr;
+        TimerLink *next = nullptr;
+    };
+
+    /**
+     * A timer scheduled in a TimerWheel. The entry storage is owned by the caller, and must stay valid
+     * until the entry has expired or has been cancelled.
+     */
+    struct TimerEntry {
+        TimerLink link;
+        tu_uint64 expires = 0;
+        void *data = nullptr;
+    };
+
+    typedef void (*TimerCallback)(TimerEntry *entry, void *cbData);
+
+    /**
+     * A hierarchical timing wheel. The root level has one slot for each of the next 256 ticks, and each
+     * of the three outer levels has 64 slots covering 64 times the range of the level below it. Timers
+     * are inserted into the slot for their expiry tick, and are cascaded down a level each time the
+     * level below wraps around, so insert and cancel are O(1) and advancing the wheel touches only
+     * the timers which expire or cascade. Timers which expire on the same tick are fired together.
+     */
+    class TimerWheel {
+    public:
+        explicit TimerWheel(tu_uint64 currentTick = 0);
+
+        TimerWheel(const TimerWheel &other) = delete;
+        TimerWheel& operator=(const TimerWheel &other) = delete;
+
+        bool isEmpty() const;
+        int numTimers() const;
+        tu_uint64 currentTick() const;
+
+        void insert(TimerEntry *entry, tu_uint64 expires);
+        bool cancel(TimerEntry *entry);
+
+        tu_uint64 nextWakeup() const;
+        int advance(tu_uint64 now, TimerCallback cb, void *cbData);
+
+        static bool isScheduled(const TimerEntry *entry);
+
+    private:
+        static constexpr int kRootBits = 8;
+        static constexpr int kRootSize = 1 << kRootBits;
+        static constexpr int kRootMask = kRootSize - 1;
+        static constexpr int kLevelBits = 6;
+        static constexpr int kLevelSize = 1 << kLevelBits;
+        static constexpr int kLevelMask = kLevelSize - 1;
+        static constexpr int kNumLevels = 3;
+        static constexpr tu_uint64 kMaxInterval = (1ull << (kRootBits + kNumLevels * kLevelBits)) - 1;
+
+        TimerLink m_root[kRootSize];
+        TimerLink m_levels[kNumLevels][kLevelSize];
+        tu_uint64 m_currentTick;
+        int m_numTimers;
+
+        void place(TimerEntry *entry);
+        int cascade(int level);
+    };
+}
+
+#endif // LYRIC_RUNTIME_TIMER_WHEEL_H
@@ -1,13 +1,24 @@
 #ifndef LYRIC_RUNTIME_TYPE_ENTRY_H
 #define LYRIC_RUNTIME_TYPE_ENTRY_H
 
+#include <span>
+#include <vector>
+
 #include <lyric_object/object_types.h>
 
 namespace lyric_runtime {
 
     class BytecodeSegment;
+    class DescriptorEntry;
     class TypeTable;
 
+    /**
+     * A type in the types section of a segment. Once the type has been compared by the TypeManager the
+     * entry also carries the ancestor display of the type, which is the sequence of descriptors from the
+     * root of the type hierarchy down to the descriptor of the type itself. The position of a descriptor
+     * in the display is its depth in the hierarchy, so testing whether one type extends another is a
+     * single array load.
+     */
     class TypeEntry {
 
     public:
@@ -19,9 +30,14 @@ namespace lyric_runtime {
 
         lyric_common::TypeDef getTypeDef() const;
 
+        bool hasDisplay() const;
+        std::span<DescriptorEntry * const> getDisplay() const;
+        void setDisplay(std::vector<DescriptorEntry *> &&display);
+
     private:
         TypeTable *m_typeTable;
         tu_uint32 m_index;
+        std::vector<DescriptorEntry *> m_display;
     };
 
     class TypeTable {
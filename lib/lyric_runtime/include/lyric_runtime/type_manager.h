@@ -19,6 +19,8 @@ namespace lyric_runtime {
     private:
         std::vector<Operand> m_intrinsiccache;
         SegmentManager *m_segmentManager;
+
+        tempo_utils::Status resolveDisplay(TypeEntry *typeEntry, std::span<DescriptorEntry * const> &display);
     };
 }
 
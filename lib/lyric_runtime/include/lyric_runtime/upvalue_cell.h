@@ -0,0 +1,34 @@
+#ifndef LYRIC_RUNTIME_UPVALUE_CELL_H
+#define LYRIC_RUNTIME_UPVALUE_CELL_H
+
+#include <memory>
+
+#include "operand.h"
+
+namespace lyric_runtime {
+
+    /**
+     * A heap-allocated cell holding a variable which has been captured by a closure. When a variable is
+     * captured the frame slot is promoted to an upvalue cell, and from then on the frame which defines
+     * the variable and every closure which captured it share the cell, so an update made through any of
+     * them is visible to the others and the variable outlives the defining frame.
+     */
+    class UpvalueCell {
+
+    public:
+        explicit UpvalueCell(const Operand &value);
+
+        Operand getValue() const;
+        void setValue(const Operand &value);
+
+        void setReachable() const;
+
+    private:
+        Operand m_value;
+        mutable tu_uint64 m_markEpoch;
+    };
+
+    typedef std::shared_ptr<UpvalueCell> UpvalueCellPtr;
+}
+
+#endif // LYRIC_RUNTIME_UPVALUE_CELL_H
@@ -1,8 +1,13 @@
 #ifndef LYRIC_RUNTIME_VIRTUAL_TABLE_H
 #define LYRIC_RUNTIME_VIRTUAL_TABLE_H
 
+#include <array>
+#include <memory>
+#include <vector>
+
 #include <absl/container/flat_hash_map.h>
 
+#include "descriptor_entry.h"
 #include "native_interface.h"
 #include "operand.h"
 #include "runtime_types.h"
@@ -48,6 +53,77 @@ namespace lyric_runtime {
         bool m_returnsValue;
     };
 
+    /**
+     * The number of slots in each chunk of a SlotArray, expressed as a shift.
+     */
+    constexpr int kSlotChunkShift = 4;
+    constexpr tu_uint32 kSlotChunkSize = 1u << kSlotChunkShift;
+
+    /**
+     * Array of vtable slots, where each slot holds the descriptor which owns the slot and the entry resolved
+     * for that descriptor. The slots are stored in fixed size chunks which are shared between a parent table
+     * and its descendants. A descendant starts from a copy of the parent chunk list and only copies a chunk
+     * when it overrides or appends a slot in that chunk, so the inherited prefix is not duplicated at every
+     * level of the hierarchy.
+     */
+    template <typename T>
+    class SlotArray {
+
+    public:
+        SlotArray() : m_size(0) {};
+
+        tu_uint32 size() const { return m_size; };
+
+        const DescriptorEntry *getKey(tu_uint32 slot) const
+        {
+            if (m_size <= slot)
+                return nullptr;
+            return m_chunks[slot >> kSlotChunkShift]->keys[slot & (kSlotChunkSize - 1)];
+        };
+
+        const T *getValue(tu_uint32 slot) const
+        {
+            if (m_size <= slot)
+                return nullptr;
+            return m_chunks[slot >> kSlotChunkShift]->values[slot & (kSlotChunkSize - 1)];
+        };
+
+        void set(tu_uint32 slot, const DescriptorEntry *key, const T *value)
+        {
+            auto &chunk = m_chunks[slot >> kSlotChunkShift];
+            if (chunk.use_count() > 1) {
+                chunk = std::make_shared<Chunk>(*chunk);      // copy the chunk shared with the parent
+            }
+            chunk->keys[slot & (kSlotChunkSize - 1)] = key;
+            chunk->values[slot & (kSlotChunkSize - 1)] = value;
+        };
+
+        tu_uint32 append(const DescriptorEntry *key, const T *value)
+        {
+            if ((m_size & (kSlotChunkSize - 1)) == 0) {
+                m_chunks.push_back(std::make_shared<Chunk>());
+            }
+            auto slot = m_size++;
+            set(slot, key, value);
+            return slot;
+        };
+
+        bool sharesChunk(const SlotArray &other, tu_uint32 slot) const
+        {
+            auto index = slot >> kSlotChunkShift;
+            return index < m_chunks.size() && index < other.m_chunks.size()
+                && m_chunks[index] == other.m_chunks[index];
+        };
+
+    private:
+        struct Chunk {
+            std::array<const DescriptorEntry *,kSlotChunkSize> keys = {};
+            std::array<const T *,kSlotChunkSize> values = {};
+        };
+        std::vector<std::shared_ptr<Chunk>> m_chunks;
+        tu_uint32 m_size;
+    };
+
     class AbstractMemberResolver {
     public:
         virtual ~AbstractMemberResolver() = default;
@@ -216,6 +292,17 @@ namespace lyric_runtime {
             const Operand &conceptDescriptor,
             const Operand &callDescriptor) const override;
 
+        tu_uint32 getMemberSlot(const Operand &descriptor) const;
+        const VirtualMember *getMemberAt(tu_uint32 slot) const;
+        tu_uint32 numMemberSlots() const;
+
+        tu_uint32 getMethodSlot(const Operand &descriptor) const;
+        const VirtualMethod *getMethodAt(tu_uint32 slot) const;
+        tu_uint32 numMethodSlots() const;
+
+        bool sharesMemberSlot(const VirtualTable *other, tu_uint32 slot) const;
+        bool sharesMethodSlot(const VirtualTable *other, tu_uint32 slot) const;
+
     private:
         BytecodeSegment *m_segment;
         DescriptorEntry *m_descriptor;
@@ -226,6 +313,17 @@ namespace lyric_runtime {
         const absl::flat_hash_map<OperandIdentity,VirtualMember> m_members;
         const absl::flat_hash_map<OperandIdentity,VirtualMethod> m_methods;
         const absl::flat_hash_map<OperandIdentity,ImplTable> m_impls;
+
+        // slots of the members and methods of this table and all ancestor tables, indexed by the slot
+        // assigned to the descriptor. entries which could not be assigned a slot are kept in the overflow
+        // maps, which are empty unless the same descriptor is linked into unrelated tables.
+        SlotArray<VirtualMember> m_memberSlots;
+        SlotArray<VirtualMethod> m_methodSlots;
+        absl::flat_hash_map<OperandIdentity,const VirtualMember *> m_memberOverflow;
+        absl::flat_hash_map<OperandIdentity,const VirtualMethod *> m_methodOverflow;
+        tu_uint32 m_layoutStart;
+
+        void flatten();
     };
 }
 
@@ -0,0 +1,174 @@
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include <lyric_runtime/arena_heap.h>
+#include <tempo_utils/log_stream.h>
+
+// the first slot of the first page of each arena begins after the arena header, rounded up to the size
+// class granularity
+constexpr std::size_t kArenaHeaderSize = ((lyric_runtime::kNumArenaPages
+    + lyric_runtime::kArenaSizeClassGranularity - 1) / lyric_runtime::kArenaSizeClassGranularity)
+    * lyric_runtime::kArenaSizeClassGranularity;
+
+static_assert(lyric_runtime::kArenaSize % lyric_runtime::kArenaPageSize == 0);
+static_assert(lyric_runtime::kArenaPageSize % lyric_runtime::kArenaSizeClassGranularity == 0);
+static_assert(lyric_runtime::kMaxArenaInstanceSize % lyric_runtime::kArenaSizeClassGranularity == 0);
+static_assert(kArenaHeaderSize + lyric_runtime::kMaxArenaInstanceSize <= lyric_runtime::kArenaPageSize);
+static_assert(lyric_runtime::kNumArenaSizeClasses <= 256);
+
+inline tu_uint32
+size_to_size_class(std::size_t size)
+{
+    return static_cast<tu_uint32>((size + lyric_runtime::kArenaSizeClassGranularity - 1)
+        / lyric_runtime::kArenaSizeClassGranularity) - 1;
+}
+
+inline std::size_t
+size_class_to_slot_size(tu_uint32 sizeClass)
+{
+    return (static_cast<std::size_t>(sizeClass) + 1) * lyric_runtime::kArenaSizeClassGranularity;
+}
+
+lyric_runtime::ArenaHeap::ArenaHeap()
+    : GCHeap(),
+      m_nextPage(kNumArenaPages)
+{
+    for (auto &sizeClass : m_sizeClasses) {
+        sizeClass = {nullptr, nullptr, nullptr};
+    }
+}
+
+/**
+ * Destroys all remaining instances, then releases all arenas and large instances.
+ */
+lyric_runtime::ArenaHeap::~ArenaHeap()
+{
+    releaseInstances();
+    releasePermanentInstances();
+
+    for (void *arena : m_arenas) {
+        std::free(arena);
+    }
+    for (void *instance : m_largeInstances) {
+        ::operator delete(instance);
+    }
+}
+
+/**
+ * Allocates uninitialized storage for an instance of the specified `size`. Storage for instances up to
+ * kMaxArenaInstanceSize bytes is taken from the free list of the matching size class, or carved from a
+ * page of that size class if the free list is empty. Larger instances are allocated from the global
+ * allocator.
+ *
+ * @param size The size of the instance in bytes.
+ * @return Pointer to the storage.
+ */
+void *
+lyric_runtime::ArenaHeap::allocateMemory(std::size_t size)
+{
+    if (size == 0 || kMaxArenaInstanceSize < size) {
+        auto *instance = ::operator new(size);
+        m_largeInstances.insert(instance);
+        return instance;
+    }
+
+    auto sizeClass = size_to_size_class(size);
+    auto &entry = m_sizeClasses[sizeClass];
+
+    // reuse the storage of a swept instance if one is available
+    if (entry.freeList != nullptr) {
+        auto *slot = entry.freeList;
+        entry.freeList = slot->next;
+        return slot;
+    }
+
+    // otherwise carve the next slot from the current page, allocating a new page if necessary
+    auto slotSize = size_class_to_slot_size(sizeClass);
+    if (entry.bumpCurr == nullptr || static_cast<std::size_t>(entry.bumpEnd - entry.bumpCurr) < slotSize) {
+        if (!allocatePage(sizeClass))
+            throw std::bad_alloc();
+    }
+    auto *slot = entry.bumpCurr;
+    entry.bumpCurr += slotSize;
+    return slot;
+}
+
+/**
+ * Assigns the next free page of the current arena to the specified `sizeClass` and makes it the current
+ * page for the size class, allocating a new arena if every page of the current arena is assigned. Any
+ * unused space remaining in the previous page of the size class is abandoned, which is less than one slot.
+ *
+ * @param sizeClass The size class.
+ * @return true if the page was allocated, otherwise false.
+ */
+bool
+lyric_runtime::ArenaHeap::allocatePage(tu_uint32 sizeClass)
+{
+    if (m_nextPage == kNumArenaPages) {
+        auto *arena = std::aligned_alloc(kArenaSize, kArenaSize);
+        if (arena == nullptr)
+            return false;
+        m_arenas.push_back(arena);
+        m_nextPage = 0;
+    }
+
+    auto *arena = static_cast<char *>(m_arenas.back());
+    auto *header = reinterpret_cast<ArenaHeader *>(arena);
+    auto pageIndex = m_nextPage++;
+    header->pageSizeClasses[pageIndex] = static_cast<tu_uint8>(sizeClass);
+
+    auto *page = arena + pageIndex * kArenaPageSize;
+    auto &entry = m_sizeClasses[sizeClass];
+    entry.bumpCurr = pageIndex == 0 ? page + kArenaHeaderSize : page;
+    entry.bumpEnd = page + kArenaPageSize;
+    return true;
+}
+
+/**
+ * Destroys the specified unreachable `instance` and returns its storage to the free list of the size
+ * class of the arena page containing it, or to the global allocator if it is a large instance.
+ *
+ * @param instance The instance to release.
+ */
+void
+lyric_runtime::ArenaHeap::releaseInstance(AbstractRef *instance)
+{
+    void *storage = instance;
+    instance->~AbstractRef();
+
+    if (m_largeInstances.erase(storage) > 0) {
+        ::operator delete(storage);
+        return;
+    }
+
+    auto address = reinterpret_cast<std::uintptr_t>(storage);
+    auto *header = reinterpret_cast<ArenaHeader *>(address & ~(kArenaSize - 1));
+    auto pageIndex = (address & (kArenaSize - 1)) / kArenaPageSize;
+    auto sizeClass = header->pageSizeClasses[pageIndex];
+    TU_ASSERT (sizeClass < kNumArenaSizeClasses);
+
+    auto &entry = m_sizeClasses[sizeClass];
+    auto *slot = static_cast<FreeSlot *>(storage);
+    slot->next = entry.freeList;
+    entry.freeList = slot;
+}
+
+int
+lyric_runtime::ArenaHeap::numArenas() const
+{
+    return m_arenas.size();
+}
+
+int
+lyric_runtime::ArenaHeap::numLargeInstances() const
+{
+    return m_largeInstances.size();
+}
+
+std::shared_ptr<lyric_runtime::ArenaHeap>
+lyric_runtime::ArenaHeap::create()
+{
+    return std::shared_ptr<ArenaHeap>(new ArenaHeap());
+}
@@ -148,23 +148,27 @@ lyric_runtime::BaseRef::setMembersReachable()
 {
 }
 
-void
-lyric_runtime::BaseRef::clearMembersReachable()
-{
-}
-
+/**
+ * Marks the ref as reachable and then marks the members of the ref. If the ref is already marked then
+ * the members are not visited again, which guarantees that marking terminates for cyclic object graphs.
+ */
 void
 lyric_runtime::BaseRef::setReachable()
 {
+    if (m_reachable)
+        return;
     m_reachable = true;
     setMembersReachable();
 }
 
+/**
+ * Clears the reachable flag of the ref. The members are not visited, the heap clears the flag of every
+ * instance it owns in a single pass.
+ */
 void
 lyric_runtime::BaseRef::clearReachable()
 {
     m_reachable = false;
-    clearMembersReachable();
 }
 
 void
@@ -20,6 +20,43 @@
 #define FAST_POLL_ITERATIONS            4
 #define MAX_INTERPRETER_RECURSION       128
 
+// use direct threaded dispatch (via the labels-as-values extension) when the compiler supports it
+#if defined(__GNUC__) || defined(__clang__)
+#define LYRIC_RUNTIME_COMPUTED_GOTO
+#endif
+
+#ifdef LYRIC_RUNTIME_COMPUTED_GOTO
+#define DISPATCH_CASE(name)             case lyric_object::Opcode::name: dispatch_##name
+#define DISPATCH_DEFAULT                default: dispatch_default
+#else
+#define DISPATCH_CASE(name)             case lyric_object::Opcode::name
+#define DISPATCH_DEFAULT                default
+#endif
+
+// ends an instruction handler. if the following predecoded op is known and the handler is not a checkpoint
+// then fetch the op and jump directly to its handler, otherwise complete the instruction at the loop top.
+#ifdef LYRIC_RUNTIME_COMPUTED_GOTO
+#define DISPATCH_NEXT()                                                                             \
+    do {                                                                                            \
+        if (!Inspected && !checkpoint && next != nullptr) {                                         \
+            m_instructionCounter++;                                                                 \
+            m_sliceCounter++;                                                                       \
+            predecoded = next;                                                                      \
+            op = &predecoded->op;                                                                   \
+            next = following_op(predecoded, 1, opsEnd);                                             \
+            currentCoro->jumpIP(predecoded->next);                                                  \
+            if (predecoded->fused != Superinstruction::None)                                        \
+                goto dispatch_superinstruction;                                                     \
+            if (op->opcode >= lyric_object::Opcode::LAST_)                                          \
+                goto dispatch_switch;                                                               \
+            goto *dispatchTable[static_cast<tu_uint8>(op->opcode)];                                 \
+        }                                                                                           \
+        goto dispatch_complete;                                                                     \
+    } while (0)
+#else
+#define DISPATCH_NEXT()                 goto dispatch_complete
+#endif
+
 lyric_runtime::BytecodeInterpreter::BytecodeInterpreter(
     std::shared_ptr<InterpreterState> state,
     AbstractInspector *inspector)
@@ -27,7 +64,11 @@ lyric_runtime::BytecodeInterpreter::BytecodeInterpreter(
       m_inspector(inspector),
       m_sliceCounter(0),
       m_instructionCounter(0),
-      m_recursionDepth(0)
+      m_recursionDepth(0),
+      m_quantum(0),
+      m_slicesRemaining(0),
+      m_resuming(false),
+      m_yield(InterpreterYield::Halted)
 {
     TU_ASSERT (m_state != nullptr);
 }
@@ -38,6 +79,7 @@ lyric_runtime::BytecodeInterpreter::run()
     InterpreterExit interpreterExit;
 
     TU_ASSERT (m_recursionDepth == 0);
+    TU_ASSERT (!m_resuming);
     TU_ASSIGN_OR_RETURN (interpreterExit.mainReturn, runSubinterpreter());
     TU_ASSERT (m_recursionDepth == 0);
 
@@ -48,6 +90,46 @@ lyric_runtime::BytecodeInterpreter::run()
     return interpreterExit;
 }
 
+/**
+ * Runs the interpreter for at most `numSlices` time slices. If the program halts then `interpreterExit`
+ * is set and InterpreterYield::Halted is returned. If the quantum is exhausted then the interpreter is
+ * preempted and InterpreterYield::Preempted is returned, and if there is no ready task then the
+ * interpreter returns InterpreterYield::Blocked instead of blocking on the system loop. In either case
+ * calling runQuantum again resumes the program where it left off, possibly on a different thread, as
+ * long as only one thread drives the interpreter at a time.
+ *
+ * Preemption and blocking only occur in the outermost interpreter; a subinterpreter invoked from native
+ * code runs to completion as it does with run().
+ *
+ * @param numSlices The maximum number of time slices to run, which must be greater than zero.
+ * @param interpreterExit Set to the interpreter exit if the program halted.
+ * @return The reason the interpreter returned control to the caller, or a status on failure.
+ */
+tempo_utils::Result<lyric_runtime::InterpreterYield>
+lyric_runtime::BytecodeInterpreter::runQuantum(int numSlices, InterpreterExit &interpreterExit)
+{
+    TU_ASSERT (numSlices > 0);
+    TU_ASSERT (m_recursionDepth == 0);
+
+    m_quantum = numSlices;
+    m_slicesRemaining = numSlices;
+    m_yield = InterpreterYield::Halted;
+    auto runResult = runSubinterpreter();
+    m_quantum = 0;
+    TU_ASSERT (m_recursionDepth == 0);
+
+    if (runResult.isStatus())
+        return runResult.getStatus();
+    if (m_yield != InterpreterYield::Halted)
+        return m_yield;
+
+    interpreterExit.mainReturn = runResult.getResult();
+    interpreterExit.statusCode = m_state->getStatusCode();
+    interpreterExit.interpreterStartEpochMillis = m_state->getLoadEpochMillis();
+    interpreterExit.instructionCount = m_instructionCounter;
+    return InterpreterYield::Halted;
+}
+
 tempo_utils::Status
 lyric_runtime::BytecodeInterpreter::interrupt()
 {
@@ -59,10 +141,50 @@ lyric_runtime::BytecodeInterpreter::interrupt()
     do {                                                                \
         auto status__ = static_cast<tempo_utils::Status>(expr);         \
         if (status__.notOk())                                           \
-            return onError(op, status__);                               \
+            return onError(*op, status__);                              \
     } while (0)
 
 
+/**
+ * Performs a branch for the jump instruction `op`. If the instruction was fetched from the predecoded
+ * instruction stream then the precomputed jump target is used and `next` is set to the predecoded op at
+ * the target, otherwise the jump offset is applied relative to the current instruction pointer and `next`
+ * is cleared. If the branch is backward then `checkpoint` is set.
+ */
+static inline bool
+take_branch(
+    lyric_runtime::StackfulCoroutine *currentCoro,
+    const lyric_runtime::PredecodedOp *predecoded,
+    const lyric_object::OpCell &op,
+    const lyric_runtime::PredecodedOp *opsBegin,
+    const lyric_runtime::PredecodedOp *&next,
+    bool &checkpoint)
+{
+    // a backward branch may begin a loop, so the next instruction is a checkpoint
+    if (op.operands.jump_i16.jump < 0)
+        checkpoint = true;
+    if (predecoded != nullptr && predecoded->target != lyric_runtime::INVALID_ADDRESS_U32) {
+        next = predecoded->targetIndex != lyric_runtime::INVALID_ADDRESS_U32?
+            opsBegin + predecoded->targetIndex : nullptr;
+        return currentCoro->jumpIP(predecoded->target);
+    }
+    next = nullptr;
+    return currentCoro->moveIP(op.operands.jump_i16.jump);
+}
+
+/**
+ * Returns the predecoded op following `predecoded` at the specified `distance` in the stream, or nullptr
+ * if the end of the stream is reached.
+ */
+static inline const lyric_runtime::PredecodedOp *
+following_op(
+    const lyric_runtime::PredecodedOp *predecoded,
+    int distance,
+    const lyric_runtime::PredecodedOp *opsEnd)
+{
+    return distance < opsEnd - predecoded? predecoded + distance : nullptr;
+}
+
 tempo_utils::Result<lyric_runtime::Operand>
 lyric_runtime::BytecodeInterpreter::runSubinterpreter()
 {
@@ -70,6 +192,34 @@ lyric_runtime::BytecodeInterpreter::runSubinterpreter()
     if (locker.getRecursionDepth() > MAX_INTERPRETER_RECURSION)
         return InterpreterStatus::forCondition(InterpreterCondition::kExceededMaximumRecursion);
 
+    if (m_inspector != nullptr)
+        return runLoop<true>();
+    return runLoop<false>();
+}
+
+/**
+ * The interpreter loop. The loop is specialized on whether an inspector is attached, so that an
+ * uninspected interpreter does not test for the inspector hooks on every instruction.
+ *
+ * The time slice, the current task, and the call stack guard are only checked at checkpoints, which are
+ * the instructions after which control does not simply fall through to the next instruction in the same
+ * proc: taken backward branches, calls, traps, returns, and raises. Straight-line code between checkpoints
+ * always terminates, so checking only at checkpoints still guarantees that a long-running task is
+ * preempted, and the call stack guard can only be violated by an instruction which modifies the call stack.
+ *
+ * When dispatching from the predecoded instruction stream, each handler ends by fetching the following op
+ * and jumping directly to its handler (see DISPATCH_NEXT), so the loop top is only revisited at checkpoints,
+ * when an inspector is attached, or when the following op is not known in advance. The following op is the
+ * next op in the stream, or the op at the precomputed target index for a taken branch; instructions which
+ * transfer control any other way are checkpoints, and clear the following op so it is fetched again by
+ * instruction pointer.
+ *
+ * @tparam Inspected true if an inspector is attached, otherwise false.
+ */
+template <bool Inspected>
+tempo_utils::Result<lyric_runtime::Operand>
+lyric_runtime::BytecodeInterpreter::runLoop()
+{
     auto *segmentManager = m_state->segmentManager();
     auto *heapManager = m_state->heapManager();
     auto *subroutineManager = m_state->subroutineManager();
@@ -77,8 +227,120 @@ lyric_runtime::BytecodeInterpreter::runSubinterpreter()
     auto *typeManager = m_state->typeManager();
 
     auto *currentCoro = m_state->currentCoro();
-    TU_ASSERT (currentCoro != nullptr);
-    currentCoro->pushGuard();
+    const bool preemptible = m_quantum > 0 && m_recursionDepth == 1;
+
+    // if resuming a preempted or blocked run then the guard is already in place. note the current coro
+    // may be null if the run was blocked, in which case a ready task is selected at the first checkpoint.
+    if (m_resuming) {
+        m_resuming = false;
+    } else {
+        TU_ASSERT (currentCoro != nullptr);
+        currentCoro->pushGuard();
+    }
+
+    const bool predecodedDispatch = m_state->isPredecodedDispatchEnabled();
+
+#ifdef LYRIC_RUNTIME_COMPUTED_GOTO
+    // dispatch table for direct threading, the order of entries must match the order of lyric_object::Opcode
+    static const void *dispatchTable[] = {
+        &&dispatch_default,             // OP_UNKNOWN
+        &&dispatch_OP_NOOP,
+        &&dispatch_OP_UNDEF,
+        &&dispatch_OP_NIL,
+        &&dispatch_OP_TRUE,
+        &&dispatch_OP_FALSE,
+        &&dispatch_OP_I8,
+        &&dispatch_OP_I16,
+        &&dispatch_OP_I32,
+        &&dispatch_OP_I64,
+        &&dispatch_OP_U8,
+        &&dispatch_OP_U16,
+        &&dispatch_OP_U32,
+        &&dispatch_OP_U64,
+        &&dispatch_OP_F32,
+        &&dispatch_OP_F64,
+        &&dispatch_OP_C32,
+        &&dispatch_OP_BYTES,
+        &&dispatch_OP_STRING,
+        &&dispatch_default,             // OP_STATIC
+        &&dispatch_OP_SYNTHETIC,
+        &&dispatch_OP_DESCRIPTOR,
+        &&dispatch_OP_LOAD,
+        &&dispatch_OP_STORE,
+        &&dispatch_OP_VA_LOAD,
+        &&dispatch_OP_VA_SIZE,
+        &&dispatch_OP_POP,
+        &&dispatch_OP_DUP,
+        &&dispatch_OP_PICK,
+        &&dispatch_OP_DROP,
+        &&dispatch_OP_ADD,
+        &&dispatch_OP_SUB,
+        &&dispatch_OP_MUL,
+        &&dispatch_OP_DIV,
+        &&dispatch_OP_NEG,
+        &&dispatch_OP_CMP,
+        &&dispatch_OP_TYPE_CMP,
+        &&dispatch_OP_LOGICAL_AND,
+        &&dispatch_OP_LOGICAL_OR,
+        &&dispatch_OP_LOGICAL_NOT,
+        &&dispatch_OP_BITWISE_AND,
+        &&dispatch_OP_BITWISE_OR,
+        &&dispatch_OP_BITWISE_XOR,
+        &&dispatch_OP_BITWISE_NOT,
+        &&dispatch_OP_BITWISE_SHR,
+        &&dispatch_OP_BITWISE_SHL,
+        &&dispatch_OP_IF_NIL,
+        &&dispatch_OP_IF_NOTNIL,
+        &&dispatch_OP_IF_TRUE,
+        &&dispatch_OP_IF_FALSE,
+        &&dispatch_OP_IF_ZERO,
+        &&dispatch_OP_IF_NOTZERO,
+        &&dispatch_OP_IF_GT,
+        &&dispatch_OP_IF_GE,
+        &&dispatch_OP_IF_LT,
+        &&dispatch_OP_IF_LE,
+        &&dispatch_OP_JUMP,
+        &&dispatch_OP_TO_I8,
+        &&dispatch_OP_TO_I16,
+        &&dispatch_OP_TO_I32,
+        &&dispatch_OP_TO_I64,
+        &&dispatch_OP_TO_U8,
+        &&dispatch_OP_TO_U16,
+        &&dispatch_OP_TO_U32,
+        &&dispatch_OP_TO_U64,
+        &&dispatch_OP_TO_F32,
+        &&dispatch_OP_TO_F64,
+        &&dispatch_OP_IMPORT,
+        &&dispatch_OP_CALL_STATIC,
+        &&dispatch_OP_CALL_VIRTUAL,
+        &&dispatch_OP_CALL_STUB,
+        &&dispatch_OP_CALL_CONCEPT,
+        &&dispatch_OP_CALL_EXISTENTIAL,
+        &&dispatch_OP_TRAP,
+        &&dispatch_OP_RETURN,
+        &&dispatch_OP_RAISE,
+        &&dispatch_OP_NEW,
+        &&dispatch_OP_TYPE_OF,
+        &&dispatch_OP_INTERRUPT,
+        &&dispatch_OP_HALT,
+        &&dispatch_OP_ABORT,
+    };
+    static_assert(std::size(dispatchTable) == static_cast<std::size_t>(lyric_object::Opcode::LAST_),
+        "dispatch table does not match opcode enumeration");
+#endif
+
+    // the first instruction is always a checkpoint
+    bool checkpoint = true;
+
+    // the current instruction. if the instruction was fetched from the predecoded stream then predecoded
+    // points to it, opsBegin and opsEnd bound the stream of the current proc, and next is the op which
+    // follows the instruction if it is known in advance.
+    const lyric_object::OpCell *op = nullptr;
+    lyric_object::OpCell decoded;
+    const PredecodedOp *predecoded = nullptr;
+    const PredecodedOp *next = nullptr;
+    const PredecodedOp *opsBegin = nullptr;
+    const PredecodedOp *opsEnd = nullptr;
 
     for (;;) {
 
@@ -88,154 +350,293 @@ lyric_runtime::BytecodeInterpreter::runSubinterpreter()
         m_instructionCounter++;
         m_sliceCounter++;
 
-        // if time slice has been exceeded, then poll for events and schedule a new task
-        if (m_sliceCounter > TIME_SLICE) {
-            m_sliceCounter = 0;
-            for (int i = 0; i < FAST_POLL_ITERATIONS; i++) {
-                if (systemScheduler->poll())
-                    break;
+        // only check the time slice, the current task and the call stack guard at a checkpoint
+        if (checkpoint) [[unlikely]] {
+            checkpoint = false;
+            auto *checkpointCoro = currentCoro;
+
+            // if time slice has been exceeded, then poll for events and schedule a new task
+            if (m_sliceCounter > TIME_SLICE) {
+                m_sliceCounter = 0;
+                // perform a bounded step of garbage collection. this is only safe in the outermost interpreter,
+                // because a subinterpreter is invoked from native code which may hold operands that are not
+                // reachable from any root.
+                if (m_recursionDepth == 1) {
+                    auto status = heapManager->collectGarbageStep();
+                    if (status.notOk())
+                        return status;
+                }
+                for (int i = 0; i < FAST_POLL_ITERATIONS; i++) {
+                    if (systemScheduler->poll())
+                        break;
+                }
+                nextReady = systemScheduler->selectNextReady();
+                currentCoro = m_state->currentCoro();
+                // if running preemptibly and the quantum is exhausted then return control to the caller
+                if (preemptible && --m_slicesRemaining <= 0 && currentCoro != nullptr)
+                    return onYield(InterpreterYield::Preempted);
             }
-            nextReady = systemScheduler->selectNextReady();
-            currentCoro = m_state->currentCoro();
-        }
 
-        // block the interpreter polling for events until there is a ready task
-        if (currentCoro == nullptr) {
-            do {
-                // perform blocking poll. this may not block if there is a ready task available.
-                systemScheduler->blockingPoll();
+            // if running preemptibly then return control to the caller instead of blocking
+            if (preemptible && currentCoro == nullptr) {
+                systemScheduler->poll();
                 nextReady = systemScheduler->selectNextReady();
-            } while (nextReady == nullptr);
-            currentCoro = m_state->currentCoro();
-            TU_ASSERT (currentCoro != nullptr);
-        }
+                currentCoro = m_state->currentCoro();
+                if (currentCoro == nullptr) {
+                    if (systemScheduler->firstWaitingTask() == nullptr)
+                        return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+                            "no tasks are ready or waiting");
+                    return onYield(InterpreterYield::Blocked);
+                }
+            }
 
-        // if we switched tasks then process all attached promises
-        //if (nextReady) {
-        //    nextReady->adaptPromises(this, m_state.get());
-        //}
+            // block the interpreter polling for events until there is a ready task
+            if (currentCoro == nullptr) {
+                do {
+                    // perform blocking poll. this may not block if there is a ready task available.
+                    systemScheduler->blockingPoll();
+                    nextReady = systemScheduler->selectNextReady();
+                } while (nextReady == nullptr);
+                currentCoro = m_state->currentCoro();
+                TU_ASSERT (currentCoro != nullptr);
+            }
+
+            // if we switched tasks then process all attached promises
+            //if (nextReady) {
+            //    nextReady->adaptPromises(this, m_state.get());
+            //}
 
-        // ensure the guard invariant for the current call stack is not violated
-        if (!currentCoro->checkGuard())
-            return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
-                "stack invariant violation");
+            // ensure the guard invariant for the current call stack is not violated
+            if (!currentCoro->checkGuard())
+                return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+                    "stack invariant violation");
 
-        // read the next bytecode op
-        lyric_object::OpCell op;
-        bool iteratorExhausted = !currentCoro->nextOp(op);
-        if (iteratorExhausted)
-            return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
-                "no instruction available");
+            // if the task changed then the following op must be fetched by instruction pointer
+            if (currentCoro != checkpointCoro) {
+                next = nullptr;
+            }
+        }
+
+        // read the next bytecode op-> if predecoded dispatch is enabled then take the following op if it is
+        // known, otherwise fetch the op from the predecoded stream by instruction pointer, falling back to
+        // decoding the op if no predecoded op is available.
+        predecoded = nullptr;
+        if (predecodedDispatch) {
+            if (next != nullptr) {
+                predecoded = next;
+                currentCoro->jumpIP(predecoded->next);
+            } else if (currentCoro->nextPredecodedOp(predecoded)) {
+                auto ops = currentCoro->peekPredecoded()->getOps();
+                opsBegin = ops.data();
+                opsEnd = opsBegin + ops.size();
+            } else {
+                predecoded = nullptr;
+            }
+        }
+        if (predecoded != nullptr) {
+            op = &predecoded->op;
+            next = following_op(predecoded, 1, opsEnd);
+        } else {
+            next = nullptr;
+            bool iteratorExhausted = !currentCoro->nextOp(decoded);
+            if (iteratorExhausted)
+                return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+                    "no instruction available");
+            op = &decoded;
+        }
 
         // run inspector hook after processing op
-        if (m_inspector) {
-            auto status = m_inspector->beforeOp(op, this, m_state.get());
+        if constexpr (Inspected) {
+            auto status = m_inspector->beforeOp(*op, this, m_state.get());
             if (!status.isOk())
                 return status;
         }
 
-        switch (op.opcode) {
+        // if the predecoded op begins a superinstruction then execute the whole sequence at once. superinstructions
+        // are not used when an inspector is attached, because the inspector expects to observe each instruction.
+    dispatch_superinstruction:
+        if (!Inspected && predecoded != nullptr && predecoded->fused != Superinstruction::None) {
+            const auto &second = predecoded[1];
+            currentCoro->jumpIP(predecoded->fusedNext);
+            next = following_op(predecoded, 2, opsEnd);
+
+            switch (predecoded->fused) {
+
+                // push two locals from the current activation onto the stack
+                case Superinstruction::LoadLocalPair: {
+                    const CallCell *activation;
+                    ON_ERROR_IF_NOT_OK (currentCoro->peekCall(&activation));
+                    auto local1 = activation->getLocal(op->operands.flags_u8_address_u32.address);
+                    auto local2 = activation->getLocal(second.op.operands.flags_u8_address_u32.address);
+                    ON_ERROR_IF_NOT_OK (currentCoro->pushData(local1));
+                    ON_ERROR_IF_NOT_OK (currentCoro->pushData(local2));
+                    break;
+                }
+
+                // pop 2 values from the stack and compare them, and jump to offset if the comparison holds
+                case Superinstruction::CompareBranch: {
+                    Operand lhs, rhs, cmp;
+                    ON_ERROR_IF_NOT_OK (currentCoro->popData(rhs));
+                    ON_ERROR_IF_NOT_OK (currentCoro->popData(lhs));
+                    ON_ERROR_IF_NOT_OK (internal::compare(lhs, rhs, cmp));
+                    tu_int64 result;
+                    cmp.getI64(result);
+                    bool taken;
+                    switch (second.op.opcode) {
+                        case lyric_object::Opcode::OP_IF_ZERO:
+                            taken = result == 0;
+                            break;
+                        case lyric_object::Opcode::OP_IF_NOTZERO:
+                            taken = result != 0;
+                            break;
+                        case lyric_object::Opcode::OP_IF_GT:
+                            taken = result > 0;
+                            break;
+                        case lyric_object::Opcode::OP_IF_GE:
+                            taken = result >= 0;
+                            break;
+                        case lyric_object::Opcode::OP_IF_LT:
+                            taken = result < 0;
+                            break;
+                        case lyric_object::Opcode::OP_IF_LE:
+                            taken = result <= 0;
+                            break;
+                        default:
+                            return onError(second.op, InterpreterStatus::forCondition(
+                                InterpreterCondition::kRuntimeInvariant, "invalid superinstruction"));
+                    }
+                    if (taken && !take_branch(currentCoro, &second, second.op, opsBegin, next, checkpoint))
+                        return onError(second.op, InterpreterStatus::forCondition(
+                            InterpreterCondition::kInvalidOperandJumpV1, "invalid jump offset"));
+                    break;
+                }
+
+                // store the top value on the stack in a local of the current activation without popping it
+                case Superinstruction::DupStoreLocal: {
+                    CallCell *activation;
+                    Operand value;
+                    ON_ERROR_IF_NOT_OK (currentCoro->peekCall(&activation));
+                    ON_ERROR_IF_NOT_OK (currentCoro->peekData(value));
+                    activation->setLocal(second.op.operands.flags_u8_address_u32.address, value);
+                    break;
+                }
+
+                default:
+                    return onError(*op, InterpreterStatus::forCondition(
+                        InterpreterCondition::kRuntimeInvariant, "invalid superinstruction"));
+            }
+            DISPATCH_NEXT();
+        }
+
+#ifdef LYRIC_RUNTIME_COMPUTED_GOTO
+        // jump directly to the handler for the predecoded op, bypassing the range check of the switch
+        if (predecoded != nullptr && op->opcode < lyric_object::Opcode::LAST_)
+            goto *dispatchTable[static_cast<tu_uint8>(op->opcode)];
+#endif
+
+    dispatch_switch:
+        switch (op->opcode) {
 
             // no operation, continue to next instruction
-            case lyric_object::Opcode::OP_NOOP:
-                break;
+            DISPATCH_CASE(OP_NOOP):
+                DISPATCH_NEXT();
 
             // push undef value onto the stack
-            case lyric_object::Opcode::OP_UNDEF:
+            DISPATCH_CASE(OP_UNDEF):
                 currentCoro->pushData(Operand::undef());
-                break;
+                DISPATCH_NEXT();
 
             // push nil value onto the stack
-            case lyric_object::Opcode::OP_NIL:
+            DISPATCH_CASE(OP_NIL):
                 currentCoro->pushData(Operand::nil());
-                break;
+                DISPATCH_NEXT();
 
             // push true value onto the stack
-            case lyric_object::Opcode::OP_TRUE:
+            DISPATCH_CASE(OP_TRUE):
                 currentCoro->pushData(Operand::fromBool(true));
-                break;
+                DISPATCH_NEXT();
 
             // push false value onto the stack
-            case lyric_object::Opcode::OP_FALSE:
+            DISPATCH_CASE(OP_FALSE):
                 currentCoro->pushData(Operand::fromBool(false));
-                break;
+                DISPATCH_NEXT();
 
             // push i8 value onto the stack
-            case lyric_object::Opcode::OP_I8:
-                currentCoro->pushData(Operand::fromI8(op.operands.immediate_i8.i8));
-                break;
+            DISPATCH_CASE(OP_I8):
+                currentCoro->pushData(Operand::fromI8(op->operands.immediate_i8.i8));
+                DISPATCH_NEXT();
 
             // push i16 value onto the stack
-            case lyric_object::Opcode::OP_I16:
-                currentCoro->pushData(Operand::fromI16(op.operands.immediate_i16.i16));
-                break;
+            DISPATCH_CASE(OP_I16):
+                currentCoro->pushData(Operand::fromI16(op->operands.immediate_i16.i16));
+                DISPATCH_NEXT();
 
             // push i32 value onto the stack
-            case lyric_object::Opcode::OP_I32:
-                currentCoro->pushData(Operand::fromI32(op.operands.immediate_i32.i32));
-                break;
+            DISPATCH_CASE(OP_I32):
+                currentCoro->pushData(Operand::fromI32(op->operands.immediate_i32.i32));
+                DISPATCH_NEXT();
 
             // push i64 value onto the stack
-            case lyric_object::Opcode::OP_I64:
-                currentCoro->pushData(Operand::fromI64(op.operands.immediate_i64.i64));
-                break;
+            DISPATCH_CASE(OP_I64):
+                currentCoro->pushData(Operand::fromI64(op->operands.immediate_i64.i64));
+                DISPATCH_NEXT();
 
             // push u8 value onto the stack
-            case lyric_object::Opcode::OP_U8:
-                currentCoro->pushData(Operand::fromU8(op.operands.immediate_u8.u8));
-                break;
+            DISPATCH_CASE(OP_U8):
+                currentCoro->pushData(Operand::fromU8(op->operands.immediate_u8.u8));
+                DISPATCH_NEXT();
 
             // push u16 value onto the stack
-            case lyric_object::Opcode::OP_U16:
-                currentCoro->pushData(Operand::fromU16(op.operands.immediate_u16.u16));
-                break;
+            DISPATCH_CASE(OP_U16):
+                currentCoro->pushData(Operand::fromU16(op->operands.immediate_u16.u16));
+                DISPATCH_NEXT();
 
             // push u32 value onto the stack
-            case lyric_object::Opcode::OP_U32:
-                currentCoro->pushData(Operand::fromU32(op.operands.immediate_u32.u32));
-                break;
+            DISPATCH_CASE(OP_U32):
+                currentCoro->pushData(Operand::fromU32(op->operands.immediate_u32.u32));
+                DISPATCH_NEXT();
 
             // push u64 value onto the stack
-            case lyric_object::Opcode::OP_U64:
-                currentCoro->pushData(Operand::fromU64(op.operands.immediate_u64.u64));
-                break;
+            DISPATCH_CASE(OP_U64):
+                currentCoro->pushData(Operand::fromU64(op->operands.immediate_u64.u64));
+                DISPATCH_NEXT();
 
             // push f32 value onto the stack
-            case lyric_object::Opcode::OP_F32:
-                currentCoro->pushData(Operand::fromF32(op.operands.immediate_f32.f32));
-                break;
+            DISPATCH_CASE(OP_F32):
+                currentCoro->pushData(Operand::fromF32(op->operands.immediate_f32.f32));
+                DISPATCH_NEXT();
 
             // push f64 value onto the stack
-            case lyric_object::Opcode::OP_F64:
-                currentCoro->pushData(Operand::fromF64(op.operands.immediate_f64.f64));
-                break;
+            DISPATCH_CASE(OP_F64):
+                currentCoro->pushData(Operand::fromF64(op->operands.immediate_f64.f64));
+                DISPATCH_NEXT();
 
             // push c32 value onto the stack
-            case lyric_object::Opcode::OP_C32:
-                currentCoro->pushData(Operand::fromC32(op.operands.immediate_c32.c32));
-                break;
+            DISPATCH_CASE(OP_C32):
+                currentCoro->pushData(Operand::fromC32(op->operands.immediate_c32.c32));
+                DISPATCH_NEXT();
 
             // push bytes ref onto the stack
-            case lyric_object::Opcode::OP_BYTES: {
-                auto status = heapManager->loadLiteralBytesOntoStack(op.operands.address_u32.address);
+            DISPATCH_CASE(OP_BYTES): {
+                auto status = heapManager->loadLiteralBytesOntoStack(op->operands.address_u32.address);
                 if (status.notOk())
-                    return onError(op, status);
-                break;
+                    return onError(*op, status);
+                DISPATCH_NEXT();
             }
 
             // push string ref onto the stack
-            case lyric_object::Opcode::OP_STRING: {
-                auto status = heapManager->loadLiteralStringOntoStack(op.operands.address_u32.address);
+            DISPATCH_CASE(OP_STRING): {
+                auto status = heapManager->loadLiteralStringOntoStack(op->operands.address_u32.address);
                 if (status.notOk())
-                    return onError(op, status);
-                break;
+                    return onError(*op, status);
+                DISPATCH_NEXT();
             }
 
             // push synthetic onto the stack
-            case lyric_object::Opcode::OP_SYNTHETIC: {
+            DISPATCH_CASE(OP_SYNTHETIC): {
                 const CallCell *activation;
                 ON_ERROR_IF_NOT_OK (currentCoro->peekCall(&activation));
-                auto synthetic = op.operands.type_u8.type;
+                auto synthetic = op->operands.type_u8.type;
                 switch (synthetic) {
                     case lyric_object::SYNTHETIC_THIS: {
                         auto receiver = activation->getReceiver();
@@ -248,170 +649,170 @@ lyric_runtime::BytecodeInterpreter::runSubinterpreter()
                         break;
                     }
                     default:
-                        return onError(op, InterpreterStatus::forCondition(
+                        return onError(*op, InterpreterStatus::forCondition(
                             InterpreterCondition::kInvalidOperandTypeV1, "unknown SYNTHETIC type"));
                 }
-                break;
+                DISPATCH_NEXT();
             }
 
             // push descriptor value onto the stack
-            case lyric_object::Opcode::OP_DESCRIPTOR: {
-                auto section = op.operands.flags_u8_address_u32.flags;
-                auto address = op.operands.flags_u8_address_u32.address;
+            DISPATCH_CASE(OP_DESCRIPTOR): {
+                auto section = op->operands.flags_u8_address_u32.flags;
+                auto address = op->operands.flags_u8_address_u32.address;
                 auto status = segmentManager->pushDescriptorOntoStack(
                     currentCoro->peekSP(), section, address, currentCoro);
                 if (status.notOk())
-                    return onError(op, status);
-                break;
+                    return onError(*op, status);
+                DISPATCH_NEXT();
             }
 
             // load a value from the current activation frame and push it onto the stack
-            case lyric_object::Opcode::OP_LOAD: {
-                auto address = op.operands.flags_u8_address_u32.address;
-                auto flags = op.operands.flags_u8_address_u32.flags;
+            DISPATCH_CASE(OP_LOAD): {
+                auto address = op->operands.flags_u8_address_u32.address;
+                auto flags = op->operands.flags_u8_address_u32.flags;
                 ON_ERROR_IF_NOT_OK (internal::load(
                     currentCoro, segmentManager, subroutineManager, heapManager, m_state.get(), this, address, flags));
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop value from the stack and store it in the current activation frame
-            case lyric_object::Opcode::OP_STORE: {
-                auto address = op.operands.flags_u8_address_u32.address;
-                auto flags = op.operands.flags_u8_address_u32.flags;
+            DISPATCH_CASE(OP_STORE): {
+                auto address = op->operands.flags_u8_address_u32.address;
+                auto flags = op->operands.flags_u8_address_u32.flags;
                 ON_ERROR_IF_NOT_OK (internal::store(currentCoro, segmentManager, address, flags));
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop index from the stack and push variadic argument in the current activation onto the top of the stack
-            case lyric_object::Opcode::OP_VA_LOAD: {
+            DISPATCH_CASE(OP_VA_LOAD): {
                 CallCell *activation;
                 Operand load;
                 tu_int64 offset;
                 ON_ERROR_IF_NOT_OK (currentCoro->peekCall(&activation));
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(load));
                 if (!load.getI64(offset))
-                    return onError(op, InterpreterStatus::forCondition(
+                    return onError(*op, InterpreterStatus::forCondition(
                         InterpreterCondition::kInvalidDataStackV1, "invalid offset"));
                 if (activation->numRest() <= offset)
-                    return onError(op, InterpreterStatus::forCondition(
+                    return onError(*op, InterpreterStatus::forCondition(
                         InterpreterCondition::kInvalidDataStackV1, "offset is out of range"));
                 auto rest = activation->getRest(offset);
                 ON_ERROR_IF_NOT_OK (currentCoro->pushData(rest));
-                break;
+                DISPATCH_NEXT();
             }
 
             // push count of the variadic arguments in the current activation onto the top of the stack
-            case lyric_object::Opcode::OP_VA_SIZE: {
+            DISPATCH_CASE(OP_VA_SIZE): {
                 CallCell *activation;
                 ON_ERROR_IF_NOT_OK (currentCoro->peekCall(&activation));
                 auto size = Operand::fromI64(activation->numRest());
                 ON_ERROR_IF_NOT_OK (currentCoro->pushData(size));
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop value from the stack and discard it
-            case lyric_object::Opcode::OP_POP: {
+            DISPATCH_CASE(OP_POP): {
                 ON_ERROR_IF_NOT_OK (currentCoro->dropData());
-                break;
+                DISPATCH_NEXT();
             }
 
             // duplicate top value on the stack and push it onto the top of the stack
-            case lyric_object::Opcode::OP_DUP: {
+            DISPATCH_CASE(OP_DUP): {
                 Operand value;
                 ON_ERROR_IF_NOT_OK (currentCoro->peekData(value));
                 ON_ERROR_IF_NOT_OK (currentCoro->pushData(value));
-                break;
+                DISPATCH_NEXT();
             }
 
             // duplicate the picked value on the stack and push onto the top of the stack
-            case lyric_object::Opcode::OP_PICK: {
-                auto offset = op.operands.offset_u16.offset;
+            DISPATCH_CASE(OP_PICK): {
+                auto offset = op->operands.offset_u16.offset;
                 Operand value;
                 ON_ERROR_IF_NOT_OK (currentCoro->peekData(value, offset));
                 ON_ERROR_IF_NOT_OK (currentCoro->pushData(value));
-                break;
+                DISPATCH_NEXT();
             }
 
             // remove the value at the specified offset from the stack
-            case lyric_object::Opcode::OP_DROP: {
-                auto offset = op.operands.offset_u16.offset;
+            DISPATCH_CASE(OP_DROP): {
+                auto offset = op->operands.offset_u16.offset;
                 ON_ERROR_IF_NOT_OK (currentCoro->dropData(offset));
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop 2 numeric values from the stack and add them, and push result onto the stack
-            case lyric_object::Opcode::OP_ADD: {
+            DISPATCH_CASE(OP_ADD): {
                 Operand lhs, rhs, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(rhs));
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(lhs));
                 ON_ERROR_IF_NOT_OK (internal::add(heapManager, lhs, rhs, result));
                 ON_ERROR_IF_NOT_OK (currentCoro->pushData(result));
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop 2 numeric values from the stack and subtract them, and push result onto the stack
-            case lyric_object::Opcode::OP_SUB: {
+            DISPATCH_CASE(OP_SUB): {
                 Operand lhs, rhs, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(rhs));
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(lhs));
                 ON_ERROR_IF_NOT_OK (internal::sub(heapManager, lhs, rhs, result));
                 ON_ERROR_IF_NOT_OK (currentCoro->pushData(result));
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop 2 numeric values from the stack and multiply them, and push result onto the stack
-            case lyric_object::Opcode::OP_MUL: {
+            DISPATCH_CASE(OP_MUL): {
                 Operand lhs, rhs, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(rhs));
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(lhs));
                 ON_ERROR_IF_NOT_OK (internal::mul(heapManager, lhs, rhs, result));
                 ON_ERROR_IF_NOT_OK (currentCoro->pushData(result));
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop 2 numeric values from the stack and divide them, and push result onto the stack
-            case lyric_object::Opcode::OP_DIV: {
+            DISPATCH_CASE(OP_DIV): {
                 Operand lhs, rhs, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(rhs));
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(lhs));
                 ON_ERROR_IF_NOT_OK (internal::div(heapManager, lhs, rhs, result));
                 ON_ERROR_IF_NOT_OK (currentCoro->pushData(result));
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop 1 numeric value from the stack and negate it, and push result onto the stack
-            case lyric_object::Opcode::OP_NEG: {
+            DISPATCH_CASE(OP_NEG): {
                 Operand element, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(element));
                 ON_ERROR_IF_NOT_OK (internal::neg(heapManager, element, result));
                 ON_ERROR_IF_NOT_OK (currentCoro->pushData(result));
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop 2 values from the stack and compare them, and push result onto the stack
-            case lyric_object::Opcode::OP_CMP: {
+            DISPATCH_CASE(OP_CMP): {
                 Operand lhs, rhs, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(rhs));
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(lhs));
                 ON_ERROR_IF_NOT_OK (internal::compare(lhs, rhs, result));
                 ON_ERROR_IF_NOT_OK (currentCoro->pushData(result));
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop two type descriptors from the stack and compare them, and push result onto the stack
-            case lyric_object::Opcode::OP_TYPE_CMP: {
+            DISPATCH_CASE(OP_TYPE_CMP): {
                 Operand lhs, rhs;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(rhs));
                 if (rhs.getType() != OperandType::Type)
-                    return onError(op, InterpreterStatus::forCondition(
+                    return onError(*op, InterpreterStatus::forCondition(
                         InterpreterCondition::kInvalidDataStackV2, "wrong type for rhs"));
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(lhs));
                 if (lhs.getType() != OperandType::Type)
-                    return onError(op, InterpreterStatus::forCondition(
+                    return onError(*op, InterpreterStatus::forCondition(
                         InterpreterCondition::kInvalidDataStackV1, "wrong type for lhs"));
                 auto compareTypesResult = typeManager->compareTypes(lhs, rhs);
                 if (compareTypesResult.isStatus())
-                    return onError(op, compareTypesResult.getStatus());
+                    return onError(*op, compareTypesResult.getStatus());
                 tu_int64 result;
                 switch (compareTypesResult.getResult()) {
                     case TypeComparison::EXTENDS:
@@ -426,281 +827,281 @@ lyric_runtime::BytecodeInterpreter::runSubinterpreter()
                         break;
                 }
                 ON_ERROR_IF_NOT_OK (currentCoro->pushData(Operand::fromI64(result)));
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop 2 bool values from the stack and perform logical AND, and push result onto the stack
-            case lyric_object::Opcode::OP_LOGICAL_AND: {
+            DISPATCH_CASE(OP_LOGICAL_AND): {
                 Operand lhs, rhs;
                 bool l, r;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(rhs));
                 if (!rhs.getBool(r))
-                    return onError(op, InterpreterStatus::forCondition(
+                    return onError(*op, InterpreterStatus::forCondition(
                         InterpreterCondition::kInvalidDataStackV2, "wrong type for rhs"));
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(lhs));
                 if (!lhs.getBool(l))
-                    return onError(op, InterpreterStatus::forCondition(
+                    return onError(*op, InterpreterStatus::forCondition(
                         InterpreterCondition::kInvalidDataStackV1, "wrong type for lhs"));
                 bool result = l && r;
                 ON_ERROR_IF_NOT_OK (currentCoro->pushData(Operand::fromBool(result)));
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop 2 bool values from the stack and perform logical OR, and push result onto the stack
-            case lyric_object::Opcode::OP_LOGICAL_OR: {
+            DISPATCH_CASE(OP_LOGICAL_OR): {
                 Operand lhs, rhs;
                 bool l, r;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(rhs));
                 if (!rhs.getBool(r))
-                    return onError(op, InterpreterStatus::forCondition(
+                    return onError(*op, InterpreterStatus::forCondition(
                         InterpreterCondition::kInvalidDataStackV2, "wrong type for rhs"));
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(lhs));
                 if (!lhs.getBool(l))
-                    return onError(op, InterpreterStatus::forCondition(
+                    return onError(*op, InterpreterStatus::forCondition(
                         InterpreterCondition::kInvalidDataStackV1, "wrong type for lhs"));
                 bool result = l || r;
                 ON_ERROR_IF_NOT_OK (currentCoro->pushData(Operand::fromBool(result)));
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop 1 bool value from the stack and perform logical NOT, and push result onto the stack
-            case lyric_object::Opcode::OP_LOGICAL_NOT: {
+            DISPATCH_CASE(OP_LOGICAL_NOT): {
                 Operand element;
                 bool e;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(element));
                 if (!element.getBool(e))
-                    return onError(op, InterpreterStatus::forCondition(
+                    return onError(*op, InterpreterStatus::forCondition(
                         InterpreterCondition::kInvalidDataStackV1, "wrong type for value"));
                 bool result = !e;
                 ON_ERROR_IF_NOT_OK (currentCoro->pushData(Operand::fromBool(result)));
-                break;
+                DISPATCH_NEXT();
             }
 
-            case lyric_object::Opcode::OP_BITWISE_AND: {
+            DISPATCH_CASE(OP_BITWISE_AND): {
                 Operand lhs, rhs, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(rhs));
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(lhs));
                 ON_ERROR_IF_NOT_OK (internal::bitwise_and(heapManager, lhs, rhs, result));
                 ON_ERROR_IF_NOT_OK (currentCoro->pushData(result));
-                break;
+                DISPATCH_NEXT();
             }
 
-            case lyric_object::Opcode::OP_BITWISE_OR: {
+            DISPATCH_CASE(OP_BITWISE_OR): {
                 Operand lhs, rhs, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(rhs));
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(lhs));
                 ON_ERROR_IF_NOT_OK (internal::bitwise_or(heapManager, lhs, rhs, result));
                 ON_ERROR_IF_NOT_OK (currentCoro->pushData(result));
-                break;
+                DISPATCH_NEXT();
             }
 
-            case lyric_object::Opcode::OP_BITWISE_XOR: {
+            DISPATCH_CASE(OP_BITWISE_XOR): {
                 Operand lhs, rhs, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(rhs));
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(lhs));
                 ON_ERROR_IF_NOT_OK (internal::bitwise_xor(heapManager, lhs, rhs, result));
                 ON_ERROR_IF_NOT_OK (currentCoro->pushData(result));
-                break;
+                DISPATCH_NEXT();
             }
 
-            case lyric_object::Opcode::OP_BITWISE_NOT: {
+            DISPATCH_CASE(OP_BITWISE_NOT): {
                 Operand element, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(element));
                 ON_ERROR_IF_NOT_OK (internal::bitwise_not(heapManager, element, result));
                 ON_ERROR_IF_NOT_OK (currentCoro->pushData(result));
-                break;
+                DISPATCH_NEXT();
             }
 
-            case lyric_object::Opcode::OP_BITWISE_SHR: {
+            DISPATCH_CASE(OP_BITWISE_SHR): {
                 Operand element, count, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(count));
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(element));
                 ON_ERROR_IF_NOT_OK (internal::bitwise_shr(heapManager, element, count, result));
                 ON_ERROR_IF_NOT_OK (currentCoro->pushData(result));
-                break;
+                DISPATCH_NEXT();
             }
 
-            case lyric_object::Opcode::OP_BITWISE_SHL: {
+            DISPATCH_CASE(OP_BITWISE_SHL): {
                 Operand element, count, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(count));
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(element));
                 ON_ERROR_IF_NOT_OK (internal::bitwise_shl(heapManager, element, count, result));
                 ON_ERROR_IF_NOT_OK (currentCoro->pushData(result));
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop value from stack, and jump unconditionally
-            case lyric_object::Opcode::OP_JUMP: {
-                auto delta = op.operands.jump_i16.jump;
-                if (!currentCoro->moveIP(delta))
-                    return onError(op, InterpreterStatus::forCondition(
+            DISPATCH_CASE(OP_JUMP): {
+                auto delta = op->operands.jump_i16.jump;
+                if (!take_branch(currentCoro, predecoded, *op, opsBegin, next, checkpoint))
+                    return onError(*op, InterpreterStatus::forCondition(
                         InterpreterCondition::kInvalidOperandJumpV1, "invalid jump offset"));
                 TU_LOG_V << "moved ip " << delta << " bytes to " << currentCoro->peekIP();
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop value from stack, and jump to offset if value is Nil
-            case lyric_object::Opcode::OP_IF_NIL: {
+            DISPATCH_CASE(OP_IF_NIL): {
                 Operand cmp;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(cmp));
                 if (cmp.isNil()) {
-                    auto delta = op.operands.jump_i16.jump;
-                    if (!currentCoro->moveIP(delta))
-                        return onError(op, InterpreterStatus::forCondition(
+                    auto delta = op->operands.jump_i16.jump;
+                    if (!take_branch(currentCoro, predecoded, *op, opsBegin, next, checkpoint))
+                        return onError(*op, InterpreterStatus::forCondition(
                             InterpreterCondition::kInvalidOperandJumpV1, "invalid jump offset"));
                     TU_LOG_V << "moved ip " << delta << " bytes to " << currentCoro->peekIP();
                 }
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop value from stack, and jump to offset if value is not Nil
-            case lyric_object::Opcode::OP_IF_NOTNIL: {
+            DISPATCH_CASE(OP_IF_NOTNIL): {
                 Operand cmp;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(cmp));
                 if (!cmp.isNil()) {
-                    auto delta = op.operands.jump_i16.jump;
-                    if (!currentCoro->moveIP(delta))
-                        return onError(op, InterpreterStatus::forCondition(
+                    auto delta = op->operands.jump_i16.jump;
+                    if (!take_branch(currentCoro, predecoded, *op, opsBegin, next, checkpoint))
+                        return onError(*op, InterpreterStatus::forCondition(
                             InterpreterCondition::kInvalidOperandJumpV1, "invalid jump offset"));
                     TU_LOG_V << "moved ip " << delta << " bytes to " << currentCoro->peekIP();
                 }
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop value from stack, and jump to offset if value is zero
-            case lyric_object::Opcode::OP_IF_TRUE: {
+            DISPATCH_CASE(OP_IF_TRUE): {
                 Operand cmp;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(cmp));
                 bool b;
                 if (!cmp.getBool(b))
-                    return onError(op, InterpreterStatus::forCondition(
+                    return onError(*op, InterpreterStatus::forCondition(
                         InterpreterCondition::kInvalidDataStackV1, "value must be a boolean"));
                 if (b) {
-                    auto delta = op.operands.jump_i16.jump;
-                    if (!currentCoro->moveIP(delta))
-                        return onError(op, InterpreterStatus::forCondition(
+                    auto delta = op->operands.jump_i16.jump;
+                    if (!take_branch(currentCoro, predecoded, *op, opsBegin, next, checkpoint))
+                        return onError(*op, InterpreterStatus::forCondition(
                             InterpreterCondition::kInvalidOperandJumpV1, "invalid jump offset"));
                     TU_LOG_V << "moved ip " << delta << " bytes to " << currentCoro->peekIP();
                 }
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop value from stack, and jump to offset if value is not zero
-            case lyric_object::Opcode::OP_IF_FALSE: {
+            DISPATCH_CASE(OP_IF_FALSE): {
                 Operand cmp;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(cmp));
                 bool b;
                 if (!cmp.getBool(b))
-                    return onError(op, InterpreterStatus::forCondition(
+                    return onError(*op, InterpreterStatus::forCondition(
                         InterpreterCondition::kInvalidDataStackV1, "value must be a boolean"));
                 if (!b) {
-                    auto delta = op.operands.jump_i16.jump;
-                    if (!currentCoro->moveIP(delta))
-                        return onError(op, InterpreterStatus::forCondition(
+                    auto delta = op->operands.jump_i16.jump;
+                    if (!take_branch(currentCoro, predecoded, *op, opsBegin, next, checkpoint))
+                        return onError(*op, InterpreterStatus::forCondition(
                             InterpreterCondition::kInvalidOperandJumpV1, "invalid jump offset"));
                     TU_LOG_V << "moved ip " << delta << " bytes to " << currentCoro->peekIP();
                 }
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop value from stack, and jump to offset if value is zero
-            case lyric_object::Opcode::OP_IF_ZERO: {
+            DISPATCH_CASE(OP_IF_ZERO): {
                 Operand cmp;
                 bool result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(cmp));
                 ON_ERROR_IF_NOT_OK (internal::is_zero(cmp, result));
                 if (result) {
-                    auto delta = op.operands.jump_i16.jump;
-                    if (!currentCoro->moveIP(delta))
-                        return onError(op, InterpreterStatus::forCondition(
+                    auto delta = op->operands.jump_i16.jump;
+                    if (!take_branch(currentCoro, predecoded, *op, opsBegin, next, checkpoint))
+                        return onError(*op, InterpreterStatus::forCondition(
                             InterpreterCondition::kInvalidOperandJumpV1, "invalid jump offset"));
                     TU_LOG_V << "moved ip " << delta << " bytes to " << currentCoro->peekIP();
                 }
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop value from stack, and jump to offset if value is not zero
-            case lyric_object::Opcode::OP_IF_NOTZERO: {
+            DISPATCH_CASE(OP_IF_NOTZERO): {
                 Operand cmp;
                 bool result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(cmp));
                 ON_ERROR_IF_NOT_OK (internal::is_not_zero(cmp, result));
                 if (result) {
-                    auto delta = op.operands.jump_i16.jump;
-                    if (!currentCoro->moveIP(delta))
-                        return onError(op, InterpreterStatus::forCondition(
+                    auto delta = op->operands.jump_i16.jump;
+                    if (!take_branch(currentCoro, predecoded, *op, opsBegin, next, checkpoint))
+                        return onError(*op, InterpreterStatus::forCondition(
                             InterpreterCondition::kInvalidOperandJumpV1, "invalid jump offset"));
                     TU_LOG_V << "moved ip " << delta << " bytes to " << currentCoro->peekIP();
                 }
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop value from stack, and jump to offset if value is less than zero
-            case lyric_object::Opcode::OP_IF_LT: {
+            DISPATCH_CASE(OP_IF_LT): {
                 Operand cmp;
                 bool result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(cmp));
                 ON_ERROR_IF_NOT_OK (internal::is_less_than(cmp, result));
                 if (result) {
-                    auto delta = op.operands.jump_i16.jump;
-                    if (!currentCoro->moveIP(delta))
-                        return onError(op, InterpreterStatus::forCondition(
+                    auto delta = op->operands.jump_i16.jump;
+                    if (!take_branch(currentCoro, predecoded, *op, opsBegin, next, checkpoint))
+                        return onError(*op, InterpreterStatus::forCondition(
                             InterpreterCondition::kInvalidOperandJumpV1, "invalid jump offset"));
                     TU_LOG_V << "moved ip " << delta << " bytes to " << currentCoro->peekIP();
                 }
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop value from stack, and jump to offset if value is less than or equal to zero
-            case lyric_object::Opcode::OP_IF_LE: {
+            DISPATCH_CASE(OP_IF_LE): {
                 Operand cmp;
                 bool result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(cmp));
                 ON_ERROR_IF_NOT_OK (internal::is_less_or_equal(cmp, result));
                 if (result) {
-                    auto delta = op.operands.jump_i16.jump;
-                    if (!currentCoro->moveIP(delta))
-                        return onError(op, InterpreterStatus::forCondition(
+                    auto delta = op->operands.jump_i16.jump;
+                    if (!take_branch(currentCoro, predecoded, *op, opsBegin, next, checkpoint))
+                        return onError(*op, InterpreterStatus::forCondition(
                             InterpreterCondition::kInvalidOperandJumpV1, "invalid jump offset"));
                     TU_LOG_V << "moved ip " << delta << " bytes to " << currentCoro->peekIP();
                 }
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop value from stack, and jump to offset if value is greater than zero
-            case lyric_object::Opcode::OP_IF_GT: {
+            DISPATCH_CASE(OP_IF_GT): {
                 Operand cmp;
                 bool result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(cmp));
                 ON_ERROR_IF_NOT_OK (internal::is_greater_than(cmp, result));
                 if (result) {
-                    auto delta = op.operands.jump_i16.jump;
-                    if (!currentCoro->moveIP(delta))
-                        return onError(op, InterpreterStatus::forCondition(
+                    auto delta = op->operands.jump_i16.jump;
+                    if (!take_branch(currentCoro, predecoded, *op, opsBegin, next, checkpoint))
+                        return onError(*op, InterpreterStatus::forCondition(
                             InterpreterCondition::kInvalidOperandJumpV1, "invalid jump offset"));
                     TU_LOG_V << "moved ip " << delta << " bytes to " << currentCoro->peekIP();
                 }
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop value from stack, and jump to offset if value is greater than or equal o zero
-            case lyric_object::Opcode::OP_IF_GE: {
+            DISPATCH_CASE(OP_IF_GE): {
                 Operand cmp;
                 bool result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(cmp));
                 ON_ERROR_IF_NOT_OK (internal::is_greater_or_equal(cmp, result));
                 if (result) {
-                    auto delta = op.operands.jump_i16.jump;
-                    if (!currentCoro->moveIP(delta))
-                        return onError(op, InterpreterStatus::forCondition(
+                    auto delta = op->operands.jump_i16.jump;
+                    if (!take_branch(currentCoro, predecoded, *op, opsBegin, next, checkpoint))
+                        return onError(*op, InterpreterStatus::forCondition(
                             InterpreterCondition::kInvalidOperandJumpV1, "invalid jump offset"));
                     TU_LOG_V << "moved ip " << delta << " bytes to " << currentCoro->peekIP();
                 }
-                break;
+                DISPATCH_NEXT();
             }
 
             // pop value from stack and convert its representation to I8
-            case lyric_object::Opcode::OP_TO_I8: {
+            DISPATCH_CASE(OP_TO_I8): {
                 Operand source, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(source));
                 ON_ERROR_IF_NOT_OK (internal::convert_to_I8(heapManager, source, result));
@@ -708,7 +1109,7 @@ lyric_runtime::BytecodeInterpreter::runSubinterpreter()
             }
 
             // pop value from stack and convert its representation to I16
-            case lyric_object::Opcode::OP_TO_I16: {
+            DISPATCH_CASE(OP_TO_I16): {
                 Operand source, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(source));
                 ON_ERROR_IF_NOT_OK (internal::convert_to_I16(heapManager, source, result));
@@ -716,7 +1117,7 @@ lyric_runtime::BytecodeInterpreter::runSubinterpreter()
             }
 
             // pop value from stack and convert its representation to I32
-            case lyric_object::Opcode::OP_TO_I32: {
+            DISPATCH_CASE(OP_TO_I32): {
                 Operand source, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(source));
                 ON_ERROR_IF_NOT_OK (internal::convert_to_I32(heapManager, source, result));
@@ -724,7 +1125,7 @@ lyric_runtime::BytecodeInterpreter::runSubinterpreter()
             }
 
             // pop value from stack and convert its representation to I64
-            case lyric_object::Opcode::OP_TO_I64: {
+            DISPATCH_CASE(OP_TO_I64): {
                 Operand source, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(source));
                 ON_ERROR_IF_NOT_OK (internal::convert_to_I64(heapManager, source, result));
@@ -732,7 +1133,7 @@ lyric_runtime::BytecodeInterpreter::runSubinterpreter()
             }
 
             // pop value from stack and convert its representation to U8
-            case lyric_object::Opcode::OP_TO_U8: {
+            DISPATCH_CASE(OP_TO_U8): {
                 Operand source, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(source));
                 ON_ERROR_IF_NOT_OK (internal::convert_to_U8(heapManager, source, result));
@@ -740,7 +1141,7 @@ lyric_runtime::BytecodeInterpreter::runSubinterpreter()
             }
 
             // pop value from stack and convert its representation to U16
-            case lyric_object::Opcode::OP_TO_U16: {
+            DISPATCH_CASE(OP_TO_U16): {
                 Operand source, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(source));
                 ON_ERROR_IF_NOT_OK (internal::convert_to_U16(heapManager, source, result));
@@ -748,7 +1149,7 @@ lyric_runtime::BytecodeInterpreter::runSubinterpreter()
             }
 
             // pop value from stack and convert its representation to U32
-            case lyric_object::Opcode::OP_TO_U32: {
+            DISPATCH_CASE(OP_TO_U32): {
                 Operand source, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(source));
                 ON_ERROR_IF_NOT_OK (internal::convert_to_U32(heapManager, source, result));
@@ -756,7 +1157,7 @@ lyric_runtime::BytecodeInterpreter::runSubinterpreter()
             }
 
             // pop value from stack and convert its representation to U64
-            case lyric_object::Opcode::OP_TO_U64: {
+            DISPATCH_CASE(OP_TO_U64): {
                 Operand source, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(source));
                 ON_ERROR_IF_NOT_OK (internal::convert_to_U64(heapManager, source, result));
@@ -764,7 +1165,7 @@ lyric_runtime::BytecodeInterpreter::runSubinterpreter()
             }
 
             // pop value from stack and convert its representation to F32
-            case lyric_object::Opcode::OP_TO_F32: {
+            DISPATCH_CASE(OP_TO_F32): {
                 Operand source, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(source));
                 ON_ERROR_IF_NOT_OK (internal::convert_to_F32(heapManager, source, result));
@@ -772,7 +1173,7 @@ lyric_runtime::BytecodeInterpreter::runSubinterpreter()
             }
 
             // pop value from stack and convert its representation to F64
-            case lyric_object::Opcode::OP_TO_F64: {
+            DISPATCH_CASE(OP_TO_F64): {
                 Operand source, result;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(source));
                 ON_ERROR_IF_NOT_OK (internal::convert_to_F64(heapManager, source, result));
@@ -780,60 +1181,76 @@ lyric_runtime::BytecodeInterpreter::runSubinterpreter()
             }
 
             // load assembly specified by the literal address operand
-            case lyric_object::Opcode::OP_IMPORT: {
-                return onError(op, InterpreterStatus::forCondition(
+            DISPATCH_CASE(OP_IMPORT): {
+                return onError(*op, InterpreterStatus::forCondition(
                     InterpreterCondition::kRuntimeInvariant, "OP_IMPORT unimplemented"));
             }
 
             // invoke the function specified by the static address operand
-            case lyric_object::Opcode::OP_CALL_STATIC: {
-                auto address = op.operands.flags_u8_address_u32_placement_u16.address;
-                auto placementSize = op.operands.flags_u8_address_u32_placement_u16.placement;
-                auto flags = op.operands.flags_u8_address_u32_placement_u16.flags;
+            DISPATCH_CASE(OP_CALL_STATIC): {
+                checkpoint = true;
+                next = nullptr;
+                auto address = op->operands.flags_u8_address_u32_placement_u16.address;
+                auto placementSize = op->operands.flags_u8_address_u32_placement_u16.placement;
+                auto flags = op->operands.flags_u8_address_u32_placement_u16.flags;
                 ON_ERROR_IF_NOT_OK (internal::call_static(
                     currentCoro, subroutineManager, address, placementSize, flags));
-                break;
+                DISPATCH_NEXT();
             }
 
             // execute the method specified by index into the vtable of the object on the top of the stack
-            case lyric_object::Opcode::OP_CALL_VIRTUAL: {
-                auto callAddress = op.operands.flags_u8_address_u32_placement_u16.address;
-                auto placementSize = op.operands.flags_u8_address_u32_placement_u16.placement;
-                auto flags = op.operands.flags_u8_address_u32_placement_u16.flags;
+            DISPATCH_CASE(OP_CALL_VIRTUAL): {
+                checkpoint = true;
+                next = nullptr;
+                auto callAddress = op->operands.flags_u8_address_u32_placement_u16.address;
+                auto placementSize = op->operands.flags_u8_address_u32_placement_u16.placement;
+                auto flags = op->operands.flags_u8_address_u32_placement_u16.flags;
+                auto *callSite = predecoded != nullptr ? predecoded->callSite : nullptr;
                 ON_ERROR_IF_NOT_OK (internal::call_virtual(
-                    currentCoro, subroutineManager, callAddress, placementSize, flags));
-                break;
+                    currentCoro, subroutineManager, callAddress, placementSize, flags, callSite));
+                DISPATCH_NEXT();
             }
 
-            case lyric_object::Opcode::OP_CALL_CONCEPT: {
-                auto actionAddress = op.operands.flags_u8_address_u32_placement_u16.address;
-                auto placementSize = op.operands.flags_u8_address_u32_placement_u16.placement;
-                auto flags = op.operands.flags_u8_address_u32_placement_u16.flags;
+            DISPATCH_CASE(OP_CALL_CONCEPT): {
+                checkpoint = true;
+                next = nullptr;
+                auto actionAddress = op->operands.flags_u8_address_u32_placement_u16.address;
+                auto placementSize = op->operands.flags_u8_address_u32_placement_u16.placement;
+                auto flags = op->operands.flags_u8_address_u32_placement_u16.flags;
+                auto *callSite = predecoded != nullptr ? predecoded->callSite : nullptr;
                 ON_ERROR_IF_NOT_OK (internal::call_concept(
-                    currentCoro, subroutineManager, actionAddress, placementSize, flags));
-                break;
+                    currentCoro, subroutineManager, actionAddress, placementSize, flags, callSite));
+                DISPATCH_NEXT();
             }
 
-            case lyric_object::Opcode::OP_CALL_STUB: {
-                auto actionAddress = op.operands.flags_u8_address_u32_placement_u16.address;
-                auto placementSize = op.operands.flags_u8_address_u32_placement_u16.placement;
-                auto flags = op.operands.flags_u8_address_u32_placement_u16.flags;
+            DISPATCH_CASE(OP_CALL_STUB): {
+                checkpoint = true;
+                next = nullptr;
+                auto actionAddress = op->operands.flags_u8_address_u32_placement_u16.address;
+                auto placementSize = op->operands.flags_u8_address_u32_placement_u16.placement;
+                auto flags = op->operands.flags_u8_address_u32_placement_u16.flags;
+                auto *callSite = predecoded != nullptr ? predecoded->callSite : nullptr;
                 ON_ERROR_IF_NOT_OK (internal::call_stub(
-                    currentCoro, subroutineManager, actionAddress, placementSize, flags));
-                break;
+                    currentCoro, subroutineManager, actionAddress, placementSize, flags, callSite));
+                DISPATCH_NEXT();
             }
 
-            case lyric_object::Opcode::OP_CALL_EXISTENTIAL: {
-                auto callAddress = op.operands.flags_u8_address_u32_placement_u16.address;
-                auto placementSize = op.operands.flags_u8_address_u32_placement_u16.placement;
-                auto flags = op.operands.flags_u8_address_u32_placement_u16.flags;
+            DISPATCH_CASE(OP_CALL_EXISTENTIAL): {
+                checkpoint = true;
+                next = nullptr;
+                auto callAddress = op->operands.flags_u8_address_u32_placement_u16.address;
+                auto placementSize = op->operands.flags_u8_address_u32_placement_u16.placement;
+                auto flags = op->operands.flags_u8_address_u32_placement_u16.flags;
+                auto *callSite = predecoded != nullptr ? predecoded->callSite : nullptr;
                 ON_ERROR_IF_NOT_OK (internal::call_existential(
-                    currentCoro, subroutineManager, callAddress, placementSize, flags));
-                break;
+                    currentCoro, subroutineManager, callAddress, placementSize, flags, callSite));
+                DISPATCH_NEXT();
             }
 
             // return from the current activation
-            case lyric_object::Opcode::OP_RETURN: {
+            DISPATCH_CASE(OP_RETURN): {
+                checkpoint = true;
+                next = nullptr;
                 // if we reached the call stack guard then pop the guard
                 bool reachedGuard = currentCoro->peekGuard() == currentCoro->callStackSize();
                 if (reachedGuard)
@@ -842,16 +1259,16 @@ lyric_runtime::BytecodeInterpreter::runSubinterpreter()
                 // check if we reached the bottom of the call stack
                 if (!subroutineManager->returnToCaller(currentCoro, status)) {
                     if (status.notOk())
-                        return onError(op, status);
+                        return onError(*op, status);
                     auto *currentTask = systemScheduler->currentTask();
                     // if we're executing the main task and we have no return address then halt
                     if (currentTask->isMainTask())
-                        return onHalt(op);
+                        return onHalt(*op);
                     // otherwise this is a worker task so terminate the task
                     systemScheduler->terminateTask(currentTask);
                     // clear the current coro so we select the next ready task
                     currentCoro = nullptr;
-                    break;
+                    DISPATCH_NEXT();
                 }
                 // if the call stack is still valid and we reached a guard then return from the subinterpreter
                 if (reachedGuard) {
@@ -861,77 +1278,83 @@ lyric_runtime::BytecodeInterpreter::runSubinterpreter()
                     }
                     return result;
                 }
-                break;
+                DISPATCH_NEXT();
             }
-            case lyric_object::Opcode::OP_RAISE: {
+            DISPATCH_CASE(OP_RAISE): {
+                checkpoint = true;
+                next = nullptr;
                 Operand exc;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(exc));
                 if (exc.getType() != OperandType::Status)
-                    return onError(op, InterpreterStatus::forCondition(
+                    return onError(*op, InterpreterStatus::forCondition(
                         InterpreterCondition::kInvalidDataStackV1, "invalid exception"));
                 ON_ERROR_IF_NOT_OK (internal::raise_exception(
-                    op, exc, currentCoro, segmentManager, subroutineManager, typeManager));
-                break;
+                    *op, exc, currentCoro, segmentManager, subroutineManager, typeManager));
+                DISPATCH_NEXT();
             }
 
             // execute the specified trap, passing params from the stack, and push the result onto the stack.
-            case lyric_object::Opcode::OP_TRAP: {
-                auto flags = op.operands.flags_u8_address_u32.flags;
-                auto address = op.operands.flags_u8_address_u32.address;
+            DISPATCH_CASE(OP_TRAP): {
+                checkpoint = true;
+                next = nullptr;
+                auto flags = op->operands.flags_u8_address_u32.flags;
+                auto address = op->operands.flags_u8_address_u32.address;
                 if (flags & lyric_object::TRAP_INDEX_FOLLOWS) {
                     if (address != 0)
-                        return onError(op, InterpreterStatus::forCondition(
+                        return onError(*op, InterpreterStatus::forCondition(
                             InterpreterCondition::kInvalidOperandFlagsAddressV2, "invalid trap address operand"));
                     Operand trap;
                     ON_ERROR_IF_NOT_OK (currentCoro->popData(trap));
                     if (!trap.getU32(address))
-                        return onError(op, InterpreterStatus::forCondition(
+                        return onError(*op, InterpreterStatus::forCondition(
                             InterpreterCondition::kInvalidDataStackV1, "invalid trap index"));
                 }
                 TU_LOG_V << "trap index is " << address;
                 auto *sp = currentCoro->peekSP();
                 auto *trap = sp->getTrap(address);
                 if (trap == nullptr)
-                    return onError(op, InterpreterStatus::forCondition(
+                    return onError(*op, InterpreterStatus::forCondition(
                         InterpreterCondition::kRuntimeInvariant, "no trap found"));
                 // invoke the trap
                 auto status = trap->func(this, m_state.get(), nullptr);
                 if (!status.isOk())
-                    return onError(op, status);
+                    return onError(*op, status);
                 // ensure currentCoro is up to date
                 currentCoro = m_state->currentCoro();
-                break;
+                DISPATCH_NEXT();
             }
 
             // invoke the constructor specified by the address operand
-            case lyric_object::Opcode::OP_NEW: {
-                auto address = op.operands.flags_u8_address_u32_placement_u16.address;
-                auto placement = op.operands.flags_u8_address_u32_placement_u16.placement;
-                auto flags = op.operands.flags_u8_address_u32_placement_u16.flags;
+            DISPATCH_CASE(OP_NEW): {
+                checkpoint = true;
+                next = nullptr;
+                auto address = op->operands.flags_u8_address_u32_placement_u16.address;
+                auto placement = op->operands.flags_u8_address_u32_placement_u16.placement;
+                auto flags = op->operands.flags_u8_address_u32_placement_u16.flags;
 
                 auto status = internal::construct_new(
                     address, placement, flags, currentCoro, segmentManager, this, m_state.get());
                 if (status.notOk())
-                    return onError(op, status);
-                break;
+                    return onError(*op, status);
+                DISPATCH_NEXT();
             }
 
-            case lyric_object::Opcode::OP_TYPE_OF: {
+            DISPATCH_CASE(OP_TYPE_OF): {
                 Operand value;
                 ON_ERROR_IF_NOT_OK (currentCoro->popData(value));
                 auto typeOfResult = typeManager->typeOf(value);
                 if (typeOfResult.isStatus())
-                    return onError(op, typeOfResult.getStatus());
+                    return onError(*op, typeOfResult.getStatus());
                 auto typeOf = typeOfResult.getResult();
                 if (typeOf.getType() != OperandType::Type)
-                    return onError(op, InterpreterStatus::forCondition(
+                    return onError(*op, InterpreterStatus::forCondition(
                         InterpreterCondition::kRuntimeInvariant, "invalid type result"));
                 ON_ERROR_IF_NOT_OK (currentCoro->pushData(typeOf));
-                break;
+                DISPATCH_NEXT();
             }
 
             // interrupt the interpreter.  if there is a value on the stack, return it, otherwise return nil.
-            case lyric_object::Opcode::OP_INTERRUPT: {
+            DISPATCH_CASE(OP_INTERRUPT): {
                 Operand result;
                 if (!currentCoro->dataStackEmpty()) {
                     ON_ERROR_IF_NOT_OK (currentCoro->popData(result));
@@ -945,24 +1368,25 @@ lyric_runtime::BytecodeInterpreter::runSubinterpreter()
             }
 
             // exit the interpreter.  if there is a value on the stack, return it, otherwise return nil.
-            case lyric_object::Opcode::OP_HALT: {
-                return onHalt(op);
+            DISPATCH_CASE(OP_HALT): {
+                return onHalt(*op);
             }
 
             // abort the interpreter.  if there is a value on the stack, return it, otherwise return nil.
-            case lyric_object::Opcode::OP_ABORT: {
-                return onError(op, InterpreterStatus::forCondition(InterpreterCondition::kAborted));
+            DISPATCH_CASE(OP_ABORT): {
+                return onError(*op, InterpreterStatus::forCondition(InterpreterCondition::kAborted));
             }
 
             // unknown opcode
-            default:
-                return onError(op, InterpreterStatus::forCondition(
+            DISPATCH_DEFAULT:
+                return onError(*op, InterpreterStatus::forCondition(
                     InterpreterCondition::kRuntimeInvariant, "unknown instruction"));
         }
 
+    dispatch_complete:
         // run inspector hook after processing op
-        if (m_inspector) {
-            auto status = m_inspector->afterOp(op, this, m_state.get());
+        if constexpr (Inspected) {
+            auto status = m_inspector->afterOp(*op, this, m_state.get());
             if (!status.isOk())
                 return status;
         }
@@ -1061,6 +1485,19 @@ lyric_runtime::BytecodeInterpreter::onHalt(const lyric_object::OpCell &op)
     return mainReturn;
 }
 
+/**
+ * Returns control from a preemptible run to the caller of runQuantum. The interpreter is left in a
+ * state where the next call to runQuantum resumes at the next instruction of the current task.
+ */
+tempo_utils::Result<lyric_runtime::Operand>
+lyric_runtime::BytecodeInterpreter::onYield(InterpreterYield yield)
+{
+    TU_LOG_VV << "yielding interpreter";
+    m_yield = yield;
+    m_resuming = true;
+    return Operand{};
+}
+
 lyric_runtime::RecursionLocker::RecursionLocker(lyric_runtime::BytecodeInterpreter *interp)
     : m_interp(interp)
 {
@@ -47,6 +47,9 @@ lyric_runtime::BytecodeSegment::BytecodeSegment(
     m_protocols = m_numProtocols > 0 ? new Operand[m_numProtocols] : nullptr;
     m_numNamespaces = m_object.numNamespaces();
     m_namespaces = m_numNamespaces > 0 ? new Operand[m_numNamespaces] : nullptr;
+    m_numLiterals = m_object.numStrings();
+    m_stringLiterals = m_numLiterals > 0 ? new Operand[m_numLiterals] : nullptr;
+    m_bytesLiterals = m_numLiterals > 0 ? new Operand[m_numLiterals] : nullptr;
 
     if (m_object.hasPlugin()) {
         TU_NOTNULL (m_plugin);
@@ -92,6 +95,8 @@ lyric_runtime::BytecodeSegment::~BytecodeSegment()
     delete[] m_enums;
     delete[] m_protocols;
     delete[] m_namespaces;
+    delete[] m_stringLiterals;
+    delete[] m_bytesLiterals;
     delete[] m_traps;
 }
 
@@ -290,6 +295,54 @@ lyric_runtime::BytecodeSegment::setNamespace(uint32_t index, const Operand &valu
     return true;
 }
 
+/**
+ * Returns the interned StringRef for the string literal at the specified `index`, or an invalid operand
+ * if the literal has not been materialized yet.
+ *
+ * @param index The index of the literal in the strings section of the object.
+ * @return The interned literal, or an invalid operand.
+ */
+lyric_runtime::Operand
+lyric_runtime::BytecodeSegment::getStringLiteral(tu_uint32 index) const
+{
+    if (m_numLiterals <= index)
+        return {};
+    return m_stringLiterals[index];
+}
+
+bool
+lyric_runtime::BytecodeSegment::setStringLiteral(tu_uint32 index, const Operand &value)
+{
+    if (m_numLiterals <= index)
+        return false;
+    m_stringLiterals[index] = value;
+    return true;
+}
+
+/**
+ * Returns the interned BytesRef for the string literal at the specified `index`, or an invalid operand
+ * if the literal has not been materialized yet.
+ *
+ * @param index The index of the literal in the strings section of the object.
+ * @return The interned literal, or an invalid operand.
+ */
+lyric_runtime::Operand
+lyric_runtime::BytecodeSegment::getBytesLiteral(tu_uint32 index) const
+{
+    if (m_numLiterals <= index)
+        return {};
+    return m_bytesLiterals[index];
+}
+
+bool
+lyric_runtime::BytecodeSegment::setBytesLiteral(tu_uint32 index, const Operand &value)
+{
+    if (m_numLiterals <= index)
+        return false;
+    m_bytesLiterals[index] = value;
+    return true;
+}
+
 const lyric_runtime::NativeTrap *
 lyric_runtime::BytecodeSegment::getTrap(tu_uint32 address) const
 {
@@ -298,6 +351,111 @@ lyric_runtime::BytecodeSegment::getTrap(tu_uint32 address) const
     return nullptr;
 }
 
+/**
+ * Marks every heap instance referenced from the static storage areas of the segment as reachable.
+ */
+void
+lyric_runtime::BytecodeSegment::setReachable() const
+{
+    for (tu_uint32 i = 0; i < m_numStatics; i++) {
+        m_statics[i].setReachable();
+    }
+    for (tu_uint32 i = 0; i < m_numInstances; i++) {
+        m_instances[i].setReachable();
+    }
+    for (tu_uint32 i = 0; i < m_numEnums; i++) {
+        m_enums[i].setReachable();
+    }
+    for (tu_uint32 i = 0; i < m_numProtocols; i++) {
+        m_protocols[i].setReachable();
+    }
+    for (tu_uint32 i = 0; i < m_numNamespaces; i++) {
+        m_namespaces[i].setReachable();
+    }
+}
+
+/**
+ * Returns the decoded metadata for the proc at `procOffset` in the segment bytecode. The proc is decoded
+ * the first time its metadata is requested, and subsequent requests return the cached metadata.
+ *
+ * @param procOffset The offset of the proc within the segment bytecode.
+ * @param procMetadata Set to the proc metadata if the proc was decoded successfully.
+ * @return Ok status if the proc metadata is available, otherwise status describing the parse failure.
+ */
+tempo_utils::Status
+lyric_runtime::BytecodeSegment::getProcMetadata(tu_uint32 procOffset, const ProcMetadata **procMetadata)
+{
+    TU_ASSERT (procMetadata != nullptr);
+
+    auto entry = m_procMetadata.find(procOffset);
+    if (entry != m_procMetadata.cend()) {
+        *procMetadata = entry->second.get();
+        return {};
+    }
+
+    std::unique_ptr<ProcMetadata> metadata;
+    TU_RETURN_IF_NOT_OK (ProcMetadata::parse(getBytecode(), procOffset, metadata));
+    *procMetadata = metadata.get();
+    m_procMetadata[procOffset] = std::move(metadata);
+    return {};
+}
+
+/**
+ * Returns the predecoded instruction stream for the proc code which the instruction pointer `ip` iterates
+ * over. The code is decoded the first time it is requested and the result is cached for the lifetime of
+ * the segment. If `ip` does not iterate over code contained in the bytecode of this segment then nullptr
+ * is returned.
+ *
+ * @param ip The instruction pointer.
+ * @return The predecoded proc, or nullptr.
+ */
+const lyric_runtime::PredecodedProc *
+lyric_runtime::BytecodeSegment::getPredecodedProc(const lyric_object::BytecodeIterator &ip)
+{
+    auto *base = ip.getBase();
+    if (base < m_bytecode || m_bytecode + m_bytecodeSize < base + ip.getSize())
+        return nullptr;
+    tu_uint32 codeOffset = base - m_bytecode;
+
+    auto entry = m_predecodedProcs.find(codeOffset);
+    if (entry != m_predecodedProcs.cend())
+        return entry->second.get();
+
+    auto predecoded = std::make_unique<PredecodedProc>(std::span(base, ip.getSize()));
+    auto *ptr = predecoded.get();
+    m_predecodedProcs[codeOffset] = std::move(predecoded);
+    return ptr;
+}
+
+/**
+ * Returns the inline cache for the call site whose call instruction immediately precedes `returnIP`,
+ * creating an empty cache if the call site has not been executed before. The return IP is used to
+ * identify the call site because it is unique per call instruction and is available without decoding
+ * the call instruction again. Returns nullptr if `returnIP` does not point into the segment bytecode.
+ * Predecoded call sites carry their cache in the PredecodedOp, so this lookup is only the fallback
+ * for calls which are dispatched from decoded instructions.
+ *
+ * @param returnIP The instruction pointer following the call instruction.
+ * @return The call site cache, or nullptr.
+ */
+lyric_runtime::CallSiteCache *
+lyric_runtime::BytecodeSegment::getCallSiteCache(const lyric_object::BytecodeIterator &returnIP)
+{
+    auto *curr = returnIP.getCurr();
+    if (curr == nullptr || curr <= m_bytecode || m_bytecode + m_bytecodeSize < curr)
+        return nullptr;
+    tu_uint32 siteOffset = curr - m_bytecode;
+
+    auto entry = m_callSiteCaches.find(siteOffset);
+    if (entry != m_callSiteCaches.cend())
+        return entry->second.get();
+
+    auto cache = std::make_unique<CallSiteCache>();
+    auto *ptr = cache.get();
+    m_callSiteCaches[siteOffset] = std::move(cache);
+    return ptr;
+}
+
 void *
 lyric_runtime::BytecodeSegment::getData() const
 {
@@ -1,14 +1,21 @@
 
+#include <limits>
+
 #include <absl/strings/substitute.h>
 
 #include <lyric_runtime/bytes_ref.h>
+#include <lyric_runtime/internal/text_kernels.h>
 #include <lyric_runtime/interpreter_state.h>
+#include <lyric_runtime/shared_bytes.h>
 #include <tempo_utils/log_stream.h>
+#include <tempo_utils/memory_bytes.h>
 #include <tempo_utils/unicode.h>
 #include <utf8/checked.h>
 
 lyric_runtime::BytesRef::BytesRef(const ExistentialTable *etable, std::string_view literal)
     : m_etable(etable),
+      m_sharedOffset(0),
+      m_permanent(false),
       m_reachable(false)
 {
     TU_ASSERT (m_etable != nullptr);
@@ -20,6 +27,8 @@ lyric_runtime::BytesRef::BytesRef(const ExistentialTable *etable, std::string_vi
 
 lyric_runtime::BytesRef::BytesRef(const ExistentialTable *etable, const tu_uint8 *src, int32_t size)
     : m_etable(etable),
+      m_sharedOffset(0),
+      m_permanent(false),
       m_reachable(false)
 {
     TU_ASSERT (m_etable != nullptr);
@@ -32,6 +41,8 @@ lyric_runtime::BytesRef::BytesRef(const ExistentialTable *etable, const tu_uint8
 
 lyric_runtime::BytesRef::BytesRef(const ExistentialTable *etable, tempo_utils::Rope<tu_uint8> rope)
     : m_etable(etable),
+      m_sharedOffset(0),
+      m_permanent(false),
       m_reachable(false)
 {
     TU_ASSERT (m_etable != nullptr);
@@ -39,6 +50,33 @@ lyric_runtime::BytesRef::BytesRef(const ExistentialTable *etable, tempo_utils::R
     m_size = m_rope.numElements();
 }
 
+/**
+ * Construct a BytesRef which is a view of the specified range of shared bytes. The range is not
+ * copied, the BytesRef shares ownership of the bytes instead.
+ *
+ * @param etable The existential table.
+ * @param shared The shared bytes.
+ * @param offset The offset of the range in the shared bytes.
+ * @param size The size of the range.
+ */
+lyric_runtime::BytesRef::BytesRef(
+    const ExistentialTable *etable,
+    std::shared_ptr<const tempo_utils::ImmutableBytes> shared,
+    tu_uint32 offset,
+    tu_uint32 size)
+    : m_etable(etable),
+      m_shared(std::move(shared)),
+      m_sharedOffset(offset),
+      m_permanent(false),
+      m_reachable(false)
+{
+    TU_ASSERT (m_etable != nullptr);
+    TU_NOTNULL (m_shared);
+    TU_ASSERT (static_cast<tu_uint64>(offset) + size <= m_shared->getSize());
+    TU_ASSERT (size <= static_cast<tu_uint32>(std::numeric_limits<int32_t>::max()));
+    m_size = static_cast<int32_t>(size);
+}
+
 lyric_runtime::BytesRef::~BytesRef()
 {
     TU_LOG_VV << "free BytesRef" << BytesRef::toString();
@@ -79,47 +117,31 @@ lyric_runtime::BytesRef::compare(const AbstractRef *other) const
 {
     TU_NOTNULL (other);
 
-    auto thischunks = m_rope.iterateChunks();
     auto *otherbytes = static_cast<const BytesRef *>(other);
-    auto otherchunks = otherbytes->m_rope.iterateChunks();
-
-    tempo_utils::RopeChunk<tu_uint8> thischunk, otherchunk;
-
-    auto thisactive = thischunks.getNext(thischunk);
-    auto thisit = thischunk.cbegin();
-    auto thisend = thischunk.cend();;
-
-    auto otheractive = otherchunks.getNext(otherchunk);
-    auto otherit = otherchunk.cbegin();
-    auto otherend = otherchunk.cend();
-
-    while (thisactive && otheractive) {
-
-        while (thisit != thisend && otherit != otherend) {
-            if (*thisit < *otherit)
-                return -1;
-            if (*thisit > *otherit)
-                return 1;
-            ++thisit;
-            ++otherit;
-        }
-
-        if (thisit == thisend) {
-            thisactive = thischunks.getNext(thischunk);
-            thisit = thischunk.cbegin();
-            thisend = thischunk.cend();
-        }
-
-        if (otherit == otherend) {
-            otheractive = otherchunks.getNext(otherchunk);
-            otherit = otherchunk.cbegin();
-            otherend = otherchunk.cend();
-        }
+    if (m_shared == nullptr && otherbytes->m_shared == nullptr)
+        return internal::compare_ropes(m_rope, otherbytes->m_rope);
+    // compare the shared span against the chunks of the other rope, without building either rope
+    if (m_shared == nullptr) {
+        auto rhs = otherbytes->getSharedSpan();
+        return -internal::compare_bytes_to_rope(
+            reinterpret_cast<const char *>(rhs.data()), rhs.size(), m_rope);
+    }
+    if (otherbytes->m_shared == nullptr) {
+        auto lhs = getSharedSpan();
+        return internal::compare_bytes_to_rope(
+            reinterpret_cast<const char *>(lhs.data()), lhs.size(), otherbytes->m_rope);
     }
 
-    if (!thisactive)
-        return otheractive? 1 : 0;
-    return -1;
+    auto lhs = getSharedSpan();
+    auto rhs = otherbytes->getSharedSpan();
+    auto size = std::min(lhs.size(), rhs.size());
+    auto offset = internal::mismatch_bytes(
+        reinterpret_cast<const char *>(lhs.data()), reinterpret_cast<const char *>(rhs.data()), size);
+    if (offset < size)
+        return lhs[offset] < rhs[offset]? -1 : 1;
+    if (lhs.size() == rhs.size())
+        return 0;
+    return lhs.size() < rhs.size()? -1 : 1;
 }
 
 bool
@@ -138,6 +160,14 @@ lyric_runtime::BytesRef::rawSize(tu_int32 &size) const
 tu_int32
 lyric_runtime::BytesRef::rawCopy(tu_int32 offset, char *dst, tu_int32 size) const
 {
+    if (m_shared != nullptr) {
+        if (offset < 0 || size < 0 || offset >= m_size)
+            return 0;
+        auto ncopied = std::min(size, m_size - offset);
+        memcpy(dst, getSharedSpan().data() + offset, ncopied);
+        return ncopied;
+    }
+
     auto subspan = m_rope.subspan(offset, size);
     auto chunks = subspan.iterateChunks();
     tempo_utils::RopeChunk<tu_uint8> chunk;
@@ -154,11 +184,16 @@ lyric_runtime::BytesRef::rawCopy(tu_int32 offset, char *dst, tu_int32 size) cons
 bool
 lyric_runtime::BytesRef::utf8Value(std::string &utf8) const
 {
-    auto chunks = m_rope.iterateChunks();
-    tempo_utils::RopeChunk<tu_uint8> chunk;
+    if (m_shared != nullptr) {
+        auto span = getSharedSpan();
+        utf8.append((const char *) span.data(), span.size());
+    } else {
+        auto chunks = m_rope.iterateChunks();
+        tempo_utils::RopeChunk<tu_uint8> chunk;
 
-    while (chunks.getNext(chunk)) {
-        utf8.append((const char *) chunk.data(), chunk.size());
+        while (chunks.getNext(chunk)) {
+            utf8.append((const char *) chunk.data(), chunk.size());
+        }
     }
     utf8::iterator it(utf8.cbegin(), utf8.cbegin(), utf8.cend());
     utf8::iterator end(utf8.cend(), utf8.cbegin(), utf8.cend());
@@ -175,6 +210,11 @@ lyric_runtime::BytesRef::utf8Value(std::string &utf8) const
 bool
 lyric_runtime::BytesRef::hashValue(absl::HashState state)
 {
+    if (m_shared != nullptr) {
+        auto span = getSharedSpan();
+        state = absl::HashState::combine_contiguous(std::move(state), span.data(), span.size());
+        return true;
+    }
     auto chunks = m_rope.iterateChunks();
     tempo_utils::RopeChunk<tu_uint8> chunk;
     while (chunks.getNext(chunk)) {
@@ -204,6 +244,12 @@ lyric_runtime::BytesRef::toString() const
 lyric_runtime::Operand
 lyric_runtime::BytesRef::byteAt(int index) const
 {
+    if (m_shared != nullptr) {
+        if (index < 0 || index >= m_size)
+            return Operand::undef();
+        return Operand::fromI64(getSharedSpan()[index]);
+    }
+
     if (m_rope.isEmpty())
         return Operand::undef();
 
@@ -225,6 +271,43 @@ lyric_runtime::BytesRef::bytesCompare(BytesRef *other) const
     return Operand::fromI64(compare(other));
 }
 
+/**
+ * Returns true if the contents begin with the contents of `other`. Shared bytes are compared in place
+ * and ropes are compared chunk by chunk, so neither side is flattened.
+ *
+ * @param other The prefix.
+ * @return true if `other` is a prefix of the contents, otherwise false.
+ */
+bool
+lyric_runtime::BytesRef::startsWith(const BytesRef *other) const
+{
+    TU_NOTNULL (other);
+
+    auto size = other->m_size;
+    if (m_size < size)
+        return false;
+
+    if (m_shared != nullptr && other->m_shared != nullptr) {
+        auto lhs = getSharedSpan();
+        auto rhs = other->getSharedSpan();
+        auto offset = internal::mismatch_bytes(
+            reinterpret_cast<const char *>(lhs.data()), reinterpret_cast<const char *>(rhs.data()), size);
+        return offset == static_cast<size_t>(size);
+    }
+    if (m_shared != nullptr) {
+        auto lhs = getSharedSpan();
+        return internal::compare_bytes_to_rope(
+            reinterpret_cast<const char *>(lhs.data()), size, other->m_rope) == 0;
+    }
+    auto head = m_rope.subspan(0, size);
+    if (other->m_shared != nullptr) {
+        auto rhs = other->getSharedSpan();
+        return internal::compare_bytes_to_rope(
+            reinterpret_cast<const char *>(rhs.data()), size, head) == 0;
+    }
+    return internal::compare_ropes(head, other->m_rope) == 0;
+}
+
 lyric_runtime::Operand
 lyric_runtime::BytesRef::bytesLength() const
 {
@@ -240,9 +323,19 @@ lyric_runtime::BytesRef::getBytes() const
     return bytes;
 }
 
+/**
+ * Returns the contents as a rope. If the BytesRef is a view of shared bytes then the rope is a copy
+ * of the view, so callers which can operate on a contiguous span should use getSharedSpan() instead.
+ */
 tempo_utils::Rope<tu_uint8>
 lyric_runtime::BytesRef::getBytesData() const
 {
+    if (m_shared != nullptr) {
+        if (m_size == 0)
+            return {};
+        auto span = getSharedSpan();
+        return tempo_utils::Rope<tu_uint8>(span.begin(), span.end());
+    }
     return m_rope;
 }
 
@@ -252,10 +345,51 @@ lyric_runtime::BytesRef::getBytesSize() const
     return m_size;
 }
 
+/**
+ * Returns true if the BytesRef is a view of shared bytes rather than a rope.
+ */
+bool
+lyric_runtime::BytesRef::isShared() const
+{
+    return m_shared != nullptr;
+}
+
+/**
+ * Returns the span of the shared bytes viewed by the BytesRef, or an empty span if the BytesRef is
+ * not a view of shared bytes.
+ */
+std::span<const tu_uint8>
+lyric_runtime::BytesRef::getSharedSpan() const
+{
+    if (m_shared == nullptr)
+        return {};
+    return std::span<const tu_uint8>(m_shared->getData() + m_sharedOffset, m_size);
+}
+
+/**
+ * Returns the contents as ImmutableBytes. If the BytesRef is a view of shared bytes then the shared
+ * bytes (or a slice of them) are returned without copying, otherwise the rope is copied once into
+ * a contiguous buffer.
+ */
+std::shared_ptr<const tempo_utils::ImmutableBytes>
+lyric_runtime::BytesRef::toImmutableBytes() const
+{
+    if (m_shared != nullptr)
+        return BytesSlice::create(m_shared, m_sharedOffset, m_size);
+    auto bytes = getBytes();
+    return tempo_utils::MemoryBytes::copy(bytes);
+}
+
+void
+lyric_runtime::BytesRef::setPermanent()
+{
+    m_permanent = true;
+}
+
 bool
 lyric_runtime::BytesRef::isReachable() const
 {
-    return m_reachable;
+    return m_permanent || m_reachable;
 }
 
 void
@@ -31,7 +31,7 @@ lyric_runtime::CallCell::CallCell(
     tu_uint16 numRest,
     tu_uint16 numLocals,
     tu_uint16 numLexicals,
-    const std::vector<Operand> &data,
+    std::span<const Operand> data,
     const VirtualTable *vtable)
     : m_callIndex(callIndex),
       m_callSegment(callSegment),
@@ -44,7 +44,7 @@ lyric_runtime::CallCell::CallCell(
       m_numRest(numRest),
       m_numLocals(numLocals),
       m_numLexicals(numLexicals),
-      m_data(data),
+      m_data(data.begin(), data.end()),
       m_vtable(vtable)
 {
     TU_ASSERT (m_vtable != nullptr);
@@ -63,7 +63,7 @@ lyric_runtime::CallCell::CallCell(
     tu_uint16 numRest,
     tu_uint16 numLocals,
     tu_uint16 numLexicals,
-    const std::vector<Operand> &data,
+    std::span<const Operand> data,
     Operand receiver)
     : m_callIndex(callIndex),
       m_callSegment(callSegment),
@@ -76,7 +76,7 @@ lyric_runtime::CallCell::CallCell(
       m_numRest(numRest),
       m_numLocals(numLocals),
       m_numLexicals(numLexicals),
-      m_data(data),
+      m_data(data.begin(), data.end()),
       m_receiver(std::move(receiver)),
       m_vtable(nullptr)
 {
@@ -96,7 +96,7 @@ lyric_runtime::CallCell::CallCell(
     tu_uint16 numRest,
     tu_uint16 numLocals,
     tu_uint16 numLexicals,
-    const std::vector<Operand> &data)
+    std::span<const Operand> data)
     : m_callIndex(callIndex),
       m_callSegment(callSegment),
       m_procOffset(procOffset),
@@ -108,7 +108,7 @@ lyric_runtime::CallCell::CallCell(
       m_numRest(numRest),
       m_numLocals(numLocals),
       m_numLexicals(numLexicals),
-      m_data(data),
+      m_data(data.begin(), data.end()),
       m_vtable(nullptr)
 {
     m_data.resize(numArguments + numRest + numLocals + numLexicals);
@@ -127,6 +127,7 @@ lyric_runtime::CallCell::CallCell(const CallCell &other)
       m_numLocals(other.m_numLocals),
       m_numLexicals(other.m_numLexicals),
       m_data(other.m_data),
+      m_upvalues(other.m_upvalues),
       m_receiver(other.m_receiver),
       m_vtable(other.m_vtable)
 {
@@ -147,6 +148,7 @@ lyric_runtime::CallCell::CallCell(CallCell &&other) noexcept
     m_numLocals = other.m_numLocals;
     m_numLexicals = other.m_numLexicals;
     m_data.swap(other.m_data);
+    m_upvalues.swap(other.m_upvalues);
     m_receiver = other.m_receiver;
     m_vtable = other.m_vtable;
 
@@ -162,6 +164,7 @@ lyric_runtime::CallCell::CallCell(CallCell &&other) noexcept
     other.m_numLocals = 0;
     other.m_numLexicals = 0;
     other.m_data.clear();
+    other.m_upvalues.clear();
     other.m_receiver = {};
     other.m_vtable = nullptr;
 }
@@ -182,6 +185,7 @@ lyric_runtime::CallCell::operator=(const CallCell &other)
     m_numLocals = other.m_numLocals;
     m_numLexicals = other.m_numLexicals;
     m_data = other.m_data;
+    m_upvalues = other.m_upvalues;
     m_receiver = other.m_receiver;
     m_vtable = other.m_vtable;
     return *this;
@@ -205,6 +209,7 @@ lyric_runtime::CallCell::operator=(CallCell &&other) noexcept
         m_numLocals = other.m_numLocals;
         m_numLexicals = other.m_numLexicals;
         m_data.swap(other.m_data);
+        m_upvalues.swap(other.m_upvalues);
         m_receiver = other.m_receiver;
         m_vtable = other.m_vtable;
 
@@ -220,6 +225,7 @@ lyric_runtime::CallCell::operator=(CallCell &&other) noexcept
         other.m_numLocals = 0;
         other.m_numLexicals = 0;
         other.m_data.clear();
+        other.m_upvalues.clear();
         other.m_receiver = {};
         other.m_vtable = nullptr;
     }
@@ -287,11 +293,55 @@ lyric_runtime::CallCell::getVirtualTable() const
     return m_vtable;
 }
 
+/**
+ * Returns the value of the frame slot at the specified `slot` offset. If the slot has been promoted to
+ * an upvalue cell then the value is read from the cell.
+ */
+inline lyric_runtime::Operand
+lyric_runtime::CallCell::loadSlot(int slot) const
+{
+    if (!m_upvalues.empty() && m_upvalues[slot] != nullptr) [[unlikely]]
+        return m_upvalues[slot]->getValue();
+    return m_data[slot];
+}
+
+/**
+ * Sets the value of the frame slot at the specified `slot` offset. If the slot has been promoted to an
+ * upvalue cell then the value is written to the cell.
+ */
+inline void
+lyric_runtime::CallCell::storeSlot(int slot, const Operand &cell)
+{
+    if (!m_upvalues.empty() && m_upvalues[slot] != nullptr) [[unlikely]] {
+        m_upvalues[slot]->setValue(cell);
+        return;
+    }
+    m_data[slot] = cell;
+}
+
+/**
+ * Promotes the frame slot at the specified `slot` offset to an upvalue cell if it has not been promoted
+ * already, and returns the cell.
+ */
+lyric_runtime::UpvalueCellPtr
+lyric_runtime::CallCell::captureSlot(int slot)
+{
+    if (m_upvalues.empty()) {
+        m_upvalues.resize(m_data.size());
+    }
+    auto &upvalue = m_upvalues[slot];
+    if (upvalue == nullptr) {
+        upvalue = std::make_shared<UpvalueCell>(m_data[slot]);
+        m_data[slot] = {};
+    }
+    return upvalue;
+}
+
 lyric_runtime::Operand
 lyric_runtime::CallCell::getArgument(int index) const
 {
     if (0 <= index && index < m_numArguments)
-        return m_data[index];
+        return loadSlot(index);
     return {};
 }
 
@@ -299,7 +349,22 @@ void
 lyric_runtime::CallCell::setArgument(int index, const Operand &cell)
 {
     if (0 <= index && index < m_numArguments)
-        m_data[index] = cell;
+        storeSlot(index, cell);
+}
+
+/**
+ * Promotes the argument at the specified `index` to an upvalue cell so that it can be shared with a
+ * closure, and returns the cell.
+ *
+ * @param index The argument index.
+ * @return The upvalue cell, or nullptr if the index is out of range.
+ */
+lyric_runtime::UpvalueCellPtr
+lyric_runtime::CallCell::captureArgument(int index)
+{
+    if (0 <= index && index < m_numArguments)
+        return captureSlot(index);
+    return {};
 }
 
 tu_uint16
@@ -333,7 +398,7 @@ lyric_runtime::Operand
 lyric_runtime::CallCell::getLocal(int index) const
 {
     if (0 <= index && index < m_numLocals)
-        return m_data[m_numArguments + m_numRest + index];
+        return loadSlot(m_numArguments + m_numRest + index);
     return {};
 }
 
@@ -341,10 +406,47 @@ void
 lyric_runtime::CallCell::setLocal(int index, const Operand &cell)
 {
     if (0 <= index && index < m_numLocals) {
-        m_data[m_numArguments + m_numRest + index] = cell;
+        storeSlot(m_numArguments + m_numRest + index, cell);
+    }
+}
+
+/**
+ * Begins a new binding of the local at the specified `index` with the value `cell`. If the local was
+ * promoted to an upvalue cell then the cell is detached from the frame rather than written, so closures
+ * which captured the previous binding keep observing it, and a closure which captures the new binding
+ * receives a fresh cell. This gives each iteration of a loop its own binding of the locals declared
+ * in the loop body.
+ *
+ * @param index The local index.
+ * @param cell The initial value of the binding.
+ */
+void
+lyric_runtime::CallCell::rebindLocal(int index, const Operand &cell)
+{
+    if (0 <= index && index < m_numLocals) {
+        auto slot = m_numArguments + m_numRest + index;
+        if (!m_upvalues.empty()) {
+            m_upvalues[slot].reset();
+        }
+        m_data[slot] = cell;
     }
 }
 
+/**
+ * Promotes the local at the specified `index` to an upvalue cell so that it can be shared with a
+ * closure, and returns the cell.
+ *
+ * @param index The local index.
+ * @return The upvalue cell, or nullptr if the index is out of range.
+ */
+lyric_runtime::UpvalueCellPtr
+lyric_runtime::CallCell::captureLocal(int index)
+{
+    if (0 <= index && index < m_numLocals)
+        return captureSlot(m_numArguments + m_numRest + index);
+    return {};
+}
+
 tu_uint16
 lyric_runtime::CallCell::numLocals() const
 {
@@ -355,7 +457,7 @@ lyric_runtime::Operand
 lyric_runtime::CallCell::getLexical(int index) const
 {
     if (0 <= index && index < m_numLexicals)
-        return m_data[m_numArguments + m_numRest + m_numLocals + index];
+        return loadSlot(m_numArguments + m_numRest + m_numLocals + index);
     return {};
 }
 
@@ -363,7 +465,41 @@ void
 lyric_runtime::CallCell::setLexical(int index, const Operand &cell)
 {
     if (0 <= index && index < m_numLexicals)
-        m_data[m_numArguments + m_numRest + m_numLocals + index] = cell;
+        storeSlot(m_numArguments + m_numRest + m_numLocals + index, cell);
+}
+
+/**
+ * Returns the upvalue cell bound to the lexical at the specified `index`, promoting the lexical to a
+ * cell if it is not bound already. This allows a closure to share a variable which was captured by the
+ * enclosing closure.
+ *
+ * @param index The lexical index.
+ * @return The upvalue cell, or nullptr if the index is out of range.
+ */
+lyric_runtime::UpvalueCellPtr
+lyric_runtime::CallCell::captureLexical(int index)
+{
+    if (0 <= index && index < m_numLexicals)
+        return captureSlot(m_numArguments + m_numRest + m_numLocals + index);
+    return {};
+}
+
+/**
+ * Binds the lexical at the specified `index` to the upvalue `cell`, so that loads and stores of the
+ * lexical operate on the shared cell.
+ *
+ * @param index The lexical index.
+ * @param cell The upvalue cell.
+ */
+void
+lyric_runtime::CallCell::bindLexical(int index, UpvalueCellPtr cell)
+{
+    if (0 <= index && index < m_numLexicals) {
+        if (m_upvalues.empty()) {
+            m_upvalues.resize(m_data.size());
+        }
+        m_upvalues[m_numArguments + m_numRest + m_numLocals + index] = std::move(cell);
+    }
 }
 
 tu_uint16
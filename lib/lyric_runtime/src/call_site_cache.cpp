@@ -0,0 +1,102 @@
+
+#include <lyric_runtime/call_site_cache.h>
+#include <tempo_utils/log_stream.h>
+
+lyric_runtime::CallSiteCache::CallSiteCache()
+    : m_section(lyric_object::LinkageSection::Invalid),
+      m_address(INVALID_ADDRESS_U32),
+      m_entries(),
+      m_numEntries(0),
+      m_megamorphic(false)
+{
+}
+
+bool
+lyric_runtime::CallSiteCache::isBoundTo(lyric_object::LinkageSection section, tu_uint32 address) const
+{
+    return m_section == section && m_address == address && m_descriptor.isValid();
+}
+
+lyric_runtime::Operand
+lyric_runtime::CallSiteCache::getDescriptor() const
+{
+    return m_descriptor;
+}
+
+/**
+ * Binds the cache to the specified call `section` and `address` and its resolved `descriptor`. If the
+ * cache was previously bound to a different section or address then all cached method resolutions are
+ * discarded.
+ *
+ * @param section The linkage section of the call address.
+ * @param address The call address.
+ * @param descriptor The descriptor resolved from the call address.
+ */
+void
+lyric_runtime::CallSiteCache::bind(
+    lyric_object::LinkageSection section,
+    tu_uint32 address,
+    const Operand &descriptor)
+{
+    if (m_section != section || m_address != address) {
+        m_numEntries = 0;
+        m_megamorphic = false;
+    }
+    m_section = section;
+    m_address = address;
+    m_descriptor = descriptor;
+}
+
+/**
+ * Returns the cached method for the specified `receiverKey` and `auxKey`, or nullptr if the method
+ * has not been cached for the call site.
+ *
+ * @param receiverKey The identity of the resolver.
+ * @param auxKey The additional lookup key, or nullptr.
+ * @return The cached method, or nullptr.
+ */
+const lyric_runtime::VirtualMethod *
+lyric_runtime::CallSiteCache::lookup(const void *receiverKey, const void *auxKey) const
+{
+    for (int i = 0; i < m_numEntries; i++) {
+        const auto &entry = m_entries[i];
+        if (entry.receiverKey == receiverKey && entry.auxKey == auxKey)
+            return entry.method;
+    }
+    return nullptr;
+}
+
+/**
+ * Caches the resolved `method` for the specified `receiverKey` and `auxKey`. If the cache is full then
+ * the call site is marked megamorphic and the method is not cached.
+ *
+ * @param receiverKey The identity of the resolver.
+ * @param auxKey The additional lookup key, or nullptr.
+ * @param method The resolved method.
+ */
+void
+lyric_runtime::CallSiteCache::insert(const void *receiverKey, const void *auxKey, const VirtualMethod *method)
+{
+    TU_ASSERT (receiverKey != nullptr);
+    TU_ASSERT (method != nullptr);
+
+    if (m_megamorphic)
+        return;
+    if (m_numEntries == kMaxCallSiteEntries) {
+        m_megamorphic = true;
+        return;
+    }
+    m_entries[m_numEntries++] = {receiverKey, auxKey, method};
+}
+
+int
+lyric_runtime::CallSiteCache::numEntries() const
+{
+    return m_numEntries;
+}
+
+bool
+lyric_runtime::CallSiteCache::isMegamorphic() const
+{
+    return m_megamorphic;
+}
@@ -1,6 +1,7 @@
 
 #include <queue>
 
+#include <lyric_runtime/bytes_ref.h>
 #include <lyric_runtime/connection.h>
 #include <lyric_runtime/interpreter_result.h>
 #include <tempo_utils/log_message.h>
@@ -300,6 +301,20 @@ lyric_runtime::Connection::send(std::shared_ptr<const tempo_utils::ImmutableByte
     return m_stream->sendPayload(std::move(payload));
 }
 
+/**
+ * Send the contents of `bytes` as the payload. If the BytesRef is a view of shared bytes then the
+ * underlying buffer is handed to the transport without copying.
+ *
+ * @param bytes The bytes to send.
+ * @return Ok status if the payload was sent, otherwise status describing the failure.
+ */
+tempo_utils::Status
+lyric_runtime::Connection::send(const BytesRef *bytes)
+{
+    TU_NOTNULL (bytes);
+    return m_stream->sendPayload(bytes->toImmutableBytes());
+}
+
 tempo_utils::Status
 lyric_runtime::Connection::shutdown()
 {
@@ -6,7 +6,8 @@ lyric_runtime::DescriptorEntry::DescriptorEntry(
     DescriptorTable *descriptorTable,
     tu_uint32 index)
     : m_descriptorTable(descriptorTable),
-      m_index(index)
+      m_index(index),
+      m_slot(lyric_object::INVALID_ADDRESS_U32)
 {
     TU_ASSERT (m_descriptorTable != nullptr);
     TU_ASSERT (m_index != lyric_object::INVALID_ADDRESS_U32);
@@ -36,6 +37,27 @@ lyric_runtime::DescriptorEntry::getDescriptorIndex() const
     return m_index;
 }
 
+/**
+ * Returns the vtable slot assigned to the descriptor, or INVALID_ADDRESS_U32 if no slot has been assigned.
+ * A field descriptor is assigned the layout offset of the field, and a call descriptor is assigned the
+ * method slot of the virtual table which first defines the method. The slot is assigned when the virtual
+ * table is linked and is the same in every descendant table, so resolving a member or method through the
+ * descriptor is a single array load.
+ *
+ * @return The slot number.
+ */
+tu_uint32
+lyric_runtime::DescriptorEntry::getSlot() const
+{
+    return m_slot;
+}
+
+void
+lyric_runtime::DescriptorEntry::setSlot(tu_uint32 slot)
+{
+    m_slot = slot;
+}
+
 lyric_common::SymbolUrl
 lyric_runtime::DescriptorEntry::getSymbolUrl() const
 {
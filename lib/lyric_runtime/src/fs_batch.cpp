@@ -0,0 +1,283 @@
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#include <lyric_runtime/fs_batch.h>
+#include <lyric_runtime/interpreter_state.h>
+#include <lyric_runtime/shared_bytes.h>
+#include <lyric_runtime/system_scheduler.h>
+#include <tempo_utils/log_stream.h>
+
+/**
+ * The initial buffer size when reading a file until end of file.
+ */
+constexpr tu_uint64 kReadUntilEofInitialCapacity = 64 * 1024;
+
+lyric_runtime::FsOperation
+lyric_runtime::FsOperation::read(uv_file file, std::vector<uv_buf_t> bufs, tu_int64 offset)
+{
+    FsOperation op;
+    op.kind = Kind::Read;
+    op.file = file;
+    op.bufs = std::move(bufs);
+    op.offset = offset;
+    return op;
+}
+
+lyric_runtime::FsOperation
+lyric_runtime::FsOperation::write(uv_file file, std::vector<uv_buf_t> bufs, tu_int64 offset)
+{
+    FsOperation op;
+    op.kind = Kind::Write;
+    op.file = file;
+    op.bufs = std::move(bufs);
+    op.offset = offset;
+    return op;
+}
+
+lyric_runtime::FsBatch::FsBatch(int numOperations)
+    : m_reqs(std::make_unique<uv_fs_t[]>(numOperations)),
+      m_results(numOperations, 0),
+      m_numOperations(numOperations),
+      m_numPending(0),
+      m_waiter(nullptr)
+{
+    TU_ASSERT (m_numOperations > 0);
+}
+
+int
+lyric_runtime::FsBatch::numOperations() const
+{
+    return m_numOperations;
+}
+
+int
+lyric_runtime::FsBatch::numPending() const
+{
+    return m_numPending;
+}
+
+/**
+ * Returns the result of the operation at the specified index, which is the number of bytes read or
+ * written if the operation succeeded, otherwise a negative uv error code.
+ *
+ * @param index The index of the operation in the batch.
+ * @return The operation result.
+ */
+tu_int64
+lyric_runtime::FsBatch::getResult(int index) const
+{
+    TU_ASSERT (0 <= index && index < m_numOperations);
+    return m_results[index];
+}
+
+/**
+ * Returns true if any operation in the batch failed, otherwise false.
+ */
+bool
+lyric_runtime::FsBatch::hasError() const
+{
+    for (auto result : m_results) {
+        if (result < 0)
+            return true;
+    }
+    return false;
+}
+
+lyric_runtime::FsReadFile::FsReadFile(uv_loop_t *loop, uv_file file)
+    : m_loop(loop),
+      m_file(file),
+      m_capacity(0),
+      m_size(0),
+      m_offset(0),
+      m_untilEof(false),
+      m_result(0),
+      m_inFlight(false),
+      m_waiter(nullptr)
+{
+    TU_NOTNULL (m_loop);
+    memset(&m_req, 0, sizeof(uv_fs_t));
+    m_req.data = this;
+}
+
+/**
+ * Returns 0 if the file was read successfully, otherwise a negative uv error code. If the file is larger
+ * than kMaxReadFileSize then UV_EFBIG is returned.
+ */
+int
+lyric_runtime::FsReadFile::getResult() const
+{
+    return m_result;
+}
+
+/**
+ * Returns the number of bytes read. This is less than the size reported by fstat if the file was
+ * truncated while it was being read.
+ */
+tu_uint64
+lyric_runtime::FsReadFile::getSize() const
+{
+    return m_size;
+}
+
+/**
+ * Returns the file contents. The buffer is shared rather than copied, so it can be handed on to the
+ * consumer without copying.
+ */
+std::shared_ptr<tu_uint8[]>
+lyric_runtime::FsReadFile::getData() const
+{
+    return m_data;
+}
+
+/**
+ * Returns the file contents as ImmutableBytes sharing the file buffer, which can be wrapped in a
+ * BytesRef or sent over a Connection without copying.
+ *
+ * @return The file contents, or nullptr if the read failed.
+ */
+std::shared_ptr<const tempo_utils::ImmutableBytes>
+lyric_runtime::FsReadFile::getBytes() const
+{
+    if (m_result < 0 || kMaxReadFileSize < m_size)
+        return {};
+    return std::make_shared<SharedArrayBytes>(m_data, static_cast<tu_uint32>(m_size));
+}
+
+/**
+ * Issue a read for the unread remainder of the file buffer. A file of known size is read at the
+ * buffer offset, otherwise the file is read from its current position, as a pipe or other file
+ * which is not seekable cannot be read at an explicit offset.
+ *
+ * @return 0 if the read was submitted, otherwise a negative uv error code.
+ */
+int
+lyric_runtime::FsReadFile::readNext()
+{
+    auto remaining = m_capacity - m_offset;
+    auto len = static_cast<unsigned int>(std::min<tu_uint64>(remaining, INT_MAX));
+    auto buf = uv_buf_init(reinterpret_cast<char *>(m_data.get() + m_offset), len);
+    auto position = m_untilEof? -1 : static_cast<int64_t>(m_offset);
+    return uv_fs_read(m_loop, &m_req, m_file, &buf, 1, position, on_read_file_read);
+}
+
+/**
+ * Doubles the capacity of the file buffer when reading until end of file, preserving the bytes read so
+ * far. The capacity is limited to kMaxReadFileSize.
+ *
+ * @return true if the buffer was grown, otherwise false if the buffer is already at the maximum size.
+ */
+bool
+lyric_runtime::FsReadFile::growBuffer()
+{
+    if (kMaxReadFileSize <= m_capacity)
+        return false;
+    auto capacity = std::min<tu_uint64>(m_capacity * 2, kMaxReadFileSize);
+    auto data = std::make_shared_for_overwrite<tu_uint8[]>(capacity);
+    memcpy(data.get(), m_data.get(), m_offset);
+    m_data = std::move(data);
+    m_capacity = capacity;
+    return true;
+}
+
+void
+lyric_runtime::on_batch_complete(uv_fs_t *req)
+{
+    auto *batch = static_cast<FsBatch *>(req->data);
+    auto index = static_cast<int>(req - batch->m_reqs.get());
+    batch->m_results[index] = req->result;
+    uv_fs_req_cleanup(req);
+
+    batch->m_numPending--;
+    if (batch->m_numPending > 0)
+        return;
+
+    // the waiter is detached if it was destroyed while operations were in flight
+    if (batch->m_waiter == nullptr) {
+        delete batch;
+        return;
+    }
+    auto *state = static_cast<InterpreterState *>(req->loop->data);
+    batch->m_waiter->complete(state);
+}
+
+void
+lyric_runtime::on_read_file_stat(uv_fs_t *req)
+{
+    auto *fileRead = static_cast<FsReadFile *>(req->data);
+    auto result = req->result;
+    auto size = static_cast<tu_uint64>(req->statbuf.st_size);
+    uv_fs_req_cleanup(req);
+
+    // the contents must fit in ImmutableBytes, so refuse rather than truncate a larger file
+    if (result >= 0 && kMaxReadFileSize < size) {
+        result = UV_EFBIG;
+    }
+
+    if (fileRead->m_waiter != nullptr && result >= 0) {
+        // a size of zero may not be the real size of the file, so read until end of file
+        if (size == 0) {
+            fileRead->m_untilEof = true;
+            size = kReadUntilEofInitialCapacity;
+        }
+        // allocate the file buffer once, the contents are overwritten by the reads
+        fileRead->m_data = std::make_shared_for_overwrite<tu_uint8[]>(size);
+        fileRead->m_capacity = size;
+        auto ret = fileRead->readNext();
+        if (ret == 0)
+            return;
+        result = ret;
+    }
+
+    fileRead->m_result = result < 0? static_cast<int>(result) : 0;
+    fileRead->m_inFlight = false;
+
+    // the waiter is detached if it was destroyed while the read was in flight
+    if (fileRead->m_waiter == nullptr) {
+        delete fileRead;
+        return;
+    }
+    auto *state = static_cast<InterpreterState *>(fileRead->m_loop->data);
+    fileRead->m_waiter->complete(state);
+}
+
+void
+lyric_runtime::on_read_file_read(uv_fs_t *req)
+{
+    auto *fileRead = static_cast<FsReadFile *>(req->data);
+    auto result = req->result;
+    uv_fs_req_cleanup(req);
+
+    if (result > 0) {
+        fileRead->m_offset += result;
+        // if reading until end of file and the buffer is full then grow the buffer
+        if (fileRead->m_waiter != nullptr && fileRead->m_untilEof && fileRead->m_offset == fileRead->m_capacity) {
+            if (!fileRead->growBuffer()) {
+                result = UV_EFBIG;
+            }
+        }
+        // read the remainder if the read was short, or continue reading until end of file
+        if (result > 0 && fileRead->m_waiter != nullptr && fileRead->m_offset < fileRead->m_capacity) {
+            auto ret = fileRead->readNext();
+            if (ret == 0)
+                return;
+            result = ret;
+        }
+    }
+
+    // on end of file the contents are truncated to the bytes actually read
+    if (result >= 0) {
+        fileRead->m_size = fileRead->m_offset;
+    }
+    fileRead->m_result = result < 0? static_cast<int>(result) : 0;
+    fileRead->m_inFlight = false;
+
+    // the waiter is detached if it was destroyed while the read was in flight
+    if (fileRead->m_waiter == nullptr) {
+        delete fileRead;
+        return;
+    }
+    auto *state = static_cast<InterpreterState *>(fileRead->m_loop->data);
+    fileRead->m_waiter->complete(state);
+}
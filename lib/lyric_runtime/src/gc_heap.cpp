@@ -1,14 +1,23 @@
 
+#include <limits>
+
 #include <lyric_runtime/gc_heap.h>
+#include <lyric_runtime/mark_stack.h>
 #include <tempo_utils/log_stream.h>
 
 lyric_runtime::GCHeap::GCHeap()
-    : m_handles(nullptr)
+    : m_numInstances(0),
+      m_sweepCursor(0),
+      m_sweepLimit(0),
+      m_sweeping(false),
+      m_handles(nullptr)
 {
 }
 
 lyric_runtime::GCHeap::~GCHeap()
 {
+    releasePermanentInstances();
+
     for (AbstractRef *instance : m_instances) {
         if (instance == nullptr)
             continue;
@@ -16,18 +25,55 @@ lyric_runtime::GCHeap::~GCHeap()
     }
 }
 
+/**
+ * Allocates uninitialized storage for an instance of the specified `size` from the global allocator.
+ *
+ * @param size The size of the instance in bytes.
+ * @return Pointer to the storage.
+ */
+void *
+lyric_runtime::GCHeap::allocateMemory(std::size_t size)
+{
+    return ::operator new(size);
+}
+
 uint32_t
 lyric_runtime::GCHeap::insertInstance(AbstractRef *obj)
 {
     auto offset = static_cast<uint32_t>(m_instances.size());
     m_instances.push_back(obj);
+    m_numInstances++;
     return offset;
 }
 
+/**
+ * Inserts the specified permanent `instance` into the heap. Permanent instances are never collected, so
+ * they are kept apart from the collectable instances and are not visited by the mark or sweep phases of
+ * a collection. Permanent instances are released when the heap is destroyed.
+ *
+ * @param instance The permanent instance.
+ */
+void
+lyric_runtime::GCHeap::insertPermanentInstance(AbstractRef *instance)
+{
+    TU_ASSERT (instance != nullptr);
+    m_permanentInstances.push_back(instance);
+}
+
+tu_uint32
+lyric_runtime::GCHeap::numPermanentInstances() const
+{
+    return m_permanentInstances.size();
+}
+
+/**
+ * Clears the reachable flag of every collectable instance. Clearing does not follow references, so the
+ * heap is cleared in a single flat pass over the instance list regardless of the shape of the object graph.
+ */
 void
 lyric_runtime::GCHeap::clearReachable()
 {
-    for (auto &instance : m_instances) {
+    for (auto *instance : m_instances) {
         if (instance != nullptr) {
             instance->clearReachable();
         }
@@ -37,18 +83,123 @@ lyric_runtime::GCHeap::clearReachable()
 void
 lyric_runtime::GCHeap::deleteUnreachable()
 {
+    if (!m_sweeping) {
+        beginSweep();
+    }
+    sweepUnreachable(std::numeric_limits<tu_uint32>::max());
+}
+
+tu_uint32
+lyric_runtime::GCHeap::numInstances() const
+{
+    return m_numInstances;
+}
+
+/**
+ * Begins the sweep phase of a collection. The reachable flag of every instance must have been set by the
+ * mark phase before the sweep begins. Only instances which were present when the sweep began are
+ * considered for deletion, so instances allocated while an incremental sweep is in progress are never
+ * swept by that sweep.
+ */
+void
+lyric_runtime::GCHeap::beginSweep()
+{
+    TU_ASSERT (!m_sweeping);
+
     // mark all handles as reachable
+    MarkStack markStack;
     for (HandlePriv *handle = m_handles; handle != nullptr; handle = handle->next) {
-        handle->instance->setReachable();
+        markStack.push(handle->instance);
+        if (handle->next == m_handles)
+            break;
     }
-    // deallocate all unreachable instances
-    for (tu_uint32 i = 0; i < m_instances.size(); i++) {
-        auto *instance = m_instances[i];
+    markStack.drain();
+
+    m_sweepCursor = 0;
+    m_sweepLimit = m_instances.size();
+    m_sweeping = true;
+}
+
+/**
+ * Deletes up to `maxInstances` unreachable instances. Once every instance present at the beginning of
+ * the sweep has been examined, the instance list is compacted to remove the slots of deleted instances
+ * and the sweep ends.
+ *
+ * @param maxInstances The maximum number of instances to examine.
+ * @return true if the sweep is complete, otherwise false.
+ */
+bool
+lyric_runtime::GCHeap::sweepUnreachable(tu_uint32 maxInstances)
+{
+    if (!m_sweeping)
+        return true;
+
+    tu_uint32 count = 0;
+    for (; m_sweepCursor < m_sweepLimit && count < maxInstances; m_sweepCursor++, count++) {
+        auto *instance = m_instances[m_sweepCursor];
         if (instance != nullptr && !instance->isReachable()) {
-            delete instance;
-            m_instances[i] = nullptr;
+            releaseInstance(instance);
+            m_instances[m_sweepCursor] = nullptr;
+            m_numInstances--;
         }
     }
+    if (m_sweepCursor < m_sweepLimit)
+        return false;
+
+    // compact the instance list, preserving the allocation order of the remaining instances
+    std::erase(m_instances, nullptr);
+    m_sweeping = false;
+    return true;
+}
+
+bool
+lyric_runtime::GCHeap::isSweeping() const
+{
+    return m_sweeping;
+}
+
+/**
+ * Destroys the specified unreachable `instance` and releases its storage.
+ *
+ * @param instance The instance to release.
+ */
+void
+lyric_runtime::GCHeap::releaseInstance(AbstractRef *instance)
+{
+    delete instance;
+}
+
+/**
+ * Releases all instances remaining in the heap regardless of whether they are reachable, abandoning any
+ * sweep in progress. A subclass which overrides releaseInstance must call this method from its destructor,
+ * before the storage backing the instances is released.
+ */
+void
+lyric_runtime::GCHeap::releaseInstances()
+{
+    for (AbstractRef *instance : m_instances) {
+        if (instance == nullptr)
+            continue;
+        releaseInstance(instance);
+    }
+    m_instances.clear();
+    m_numInstances = 0;
+    m_sweepCursor = 0;
+    m_sweepLimit = 0;
+    m_sweeping = false;
+}
+
+/**
+ * Releases all permanent instances. A subclass which overrides releaseInstance must call this method
+ * from its destructor, before the storage backing the permanent instances is released.
+ */
+void
+lyric_runtime::GCHeap::releasePermanentInstances()
+{
+    for (AbstractRef *instance : m_permanentInstances) {
+        releaseInstance(instance);
+    }
+    m_permanentInstances.clear();
 }
 
 void *
@@ -115,3 +266,4 @@ lyric_runtime::GCHeap::create()
 {
     return std::shared_ptr<GCHeap>(new GCHeap());
 }
+
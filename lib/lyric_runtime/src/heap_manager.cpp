@@ -1,10 +1,15 @@
 
+#include <chrono>
+#include <limits>
+
 #include <lyric_runtime/base_ref.h>
 #include <lyric_runtime/bytes_ref.h>
 #include <lyric_runtime/f64_ref.h>
 #include <lyric_runtime/heap_manager.h>
 #include <lyric_runtime/i64_ref.h>
+#include <lyric_runtime/mark_stack.h>
 #include <lyric_runtime/namespace_ref.h>
+#include <lyric_runtime/promise.h>
 #include <lyric_runtime/protocol_ref.h>
 #include <lyric_runtime/rest_ref.h>
 #include <lyric_runtime/status_ref.h>
@@ -16,35 +21,60 @@ lyric_runtime::HeapManager::HeapManager(
     PreludeTables preludeTables,
     SegmentManager *segmentManager,
     SystemScheduler *systemScheduler,
-    std::shared_ptr<AbstractHeap> heap)
+    std::shared_ptr<AbstractHeap> heap,
+    const CollectorOptions &collectorOptions)
     : m_preludeTables(std::move(preludeTables)),
       m_segmentManager(segmentManager),
       m_systemScheduler(systemScheduler),
-      m_heap(std::move(heap))
+      m_heap(std::move(heap)),
+      m_collectorOptions(collectorOptions),
+      m_collectionThreshold(0)
 {
     TU_ASSERT (m_heap != nullptr);
+    resetCollectionThreshold();
 }
 
+/**
+ * Allocate a boxed I64Ref on the heap. Note that the runtime represents all I64 values as unboxed operands,
+ * so this method exists only for compatibility with native code which expects boxed values. New code should
+ * use Operand::fromI64 instead, and code which consumes operands should call Operand::getI64 (or
+ * Operand::unboxed) which handles both representations.
+ *
+ * @param i64 The value.
+ * @return The boxed operand.
+ */
 lyric_runtime::Operand
 lyric_runtime::HeapManager::allocateI64(tu_int64 i64)
 {
-    auto *instance = new I64Ref(m_preludeTables.I64Table, i64);
+    auto *instance = new (allocateStorage<I64Ref>()) I64Ref(m_preludeTables.I64Table, i64);
     m_heap->insertInstance(instance);
     return Operand::fromI64(instance);
 }
 
+/**
+ * Allocate a boxed U64Ref on the heap. Retained for compatibility, see HeapManager::allocateI64.
+ *
+ * @param u64 The value.
+ * @return The boxed operand.
+ */
 lyric_runtime::Operand
 lyric_runtime::HeapManager::allocateU64(tu_uint64 u64)
 {
-    auto *instance = new U64Ref(m_preludeTables.U64Table, u64);
+    auto *instance = new (allocateStorage<U64Ref>()) U64Ref(m_preludeTables.U64Table, u64);
     m_heap->insertInstance(instance);
     return Operand::fromU64(instance);
 }
 
+/**
+ * Allocate a boxed F64Ref on the heap. Retained for compatibility, see HeapManager::allocateI64.
+ *
+ * @param f64 The value.
+ * @return The boxed operand.
+ */
 lyric_runtime::Operand
 lyric_runtime::HeapManager::allocateF64(double f64)
 {
-    auto *instance = new F64Ref(m_preludeTables.F64Table, f64);
+    auto *instance = new (allocateStorage<F64Ref>()) F64Ref(m_preludeTables.F64Table, f64);
     m_heap->insertInstance(instance);
     return Operand::fromF64(instance);
 }
@@ -52,7 +82,8 @@ lyric_runtime::HeapManager::allocateF64(double f64)
 lyric_runtime::Operand
 lyric_runtime::HeapManager::allocateString(std::string_view string, bool isPermanent)
 {
-    auto *instance = new StringRef(m_preludeTables.StringTable, string.data(), string.size());
+    auto *instance = new (allocateStorage<StringRef>()) StringRef(
+        m_preludeTables.StringTable, string.data(), string.size());
     if (isPermanent) {
         instance->setPermanent();
     }
@@ -63,7 +94,7 @@ lyric_runtime::HeapManager::allocateString(std::string_view string, bool isPerma
 lyric_runtime::Operand
 lyric_runtime::HeapManager::allocateString(tempo_utils::Rope<char> rope, bool isPermanent)
 {
-    auto *instance = new StringRef(m_preludeTables.StringTable, rope);
+    auto *instance = new (allocateStorage<StringRef>()) StringRef(m_preludeTables.StringTable, rope);
     if (isPermanent) {
         instance->setPermanent();
     }
@@ -71,6 +102,14 @@ lyric_runtime::HeapManager::allocateString(tempo_utils::Rope<char> rope, bool is
     return Operand::fromString(instance);
 }
 
+/**
+ * Pushes the string literal at the specified `address` onto the data stack. Each literal is materialized
+ * once per segment as a permanent StringRef which is interned in the segment literal pool, so repeated
+ * executions of the same literal share a single instance and do not allocate.
+ *
+ * @param address The address of the literal.
+ * @return Ok status if the literal was pushed, otherwise status describing the failure.
+ */
 tempo_utils::Status
 lyric_runtime::HeapManager::loadLiteralStringOntoStack(tu_uint32 address)
 {
@@ -79,13 +118,21 @@ lyric_runtime::HeapManager::loadLiteralStringOntoStack(tu_uint32 address)
     auto *sp = currentCoro->peekSP();
     TU_ASSERT (sp != nullptr);
 
-    tempo_utils::Status status;
-    auto literal = m_segmentManager->resolveString(sp, address, status);
-    TU_RETURN_IF_NOT_OK (status);
+    auto index = lyric_object::GET_DESCRIPTOR_OFFSET(address);
+    auto operand = sp->getStringLiteral(index);
+
+    if (!operand.isValid()) {
+        tempo_utils::Status status;
+        auto literal = m_segmentManager->resolveString(sp, address, status);
+        TU_RETURN_IF_NOT_OK (status);
+
+        auto *instance = new (allocateStorage<StringRef>()) StringRef(m_preludeTables.StringTable, literal);
+        instance->setPermanent();
+        m_heap->insertPermanentInstance(instance);
+        operand = Operand::fromString(instance);
+        sp->setStringLiteral(index, operand);
+    }
 
-    auto *instance = new StringRef(m_preludeTables.StringTable, literal);
-    m_heap->insertInstance(instance);
-    auto operand = Operand::fromString(instance);
     TU_RETURN_IF_NOT_OK (currentCoro->pushData(operand));
 
     return {};
@@ -97,7 +144,8 @@ lyric_runtime::HeapManager::loadStringOntoStack(std::string_view string)
     auto *currentCoro = m_systemScheduler->currentCoro();
     TU_ASSERT(currentCoro != nullptr);
 
-    auto *instance = new StringRef(m_preludeTables.StringTable, string.data(), string.size());
+    auto *instance = new (allocateStorage<StringRef>()) StringRef(
+        m_preludeTables.StringTable, string.data(), string.size());
     m_heap->insertInstance(instance);
     auto operand = Operand::fromString(instance);
     TU_RETURN_IF_NOT_OK (currentCoro->pushData(operand));
@@ -111,7 +159,7 @@ lyric_runtime::HeapManager::loadStringOntoStack(tempo_utils::Rope<char> rope)
     auto *currentCoro = m_systemScheduler->currentCoro();
     TU_ASSERT(currentCoro != nullptr);
 
-    auto *instance = new StringRef(m_preludeTables.StringTable, rope);
+    auto *instance = new (allocateStorage<StringRef>()) StringRef(m_preludeTables.StringTable, rope);
     m_heap->insertInstance(instance);
     auto operand = Operand::fromString(instance);
     TU_RETURN_IF_NOT_OK (currentCoro->pushData(operand));
@@ -122,7 +170,7 @@ lyric_runtime::HeapManager::loadStringOntoStack(tempo_utils::Rope<char> rope)
 lyric_runtime::Operand
 lyric_runtime::HeapManager::allocateBytes(std::span<const tu_uint8> bytes)
 {
-    auto *instance = new BytesRef(m_preludeTables.BytesTable, bytes.data(), bytes.size());
+    auto *instance = new (allocateStorage<BytesRef>()) BytesRef(m_preludeTables.BytesTable, bytes.data(), bytes.size());
     m_heap->insertInstance(instance);
     return Operand::fromBytes(instance);
 }
@@ -130,11 +178,52 @@ lyric_runtime::HeapManager::allocateBytes(std::span<const tu_uint8> bytes)
 lyric_runtime::Operand
 lyric_runtime::HeapManager::allocateBytes(tempo_utils::Rope<tu_uint8> rope)
 {
-    auto *instance = new BytesRef(m_preludeTables.BytesTable, rope);
+    auto *instance = new (allocateStorage<BytesRef>()) BytesRef(m_preludeTables.BytesTable, rope);
+    m_heap->insertInstance(instance);
+    return Operand::fromBytes(instance);
+}
+
+/**
+ * Allocates a BytesRef which shares ownership of `bytes` rather than copying them.
+ *
+ * @param bytes The shared bytes.
+ * @return The bytes operand.
+ */
+lyric_runtime::Operand
+lyric_runtime::HeapManager::allocateBytes(std::shared_ptr<const tempo_utils::ImmutableBytes> bytes)
+{
+    TU_NOTNULL (bytes);
+    auto size = bytes->getSize();
+    return allocateBytes(std::move(bytes), 0, size);
+}
+
+/**
+ * Allocates a BytesRef which is a view of the specified range of `bytes`. The range is not copied.
+ *
+ * @param bytes The shared bytes.
+ * @param offset The offset of the range.
+ * @param size The size of the range.
+ * @return The bytes operand.
+ */
+lyric_runtime::Operand
+lyric_runtime::HeapManager::allocateBytes(
+    std::shared_ptr<const tempo_utils::ImmutableBytes> bytes,
+    tu_uint32 offset,
+    tu_uint32 size)
+{
+    auto *instance = new (allocateStorage<BytesRef>()) BytesRef(
+        m_preludeTables.BytesTable, std::move(bytes), offset, size);
     m_heap->insertInstance(instance);
     return Operand::fromBytes(instance);
 }
 
+/**
+ * Pushes the bytes literal at the specified `address` onto the data stack. Like string literals, each
+ * bytes literal is materialized once per segment as a permanent BytesRef interned in the literal pool.
+ *
+ * @param address The address of the literal.
+ * @return Ok status if the literal was pushed, otherwise status describing the failure.
+ */
 tempo_utils::Status
 lyric_runtime::HeapManager::loadLiteralBytesOntoStack(tu_uint32 address)
 {
@@ -143,16 +232,24 @@ lyric_runtime::HeapManager::loadLiteralBytesOntoStack(tu_uint32 address)
     auto *sp = currentCoro->peekSP();
     TU_ASSERT (sp != nullptr);
 
-    tempo_utils::Status status;
-    auto literal = m_segmentManager->resolveString(sp, address, status);
-    TU_RETURN_IF_NOT_OK (status);
+    auto index = lyric_object::GET_DESCRIPTOR_OFFSET(address);
+    auto operand = sp->getBytesLiteral(index);
+
+    if (!operand.isValid()) {
+        tempo_utils::Status status;
+        auto literal = m_segmentManager->resolveString(sp, address, status);
+        TU_RETURN_IF_NOT_OK (status);
+
+        auto *instance = new (allocateStorage<BytesRef>()) BytesRef(m_preludeTables.BytesTable, literal);
+        instance->setPermanent();
+        m_heap->insertPermanentInstance(instance);
+        operand = Operand::fromBytes(instance);
+        sp->setBytesLiteral(index, operand);
+    }
 
-    auto *instance = new BytesRef(m_preludeTables.BytesTable, literal);
-    m_heap->insertInstance(instance);
-    auto operand = Operand::fromBytes(instance);
     TU_RETURN_IF_NOT_OK (currentCoro->pushData(operand));
 
-    return status;
+    return {};
 }
 
 tempo_utils::Status
@@ -161,7 +258,7 @@ lyric_runtime::HeapManager::loadBytesOntoStack(std::span<const tu_uint8> bytes)
     auto *currentCoro = m_systemScheduler->currentCoro();
     TU_ASSERT(currentCoro != nullptr);
 
-    auto *instance = new BytesRef(m_preludeTables.BytesTable, bytes.data(), bytes.size());
+    auto *instance = new (allocateStorage<BytesRef>()) BytesRef(m_preludeTables.BytesTable, bytes.data(), bytes.size());
     m_heap->insertInstance(instance);
     auto operand = Operand::fromBytes(instance);
     TU_RETURN_IF_NOT_OK (currentCoro->pushData(operand));
@@ -175,7 +272,7 @@ lyric_runtime::HeapManager::loadBytesOntoStack(tempo_utils::Rope<tu_uint8> rope)
     auto *currentCoro = m_systemScheduler->currentCoro();
     TU_ASSERT(currentCoro != nullptr);
 
-    auto *instance = new BytesRef(m_preludeTables.BytesTable, rope);
+    auto *instance = new (allocateStorage<BytesRef>()) BytesRef(m_preludeTables.BytesTable, rope);
     m_heap->insertInstance(instance);
     auto operand = Operand::fromBytes(instance);
     TU_RETURN_IF_NOT_OK (currentCoro->pushData(operand));
@@ -183,6 +280,21 @@ lyric_runtime::HeapManager::loadBytesOntoStack(tempo_utils::Rope<tu_uint8> rope)
     return {};
 }
 
+tempo_utils::Status
+lyric_runtime::HeapManager::loadBytesOntoStack(
+    std::shared_ptr<const tempo_utils::ImmutableBytes> bytes,
+    tu_uint32 offset,
+    tu_uint32 size)
+{
+    auto *currentCoro = m_systemScheduler->currentCoro();
+    TU_ASSERT(currentCoro != nullptr);
+
+    auto operand = allocateBytes(std::move(bytes), offset, size);
+    TU_RETURN_IF_NOT_OK (currentCoro->pushData(operand));
+
+    return {};
+}
+
 inline const lyric_runtime::VirtualTable *
 status_code_to_vtable(tempo_utils::StatusCode statusCode, const lyric_runtime::PreludeTables &preludeTables)
 {
@@ -227,7 +339,7 @@ status_code_to_vtable(tempo_utils::StatusCode statusCode, const lyric_runtime::P
 lyric_runtime::Operand
 lyric_runtime::HeapManager::allocateStatus(const VirtualTable *vtable)
 {
-    auto *instance = new StatusRef(vtable);
+    auto *instance = new (allocateStorage<StatusRef>()) StatusRef(vtable);
     m_heap->insertInstance(instance);
     return Operand::fromStatus(instance);
 }
@@ -235,10 +347,11 @@ lyric_runtime::HeapManager::allocateStatus(const VirtualTable *vtable)
 lyric_runtime::Operand
 lyric_runtime::HeapManager::allocateStatus(tempo_utils::StatusCode statusCode, std::string_view statusMessage)
 {
-    auto *messageRef = new StringRef(m_preludeTables.StringTable, statusMessage.data(), statusMessage.size());
+    auto *messageRef = new (allocateStorage<StringRef>()) StringRef(
+        m_preludeTables.StringTable, statusMessage.data(), statusMessage.size());
     m_heap->insertInstance(messageRef);
     const VirtualTable *vtable = status_code_to_vtable(statusCode, m_preludeTables);
-    auto *statusRef = new StatusRef(vtable, statusCode, messageRef);
+    auto *statusRef = new (allocateStorage<StatusRef>()) StatusRef(vtable, statusCode, messageRef);
     m_heap->insertInstance(statusRef);
     return Operand::fromStatus(statusRef);
 }
@@ -260,7 +373,7 @@ lyric_runtime::HeapManager::allocateRest(const CallCell &frame)
     for (int i = 0; i < frame.numRest(); i++) {
         restArgs.push_back(frame.getRest(i));
     }
-    auto *instance = new RestRef(m_preludeTables.RestTable, std::move(restArgs));
+    auto *instance = new (allocateStorage<RestRef>()) RestRef(m_preludeTables.RestTable, std::move(restArgs));
     m_heap->insertInstance(instance);
     return Operand::fromRest(instance);
 }
@@ -291,7 +404,8 @@ lyric_runtime::HeapManager::allocateProtocol(const Operand &descriptor)
     auto comm = walker.getCommunication();
     auto *protocolType = segment->lookupType(walker.getProtocolType().getDescriptorOffset());
 
-    auto *instance = new ProtocolRef(m_preludeTables.ProtocolTable, url, protocolDescriptor, protocolType, port, comm);
+    auto *instance = new (allocateStorage<ProtocolRef>()) ProtocolRef(
+        m_preludeTables.ProtocolTable, url, protocolDescriptor, protocolType, port, comm);
     m_heap->insertInstance(instance);
     return Operand::fromProtocol(instance);
 }
@@ -320,7 +434,8 @@ lyric_runtime::HeapManager::allocateNamespace(const Operand &descriptor)
     lyric_common::SymbolUrl url(segment->getObjectLocation(), walker.getSymbolPath());
     auto *namespaceType = segment->lookupType(walker.getNamespaceType().getDescriptorOffset());
 
-    auto *instance = new NamespaceRef(m_preludeTables.NamespaceTable, url, namespaceDescriptor, namespaceType);
+    auto *instance = new (allocateStorage<NamespaceRef>()) NamespaceRef(
+        m_preludeTables.NamespaceTable, url, namespaceDescriptor, namespaceType);
     m_heap->insertInstance(instance);
     return Operand::fromNamespace(instance);
 }
@@ -349,14 +464,45 @@ set_reachable_for_task(lyric_runtime::Task *task)
     while (iterator.getNext(operand)) {
         operand.setReachable();
     }
-}
 
-tempo_utils::Status
-lyric_runtime::HeapManager::collectGarbage() {
+    // walk the call stack and mark all instances reachable from a frame
+    for (auto it = coro->callsBegin(); it != coro->callsEnd(); it++) {
+        const auto &frame = *it;
+        frame.getReceiver().setReachable();
+        for (int i = 0; i < frame.numArguments(); i++) {
+            frame.getArgument(i).setReachable();
+        }
+        for (int i = 0; i < frame.numRest(); i++) {
+            frame.getRest(i).setReachable();
+        }
+        for (int i = 0; i < frame.numLocals(); i++) {
+            frame.getLocal(i).setReachable();
+        }
+        for (int i = 0; i < frame.numLexicals(); i++) {
+            frame.getLexical(i).setReachable();
+        }
+    }
 
+    // mark the result and dependencies of the task promise
+    if (task->hasPromise()) {
+        task->getPromise()->setReachable();
+    }
+}
+
+/**
+ * Clears the reachable flag of every heap instance and then marks every instance which is reachable from
+ * the roots: the data and call stacks of all tasks, the pending waiters, and the static storage of all
+ * loaded segments. Marking the roots pushes the referenced instances onto a mark stack, which is then
+ * drained, so marking never recurses through the object graph.
+ */
+void
+lyric_runtime::HeapManager::markReachable()
+{
     // clear reachable flag for all heap allocated instances
     m_heap->clearReachable();
 
+    MarkStack markStack;
+
     set_reachable_for_task(m_systemScheduler->currentTask());
 
     for (Task *task = m_systemScheduler->firstWaitingTask(); task != nullptr; task = task->nextTask()) {
@@ -368,18 +514,94 @@ lyric_runtime::HeapManager::collectGarbage() {
     }
 
     Waiter *waiterHead = m_systemScheduler->firstWaiter();
-    if (waiterHead != nullptr) {
-        Waiter *waiter = waiterHead;
-        Waiter *next = waiter->nextWaiter();
-        do {
-            waiter->setReachable();
-            waiter = next;
-            next = waiter->nextWaiter();
-        } while (next != nullptr && next != waiterHead);
+    for (Waiter *waiter = waiterHead; waiter != nullptr;) {
+        waiter->setReachable();
+        waiter = waiter->nextWaiter();
+        if (waiter == waiterHead)
+            break;
+    }
+
+    m_segmentManager->setReachable();
+
+    // trace every instance reachable from the roots
+    markStack.drain();
+}
+
+/**
+ * Sweeps unreachable instances in batches until the sweep completes or the pause limit is exceeded.
+ */
+void
+lyric_runtime::HeapManager::sweepWithinPause()
+{
+    constexpr tu_uint32 kSweepBatchSize = 256;
+
+    if (m_collectorOptions.maxPauseMicros == 0) {
+        m_heap->sweepUnreachable(std::numeric_limits<tu_uint32>::max());
+        resetCollectionThreshold();
+        return;
+    }
+
+    auto deadline = std::chrono::steady_clock::now()
+        + std::chrono::microseconds(m_collectorOptions.maxPauseMicros);
+    while (!m_heap->sweepUnreachable(kSweepBatchSize)) {
+        if (std::chrono::steady_clock::now() >= deadline)
+            return;
+    }
+    resetCollectionThreshold();
+}
+
+void
+lyric_runtime::HeapManager::resetCollectionThreshold()
+{
+    auto numInstances = static_cast<tu_uint64>(m_heap->numInstances());
+    auto threshold = numInstances + m_collectorOptions.allocationBudget;
+    m_collectionThreshold = static_cast<tu_uint32>(
+        std::min<tu_uint64>(threshold, std::numeric_limits<tu_uint32>::max()));
+}
+
+/**
+ * Collects all unreachable instances in a single stop-the-world pass. If an incremental sweep is in progress
+ * then it is completed before the heap is marked again.
+ */
+tempo_utils::Status
+lyric_runtime::HeapManager::collectGarbage()
+{
+    // finish any incremental sweep in progress using the marks from when the sweep began
+    if (m_heap->isSweeping()) {
+        m_heap->sweepUnreachable(std::numeric_limits<tu_uint32>::max());
     }
 
+    markReachable();
+
     // scan the heap and delete all unreachable instances
     m_heap->deleteUnreachable();
+    resetCollectionThreshold();
+
+    return {};
+}
+
+/**
+ * Performs a bounded amount of garbage collection work. If a sweep is in progress then the sweep is
+ * continued, otherwise if the number of instances allocated since the last collection exceeds the
+ * allocation budget then the heap is marked and a new sweep is started. Sweeping stops once the pause
+ * limit is exceeded and is resumed by the next step.
+ *
+ * This method must only be called when every live operand is reachable from a root, i.e. when no native
+ * code is holding operands outside of the interpreter stacks.
+ */
+tempo_utils::Status
+lyric_runtime::HeapManager::collectGarbageStep()
+{
+    if (!m_heap->isSweeping()) {
+        if (m_collectorOptions.allocationBudget == 0)
+            return {};
+        if (m_heap->numInstances() < m_collectionThreshold)
+            return {};
+        TU_LOG_V << "starting garbage collection with " << m_heap->numInstances() << " instances";
+        markReachable();
+        m_heap->beginSweep();
+    }
 
+    sweepWithinPause();
     return {};
 }
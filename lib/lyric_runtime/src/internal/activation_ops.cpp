@@ -126,7 +126,7 @@ lyric_runtime::internal::store(
     Operand value;
     TU_RETURN_IF_NOT_OK (currentCoro->popData(value));
 
-    switch (flags) {
+    switch (flags & lyric_object::STORE_TYPE_MASK) {
 
         case lyric_object::STORE_ARGUMENT: {
             activation->setArgument(address, value);
@@ -135,7 +135,11 @@ lyric_runtime::internal::store(
         }
 
         case lyric_object::STORE_LOCAL: {
-            activation->setLocal(address, value);
+            if (flags & lyric_object::STORE_INITIAL) {
+                activation->rebindLocal(address, value);
+            } else {
+                activation->setLocal(address, value);
+            }
             TU_LOG_V << "stored local " << value;
             return {};
         }
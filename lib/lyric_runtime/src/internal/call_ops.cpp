@@ -10,7 +10,7 @@ lyric_runtime::internal::call_static(
     tu_uint16 placement,
     tu_uint8 flags)
 {
-    std::vector<Operand> arguments;
+    auto &arguments = currentCoro->argumentWindow();
     TU_RETURN_IF_NOT_OK (currentCoro->popData(placement, arguments));
 
     // construct the activation call frame
@@ -27,10 +27,11 @@ lyric_runtime::internal::call_virtual(
     SubroutineManager *subroutineManager,
     tu_uint32 address,
     tu_uint16 placement,
-    tu_uint8 flags)
+    tu_uint8 flags,
+    CallSiteCache *callSite)
 {
     Operand receiver;
-    std::vector<Operand> arguments;
+    auto &arguments = currentCoro->argumentWindow();
 
     if (flags & lyric_object::CALL_RECEIVER_FOLLOWS) {
         // receiver comes after arguments so we pop receiver first
@@ -58,7 +59,7 @@ lyric_runtime::internal::call_virtual(
 
     // construct the activation call frame
     tempo_utils::Status status;
-    if (!subroutineManager->callVirtual(receiver, address, arguments, currentCoro, status))
+    if (!subroutineManager->callVirtual(receiver, address, arguments, currentCoro, status, callSite))
         return status;
 
     return {};
@@ -70,10 +71,11 @@ lyric_runtime::internal::call_stub(
     SubroutineManager *subroutineManager,
     tu_uint32 address,
     tu_uint16 placement,
-    tu_uint8 flags)
+    tu_uint8 flags,
+    CallSiteCache *callSite)
 {
     Operand receiver;
-    std::vector<Operand> arguments;
+    auto &arguments = currentCoro->argumentWindow();
 
     if (flags & lyric_object::CALL_RECEIVER_FOLLOWS) {
         // receiver comes after arguments so we pop receiver first
@@ -101,7 +103,7 @@ lyric_runtime::internal::call_stub(
 
     // construct the activation call frame
     tempo_utils::Status status;
-    if (!subroutineManager->callStub(receiver, address, arguments, currentCoro, status))
+    if (!subroutineManager->callStub(receiver, address, arguments, currentCoro, status, callSite))
         return status;
 
     return {};
@@ -113,10 +115,11 @@ lyric_runtime::internal::call_concept(
     SubroutineManager *subroutineManager,
     tu_uint32 address,
     tu_uint16 placement,
-    tu_uint8 flags)
+    tu_uint8 flags,
+    CallSiteCache *callSite)
 {
     Operand receiver;
-    std::vector<Operand> arguments;
+    auto &arguments = currentCoro->argumentWindow();
     Operand descriptor;
 
     TU_RETURN_IF_NOT_OK (currentCoro->popData(descriptor));
@@ -146,7 +149,8 @@ lyric_runtime::internal::call_concept(
 
     // construct the activation call frame
     tempo_utils::Status status;
-    if (!subroutineManager->callConcept(receiver, descriptor, address, arguments, currentCoro, status))
+    if (!subroutineManager->callConcept(
+        receiver, descriptor, address, arguments, currentCoro, status, callSite))
         return status;
 
     return {};
@@ -158,10 +162,11 @@ lyric_runtime::internal::call_existential(
     SubroutineManager *subroutineManager,
     tu_uint32 address,
     tu_uint16 placement,
-    tu_uint8 flags)
+    tu_uint8 flags,
+    CallSiteCache *callSite)
 {
     Operand receiver;
-    std::vector<Operand> arguments;
+    auto &arguments = currentCoro->argumentWindow();
     Operand descriptor;
 
     TU_RETURN_IF_NOT_OK (currentCoro->popData(descriptor));
@@ -179,7 +184,7 @@ lyric_runtime::internal::call_existential(
     // construct the activation call frame
     tempo_utils::Status status;
     if (!subroutineManager->callExistential(
-        receiver, descriptor, address, arguments, currentCoro, status))
+        receiver, descriptor, address, arguments, currentCoro, status, callSite))
         return status;
 
     return {};
@@ -90,6 +90,24 @@ tempo_utils::Status apply_is_less_or_equal(
 tempo_utils::Status
 lyric_runtime::internal::compare(const Operand &lhs, const Operand &rhs, Operand &result)
 {
+    // fast path for the common case where both operands are I64 or both are F64
+    tu_int64 li, ri;
+    if (lhs.getI64(li) && rhs.getI64(ri)) [[likely]] {
+        result = Operand::fromI64(li < ri? -1 : li == ri? 0 : 1);
+        return {};
+    }
+    double lf, rf;
+    if (lhs.getF64(lf) && rhs.getF64(rf)) {
+        tu_int64 cmp;
+        if (lf <= rf) {
+            cmp = lf == rf? 0 : -1;
+        } else {
+            cmp = 1;
+        }
+        result = Operand::fromI64(cmp);
+        return {};
+    }
+
     switch (lhs.getType()) {
         case OperandType::Bool:    return apply_compare<bool>(lhs, rhs, result);
         case OperandType::UInt8:   return apply_compare<tu_uint8>(lhs, rhs, result);
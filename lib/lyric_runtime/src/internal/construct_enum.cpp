@@ -70,9 +70,9 @@ lyric_runtime::internal::construct_enum(
     auto procOffset = ctor->getProcOffset();
 
     // parse the proc
-    auto bytecode = ctorSegment->getBytecode();
-    lyric_object::ProcInfo procInfo;
-    TU_RETURN_IF_NOT_OK (lyric_object::parse_proc_info(bytecode, procOffset, procInfo));
+    const ProcMetadata *procMetadata;
+    TU_RETURN_IF_NOT_OK (ctorSegment->getProcMetadata(procOffset, &procMetadata));
+    const auto &procInfo = procMetadata->getProcInfo();
 
     // calculate the stack guard
     auto stackGuard = currentCoro->dataStackSize();
@@ -90,7 +90,7 @@ lyric_runtime::internal::construct_enum(
         0, 0, procInfo.num_locals, 0, {}, ref);
 
     lyric_object::BytecodeIterator ip(procInfo.code);
-    currentCoro->pushCall(frame, ip, ctorSegment);               // push the activation onto the call stack
+    currentCoro->pushCall(std::move(frame), ip, ctorSegment);    // push the activation onto the call stack
     TU_LOG_V << "moved ip to " << ip;
 
     // reenter the interpreter to invoke the enum ctor
@@ -119,9 +119,9 @@ lyric_runtime::internal::construct_new(
     const auto procOffset = ctor.getProcOffset();
 
     // parse the proc
-    auto bytecode = ctorSegment->getBytecode();
-    lyric_object::ProcInfo procInfo;
-    TU_RETURN_IF_NOT_OK (lyric_object::parse_proc_info(bytecode, procOffset, procInfo));
+    const ProcMetadata *procMetadata;
+    TU_RETURN_IF_NOT_OK (ctorSegment->getProcMetadata(procOffset, &procMetadata));
+    const auto &procInfo = procMetadata->getProcInfo();
 
     // calculate the stack guard
     auto stackGuard = currentCoro->dataStackSize();
@@ -137,11 +137,11 @@ lyric_runtime::internal::construct_new(
 
     // if any lexicals are present then import them
     if (procInfo.num_lexicals > 0) {
-        TU_RETURN_IF_NOT_OK (import_lexicals_into_frame(procInfo, currentCoro, ctorSegment, frame));
+        TU_RETURN_IF_NOT_OK (import_lexicals_into_frame(*procMetadata, currentCoro, ctorSegment, frame));
     }
 
     lyric_object::BytecodeIterator ip(procInfo.code);
-    currentCoro->pushCall(frame, ip, ctorSegment);               // push the activation onto the call stack
+    currentCoro->pushCall(std::move(frame), ip, ctorSegment);    // push the activation onto the call stack
     TU_LOG_V << "moved ip to " << ip;
 
     return {};
@@ -1,4 +1,6 @@
 
+#include <limits>
+
 #include <boost/safe_numerics/checked_default.hpp>
 
 #include <lyric_runtime/internal/numeric_ops.h>
@@ -89,9 +91,49 @@ tempo_utils::Status apply_neg(
     return {};
 }
 
+/**
+ * Fast path for the common case where both operands are I64 or both are F64, which bypasses the type
+ * dispatch and value conversion of the generic path. Returns true if the result was computed. Returns
+ * false if the operands have any other type or the integer op reports an error, in which case the caller
+ * falls back to the generic path, which produces the same error for the operation.
+ */
+template<class IntOp, class FloatOp>
+static inline bool
+try_binary_fast_path(
+    const lyric_runtime::Operand &lhs,
+    const lyric_runtime::Operand &rhs,
+    lyric_runtime::Operand &result,
+    IntOp &&intOp,
+    FloatOp &&floatOp)
+{
+    tu_int64 li, ri;
+    if (lhs.getI64(li)) {
+        tu_int64 i64;
+        if (!rhs.getI64(ri) || !intOp(li, ri, i64)) [[unlikely]]
+            return false;
+        result = lyric_runtime::Operand::fromI64(i64);
+        return true;
+    }
+    double lf, rf;
+    if (lhs.getF64(lf)) {
+        double f64;
+        if (!rhs.getF64(rf) || !floatOp(lf, rf, f64)) [[unlikely]]
+            return false;
+        result = lyric_runtime::Operand::fromF64(f64);
+        return true;
+    }
+    return false;
+}
+
 tempo_utils::Status
 lyric_runtime::internal::add(HeapManager *heapManager, const Operand &lhs, const Operand &rhs, Operand &result)
 {
+    auto fastPath = try_binary_fast_path(lhs, rhs, result,
+        [](tu_int64 l, tu_int64 r, tu_int64 &i64) { return !__builtin_add_overflow(l, r, &i64); },
+        [](double l, double r, double &f64) { f64 = l + r; return true; });
+    if (fastPath) [[likely]]
+        return {};
+
     switch (lhs.getType()) {
         case OperandType::UInt8:    return apply_add<tu_uint8>(heapManager, lhs, rhs, result);
         case OperandType::UInt16:   return apply_add<tu_uint16>(heapManager, lhs, rhs, result);
@@ -112,6 +154,12 @@ lyric_runtime::internal::add(HeapManager *heapManager, const Operand &lhs, const
 tempo_utils::Status
 lyric_runtime::internal::sub(HeapManager *heapManager, const Operand &lhs, const Operand &rhs, Operand &result)
 {
+    auto fastPath = try_binary_fast_path(lhs, rhs, result,
+        [](tu_int64 l, tu_int64 r, tu_int64 &i64) { return !__builtin_sub_overflow(l, r, &i64); },
+        [](double l, double r, double &f64) { f64 = l - r; return true; });
+    if (fastPath) [[likely]]
+        return {};
+
     switch (lhs.getType()) {
         case OperandType::UInt8:    return apply_sub<tu_uint8>(heapManager, lhs, rhs, result);
         case OperandType::UInt16:   return apply_sub<tu_uint16>(heapManager, lhs, rhs, result);
@@ -132,6 +180,12 @@ lyric_runtime::internal::sub(HeapManager *heapManager, const Operand &lhs, const
 tempo_utils::Status
 lyric_runtime::internal::mul(HeapManager *heapManager, const Operand &lhs, const Operand &rhs, Operand &result)
 {
+    auto fastPath = try_binary_fast_path(lhs, rhs, result,
+        [](tu_int64 l, tu_int64 r, tu_int64 &i64) { return !__builtin_mul_overflow(l, r, &i64); },
+        [](double l, double r, double &f64) { f64 = l * r; return true; });
+    if (fastPath) [[likely]]
+        return {};
+
     switch (lhs.getType()) {
         case OperandType::UInt8:    return apply_mul<tu_uint8>(heapManager, lhs, rhs, result);
         case OperandType::UInt16:   return apply_mul<tu_uint16>(heapManager, lhs, rhs, result);
@@ -152,6 +206,23 @@ lyric_runtime::internal::mul(HeapManager *heapManager, const Operand &lhs, const
 tempo_utils::Status
 lyric_runtime::internal::div(HeapManager *heapManager, const Operand &lhs, const Operand &rhs, Operand &result)
 {
+    // division by zero (and the one overflowing integer quotient) is left to the generic path
+    auto fastPath = try_binary_fast_path(lhs, rhs, result,
+        [](tu_int64 l, tu_int64 r, tu_int64 &i64) {
+            if (r == 0 || (r == -1 && l == std::numeric_limits<tu_int64>::min()))
+                return false;
+            i64 = l / r;
+            return true;
+        },
+        [](double l, double r, double &f64) {
+            if (r == 0.0)
+                return false;
+            f64 = l / r;
+            return true;
+        });
+    if (fastPath) [[likely]]
+        return {};
+
     switch (lhs.getType()) {
         case OperandType::UInt8:    return apply_div<tu_uint8>(heapManager, lhs, rhs, result);
         case OperandType::UInt16:   return apply_div<tu_uint16>(heapManager, lhs, rhs, result);
@@ -1,6 +1,12 @@
 
 #include <lyric_runtime/internal/raise_exception.h>
 
+/**
+ * Raises the exception `exc`, unwinding the call stack until a frame is found with a catch handler
+ * matching the exception type, and transfers control to the handler. The active handlers for each frame
+ * are found with a single lookup in the precomputed handler table of the proc, so the cost of raising is
+ * proportional to the number of frames unwound.
+ */
 tempo_utils::Status
 lyric_runtime::internal::raise_exception(
     const lyric_object::OpCell &op,
@@ -11,12 +17,7 @@ lyric_runtime::internal::raise_exception(
     TypeManager *typeManager)
 {
     CallCell *frame = nullptr;
-    BytecodeSegment *segment = nullptr;
-    std::vector<lyric_object::ProcCheck> checks;
-    std::vector<lyric_object::ProcException> exceptions;
-    lyric_object::CallWalker call;
-    int exception_match = -1;
-    int exception_local = -1;
+    const ProcHandler *match = nullptr;
 
     // get the runtime type of the exception
     Operand excType;
@@ -29,53 +30,34 @@ lyric_runtime::internal::raise_exception(
     TU_RETURN_IF_NOT_OK (currentCoro->peekCall(&frame));
     auto initialSegmentIndex = frame->getCallSegment();
 
+    // in the raising frame the exception is raised at the offset of the raise instruction
+    tu_uint32 offset = op.offset;
+
     for (;;) {
         auto segmentIndex = frame->getCallSegment();
         if (segmentIndex != initialSegmentIndex)
             return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
                 "exception cannot cross the segment boundary");
 
-        segment = segmentManager->getSegment(segmentIndex);
+        auto *segment = segmentManager->getSegment(segmentIndex);
         TU_ASSERT (segment != nullptr);
 
-        auto object = segment->getObject();
-        call = object.getCall(frame->getCallIndex());
-        TU_ASSERT (call.isValid());
-
-        lyric_object::ProcInfo procInfo;
-        TU_ASSIGN_OR_RETURN (procInfo, call.getProcInfo());
-
-        lyric_object::TrailerInfo trailerInfo;
-        TU_RETURN_IF_NOT_OK (lyric_object::parse_proc_trailer(procInfo, trailerInfo));
-        TU_RETURN_IF_NOT_OK (lyric_object::parse_checks_table(trailerInfo, checks));
-        TU_RETURN_IF_NOT_OK (lyric_object::parse_exceptions_table(trailerInfo, exceptions));
-
-        // find the most specific exception entry in the current activation which matches the exception
-        for (int i = 0; exception_match < 0 &&  i < checks.size(); i++) {
-            const auto &check = checks.at(i);
-
-            if (check.interval_offset <= op.offset && op.offset < (check.interval_offset + check.interval_size)) {
-                for (int j = 0; exception_match < 0 && j < check.num_exceptions; j++) {
-                    const auto &exception = exceptions.at(check.first_exception + j);
-                    auto *typeEntry = segment->lookupType(exception.exception_type);
-                    auto catchType = Operand::fromType(typeEntry);
-                    TypeComparison cmp;
-                    TU_ASSIGN_OR_RETURN (cmp, typeManager->compareTypes(excType, catchType));
-                    switch (cmp) {
-                        case TypeComparison::EQUAL:
-                        case TypeComparison::EXTENDS:
-                            exception_local = check.exception_local;
-                            exception_match = check.first_exception + j;
-                            break;
-                        default:
-                            break;
-                    }
-                }
+        const ProcMetadata *procMetadata;
+        TU_RETURN_IF_NOT_OK (segment->getProcMetadata(frame->getProcOffset(), &procMetadata));
+
+        // find the first handler active at the offset which matches the exception
+        for (const auto &handler : procMetadata->findHandlers(offset)) {
+            auto catchType = Operand::fromType(segment->lookupType(handler.exception_type));
+            TypeComparison cmp;
+            TU_ASSIGN_OR_RETURN (cmp, typeManager->compareTypes(excType, catchType));
+            if (cmp == TypeComparison::EQUAL || cmp == TypeComparison::EXTENDS) {
+                match = &handler;
+                break;
             }
         }
 
-        // if there is a matching exception then run the catch handler
-        if (0 <= exception_match)
+        // if there is a matching handler then run the catch handler
+        if (match != nullptr)
             break;
 
         // otherwise return to caller and continue searching for a matching catch
@@ -84,17 +66,21 @@ lyric_runtime::internal::raise_exception(
             return status;
 
         TU_RETURN_IF_NOT_OK (currentCoro->peekCall(&frame));
+
+        // in a calling frame the exception is raised at the call instruction, which ends immediately
+        // before the return address
+        auto returnIP = currentCoro->peekIP();
+        offset = static_cast<tu_uint32>(returnIP.getCurr() - returnIP.getBase()) - 1;
     }
 
     // store the exception ref in the assigned local variable
-    frame->setLocal(exception_local, exc);
+    frame->setLocal(match->exception_local, exc);
 
     // construct a new iterator starting at the exception catch and transfer control
-    auto &exception = exceptions.at(exception_match);
     auto ip = currentCoro->peekIP();
-    ip.reset(exception.catch_offset);
+    ip.reset(match->catch_offset);
     TU_ASSERT (ip.isValid());
     currentCoro->transferControl(ip);
 
     return {};
-}
\ No newline at end of file
+}
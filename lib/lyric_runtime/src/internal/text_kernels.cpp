@@ -0,0 +1,336 @@
+
+#include <bit>
+#include <cstring>
+
+#include <lyric_runtime/internal/text_kernels.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define LYRIC_RUNTIME_TEXT_KERNELS_X86_64
+#include <immintrin.h>
+#endif
+
+/*
+ * scalar implementations
+ */
+
+static size_t
+scalar_mismatch_bytes(const char *lhs, const char *rhs, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        if (lhs[i] != rhs[i])
+            return i;
+    }
+    return size;
+}
+
+static size_t
+scalar_ascii_prefix_length(const char *data, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        if (static_cast<unsigned char>(data[i]) & 0x80)
+            return i;
+    }
+    return size;
+}
+
+static size_t
+scalar_count_code_points(const char *data, size_t size)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < size; i++) {
+        // count every byte which is not a continuation byte
+        if ((static_cast<unsigned char>(data[i]) & 0xC0) != 0x80) {
+            count++;
+        }
+    }
+    return count;
+}
+
+static size_t
+scalar_find_byte(const char *data, size_t size, char byte)
+{
+    auto *found = static_cast<const char *>(std::memchr(data, byte, size));
+    return found != nullptr? found - data : lyric_runtime::internal::kNotFound;
+}
+
+static size_t
+scalar_find_bytes(const char *data, size_t size, const char *needle, size_t needleSize)
+{
+    for (size_t i = 0; i + needleSize <= size; i++) {
+        auto offset = scalar_find_byte(data + i, size - i - needleSize + 1, needle[0]);
+        if (offset == lyric_runtime::internal::kNotFound)
+            break;
+        i += offset;
+        if (std::memcmp(data + i + 1, needle + 1, needleSize - 1) == 0)
+            return i;
+    }
+    return lyric_runtime::internal::kNotFound;
+}
+
+#ifdef LYRIC_RUNTIME_TEXT_KERNELS_X86_64
+
+/*
+ * SSE2 implementations. SSE2 is part of the x86-64 baseline so these require no runtime check.
+ */
+
+static size_t
+sse2_mismatch_bytes(const char *lhs, const char *rhs, size_t size)
+{
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        auto l = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lhs + i));
+        auto r = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rhs + i));
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(l, r)));
+        if (mask != 0xFFFF)
+            return i + std::countr_zero(~mask);
+    }
+    return i + scalar_mismatch_bytes(lhs + i, rhs + i, size - i);
+}
+
+static size_t
+sse2_ascii_prefix_length(const char *data, size_t size)
+{
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(v));
+        if (mask != 0)
+            return i + std::countr_zero(mask);
+    }
+    return i + scalar_ascii_prefix_length(data + i, size - i);
+}
+
+static size_t
+sse2_count_code_points(const char *data, size_t size)
+{
+    // continuation bytes are 0x80-0xBF, which as signed bytes are less than -64
+    auto threshold = _mm_set1_epi8(-65);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi8(v, threshold)));
+        count += std::popcount(mask);
+    }
+    return count + scalar_count_code_points(data + i, size - i);
+}
+
+static size_t
+sse2_find_byte(const char *data, size_t size, char byte)
+{
+    auto b = _mm_set1_epi8(byte);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, b)));
+        if (mask != 0)
+            return i + std::countr_zero(mask);
+    }
+    auto offset = scalar_find_byte(data + i, size - i, byte);
+    return offset != lyric_runtime::internal::kNotFound? i + offset : offset;
+}
+
+/**
+ * Finds candidate positions by comparing blocks of the haystack against the first and last bytes of the
+ * needle simultaneously, and verifies each candidate with memcmp.
+ */
+static size_t
+sse2_find_bytes(const char *data, size_t size, const char *needle, size_t needleSize)
+{
+    auto first = _mm_set1_epi8(needle[0]);
+    auto last = _mm_set1_epi8(needle[needleSize - 1]);
+    size_t i = 0;
+    for (; i + needleSize - 1 + 16 <= size; i += 16) {
+        auto f = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        auto l = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + needleSize - 1));
+        auto eq = _mm_and_si128(_mm_cmpeq_epi8(f, first), _mm_cmpeq_epi8(l, last));
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(eq));
+        while (mask != 0) {
+            auto bit = std::countr_zero(mask);
+            if (std::memcmp(data + i + bit + 1, needle + 1, needleSize - 2) == 0)
+                return i + bit;
+            mask &= mask - 1;
+        }
+    }
+    auto offset = scalar_find_bytes(data + i, size - i, needle, needleSize);
+    return offset != lyric_runtime::internal::kNotFound? i + offset : offset;
+}
+
+/*
+ * AVX2 implementations, selected at runtime.
+ */
+
+__attribute__((target("avx2"))) static size_t
+avx2_mismatch_bytes(const char *lhs, const char *rhs, size_t size)
+{
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        auto l = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lhs + i));
+        auto r = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rhs + i));
+        auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(l, r)));
+        if (mask != 0xFFFFFFFFu)
+            return i + std::countr_zero(~mask);
+    }
+    return i + sse2_mismatch_bytes(lhs + i, rhs + i, size - i);
+}
+
+__attribute__((target("avx2"))) static size_t
+avx2_ascii_prefix_length(const char *data, size_t size)
+{
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        auto mask = static_cast<unsigned>(_mm256_movemask_epi8(v));
+        if (mask != 0)
+            return i + std::countr_zero(mask);
+    }
+    return i + sse2_ascii_prefix_length(data + i, size - i);
+}
+
+__attribute__((target("avx2"))) static size_t
+avx2_count_code_points(const char *data, size_t size)
+{
+    auto threshold = _mm256_set1_epi8(-65);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(v, threshold)));
+        count += std::popcount(mask);
+    }
+    return count + sse2_count_code_points(data + i, size - i);
+}
+
+__attribute__((target("avx2"))) static size_t
+avx2_find_byte(const char *data, size_t size, char byte)
+{
+    auto b = _mm256_set1_epi8(byte);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, b)));
+        if (mask != 0)
+            return i + std::countr_zero(mask);
+    }
+    auto offset = sse2_find_byte(data + i, size - i, byte);
+    return offset != lyric_runtime::internal::kNotFound? i + offset : offset;
+}
+
+__attribute__((target("avx2"))) static size_t
+avx2_find_bytes(const char *data, size_t size, const char *needle, size_t needleSize)
+{
+    auto first = _mm256_set1_epi8(needle[0]);
+    auto last = _mm256_set1_epi8(needle[needleSize - 1]);
+    size_t i = 0;
+    for (; i + needleSize - 1 + 32 <= size; i += 32) {
+        auto f = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        auto l = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + needleSize - 1));
+        auto eq = _mm256_and_si256(_mm256_cmpeq_epi8(f, first), _mm256_cmpeq_epi8(l, last));
+        auto mask = static_cast<unsigned>(_mm256_movemask_epi8(eq));
+        while (mask != 0) {
+            auto bit = std::countr_zero(mask);
+            if (std::memcmp(data + i + bit + 1, needle + 1, needleSize - 2) == 0)
+                return i + bit;
+            mask &= mask - 1;
+        }
+    }
+    auto offset = sse2_find_bytes(data + i, size - i, needle, needleSize);
+    return offset != lyric_runtime::internal::kNotFound? i + offset : offset;
+}
+
+#endif // LYRIC_RUNTIME_TEXT_KERNELS_X86_64
+
+struct TextKernels {
+    const char *implementation;
+    size_t (*mismatchBytes)(const char *, const char *, size_t);
+    size_t (*asciiPrefixLength)(const char *, size_t);
+    size_t (*countCodePoints)(const char *, size_t);
+    size_t (*findByte)(const char *, size_t, char);
+    size_t (*findBytes)(const char *, size_t, const char *, size_t);
+};
+
+static TextKernels
+select_text_kernels()
+{
+#ifdef LYRIC_RUNTIME_TEXT_KERNELS_X86_64
+    if (__builtin_cpu_supports("avx2")) {
+        return {"avx2", avx2_mismatch_bytes, avx2_ascii_prefix_length, avx2_count_code_points,
+            avx2_find_byte, avx2_find_bytes};
+    }
+    return {"sse2", sse2_mismatch_bytes, sse2_ascii_prefix_length, sse2_count_code_points,
+        sse2_find_byte, sse2_find_bytes};
+#else
+    return {"scalar", scalar_mismatch_bytes, scalar_ascii_prefix_length, scalar_count_code_points,
+        scalar_find_byte, scalar_find_bytes};
+#endif
+}
+
+static const TextKernels &
+text_kernels()
+{
+    static const TextKernels kernels = select_text_kernels();
+    return kernels;
+}
+
+/**
+ * Returns the offset of the first byte which differs between `lhs` and `rhs`, or `size` if the ranges
+ * are equal.
+ */
+size_t
+lyric_runtime::internal::mismatch_bytes(const char *lhs, const char *rhs, size_t size)
+{
+    return text_kernels().mismatchBytes(lhs, rhs, size);
+}
+
+/**
+ * Returns the number of leading bytes in `data` which are ASCII.
+ */
+size_t
+lyric_runtime::internal::ascii_prefix_length(const char *data, size_t size)
+{
+    return text_kernels().asciiPrefixLength(data, size);
+}
+
+/**
+ * Returns the number of UTF-8 code points in `data`, which is the number of bytes which are not
+ * continuation bytes. The contents are assumed to be well-formed UTF-8.
+ */
+size_t
+lyric_runtime::internal::count_code_points(const char *data, size_t size)
+{
+    return text_kernels().countCodePoints(data, size);
+}
+
+/**
+ * Returns the offset of the first occurrence of `byte` in `data`, or kNotFound.
+ */
+size_t
+lyric_runtime::internal::find_byte(const char *data, size_t size, char byte)
+{
+    return text_kernels().findByte(data, size, byte);
+}
+
+/**
+ * Returns the offset of the first occurrence of `needle` in `data`, or kNotFound. An empty needle is
+ * found at offset 0.
+ */
+size_t
+lyric_runtime::internal::find_bytes(const char *data, size_t size, const char *needle, size_t needleSize)
+{
+    if (needleSize == 0)
+        return 0;
+    if (size < needleSize)
+        return kNotFound;
+    if (needleSize == 1)
+        return text_kernels().findByte(data, size, needle[0]);
+    return text_kernels().findBytes(data, size, needle, needleSize);
+}
+
+/**
+ * Returns the name of the kernel implementation selected for this processor.
+ */
+const char *
+lyric_runtime::internal::text_kernels_implementation()
+{
+    return text_kernels().implementation;
+}
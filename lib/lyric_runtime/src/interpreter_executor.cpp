@@ -0,0 +1,497 @@
+#include <lyric_runtime/interpreter_executor.h>
+#include <lyric_runtime/interpreter_result.h>
+#include <tempo_utils/log_stream.h>
+
+/**
+ * The interval in milliseconds at which a parked job is retried if the system loop of its interpreter
+ * state has no pollable backend.
+ */
+constexpr int kParkedRetryIntervalMillis = 1;
+
+namespace lyric_runtime {
+
+    /**
+     * A job parked on the reactor loop, waiting for an event on the system loop of its interpreter state.
+     * The parked job is freed once all of its handles are closed.
+     */
+    struct ParkedJob {
+        InterpreterExecutor *executor = nullptr;
+        ExecutorJob *job = nullptr;
+        uv_poll_t poll;
+        uv_timer_t timer;
+        int numOpen = 0;
+        bool fired = false;
+    };
+}
+
+lyric_runtime::InterpreterExecutor::InterpreterExecutor(const ExecutorOptions &options)
+    : m_options(options),
+      m_reactorTid(),
+      m_reactorLoop(),
+      m_reactorAsync(),
+      m_running(false),
+      m_stopping(false),
+      m_numRunnable(0),
+      m_numOutstanding(0),
+      m_nextWorker(0),
+      m_reactorStopping(false)
+{
+    if (m_options.numWorkers <= 0) {
+        m_options.numWorkers = static_cast<int>(uv_available_parallelism());
+    }
+    if (m_options.slicesPerQuantum <= 0) {
+        m_options.slicesPerQuantum = ExecutorOptions{}.slicesPerQuantum;
+    }
+}
+
+lyric_runtime::InterpreterExecutor::~InterpreterExecutor()
+{
+    bool running;
+    {
+        absl::MutexLock locker(&m_lock);
+        running = m_running;
+    }
+    if (running) {
+        auto status = shutdown();
+        TU_LOG_ERROR_IF (status.notOk()) << "failed to shut down executor: " << status;
+    }
+}
+
+int
+lyric_runtime::InterpreterExecutor::numWorkers() const
+{
+    return m_options.numWorkers;
+}
+
+/**
+ * Returns the number of submitted jobs which have not yet completed.
+ */
+int
+lyric_runtime::InterpreterExecutor::numOutstanding() const
+{
+    absl::MutexLock locker(&m_lock);
+    return m_numOutstanding;
+}
+
+void
+lyric_runtime::executor_worker_thread(void *arg)
+{
+    TU_ASSERT (arg != nullptr);
+    auto *worker = static_cast<ExecutorWorker *>(arg);
+    TU_LOG_VV << "starting up executor worker " << worker->index;
+    worker->executor->runWorker(worker);
+    TU_LOG_VV << "shutting down executor worker " << worker->index;
+}
+
+void
+lyric_runtime::executor_reactor_thread(void *arg)
+{
+    TU_ASSERT (arg != nullptr);
+    auto *executor = static_cast<InterpreterExecutor *>(arg);
+    executor->runReactor();
+}
+
+void
+lyric_runtime::on_reactor_async(uv_async_t *async)
+{
+    auto *executor = static_cast<InterpreterExecutor *>(async->data);
+    executor->processParkRequests();
+}
+
+/**
+ * Starts the reactor thread and the worker threads.
+ *
+ * @return Ok status if the executor was started, otherwise a status describing the failure.
+ */
+tempo_utils::Status
+lyric_runtime::InterpreterExecutor::start()
+{
+    {
+        absl::MutexLock locker(&m_lock);
+        if (m_running)
+            return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+                "executor is already running");
+    }
+
+    // initialize the reactor loop
+    auto ret = uv_loop_init(&m_reactorLoop);
+    if (ret < 0)
+        return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+            "uv_loop_init failed: {}", uv_err_name(ret));
+    m_reactorLoop.data = this;
+
+    ret = uv_async_init(&m_reactorLoop, &m_reactorAsync, on_reactor_async);
+    if (ret < 0) {
+        uv_loop_close(&m_reactorLoop);
+        return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+            "uv_async_init failed: {}", uv_err_name(ret));
+    }
+    m_reactorAsync.data = this;
+
+    {
+        absl::MutexLock locker(&m_parkLock);
+        m_reactorStopping = false;
+    }
+
+    ret = uv_thread_create(&m_reactorTid, executor_reactor_thread, this);
+    if (ret != 0) {
+        uv_close((uv_handle_t *) &m_reactorAsync, nullptr);
+        uv_run(&m_reactorLoop, UV_RUN_DEFAULT);
+        uv_loop_close(&m_reactorLoop);
+        return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+            "failed to create reactor thread: {}", uv_err_name(ret));
+    }
+
+    // allocate all workers before starting any thread, because a worker may steal from any other worker
+    for (int i = 0; i < m_options.numWorkers; i++) {
+        auto worker = std::make_unique<ExecutorWorker>();
+        worker->executor = this;
+        worker->index = i;
+        m_workers.push_back(std::move(worker));
+    }
+
+    {
+        absl::MutexLock locker(&m_lock);
+        m_running = true;
+        m_stopping = false;
+        m_nextWorker = 0;
+    }
+
+    int numStarted = 0;
+    for (; numStarted < m_options.numWorkers; numStarted++) {
+        auto &worker = m_workers.at(numStarted);
+        ret = uv_thread_create(&worker->tid, executor_worker_thread, worker.get());
+        if (ret != 0)
+            break;
+    }
+
+    // if any worker failed to start then stop the workers which did start
+    if (numStarted < m_options.numWorkers) {
+        TU_LOG_WARN << "failed to create executor worker " << numStarted << ": " << uv_err_name(ret);
+        m_workers.resize(numStarted);
+        TU_RETURN_IF_NOT_OK (shutdown());
+        return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+            "executor worker pool could not be started");
+    }
+
+    return {};
+}
+
+/**
+ * Waits for all outstanding jobs to complete, then stops the worker threads and the reactor thread.
+ * Jobs may continue to be submitted while the executor waits for the outstanding jobs to complete.
+ *
+ * @return Ok status if the executor was shut down, otherwise a status describing the failure.
+ */
+tempo_utils::Status
+lyric_runtime::InterpreterExecutor::shutdown()
+{
+    {
+        absl::MutexLock locker(&m_lock);
+        if (!m_running)
+            return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+                "executor is not running");
+        while (m_numOutstanding > 0) {
+            m_outstandingWaiter.Wait(&m_lock);
+        }
+        m_stopping = true;
+        m_runnableWaiter.SignalAll();
+    }
+
+    for (auto &worker : m_workers) {
+        auto ret = uv_thread_join(&worker->tid);
+        TU_LOG_WARN_IF (ret != 0) << "failed to join executor worker " << worker->index << ": " << uv_strerror(ret);
+    }
+    m_workers.clear();
+
+    {
+        absl::MutexLock locker(&m_parkLock);
+        m_reactorStopping = true;
+    }
+    uv_async_send(&m_reactorAsync);
+    auto ret = uv_thread_join(&m_reactorTid);
+    TU_LOG_WARN_IF (ret != 0) << "failed to join executor reactor: " << uv_strerror(ret);
+    uv_loop_close(&m_reactorLoop);
+
+    absl::MutexLock locker(&m_lock);
+    m_running = false;
+    m_stopping = false;
+    return {};
+}
+
+/**
+ * Submits the interpreter state to be run by the executor. The state must have been loaded, and must
+ * not be driven by any other interpreter while the job is outstanding. The caller should retain the
+ * state if the main return value may be a reference, because the reference is only valid while the
+ * state is alive.
+ *
+ * @param state The loaded interpreter state.
+ * @param future Set to a future which receives the interpreter exit or the failure status once the
+ *   program completes.
+ * @return Ok status if the job was submitted, otherwise a status describing the failure.
+ */
+tempo_utils::Status
+lyric_runtime::InterpreterExecutor::submit(
+    std::shared_ptr<InterpreterState> state,
+    std::future<ExecutorResult> &future)
+{
+    TU_NOTNULL (state);
+    if (!state->isActive() || state->currentCoro() == nullptr)
+        return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+            "interpreter state is not loaded");
+
+    auto job = std::make_unique<ExecutorJob>();
+    job->interp = std::make_unique<BytecodeInterpreter>(state);
+    job->state = std::move(state);
+
+    {
+        absl::MutexLock locker(&m_lock);
+        if (!m_running || m_stopping)
+            return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+                "executor is not running");
+        m_numOutstanding++;
+    }
+
+    future = job->promise.get_future();
+    enqueue(job.release());
+    return {};
+}
+
+/**
+ * Pushes the runnable job onto the back of the queue of the specified worker. If `worker` is nullptr then
+ * the workers are assigned in round-robin order.
+ */
+void
+lyric_runtime::InterpreterExecutor::enqueue(ExecutorJob *job, ExecutorWorker *worker)
+{
+    TU_ASSERT (job != nullptr);
+
+    if (worker == nullptr) {
+        absl::MutexLock locker(&m_lock);
+        worker = m_workers.at(m_nextWorker).get();
+        m_nextWorker = (m_nextWorker + 1) % static_cast<int>(m_workers.size());
+    }
+
+    {
+        absl::MutexLock locker(&worker->lock);
+        worker->queue.push_back(job);
+    }
+
+    absl::MutexLock locker(&m_lock);
+    m_numRunnable++;
+    m_runnableWaiter.Signal();
+}
+
+/**
+ * Pops the next runnable job from the front of the queue of `worker`. If the queue is empty then a job is
+ * stolen from the back of the queue of another worker.
+ *
+ * @return The runnable job, or nullptr if no job is runnable.
+ */
+lyric_runtime::ExecutorJob *
+lyric_runtime::InterpreterExecutor::dequeue(ExecutorWorker *worker)
+{
+    ExecutorJob *job = nullptr;
+
+    {
+        absl::MutexLock locker(&worker->lock);
+        if (!worker->queue.empty()) {
+            job = worker->queue.front();
+            worker->queue.pop_front();
+        }
+    }
+
+    for (size_t i = 1; job == nullptr && i < m_workers.size(); i++) {
+        auto *victim = m_workers.at((worker->index + i) % m_workers.size()).get();
+        absl::MutexLock locker(&victim->lock);
+        if (!victim->queue.empty()) {
+            job = victim->queue.back();
+            victim->queue.pop_back();
+        }
+    }
+
+    if (job != nullptr) {
+        absl::MutexLock locker(&m_lock);
+        m_numRunnable--;
+    }
+    return job;
+}
+
+/**
+ * Hands the blocked job to the reactor thread, which makes the job runnable again once the system loop
+ * of its interpreter state has a pending event.
+ */
+void
+lyric_runtime::InterpreterExecutor::park(ExecutorJob *job)
+{
+    {
+        absl::MutexLock locker(&m_parkLock);
+        m_parkRequests.push_back(job);
+    }
+    uv_async_send(&m_reactorAsync);
+}
+
+void
+lyric_runtime::InterpreterExecutor::complete(ExecutorJob *job, ExecutorResult result)
+{
+    job->promise.set_value(std::move(result));
+    delete job;
+
+    absl::MutexLock locker(&m_lock);
+    m_numOutstanding--;
+    if (m_numOutstanding == 0) {
+        m_outstandingWaiter.SignalAll();
+    }
+}
+
+static tempo_utils::Result<lyric_runtime::InterpreterYield>
+run_job_quantum(lyric_runtime::ExecutorJob *job, int numSlices, lyric_runtime::InterpreterExit &interpreterExit)
+{
+    try {
+        return job->interp->runQuantum(numSlices, interpreterExit);
+    } catch (tempo_utils::StatusException &ex) {
+        return ex.getStatus();
+    }
+}
+
+void
+lyric_runtime::InterpreterExecutor::runWorker(ExecutorWorker *worker)
+{
+    for (;;) {
+        auto *job = dequeue(worker);
+
+        // if there is no runnable job then wait until a job is enqueued or the executor is stopping
+        if (job == nullptr) {
+            absl::MutexLock locker(&m_lock);
+            while (m_numRunnable == 0 && !m_stopping) {
+                m_runnableWaiter.Wait(&m_lock);
+            }
+            if (m_numRunnable == 0)
+                return;
+            continue;
+        }
+
+        // the job is pinned to this worker until the quantum returns
+        InterpreterExit interpreterExit;
+        auto yieldResult = run_job_quantum(job, m_options.slicesPerQuantum, interpreterExit);
+        if (yieldResult.isStatus()) {
+            complete(job, yieldResult.getStatus());
+            continue;
+        }
+
+        switch (yieldResult.getResult()) {
+            case InterpreterYield::Halted:
+                complete(job, interpreterExit);
+                break;
+            case InterpreterYield::Preempted:
+                enqueue(job, worker);
+                break;
+            case InterpreterYield::Blocked:
+                park(job);
+                break;
+        }
+    }
+}
+
+void
+lyric_runtime::InterpreterExecutor::runReactor()
+{
+    TU_LOG_VV << "starting up executor reactor";
+    auto ret = uv_run(&m_reactorLoop, UV_RUN_DEFAULT);
+    TU_LOG_WARN_IF (ret < 0) << "executor reactor failed: " << uv_err_name(ret);
+    TU_LOG_VV << "shutting down executor reactor";
+}
+
+static void
+on_parked_close(uv_handle_t *handle)
+{
+    auto *parked = static_cast<lyric_runtime::ParkedJob *>(handle->data);
+    if (--parked->numOpen == 0) {
+        delete parked;
+    }
+}
+
+void
+lyric_runtime::on_parked_job_ready(ParkedJob *parked)
+{
+    if (parked->fired)
+        return;
+    parked->fired = true;
+    parked->executor->enqueue(parked->job);
+    if (parked->poll.data != nullptr) {
+        uv_close((uv_handle_t *) &parked->poll, on_parked_close);
+    }
+    if (parked->timer.data != nullptr) {
+        uv_close((uv_handle_t *) &parked->timer, on_parked_close);
+    }
+}
+
+static void
+on_parked_poll(uv_poll_t *poll, int status, int events)
+{
+    lyric_runtime::on_parked_job_ready(static_cast<lyric_runtime::ParkedJob *>(poll->data));
+}
+
+static void
+on_parked_timer(uv_timer_t *timer)
+{
+    lyric_runtime::on_parked_job_ready(static_cast<lyric_runtime::ParkedJob *>(timer->data));
+}
+
+/**
+ * Parks each requested job until the system loop of its interpreter state has a pending event. The
+ * backend of the system loop is watched for readability, and the backend timeout (which is the time
+ * until the next timer on the system loop expires) bounds how long the job stays parked. Note the
+ * system loop is not run by the reactor; the job is only made runnable again, and the worker which
+ * picks up the job processes the event.
+ */
+void
+lyric_runtime::InterpreterExecutor::processParkRequests()
+{
+    std::vector<ExecutorJob *> requests;
+    bool stopping;
+    {
+        absl::MutexLock locker(&m_parkLock);
+        requests.swap(m_parkRequests);
+        stopping = m_reactorStopping;
+    }
+
+    for (auto *job : requests) {
+        auto *loop = job->state->mainLoop();
+        auto timeout = uv_backend_timeout(loop);
+
+        // if the system loop has pending work then the job is runnable immediately
+        if (timeout == 0) {
+            enqueue(job);
+            continue;
+        }
+
+        auto *parked = new ParkedJob();
+        parked->executor = this;
+        parked->job = job;
+        parked->poll.data = nullptr;
+        parked->timer.data = nullptr;
+
+        auto fd = uv_backend_fd(loop);
+        if (fd >= 0 && uv_poll_init(&m_reactorLoop, &parked->poll, fd) == 0) {
+            parked->poll.data = parked;
+            parked->numOpen++;
+            uv_poll_start(&parked->poll, UV_READABLE, on_parked_poll);
+        } else if (timeout < 0 || timeout > kParkedRetryIntervalMillis) {
+            // the backend is not pollable, so retry periodically
+            timeout = kParkedRetryIntervalMillis;
+        }
+
+        if (timeout > 0) {
+            uv_timer_init(&m_reactorLoop, &parked->timer);
+            parked->timer.data = parked;
+            parked->numOpen++;
+            uv_timer_start(&parked->timer, on_parked_timer, timeout, 0);
+        }
+    }
+
+    // once the async handle is closed there are no more handles, so the reactor loop exits
+    if (stopping) {
+        uv_close((uv_handle_t *) &m_reactorAsync, nullptr);
+    }
+}
@@ -1,5 +1,6 @@
 
 #include <lyric_object/symbol_walker.h>
+#include <lyric_runtime/arena_heap.h>
 #include <lyric_runtime/base_ref.h>
 #include <lyric_runtime/bytecode_segment.h>
 #include <lyric_runtime/bytes_ref.h>
@@ -18,6 +19,7 @@
  */
 lyric_runtime::InterpreterState::InterpreterState()
     : m_loop(nullptr),
+      m_predecodedDispatch(false),
       m_loadEpochMillis(0),
       m_statusCode(tempo_utils::StatusCode::kUnknown),
       m_active(false)
@@ -37,6 +39,7 @@ lyric_runtime::InterpreterState::InterpreterState(
       m_systemLoader(std::move(systemLoader)),
       m_applicationLoader(std::move(applicationLoader)),
       m_heap(std::move(heap)),
+      m_predecodedDispatch(false),
       m_systemScheduler(std::move(systemScheduler)),
       m_portMultiplexer(std::move(portMultiplexer)),
       m_loadEpochMillis(0),
@@ -81,7 +84,7 @@ lyric_runtime::InterpreterState::create(
     // if heap is not specified in options then allocate one
     std::shared_ptr<AbstractHeap> heap;
     if (options.heap == nullptr) {
-        heap = GCHeap::create();
+        heap = ArenaHeap::create();
     } else {
         heap = options.heap;
     }
@@ -112,7 +115,7 @@ lyric_runtime::InterpreterState::create(
      * ownership to the interpreter state!
      */
 
-    auto systemScheduler = std::make_unique<SystemScheduler>(loop);
+    auto systemScheduler = std::make_unique<SystemScheduler>(loop, options.operandStackLayout);
     auto portMultiplexer = std::make_unique<PortMultiplexer>(transportRegistry, systemScheduler.get());
 
     // allocate the interpreter state
@@ -123,6 +126,11 @@ lyric_runtime::InterpreterState::create(
     // capture pointer to interpreter state in the loop data field
     loop->data = state.get();
 
+    // apply interpreter options
+    state->m_predecodedDispatch = options.enablePredecodedDispatch;
+    state->m_collectorOptions.allocationBudget = options.gcAllocationBudget;
+    state->m_collectorOptions.maxPauseMicros = options.gcMaxPauseMicros;
+
     // if main location was specified then load it
     if (options.mainLocation.isValid()) {
         TU_RETURN_IF_NOT_OK(state->load(options.mainLocation, options.mainArguments));
@@ -273,6 +281,7 @@ allocate_heap_manager(
     lyric_runtime::BytecodeSegment *preludeSegment,
     const lyric_object::LyricObject &preludeObject,
     std::shared_ptr<lyric_runtime::AbstractHeap> heap,
+    const lyric_runtime::CollectorOptions &collectorOptions,
     std::unique_ptr<lyric_runtime::HeapManager> &heapManagerPtr)
 {
     TU_ASSERT (segmentManager != nullptr);
@@ -360,7 +369,7 @@ allocate_heap_manager(
     TU_RETURN_IF_NOT_OK (status);
 
     heapManagerPtr = std::make_unique<lyric_runtime::HeapManager>(
-        preludeTables, segmentManager, systemScheduler, std::move(heap));
+        preludeTables, segmentManager, systemScheduler, std::move(heap), collectorOptions);
 
     return {};
 }
@@ -403,6 +412,12 @@ lyric_runtime::InterpreterState::isActive() const
     return m_active;
 }
 
+bool
+lyric_runtime::InterpreterState::isPredecodedDispatchEnabled() const
+{
+    return m_predecodedDispatch;
+}
+
 lyric_runtime::StackfulCoroutine *
 lyric_runtime::InterpreterState::currentCoro() const
 {
@@ -504,7 +519,7 @@ lyric_runtime::InterpreterState::initialize(const lyric_common::ModuleLocation &
     // allocate the heap manager
     std::unique_ptr<HeapManager> heapManager;
     TU_RETURN_IF_NOT_OK (allocate_heap_manager(segmentManager.get(), m_systemScheduler.get(),
-        preludeSegment, preludeObject, m_heap, heapManager));
+        preludeSegment, preludeObject, m_heap, m_collectorOptions, heapManager));
 
     // transfer ownership to this
     m_segmentManager = std::move(segmentManager);
@@ -564,9 +579,9 @@ lyric_runtime::InterpreterState::load(
 
     // parse the proc
     auto procOffset = call.getProcOffset();
-    auto bytecode = segment->getBytecode();
-    lyric_object::ProcInfo procInfo;
-    TU_RETURN_IF_NOT_OK (lyric_object::parse_proc_info(bytecode, procOffset, procInfo));
+    const ProcMetadata *procMetadata;
+    TU_RETURN_IF_NOT_OK (segment->getProcMetadata(procOffset, &procMetadata));
+    const auto &procInfo = procMetadata->getProcInfo();
 
     // the entry symbol must not expect any arguments or lexicals
     if (procInfo.num_arguments != 0 || procInfo.num_lexicals != 0)
@@ -584,7 +599,7 @@ lyric_runtime::InterpreterState::load(
     auto *mainTask = m_systemScheduler->mainTask();
     auto *coro = mainTask->stackfulCoroutine();
     coro->reset();
-    coro->pushCall(frame, ip, segment);
+    coro->pushCall(std::move(frame), ip, segment);
     TU_LOG_V << "initialized ip to " << ip;
 
     // move main task to the ready queue
@@ -0,0 +1,71 @@
+
+#include <atomic>
+
+#include <lyric_runtime/mark_stack.h>
+#include <tempo_utils/log_stream.h>
+
+static thread_local lyric_runtime::MarkStack *activeMarkStack = nullptr;
+static std::atomic<tu_uint64> nextMarkEpoch = 1;
+
+/**
+ * Constructs the mark stack and makes it the active mark stack for the current thread. Each mark stack
+ * is assigned a unique epoch, which lets objects outside of the heap (such as upvalue cells) record
+ * whether they have been traced in the current mark phase without needing to be cleared afterwards.
+ */
+lyric_runtime::MarkStack::MarkStack()
+    : m_prev(activeMarkStack),
+      m_epoch(nextMarkEpoch.fetch_add(1))
+{
+    activeMarkStack = this;
+}
+
+lyric_runtime::MarkStack::~MarkStack()
+{
+    TU_ASSERT (activeMarkStack == this);
+    TU_ASSERT (m_pending.empty());
+    activeMarkStack = m_prev;
+}
+
+tu_uint64
+lyric_runtime::MarkStack::getEpoch() const
+{
+    return m_epoch;
+}
+
+/**
+ * Pushes the specified `instance` onto the stack. The instance is traced when the stack is drained.
+ *
+ * @param instance The instance to trace.
+ */
+void
+lyric_runtime::MarkStack::push(AbstractRef *instance)
+{
+    TU_ASSERT (instance != nullptr);
+    m_pending.push_back(instance);
+}
+
+/**
+ * Traces instances until the stack is empty. Tracing an instance marks it reachable and pushes each
+ * unmarked instance referenced by its members onto the stack. An instance which was pushed more than
+ * once is skipped if it has already been marked.
+ */
+void
+lyric_runtime::MarkStack::drain()
+{
+    while (!m_pending.empty()) {
+        auto *instance = m_pending.back();
+        m_pending.pop_back();
+        if (instance->isReachable())
+            continue;
+        instance->setReachable();
+    }
+}
+
+/**
+ * Returns the mark stack which is active on the current thread, or nullptr if no mark phase is in progress.
+ */
+lyric_runtime::MarkStack *
+lyric_runtime::MarkStack::active()
+{
+    return activeMarkStack;
+}
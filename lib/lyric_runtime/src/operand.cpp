@@ -1,5 +1,6 @@
 
 #include <bit>
+#include <cstddef>
 
 #include <absl/strings/substitute.h>
 #include <boost/endian.hpp>
@@ -8,6 +9,7 @@
 #include <lyric_runtime/f64_ref.h>
 #include <lyric_runtime/i64_ref.h>
 #include <lyric_runtime/heap_manager.h>
+#include <lyric_runtime/mark_stack.h>
 #include <lyric_runtime/namespace_ref.h>
 #include <lyric_runtime/operand.h>
 #include <lyric_runtime/protocol_ref.h>
@@ -67,6 +69,15 @@
  *   I16:       00100000 (32)
  *   U16:       00101000 (40)
  *   C21:       00110000 (48)
+ *   Wide:      00111000 (56)
+ */
+
+/*
+ * Wide type tags (stored in the byte preceding the Wide short byte tag, the full 64-bit value is
+ * stored unencoded in the wide payload):
+ *   I64:       00000001 (1)
+ *   U64:       00000010 (2)
+ *   F64:       00000011 (3)
  */
 
 /*
@@ -116,6 +127,11 @@ constexpr tu_uint8 kShortU8Tag              = 0x18;
 constexpr tu_uint8 kShortI16Tag             = 0x20;
 constexpr tu_uint8 kShortU16Tag             = 0x28;
 constexpr tu_uint8 kShortC21Tag             = 0x30;
+constexpr tu_uint8 kShortWideTag            = 0x38;
+
+constexpr tu_uint8 kWideI64Tag              = 0x01;
+constexpr tu_uint8 kWideU64Tag              = 0x02;
+constexpr tu_uint8 kWideF64Tag              = 0x03;
 
 constexpr tu_uint8 kNum32SignedTag          = 0x0D;
 constexpr tu_uint8 kNum32UnsignedTag        = 0x15;
@@ -158,29 +174,49 @@ inline tu_uint8 get_info_byte(const std::array<tu_uint8,8> &bytes) { return byte
 
 inline tu_uint8 get_info_tag(const std::array<tu_uint8,8> &bytes) { return bytes[7] & kTagMask; }
 
+inline tu_uint8 get_wide_byte(const std::array<tu_uint8,8> &bytes)
+{
+    if (get_info_byte(bytes) != kShortWideTag)
+        return 0;
+    return bytes[6];
+}
+
 lyric_runtime::Operand::Operand()
-    : m_bytes{0,0,0,0,0,0,0,0}
+    : m_wide(0),
+      m_bytes{0,0,0,0,0,0,0,0}
 {
+    // the wide overlay serializes the payload and the tagged value as one contiguous record
+    static_assert(offsetof(Operand, m_bytes) == offsetof(Operand, m_wide) + sizeof(m_wide));
 }
 
 lyric_runtime::Operand::Operand(std::array<tu_uint8,8> bytes)
-    : m_bytes(bytes)
+    : m_wide(0),
+      m_bytes(bytes)
+{
+}
+
+lyric_runtime::Operand::Operand(tu_uint8 widetag, tu_uint64 wide)
+    : m_wide(wide),
+      m_bytes{0,0,0,0,0,0,widetag,kShortWideTag}
 {
 }
 
 lyric_runtime::Operand::Operand(const Operand &other)
-    : m_bytes(other.m_bytes)
+    : m_wide(other.m_wide),
+      m_bytes(other.m_bytes)
 {
 }
 
 lyric_runtime::Operand::Operand(Operand &&other) noexcept
-    : m_bytes{std::exchange(other.m_bytes, {})}
+    : m_wide{std::exchange(other.m_wide, 0)},
+      m_bytes{std::exchange(other.m_bytes, {})}
 {
 }
 
 lyric_runtime::Operand&
 lyric_runtime::Operand::operator=(const Operand &other)
 {
+    m_wide = other.m_wide;
     m_bytes = other.m_bytes;
     return *this;
 }
@@ -189,6 +225,7 @@ lyric_runtime::Operand&
 lyric_runtime::Operand::operator=(Operand &&other) noexcept
 {
     if (this != &other) {
+        std::swap(m_wide, other.m_wide);
         m_bytes.swap(other.m_bytes);
     }
     return *this;
@@ -337,6 +374,9 @@ lyric_runtime::Operand::getOverlay() const
     if (info == 0)
         return OverlayType::Invalid;
 
+    if (info == kShortWideTag)
+        return OverlayType::WideValue;
+
     tu_uint8 tag = info & kTagMask;
     switch (tag) {
         case kSingleWordShortTag:
@@ -364,6 +404,8 @@ lyric_runtime::Operand::getSize() const
         case OverlayType::LargeValue:
         case OverlayType::Pointer:
             return 8;
+        case OverlayType::WideValue:
+            return 16;
         default:
             return 0;
     }
@@ -378,6 +420,8 @@ lyric_runtime::Operand::getBytes() const
         case OverlayType::LargeValue:
         case OverlayType::Pointer:
             return std::span(m_bytes.data(), m_bytes.size());
+        case OverlayType::WideValue:
+            return std::span(reinterpret_cast<const tu_uint8 *>(&m_wide), 16);
         default:
             return {};
     }
@@ -470,6 +514,19 @@ lyric_runtime::Operand::getType() const
             }
         }
 
+        case OverlayType::WideValue: {
+            switch (get_wide_byte(m_bytes)) {
+                case kWideI64Tag:
+                    return OperandType::Int64;
+                case kWideU64Tag:
+                    return OperandType::UInt64;
+                case kWideF64Tag:
+                    return OperandType::Float64;
+                default:
+                    return OperandType::Invalid;
+            }
+        }
+
         case OverlayType::Pointer: {
             tu_uint8 tag = info & kTagMask;
             if (tag != kDoubleWordPointerTag)
@@ -734,6 +791,12 @@ bool
 lyric_runtime::Operand::getI64(tu_int64 &i64) const
 {
     tu_uint8 info = get_info_byte(m_bytes);
+    if (info == kShortWideTag) {
+        if (m_bytes[6] != kWideI64Tag)
+            return false;
+        i64 = std::bit_cast<tu_int64>(m_wide);
+        return true;
+    }
     if ((info & kTagMask) == kDoubleWordPointerTag) {
         auto *ptr = (I64Ref *) getPointer(kPointerI64Tag);
         if (ptr == nullptr)
@@ -757,6 +820,12 @@ bool
 lyric_runtime::Operand::getU64(tu_uint64 &u64) const
 {
     tu_uint8 info = get_info_byte(m_bytes);
+    if (info == kShortWideTag) {
+        if (m_bytes[6] != kWideU64Tag)
+            return false;
+        u64 = m_wide;
+        return true;
+    }
     if ((info & kTagMask) == kDoubleWordPointerTag) {
         auto *ptr = (U64Ref *) getPointer(kPointerU64Tag);
         if (ptr == nullptr)
@@ -836,6 +905,13 @@ lyric_runtime::Operand::getF64(double &f64) const
             }
         }
 
+        case OverlayType::WideValue: {
+            if (get_wide_byte(m_bytes) != kWideF64Tag)
+                return false;
+            f64 = std::bit_cast<double>(m_wide);
+            return true;
+        }
+
         case OverlayType::Pointer: {
             auto *ptr = (F64Ref *) getPointer(kPointerF64Tag);
             if (ptr == nullptr)
@@ -1054,8 +1130,8 @@ lyric_runtime::Operand::fromU32(tu_uint32 u32)
 lyric_runtime::Operand
 lyric_runtime::Operand::fromI64(tu_int64 i64)
 {
-    if (i64 < kMinI64StackValue || i64 > kMaxI64StackValue)
-        return {};
+    if (i64 < kMinI64StackValue || i64 > kMaxI64StackValue) [[unlikely]]
+        return Operand(kWideI64Tag, std::bit_cast<tu_uint64>(i64));
     std::array<tu_uint8,8> bytes;
     tu_uint64 large = std::abs(i64);
     large = boost::endian::native_to_big(large << 5);
@@ -1076,8 +1152,8 @@ lyric_runtime::Operand::fromI64(I64Ref *i64)
 lyric_runtime::Operand
 lyric_runtime::Operand::fromU64(tu_uint64 u64)
 {
-    if (u64 > kMaxU64StackValue)
-        return {};
+    if (u64 > kMaxU64StackValue) [[unlikely]]
+        return Operand(kWideU64Tag, u64);
     std::array<tu_uint8,8> bytes;
     tu_uint64 large = boost::endian::native_to_big(u64 << 4);
     memcpy(bytes.data(), &large, 8);
@@ -1142,7 +1218,7 @@ lyric_runtime::Operand::fromF64(double f64)
 
     if (encode_f64(f64, bytes))
         return Operand(bytes);
-    return {};
+    return Operand(kWideF64Tag, std::bit_cast<tu_uint64>(f64));
 }
 
 lyric_runtime::Operand
@@ -1281,6 +1357,21 @@ lyric_runtime::Operand::parse(std::span<const tu_uint8> raw)
                     return {};
             }
         }
+        case 16: {
+            if (raw[15] != kShortWideTag)
+                return {};
+            switch (raw[14]) {
+                case kWideI64Tag:
+                case kWideU64Tag:
+                case kWideF64Tag: {
+                    tu_uint64 wide;
+                    memcpy(&wide, raw.data(), 8);
+                    return Operand(raw[14], wide);
+                }
+                default:
+                    return {};
+            }
+        }
         default:
             return {};
     }
@@ -1289,6 +1380,8 @@ lyric_runtime::Operand::parse(std::span<const tu_uint8> raw)
 lyric_runtime::OverlayType
 lyric_runtime::Operand::parseRepresentation(const tu_uint8 &infoByte)
 {
+    if (infoByte == kShortWideTag)
+        return OverlayType::WideValue;
     tu_uint8 tag = infoByte & kTagMask;
     switch (tag) {
         case kSingleWordShortTag:
@@ -1310,6 +1403,8 @@ lyric_runtime::Operand::parseRepresentation(const tu_uint8 &infoByte)
 size_t
 lyric_runtime::Operand::parseSize(const tu_uint8 &infoByte)
 {
+    if (infoByte == kShortWideTag)
+        return 16;
     tu_uint8 tag = infoByte & kTagMask;
     switch (tag) {
         case kSingleWordShortTag:
@@ -1384,6 +1479,9 @@ lyric_runtime::Operand::hashEquality(absl::HashState state) const
         case OverlayType::Invalid:
             absl::HashState::combine_contiguous(std::move(state), m_bytes.data(), 8);
             return;
+        case OverlayType::WideValue:
+            absl::HashState::combine(std::move(state), m_bytes[6], m_wide);
+            return;
     }
 
     switch (getType()) {
@@ -1400,6 +1498,14 @@ lyric_runtime::Operand::hashEquality(absl::HashState state) const
             return;
         }
 
+        // boxed numbers must hash the same as the equivalent unboxed value
+        case OperandType::Int64:
+        case OperandType::UInt64:
+        case OperandType::Float64: {
+            unboxed().hashEquality(std::move(state));
+            return;
+        }
+
         case OperandType::Descriptor: {
             DescriptorEntry *descriptor;
             TU_ASSERT (getDescriptor(descriptor));
@@ -1436,6 +1542,9 @@ lyric_runtime::Operand::hashIdentity(absl::HashState state) const
         case OverlayType::Pointer:
             absl::HashState::combine_contiguous(std::move(state), m_bytes.data(), 8);
             break;
+        case OverlayType::WideValue:
+            absl::HashState::combine(std::move(state), m_bytes[6], m_wide);
+            break;
         case OverlayType::Invalid:
             break;
     }
@@ -1568,11 +1677,55 @@ lyric_runtime::Operand::toString() const
     }
 }
 
+/**
+ * If the operand is a boxed I64Ref, U64Ref, or F64Ref then return the equivalent unboxed operand, otherwise
+ * return a copy of the operand. Numeric values are never boxed by the runtime, but operands created by
+ * native code via HeapManager::allocateI64, HeapManager::allocateU64, or HeapManager::allocateF64 may still
+ * be boxed.
+ *
+ * @return The unboxed operand.
+ */
+lyric_runtime::Operand
+lyric_runtime::Operand::unboxed() const
+{
+    if (getOverlay() != OverlayType::Pointer)
+        return *this;
+    switch (getType()) {
+        case OperandType::Int64: {
+            tu_int64 i64;
+            TU_ASSERT (getI64(i64));
+            return fromI64(i64);
+        }
+        case OperandType::UInt64: {
+            tu_uint64 u64;
+            TU_ASSERT (getU64(u64));
+            return fromU64(u64);
+        }
+        case OperandType::Float64: {
+            double f64;
+            TU_ASSERT (getF64(f64));
+            return fromF64(f64);
+        }
+        default:
+            return *this;
+    }
+}
+
+/**
+ * Marks the instance referenced by the operand as reachable. If a mark phase is in progress then the
+ * instance is pushed onto the active mark stack and traced when the stack is drained, otherwise the
+ * instance is traced immediately. An instance which is already marked is not traced again.
+ */
 void
 lyric_runtime::Operand::setReachable() const
 {
     auto *ref = get_ref(*this);
-    if (ref != nullptr) {
+    if (ref == nullptr || ref->isReachable())
+        return;
+    auto *markStack = MarkStack::active();
+    if (markStack != nullptr) {
+        markStack->push(ref);
+    } else {
         ref->setReachable();
     }
 }
@@ -1804,13 +1957,9 @@ void lyric_runtime::value_to_operand(tu_int32 v, Operand &op, HeapManager *)
     op = Operand::fromI32(v);
 }
 
-void lyric_runtime::value_to_operand(tu_int64 v, Operand &op, HeapManager *heapManager)
+void lyric_runtime::value_to_operand(tu_int64 v, Operand &op, HeapManager *)
 {
-    if (v < kMinI64StackValue || v > kMaxI64StackValue) [[unlikely]] {
-        op = heapManager->allocateI64(v);
-    } else {
-        op = Operand::fromI64(v);
-    }
+    op = Operand::fromI64(v);
 }
 
 void lyric_runtime::value_to_operand(tu_uint8 v, Operand &op, HeapManager *)
@@ -1828,13 +1977,9 @@ void lyric_runtime::value_to_operand(tu_uint32 v, Operand &op, HeapManager *)
     op = Operand::fromU32(v);
 }
 
-void lyric_runtime::value_to_operand(tu_uint64 v, Operand &op, HeapManager *heapManager)
+void lyric_runtime::value_to_operand(tu_uint64 v, Operand &op, HeapManager *)
 {
-    if (v > kMaxU64StackValue) [[unlikely]] {
-        op = heapManager->allocateU64(v);
-    } else {
-        op = Operand::fromU64(v);
-    }
+    op = Operand::fromU64(v);
 }
 
 void lyric_runtime::value_to_operand(float v, Operand &op, HeapManager *)
@@ -1842,14 +1987,9 @@ void lyric_runtime::value_to_operand(float v, Operand &op, HeapManager *)
     op = Operand::fromF32(v);
 }
 
-void lyric_runtime::value_to_operand(double v, Operand &op, HeapManager *heapManager)
+void lyric_runtime::value_to_operand(double v, Operand &op, HeapManager *)
 {
-    std::array<tu_uint8,8> bytes;
-    if (!encode_f64(v, bytes)) {
-        op = heapManager->allocateF64(v);
-    } else {
-        op = Operand(bytes);
-    }
+    op = Operand::fromF64(v);
 }
 
 void lyric_runtime::value_to_operand(char32_t v, Operand &op, HeapManager *)
@@ -1,12 +1,38 @@
 
+#include <algorithm>
 #include <stack>
 
 #include <lyric_runtime/operand_stack.h>
 #include <lyric_runtime/interpreter_result.h>
 
-lyric_runtime::OperandStack::OperandStack(size_t stackSize)
-    : m_stack(stackSize)
+/**
+ * Construct an OperandStack with the specified `stackSize` in bytes and storage `layout`. In the packed
+ * layout operands are stored as variable-length byte records, which minimizes memory usage but requires
+ * walking the records to access operands below the top of the stack. In the slotted layout each operand
+ * occupies one fixed-width slot, so any operand can be accessed in constant time.
+ *
+ * @param stackSize The stack size in bytes.
+ * @param layout The storage layout.
+ */
+lyric_runtime::OperandStack::OperandStack(size_t stackSize, OperandStackLayout layout)
+    : m_layout(layout)
 {
+    switch (m_layout) {
+        case OperandStackLayout::Slotted:
+            m_slots.resize(stackSize / sizeof(Operand));
+            break;
+        case OperandStackLayout::Packed:
+        default:
+            m_layout = OperandStackLayout::Packed;
+            m_stack.resize(stackSize);
+            break;
+    }
+}
+
+lyric_runtime::OperandStackLayout
+lyric_runtime::OperandStack::getLayout() const
+{
+    return m_layout;
 }
 
 bool
@@ -18,6 +44,17 @@ lyric_runtime::OperandStack::isEmpty() const
 tempo_utils::Status
 lyric_runtime::OperandStack::pushOperand(const Operand &value)
 {
+    if (m_layout == OperandStackLayout::Slotted) {
+        if (!value.isValid())
+            return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+                "failed to push invalid value");
+        if (m_slots.size() <= m_depth)
+            return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+                "no room left on stack for value");
+        m_slots[m_depth++] = value;
+        return {};
+    }
+
     auto bytes = value.getBytes();
     if (bytes.empty())
         return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
@@ -34,6 +71,14 @@ lyric_runtime::OperandStack::pushOperand(const Operand &value)
 tempo_utils::Status
 lyric_runtime::OperandStack::popOperand(Operand &value)
 {
+    if (m_layout == OperandStackLayout::Slotted) {
+        if (m_depth == 0)
+            return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+                "no values left on stack");
+        value = m_slots[--m_depth];
+        return {};
+    }
+
     if (m_last == 0)
         return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
             "no values left on stack");
@@ -52,13 +97,22 @@ lyric_runtime::OperandStack::popOperand(Operand &value)
 tempo_utils::Status
 lyric_runtime::OperandStack::popOperands(int count, std::vector<Operand> &values)
 {
-    std::vector<Operand> vs(count);
+    if (count < 0 || m_depth < static_cast<size_t>(count))
+        return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+            "no values left on stack");
+
+    if (m_layout == OperandStackLayout::Slotted) {
+        auto first = m_slots.cbegin() + (m_depth - count);
+        values.assign(first, first + count);
+        m_depth -= count;
+        return {};
+    }
+
+    // pop directly into the caller's vector so that its capacity is reused
+    values.resize(count);
     for (int i = count; i > 0; --i) {
-        Operand v;
-        TU_RETURN_IF_NOT_OK (popOperand(v));
-        vs[i - 1] = std::move(v);
+        TU_RETURN_IF_NOT_OK (popOperand(values[i - 1]));
     }
-    values = std::move(vs);
     return {};
 }
 
@@ -68,6 +122,15 @@ lyric_runtime::OperandStack::peekOperand(Operand &value, tu_int16 offset) const
     if (offset < 0)
         return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
             "invalid peek offset {}", offset);
+
+    if (m_layout == OperandStackLayout::Slotted) {
+        if (m_depth <= static_cast<size_t>(offset))
+            return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+                "no values left on stack");
+        value = m_slots[m_depth - 1 - offset];
+        return {};
+    }
+
     if (m_last == 0)
         return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
             "no values left on stack");
@@ -101,6 +164,17 @@ lyric_runtime::OperandStack::dropOperand(tu_int16 offset)
         return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
             "invalid peek offset {}", offset);
 
+    // in the slotted layout we shift the operands above the dropped operand down by one slot
+    if (m_layout == OperandStackLayout::Slotted) {
+        if (m_depth <= static_cast<size_t>(offset))
+            return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+                "no values left on stack");
+        auto dropped = m_slots.begin() + (m_depth - 1 - offset);
+        std::move(dropped + 1, m_slots.begin() + m_depth, dropped);
+        --m_depth;
+        return {};
+    }
+
     std::stack<Operand> vs;
     Operand v;
 
@@ -123,6 +197,14 @@ lyric_runtime::OperandStack::dropOperand(tu_int16 offset)
 tempo_utils::Status
 lyric_runtime::OperandStack::dropOperands(int count)
 {
+    if (m_layout == OperandStackLayout::Slotted) {
+        if (count < 0 || m_depth < static_cast<size_t>(count))
+            return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+                "no values left on stack");
+        m_depth -= count;
+        return {};
+    }
+
     for (int i = 0; i < count; ++i) {
         if (m_last == 0)
             return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
@@ -141,6 +223,8 @@ lyric_runtime::OperandStack::dropOperands(int count)
 lyric_runtime::OperandStackIterator
 lyric_runtime::OperandStack::iterateOperands() const
 {
+    if (m_layout == OperandStackLayout::Slotted)
+        return OperandStackIterator(m_slots.data(), m_depth);
     return OperandStackIterator(m_stack.data(), m_last);
 }
 
@@ -153,36 +237,53 @@ lyric_runtime::OperandStack::getDepth() const
 size_t
 lyric_runtime::OperandStack::getBytesAvailable() const
 {
+    if (m_layout == OperandStackLayout::Slotted)
+        return (m_slots.size() - m_depth) * sizeof(Operand);
     return m_stack.size() - m_last;
 }
 
 size_t
 lyric_runtime::OperandStack::getBytesUsed() const
 {
+    if (m_layout == OperandStackLayout::Slotted)
+        return m_depth * sizeof(Operand);
     return m_last;
 }
 
 float
 lyric_runtime::OperandStack::getUtilization() const
 {
+    if (m_layout == OperandStackLayout::Slotted)
+        return static_cast<float>(m_depth) / static_cast<float>(m_slots.size());
     return static_cast<float>(m_last) / static_cast<float>(m_stack.size());
 }
 
 lyric_runtime::OperandStackIterator::OperandStackIterator()
     : m_stack(nullptr),
+      m_slots(nullptr),
       m_curr(0)
 {
 }
 
 lyric_runtime::OperandStackIterator::OperandStackIterator(const tu_uint8 *stack, size_t last)
     : m_stack(stack),
+      m_slots(nullptr),
       m_curr(last)
 {
     TU_NOTNULL (m_stack);
 }
 
+lyric_runtime::OperandStackIterator::OperandStackIterator(const Operand *slots, size_t depth)
+    : m_stack(nullptr),
+      m_slots(slots),
+      m_curr(depth)
+{
+    TU_NOTNULL (m_slots);
+}
+
 lyric_runtime::OperandStackIterator::OperandStackIterator(const OperandStackIterator &other)
     : m_stack(other.m_stack),
+      m_slots(other.m_slots),
       m_curr(other.m_curr)
 {
 }
@@ -190,7 +291,7 @@ lyric_runtime::OperandStackIterator::OperandStackIterator(const OperandStackIter
 bool
 lyric_runtime::OperandStackIterator::hasNext() const
 {
-    if (m_stack == nullptr)
+    if (m_stack == nullptr && m_slots == nullptr)
         return false;
     return m_curr > 0;
 }
@@ -198,6 +299,12 @@ lyric_runtime::OperandStackIterator::hasNext() const
 bool
 lyric_runtime::OperandStackIterator::getNext(Operand &value)
 {
+    if (m_slots != nullptr) {
+        if (m_curr == 0)
+            return false;
+        value = m_slots[--m_curr];
+        return true;
+    }
     if (m_stack == nullptr)
         return false;
     if (m_curr == 0)
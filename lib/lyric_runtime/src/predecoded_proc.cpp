@@ -0,0 +1,225 @@
+
+#include <algorithm>
+
+#include <lyric_runtime/predecoded_proc.h>
+
+static bool
+is_dispatched_call(const lyric_object::OpCell &op)
+{
+    switch (op.opcode) {
+        case lyric_object::Opcode::OP_CALL_VIRTUAL:
+        case lyric_object::Opcode::OP_CALL_STUB:
+        case lyric_object::Opcode::OP_CALL_CONCEPT:
+        case lyric_object::Opcode::OP_CALL_EXISTENTIAL:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Decodes the specified `code` into a dense array of predecoded instructions. If the code contains a
+ * truncated instruction then decoding stops at the truncated instruction and the proc is marked as
+ * incomplete; fetching the truncated instruction (or any instruction after it) returns nullptr, which
+ * matches the behavior of BytecodeIterator::getNext.
+ *
+ * @param code The code section of the proc.
+ */
+lyric_runtime::PredecodedProc::PredecodedProc(std::span<const tu_uint8> code)
+    : m_code(code),
+      m_numSuperinstructions(0),
+      m_numCallSites(0),
+      m_complete(true)
+{
+    if (m_code.empty())
+        return;
+
+    lyric_object::BytecodeIterator it(m_code);
+    while (it.hasNext()) {
+        PredecodedOp predecoded;
+        if (!it.getNext(predecoded.op)) {
+            m_complete = false;
+            break;
+        }
+        predecoded.next = static_cast<tu_uint32>(it.getCurr() - it.getBase());
+        predecoded.target = INVALID_ADDRESS_U32;
+        predecoded.targetIndex = INVALID_ADDRESS_U32;
+        predecoded.fused = Superinstruction::None;
+        predecoded.fusedNext = predecoded.next;
+        predecoded.callSite = nullptr;
+
+        // precompute the absolute jump target for branch instructions. if the target is out of range then
+        // leave the target invalid so the interpreter reports the error when the branch is taken.
+        if (predecoded.op.type == lyric_object::OpInfoType::JUMP_I16) {
+            auto target = static_cast<tu_int64>(predecoded.next) + predecoded.op.operands.jump_i16.jump;
+            if (0 <= target && target <= static_cast<tu_int64>(m_code.size())) {
+                predecoded.target = static_cast<tu_uint32>(target);
+            }
+        }
+
+        if (is_dispatched_call(predecoded.op)) {
+            m_numCallSites++;
+        }
+
+        m_ops.push_back(predecoded);
+    }
+
+    // map each branch target to the index of the target op, so the interpreter can follow a branch
+    // without looking up the target offset. a target which is not the start of an op is left unmapped.
+    for (auto &predecoded : m_ops) {
+        if (predecoded.target == INVALID_ADDRESS_U32)
+            continue;
+        auto index = findOp(predecoded.target);
+        if (index >= 0) {
+            predecoded.targetIndex = static_cast<tu_uint32>(index);
+        }
+    }
+
+    // allocate a dense array of inline caches, one per dispatched call site. the ops vector is not resized
+    // after this point, so each op can hold a stable pointer to its cache.
+    if (m_numCallSites > 0) {
+        m_callSites = std::make_unique<CallSiteCache[]>(m_numCallSites);
+        int callSiteIndex = 0;
+        for (auto &predecoded : m_ops) {
+            if (is_dispatched_call(predecoded.op)) {
+                predecoded.callSite = &m_callSites[callSiteIndex++];
+            }
+        }
+    }
+
+    fuseSuperinstructions();
+}
+
+static bool
+is_local_load(const lyric_object::OpCell &op)
+{
+    return op.opcode == lyric_object::Opcode::OP_LOAD
+        && op.operands.flags_u8_address_u32.flags == lyric_object::LOAD_LOCAL;
+}
+
+// an initial store of a local is not matched, because it rebinds the local rather than storing to it
+static bool
+is_local_store(const lyric_object::OpCell &op)
+{
+    return op.opcode == lyric_object::Opcode::OP_STORE
+        && op.operands.flags_u8_address_u32.flags == lyric_object::STORE_LOCAL;
+}
+
+static bool
+is_compare_branch(const lyric_object::OpCell &op)
+{
+    switch (op.opcode) {
+        case lyric_object::Opcode::OP_IF_ZERO:
+        case lyric_object::Opcode::OP_IF_NOTZERO:
+        case lyric_object::Opcode::OP_IF_GT:
+        case lyric_object::Opcode::OP_IF_GE:
+        case lyric_object::Opcode::OP_IF_LT:
+        case lyric_object::Opcode::OP_IF_LE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Peephole pass which marks each instruction beginning a common instruction sequence as a superinstruction.
+ * The instructions of the sequence are left in place, so a branch which targets an instruction in the middle
+ * of a superinstruction executes the remaining instructions individually.
+ */
+void
+lyric_runtime::PredecodedProc::fuseSuperinstructions()
+{
+    for (std::size_t i = 0; i + 1 < m_ops.size(); i++) {
+        auto &first = m_ops[i];
+        const auto &second = m_ops[i + 1];
+
+        if (is_local_load(first.op) && is_local_load(second.op)) {
+            first.fused = Superinstruction::LoadLocalPair;
+        } else if (first.op.opcode == lyric_object::Opcode::OP_CMP && is_compare_branch(second.op)) {
+            first.fused = Superinstruction::CompareBranch;
+        } else if (first.op.opcode == lyric_object::Opcode::OP_DUP && is_local_store(second.op)) {
+            first.fused = Superinstruction::DupStoreLocal;
+        } else {
+            continue;
+        }
+
+        first.fusedNext = second.next;
+        m_numSuperinstructions++;
+    }
+}
+
+const tu_uint8 *
+lyric_runtime::PredecodedProc::getCodeBase() const
+{
+    return m_code.data();
+}
+
+tu_uint32
+lyric_runtime::PredecodedProc::getCodeSize() const
+{
+    return m_code.size();
+}
+
+bool
+lyric_runtime::PredecodedProc::isComplete() const
+{
+    return m_complete;
+}
+
+int
+lyric_runtime::PredecodedProc::numOps() const
+{
+    return m_ops.size();
+}
+
+int
+lyric_runtime::PredecodedProc::numSuperinstructions() const
+{
+    return m_numSuperinstructions;
+}
+
+int
+lyric_runtime::PredecodedProc::numCallSites() const
+{
+    return m_numCallSites;
+}
+
+/**
+ * Returns the index of the predecoded instruction starting at the specified `offset`, or -1 if `offset`
+ * does not point to the start of an instruction. The ops are ordered by offset, so the lookup is a
+ * binary search.
+ */
+int
+lyric_runtime::PredecodedProc::findOp(tu_uint32 offset) const
+{
+    auto it = std::lower_bound(m_ops.cbegin(), m_ops.cend(), offset,
+        [](const PredecodedOp &predecoded, tu_uint32 value) { return predecoded.op.offset < value; });
+    if (it == m_ops.cend() || it->op.offset != offset)
+        return -1;
+    return static_cast<int>(it - m_ops.cbegin());
+}
+
+/**
+ * Returns the predecoded instruction starting at the specified `offset`, or nullptr if `offset` does not
+ * point to the start of an instruction.
+ *
+ * @param offset The offset relative to the start of the code.
+ * @return The predecoded instruction, or nullptr.
+ */
+const lyric_runtime::PredecodedOp *
+lyric_runtime::PredecodedProc::getOp(tu_uint32 offset) const
+{
+    auto index = findOp(offset);
+    if (index < 0)
+        return nullptr;
+    return &m_ops[index];
+}
+
+/**
+ * Returns the predecoded instruction stream, ordered by offset.
+ */
+std::span<const lyric_runtime::PredecodedOp>
+lyric_runtime::PredecodedProc::getOps() const
+{
+    return m_ops;
+}
@@ -0,0 +1,151 @@
+
+#include <algorithm>
+
+#include <lyric_runtime/proc_metadata.h>
+
+const lyric_object::ProcInfo &
+lyric_runtime::ProcMetadata::getProcInfo() const
+{
+    return m_procInfo;
+}
+
+tu_uint16
+lyric_runtime::ProcMetadata::numArguments() const
+{
+    return m_procInfo.num_arguments;
+}
+
+tu_uint16
+lyric_runtime::ProcMetadata::numLocals() const
+{
+    return m_procInfo.num_locals;
+}
+
+tu_uint16
+lyric_runtime::ProcMetadata::numLexicals() const
+{
+    return m_procInfo.num_lexicals;
+}
+
+std::span<const tu_uint8>
+lyric_runtime::ProcMetadata::getCode() const
+{
+    return m_procInfo.code;
+}
+
+std::span<const lyric_object::ProcLexical>
+lyric_runtime::ProcMetadata::getLexicals() const
+{
+    return m_lexicals;
+}
+
+std::span<const lyric_object::ProcCheck>
+lyric_runtime::ProcMetadata::getChecks() const
+{
+    return m_checks;
+}
+
+std::span<const lyric_object::ProcException>
+lyric_runtime::ProcMetadata::getExceptions() const
+{
+    return m_exceptions;
+}
+
+/**
+ * Returns the catch handlers which are active at the specified `offset` in the proc code, ordered from
+ * the innermost check to the outermost check. Within a check the handlers are in declaration order.
+ *
+ * @param offset The offset from the start of the proc code.
+ * @return The active handlers, which is empty if no check covers the offset.
+ */
+std::span<const lyric_runtime::ProcHandler>
+lyric_runtime::ProcMetadata::findHandlers(tu_uint32 offset) const
+{
+    auto next = std::upper_bound(m_handlerRanges.cbegin(), m_handlerRanges.cend(), offset,
+        [](tu_uint32 o, const ProcHandlerRange &range) { return o < range.range_start; });
+    if (next == m_handlerRanges.cbegin())
+        return {};
+    const auto &range = *std::prev(next);
+    if (range.range_end <= offset)
+        return {};
+    return std::span<const ProcHandler>(m_handlers).subspan(range.first_handler, range.num_handlers);
+}
+
+/**
+ * Builds the handler table from the checks table. The check intervals are split at every interval
+ * boundary into disjoint ranges sorted by offset, and each range is assigned the handlers of every check
+ * which covers it. The checks table lists inner checks before the checks which enclose them, so the
+ * handlers of each range are ordered from the innermost check outwards. Looking up the handlers for an
+ * offset is then a binary search over the ranges.
+ */
+void
+lyric_runtime::ProcMetadata::buildHandlerTable()
+{
+    if (m_checks.empty())
+        return;
+
+    std::vector<tu_uint32> boundaries;
+    for (const auto &check : m_checks) {
+        boundaries.push_back(check.interval_offset);
+        boundaries.push_back(check.interval_offset + check.interval_size);
+    }
+    std::sort(boundaries.begin(), boundaries.end());
+    boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+
+    for (int i = 0; i + 1 < boundaries.size(); i++) {
+        ProcHandlerRange range;
+        range.range_start = boundaries[i];
+        range.range_end = boundaries[i + 1];
+        range.first_handler = m_handlers.size();
+
+        for (const auto &check : m_checks) {
+            if (range.range_start < check.interval_offset
+                || check.interval_offset + check.interval_size < range.range_end)
+                continue;
+            for (int j = 0; j < check.num_exceptions; j++) {
+                if (m_exceptions.size() <= check.first_exception + j)
+                    break;
+                const auto &exception = m_exceptions[check.first_exception + j];
+                ProcHandler handler;
+                handler.exception_type = exception.exception_type;
+                handler.catch_offset = exception.catch_offset;
+                handler.exception_local = check.exception_local;
+                m_handlers.push_back(handler);
+            }
+        }
+
+        range.num_handlers = m_handlers.size() - range.first_handler;
+        if (range.num_handlers > 0) {
+            m_handlerRanges.push_back(range);
+        }
+    }
+}
+
+/**
+ * Decodes the proc at `procOffset` in the specified `bytecode`, including the lexicals table and the
+ * checks and exceptions tables of the proc trailer.
+ *
+ * @param bytecode The bytecode containing the proc.
+ * @param procOffset The offset of the proc within the bytecode.
+ * @param procMetadata Set to the decoded proc metadata if parsing succeeds.
+ * @return Ok status if parsing succeeds, otherwise status describing the parse failure.
+ */
+tempo_utils::Status
+lyric_runtime::ProcMetadata::parse(
+    std::span<const tu_uint8> bytecode,
+    tu_uint32 procOffset,
+    std::unique_ptr<ProcMetadata> &procMetadata)
+{
+    std::unique_ptr<ProcMetadata> metadata(new ProcMetadata());
+    TU_RETURN_IF_NOT_OK (lyric_object::parse_proc_info(bytecode, procOffset, metadata->m_procInfo));
+    TU_RETURN_IF_NOT_OK (lyric_object::parse_lexicals_table(metadata->m_procInfo, metadata->m_lexicals));
+
+    lyric_object::TrailerInfo trailerInfo;
+    TU_RETURN_IF_NOT_OK (lyric_object::parse_proc_trailer(metadata->m_procInfo, trailerInfo));
+    TU_RETURN_IF_NOT_OK (lyric_object::parse_checks_table(trailerInfo, metadata->m_checks));
+    TU_RETURN_IF_NOT_OK (lyric_object::parse_exceptions_table(trailerInfo, metadata->m_exceptions));
+    metadata->buildHandlerTable();
+
+    procMetadata = std::move(metadata);
+    return {};
+}
@@ -183,6 +183,43 @@ lyric_runtime::Promise::await(SystemScheduler *systemScheduler)
     }
 }
 
+/**
+ * Cancel the promise. The waiter attached to the promise is destroyed without invoking the accept
+ * callback, any task awaiting the promise is resumed, and the promise state is set to Cancelled.
+ * If the promise was forwarded then the target is notified. Only promises waiting on a timer or an
+ * async handle can be cancelled.
+ *
+ * @param systemScheduler The system scheduler which owns the waiter.
+ * @return Ok status if the promise was cancelled, otherwise kRuntimeInvariant status.
+ */
+tempo_utils::Status
+lyric_runtime::Promise::cancel(SystemScheduler *systemScheduler)
+{
+    TU_NOTNULL (systemScheduler);
+    switch (m_state) {
+        case State::Pending:
+        case State::Target:
+        case State::Forwarded:
+        case State::Waiting:
+            break;
+        default:
+            return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+                "invalid promise state");
+    }
+    if (m_waiter == nullptr)
+        return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+            "promise has no waiter");
+
+    TU_RETURN_IF_NOT_OK (systemScheduler->cancelWaiter(m_waiter));
+    m_waiter = nullptr;
+
+    auto prevState = m_state;
+    m_state = State::Cancelled;
+    if (prevState == State::Forwarded)
+        return notify();
+    return {};
+}
+
 void
 lyric_runtime::Promise::accept(const Waiter *waiter, InterpreterState *state)
 {
@@ -195,6 +232,7 @@ lyric_runtime::Promise::setReachable()
     for (const auto &dep : m_dependencies) {
         dep->setReachable();
     }
+    m_result.setReachable();
     m_ops->setReachable();
 }
 
@@ -213,6 +251,7 @@ lyric_runtime::Promise::notify()
         // if target is already finished then do nothing
         case State::Completed:
         case State::Rejected:
+        case State::Cancelled:
             return {};
 
         // otherwise call onPartial to determine whether target can be resolved
@@ -228,6 +267,18 @@ lyric_runtime::Promise::notify()
     return {};
 }
 
+/**
+ * Clear the waiter if it is attached to the promise. Called by the system scheduler when the waiter is
+ * destroyed, so the promise never refers to a waiter whose storage has been reused.
+ */
+void
+lyric_runtime::Promise::detachWaiter(const Waiter *waiter)
+{
+    if (m_waiter == waiter) {
+        m_waiter = nullptr;
+    }
+}
+
 tempo_utils::Status
 lyric_runtime::Promise::complete(const Operand &result)
 {
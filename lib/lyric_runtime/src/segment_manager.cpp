@@ -66,6 +66,19 @@ lyric_runtime::SegmentManager::getSegment(const lyric_common::ModuleLocation &lo
     return nullptr;
 }
 
+/**
+ * Marks every heap instance referenced from the static storage of any loaded segment as reachable.
+ */
+void
+lyric_runtime::SegmentManager::setReachable() const
+{
+    for (const auto *segment : m_data.segments) {
+        if (segment != nullptr) {
+            segment->setReachable();
+        }
+    }
+}
+
 lyric_runtime::BytecodeSegment *
 lyric_runtime::SegmentManager::getOrLoadSegment(const lyric_common::ModuleLocation &location, bool useSystemLoader)
 {
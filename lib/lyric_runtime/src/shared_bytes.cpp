@@ -0,0 +1,72 @@
+
+#include <lyric_runtime/shared_bytes.h>
+#include <tempo_utils/log_stream.h>
+
+lyric_runtime::BytesSlice::BytesSlice(
+    std::shared_ptr<const tempo_utils::ImmutableBytes> parent,
+    tu_uint32 offset,
+    tu_uint32 size)
+    : m_parent(std::move(parent)),
+      m_offset(offset),
+      m_size(size)
+{
+    TU_NOTNULL (m_parent);
+    TU_ASSERT (static_cast<tu_uint64>(m_offset) + m_size <= m_parent->getSize());
+}
+
+const tu_uint8 *
+lyric_runtime::BytesSlice::getData() const
+{
+    return m_parent->getData() + m_offset;
+}
+
+tu_uint32
+lyric_runtime::BytesSlice::getSize() const
+{
+    return m_size;
+}
+
+/**
+ * Returns ImmutableBytes for the specified range of the parent. If the range covers the entire parent
+ * then the parent is returned, otherwise a slice sharing the parent is returned.
+ *
+ * @param parent The parent bytes.
+ * @param offset The offset of the range in the parent.
+ * @param size The size of the range.
+ * @return The bytes.
+ */
+std::shared_ptr<const tempo_utils::ImmutableBytes>
+lyric_runtime::BytesSlice::create(
+    std::shared_ptr<const tempo_utils::ImmutableBytes> parent,
+    tu_uint32 offset,
+    tu_uint32 size)
+{
+    TU_NOTNULL (parent);
+    if (offset == 0 && size == parent->getSize())
+        return parent;
+    // slices of a slice refer directly to the underlying parent
+    if (auto *slice = dynamic_cast<const BytesSlice *>(parent.get()); slice != nullptr) {
+        TU_ASSERT (static_cast<tu_uint64>(offset) + size <= slice->m_size);
+        return create(slice->m_parent, slice->m_offset + offset, size);
+    }
+    return std::make_shared<BytesSlice>(std::move(parent), offset, size);
+}
+
+lyric_runtime::SharedArrayBytes::SharedArrayBytes(std::shared_ptr<const tu_uint8[]> data, tu_uint32 size)
+    : m_data(std::move(data)),
+      m_size(size)
+{
+    TU_ASSERT (m_data != nullptr || m_size == 0);
+}
+
+const tu_uint8 *
+lyric_runtime::SharedArrayBytes::getData() const
+{
+    return m_data.get();
+}
+
+tu_uint32
+lyric_runtime::SharedArrayBytes::getSize() const
+{
+    return m_size;
+}
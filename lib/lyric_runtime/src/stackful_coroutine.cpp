@@ -9,6 +9,8 @@
  * @param offset the specified offset, which can be negative
  * @return the absolute index, or -1 if the offset is out of bounds
  */
+constexpr int kInitialCallStackCapacity = 64;
+
 template<typename T>
 int
 calculate_stack_index(const std::vector<T> &stack, int offset)
@@ -20,10 +22,15 @@ calculate_stack_index(const std::vector<T> &stack, int offset)
     return offset < size? offset : -1;
 }
 
-lyric_runtime::StackfulCoroutine::StackfulCoroutine()
+lyric_runtime::StackfulCoroutine::StackfulCoroutine(OperandStackLayout layout)
     : m_IP(),
-      m_SP(nullptr)
+      m_SP(nullptr),
+      m_operandStack(8192, layout),
+      m_predecoded(nullptr)
 {
+    // reserve space up front so that typical call depths and argument counts never reallocate
+    m_callStack.reserve(kInitialCallStackCapacity);
+    m_argumentWindow.reserve(kNumInlineFrameSlots);
 }
 
 bool
@@ -32,12 +39,61 @@ lyric_runtime::StackfulCoroutine::nextOp(lyric_object::OpCell &op)
     return m_IP.getNext(op);
 }
 
+/**
+ * Fetches the next instruction from the predecoded instruction stream of the current proc and advances
+ * the instruction pointer past the instruction. The predecoded stream is looked up in the current segment
+ * only when the instruction pointer has moved into a different proc. The interpreter uses this to enter
+ * the predecoded stream, and from there follows the stream by op index without calling back in here.
+ *
+ * @param op Set to the predecoded instruction if one is available.
+ * @return true if an instruction was fetched, otherwise false.
+ */
+bool
+lyric_runtime::StackfulCoroutine::nextPredecodedOp(const PredecodedOp *&op)
+{
+    if (m_predecoded == nullptr || m_predecoded->getCodeBase() != m_IP.getBase()) {
+        if (m_SP == nullptr)
+            return false;
+        m_predecoded = m_SP->getPredecodedProc(m_IP);
+        if (m_predecoded == nullptr)
+            return false;
+    }
+    auto *predecoded = m_predecoded->getOp(m_IP.getCurr() - m_IP.getBase());
+    if (predecoded == nullptr)
+        return false;
+    m_IP.reset(predecoded->next);
+    op = predecoded;
+    return true;
+}
+
+/**
+ * Returns the predecoded proc containing the instruction most recently fetched with nextPredecodedOp,
+ * or nullptr if no instruction has been fetched from a predecoded proc.
+ */
+const lyric_runtime::PredecodedProc *
+lyric_runtime::StackfulCoroutine::peekPredecoded() const
+{
+    return m_predecoded;
+}
+
 bool
 lyric_runtime::StackfulCoroutine::moveIP(int16_t offset)
 {
     return m_IP.move(offset);
 }
 
+/**
+ * Sets the instruction pointer to the specified absolute `address` within the code of the current proc.
+ *
+ * @param address The address relative to the start of the code.
+ * @return true if the address is valid, otherwise false.
+ */
+bool
+lyric_runtime::StackfulCoroutine::jumpIP(tu_uint32 address)
+{
+    return m_IP.reset(address);
+}
+
 lyric_runtime::BytecodeSegment *
 lyric_runtime::StackfulCoroutine::peekSP() const
 {
@@ -99,6 +155,27 @@ lyric_runtime::StackfulCoroutine::pushCall(
     return {};
 }
 
+/**
+ * Pushes the activation frame `value` onto the call stack, taking ownership of the frame slots so that
+ * the frame is not copied.
+ *
+ * @param value The activation frame.
+ * @param ip The instruction pointer of the first instruction of the callee.
+ * @param sp The segment containing the callee.
+ * @return Status
+ */
+tempo_utils::Status
+lyric_runtime::StackfulCoroutine::pushCall(
+    CallCell &&value,
+    const lyric_object::BytecodeIterator &ip,
+    BytecodeSegment *sp)
+{
+    m_IP = ip;
+    m_SP = sp;
+    m_callStack.push_back(std::move(value));
+    return {};
+}
+
 tempo_utils::Status
 lyric_runtime::StackfulCoroutine::popCall(CallCell &value)
 {
@@ -206,6 +283,20 @@ lyric_runtime::StackfulCoroutine::resizeDataStack(int size)
     return m_operandStack.dropOperands(m_operandStack.getDepth() - size);
 }
 
+/**
+ * Returns the argument window of the coroutine, which is a buffer owned by the coroutine that the call
+ * instructions pop outgoing arguments into. The window keeps its capacity between calls, so popping
+ * arguments does not allocate once the window has grown to the largest argument count seen. The contents
+ * of the window are only valid until the next call instruction is executed.
+ *
+ * @return The argument window.
+ */
+std::vector<lyric_runtime::Operand>&
+lyric_runtime::StackfulCoroutine::argumentWindow()
+{
+    return m_argumentWindow;
+}
+
 bool
 lyric_runtime::StackfulCoroutine::dataStackEmpty() const
 {
@@ -285,6 +376,8 @@ lyric_runtime::StackfulCoroutine::reset()
 {
     m_IP = {};
     m_SP = nullptr;
+    m_predecoded = nullptr;
     m_callStack.clear();
     m_guardStack.clear();
+    m_argumentWindow.clear();
 }
@@ -146,14 +146,3 @@ lyric_runtime::StatusRef::setMembersReachable()
         operand.setReachable();
     }
 }
-
-void
-lyric_runtime::StatusRef::clearMembersReachable()
-{
-    if (m_message != nullptr) {
-        m_message->clearReachable();
-    }
-    for (auto &operand : m_fields) {
-        operand.clearReachable();
-    }
-}
\ No newline at end of file
@@ -0,0 +1,301 @@
+
+#include <algorithm>
+
+#include <utf8.h>
+
+#include <lyric_runtime/internal/text_kernels.h>
+#include <lyric_runtime/string_index.h>
+#include <tempo_utils/log_stream.h>
+
+lyric_runtime::StringIndex::StringIndex()
+    : m_valid(true),
+      m_ascii(true),
+      m_length(0),
+      m_size(0)
+{
+}
+
+/**
+ * Returns true if the contents are well-formed UTF-8. The remaining metadata is meaningful only if the
+ * index is valid.
+ */
+bool
+lyric_runtime::StringIndex::isValid() const
+{
+    return m_valid;
+}
+
+bool
+lyric_runtime::StringIndex::isAscii() const
+{
+    return m_ascii;
+}
+
+tu_int32
+lyric_runtime::StringIndex::getLength() const
+{
+    return m_length;
+}
+
+tu_int32
+lyric_runtime::StringIndex::getSize() const
+{
+    return m_size;
+}
+
+tu_int32
+lyric_runtime::StringIndex::numCheckpoints() const
+{
+    return static_cast<tu_int32>(m_checkpoints.size());
+}
+
+/**
+ * Finds the checkpoint at or preceding the code point at the specified `index`. On success `checkpoint`
+ * is set to the checkpoint and `end` is set to the byte offset of the following checkpoint (or the end of
+ * the contents), so the code point lies within at most kStringIndexMaxSpan bytes of the checkpoint.
+ *
+ * @param index The code point index.
+ * @param checkpoint The checkpoint preceding the code point.
+ * @param end The byte offset at which the span of the checkpoint ends.
+ * @return true if the code point was located, otherwise false.
+ */
+bool
+lyric_runtime::StringIndex::locate(tu_int32 index, StringCheckpoint &checkpoint, tu_int32 &end) const
+{
+    if (!m_valid || index < 0 || m_length <= index)
+        return false;
+
+    if (m_ascii) {
+        checkpoint = {index, index};
+        end = index + 1;
+        return true;
+    }
+
+    TU_ASSERT (!m_checkpoints.empty());
+    auto next = std::upper_bound(m_checkpoints.cbegin(), m_checkpoints.cend(), index,
+        [](tu_int32 i, const StringCheckpoint &cp) { return i < cp.index; });
+    checkpoint = *std::prev(next);
+    end = next != m_checkpoints.cend()? next->offset : m_size;
+    return true;
+}
+
+static int
+sequence_length(unsigned char lead)
+{
+    if (lead < 0x80)
+        return 1;
+    if ((lead >> 5) == 0x06)
+        return 2;
+    if ((lead >> 4) == 0x0E)
+        return 3;
+    if ((lead >> 3) == 0x1E)
+        return 4;
+    return 0;
+}
+
+/**
+ * Returns the byte offset of the code point at index `n` in the well-formed UTF-8 contents `data`, which
+ * must contain more than `n` code points. Lead bytes are counted a window at a time with the vector
+ * kernel, and each window is no larger than the number of code points still to be passed, so the final
+ * window ends exactly at the lead byte of the located code point.
+ */
+static size_t
+code_point_offset(const char *data, size_t n)
+{
+    size_t offset = 0;
+    size_t remaining = n + 1;
+    while (remaining > 0) {
+        auto count = lyric_runtime::internal::count_code_points(data + offset, remaining);
+        offset += remaining;
+        remaining -= count;
+    }
+    return offset - 1;
+}
+
+/**
+ * Appends a run of well-formed UTF-8 contents which begins with a multibyte sequence. The code points
+ * of the run are counted and its checkpoints are located with the vector kernel, rather than by decoding
+ * the run a code point at a time.
+ */
+void
+lyric_runtime::StringIndex::indexRun(const char *data, tu_int32 size)
+{
+    auto length = static_cast<tu_int32>(internal::count_code_points(data, size));
+    tu_int32 scanIndex = m_length;
+    tu_int32 scanOffset = 0;
+    auto next = (m_length + kStringIndexStride - 1) / kStringIndexStride * kStringIndexStride;
+    for (; next < m_length + length; next += kStringIndexStride) {
+        scanOffset += static_cast<tu_int32>(code_point_offset(data + scanOffset, next - scanIndex));
+        scanIndex = next;
+        m_checkpoints.push_back({next, m_size + scanOffset});
+    }
+    m_ascii = false;
+    m_length += length;
+    m_size += size;
+}
+
+/**
+ * Builds the index for the contents of `rope` in a single pass over its chunks. Multibyte sequences
+ * which are split across chunk boundaries are reassembled before they are validated.
+ *
+ * @param rope The string contents.
+ * @return The string index, which is invalid if the contents are not well-formed UTF-8.
+ */
+lyric_runtime::StringIndex
+lyric_runtime::StringIndex::build(const tempo_utils::Rope<char> &rope)
+{
+    StringIndex index;
+
+    char pending[4];
+    int numPending = 0;
+    int sequenceLength = 0;
+
+    auto chunks = rope.iterateChunks();
+    tempo_utils::RopeChunk<char> chunk;
+    while (chunks.getNext(chunk)) {
+        const char *it = chunk.data();
+        const char *end = it + chunk.size();
+
+        while (it != end) {
+            auto lead = static_cast<unsigned char>(*it);
+
+            // fast path for runs of ascii characters
+            if (numPending == 0 && lead < 0x80) {
+                auto run = static_cast<tu_int32>(internal::ascii_prefix_length(it, end - it));
+                auto next = (index.m_length + kStringIndexStride - 1) / kStringIndexStride * kStringIndexStride;
+                for (; next < index.m_length + run; next += kStringIndexStride) {
+                    index.m_checkpoints.push_back({next, index.m_size + (next - index.m_length)});
+                }
+                index.m_length += run;
+                index.m_size += run;
+                it += run;
+                continue;
+            }
+
+            // validate the run of complete sequences in a single pass and index it with the vector kernel,
+            // the sequence at which the run ends is invalid or is split across chunks
+            if (numPending == 0) {
+                auto *invalid = utf8::find_invalid(it, end);
+                if (invalid != it) {
+                    index.indexRun(it, static_cast<tu_int32>(invalid - it));
+                    it = invalid;
+                    continue;
+                }
+                sequenceLength = sequence_length(lead);
+                if (sequenceLength == 0) {
+                    index.m_valid = false;
+                    return index;
+                }
+            }
+
+            // copy as much of the sequence as is available in this chunk
+            while (numPending < sequenceLength && it != end) {
+                pending[numPending++] = *it++;
+            }
+            if (numPending < sequenceLength)
+                break;
+
+            if (!utf8::is_valid(pending, pending + sequenceLength)) {
+                index.m_valid = false;
+                return index;
+            }
+            if (index.m_length % kStringIndexStride == 0) {
+                index.m_checkpoints.push_back({index.m_length, index.m_size});
+            }
+            index.m_ascii = false;
+            index.m_length++;
+            index.m_size += sequenceLength;
+            numPending = 0;
+        }
+    }
+
+    // contents end with a truncated sequence
+    if (numPending > 0) {
+        index.m_valid = false;
+        return index;
+    }
+
+    if (index.m_ascii) {
+        index.m_checkpoints.clear();
+    }
+    return index;
+}
+
+/**
+ * Returns the index for ASCII-only contents of the specified `length`.
+ */
+lyric_runtime::StringIndex
+lyric_runtime::StringIndex::forAscii(tu_int32 length)
+{
+    StringIndex index;
+    index.m_length = length;
+    index.m_size = length;
+    return index;
+}
+
+/**
+ * Returns an invalid index.
+ */
+lyric_runtime::StringIndex
+lyric_runtime::StringIndex::invalid()
+{
+    StringIndex index;
+    index.m_valid = false;
+    return index;
+}
+
+/**
+ * Appends the checkpoints of `other`, rebased to `indexBase` and `offsetBase`, thinning the checkpoints
+ * so the index stays sparse when it is built up from many short pieces. The last checkpoint is dropped
+ * whenever the checkpoint before it is within kStringIndexStride code points of the appended checkpoint,
+ * so consecutive checkpoints are never more than kStringIndexStride code points apart, and every other
+ * checkpoint is more than kStringIndexStride code points apart.
+ */
+void
+lyric_runtime::StringIndex::appendCheckpoints(const StringIndex &other, tu_int32 indexBase, tu_int32 offsetBase)
+{
+    auto append = [this](StringCheckpoint cp) {
+        auto size = m_checkpoints.size();
+        if (size >= 2 && cp.index - m_checkpoints[size - 2].index <= kStringIndexStride) {
+            m_checkpoints.back() = cp;
+        } else {
+            m_checkpoints.push_back(cp);
+        }
+    };
+
+    if (other.m_ascii) {
+        for (tu_int32 i = 0; i < other.m_length; i += kStringIndexStride) {
+            append({indexBase + i, offsetBase + i});
+        }
+    } else {
+        for (const auto &cp : other.m_checkpoints) {
+            append({indexBase + cp.index, offsetBase + cp.offset});
+        }
+    }
+}
+
+/**
+ * Returns the index for the concatenation of the contents indexed by `lhs` and `rhs`, without decoding
+ * the contents. If either index is invalid then the result is invalid, and the concatenated contents
+ * must be indexed using build().
+ */
+lyric_runtime::StringIndex
+lyric_runtime::StringIndex::concat(const StringIndex &lhs, const StringIndex &rhs)
+{
+    if (!lhs.m_valid || !rhs.m_valid)
+        return invalid();
+    if (rhs.m_length == 0)
+        return lhs;
+    if (lhs.m_length == 0)
+        return rhs;
+
+    StringIndex index;
+    index.m_ascii = lhs.m_ascii && rhs.m_ascii;
+    index.m_length = lhs.m_length + rhs.m_length;
+    index.m_size = lhs.m_size + rhs.m_size;
+    if (!index.m_ascii) {
+        index.appendCheckpoints(lhs, 0, 0);
+        index.appendCheckpoints(rhs, lhs.m_length, lhs.m_size);
+    }
+    return index;
+}
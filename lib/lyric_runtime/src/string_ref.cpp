@@ -2,6 +2,7 @@
 #include <absl/strings/substitute.h>
 #include <utf8.h>
 
+#include <lyric_runtime/internal/text_kernels.h>
 #include <lyric_runtime/interpreter_state.h>
 #include <lyric_runtime/string_ref.h>
 #include <tempo_utils/log_stream.h>
@@ -9,6 +10,8 @@
 
 lyric_runtime::StringRef::StringRef(const ExistentialTable *etable, std::string_view literal)
     : m_etable(etable),
+      m_hashed(false),
+      m_hash(0),
       m_permanent(false),
       m_reachable(false)
 {
@@ -21,6 +24,8 @@ lyric_runtime::StringRef::StringRef(const ExistentialTable *etable, std::string_
 
 lyric_runtime::StringRef::StringRef(const ExistentialTable *etable, const char *src, int32_t size)
     : m_etable(etable),
+      m_hashed(false),
+      m_hash(0),
       m_permanent(false),
       m_reachable(false)
 {
@@ -34,6 +39,8 @@ lyric_runtime::StringRef::StringRef(const ExistentialTable *etable, const char *
 
 lyric_runtime::StringRef::StringRef(const ExistentialTable *etable, tempo_utils::Rope<char> rope)
     : m_etable(etable),
+      m_hashed(false),
+      m_hash(0),
       m_permanent(false),
       m_reachable(false)
 {
@@ -82,55 +89,17 @@ lyric_runtime::StringRef::compare(const AbstractRef *other) const
 {
     TU_NOTNULL (other);
 
-    auto thischunks = m_rope.iterateChunks();
     auto *otherstring = static_cast<const StringRef *>(other);
-    auto otherchunks = otherstring->m_rope.iterateChunks();
-
-    tempo_utils::RopeChunk<char> thischunk, otherchunk;
-
-    auto thisactive = thischunks.getNext(thischunk);
-    auto thisit = thischunk.cbegin();
-    auto thisend = thischunk.cend();;
-
-    auto otheractive = otherchunks.getNext(otherchunk);
-    auto otherit = otherchunk.cbegin();
-    auto otherend = otherchunk.cend();
-
-    while (thisactive && otheractive) {
-
-        while (thisit != thisend && otherit != otherend) {
-            try {
-                utf8::utfchar32_t thisch = utf8::next(thisit, thisend);
-                utf8::utfchar32_t otherch = utf8::next(otherit, otherend);
-                if (thisch < otherch)
-                    return -1;
-                if (otherch < thisch)
-                    return 1;
-            } catch (utf8::exception &ex) {
-            }
-        }
-
-        if (thisit == thisend) {
-            thisactive = thischunks.getNext(thischunk);
-            thisit = thischunk.cbegin();
-            thisend = thischunk.cend();
-        }
-
-        if (otherit == otherend) {
-            otheractive = otherchunks.getNext(otherchunk);
-            otherit = otherchunk.cbegin();
-            otherend = otherchunk.cend();
-        }
-    }
-
-    if (!thisactive)
-        return otheractive? 1 : 0;
-    return -1;
+    return internal::compare_ropes(m_rope, otherstring->m_rope);
 }
 
 bool
 lyric_runtime::StringRef::equals(const AbstractRef *other) const
 {
+    // if both strings have been hashed then unequal hashes imply unequal contents
+    auto *otherstring = static_cast<const StringRef *>(other);
+    if (m_hashed && otherstring->m_hashed && m_hash != otherstring->m_hash)
+        return false;
     return compare(other) == 0;
 }
 
@@ -172,14 +141,21 @@ lyric_runtime::StringRef::utf8Value(std::string &utf8) const
     return true;
 }
 
+/**
+ * Combines the hash of the string contents into `state`. The contents are hashed once and the result is
+ * memoized, so repeated map lookups using the same string do not rehash the rope. The contents are hashed
+ * as a contiguous sequence, so equal strings hash equally regardless of how their ropes are chunked.
+ */
 bool
 lyric_runtime::StringRef::hashValue(absl::HashState state)
 {
-    auto chunks = m_rope.iterateChunks();
-    tempo_utils::RopeChunk<char> chunk;
-    while (chunks.getNext(chunk)) {
-        state = absl::HashState::combine_contiguous(std::move(state), chunk.data(), chunk.size());
+    if (!m_hashed) {
+        std::string utf8;
+        utf8Value(utf8);
+        m_hash = absl::HashOf(std::string_view(utf8));
+        m_hashed = true;
     }
+    state = absl::HashState::combine(std::move(state), m_hash);
     return true;
 }
 
@@ -203,33 +179,34 @@ lyric_runtime::StringRef::toString() const
     return absl::Substitute("<$0: StringRef \"$1\">", this, s);
 }
 
+/**
+ * Returns the code point at the specified `index` as a Char, or Undef if the index is out of range or the
+ * string is not well-formed UTF-8. The code point is located using the string index, so the cost is
+ * O(log n) rather than linear in the index.
+ */
 lyric_runtime::Operand
 lyric_runtime::StringRef::stringAt(int index) const
 {
-    if (m_rope.isEmpty())
-        return Operand::undef();
+    const auto &stringIndex = getStringIndex();
 
-    try {
-
-        int curr = 0;
-        auto chunks = m_rope.iterateChunks();
-        tempo_utils::RopeChunk<char> chunk;
-        while (chunks.getNext(chunk)) {
-            auto *it = chunk.data();
-            auto *end = it + chunk.size();
-            do {
-                utf8::utfchar32_t chr = utf8::next(it, end);
-                if (curr++ == index)
-                    return Operand::fromC32(chr);
-            } while (it != end);
-        }
+    StringCheckpoint checkpoint;
+    tu_int32 end;
+    if (!stringIndex.locate(index, checkpoint, end))
         return Operand::undef();
 
-    } catch (utf8::not_enough_room &ex) {
-        return Operand::undef();
-    } catch (utf8::invalid_code_point &ex) {
+    char buffer[kStringIndexMaxSpan];
+    auto size = end - checkpoint.offset;
+    TU_ASSERT (size <= kStringIndexMaxSpan);
+    if (rawCopy(checkpoint.offset, buffer, size) != size)
         return Operand::undef();
+
+    // the contents were validated when the index was built, so decode without checking
+    const char *it = buffer;
+    utf8::utfchar32_t chr = utf8::unchecked::next(it);
+    for (auto curr = checkpoint.index; curr < index; curr++) {
+        chr = utf8::unchecked::next(it);
     }
+    return Operand::fromC32(chr);
 }
 
 lyric_runtime::Operand
@@ -239,32 +216,16 @@ lyric_runtime::StringRef::stringCompare(StringRef *other) const
     return Operand::fromI64(static_cast<tu_int64>(compare(other)));
 }
 
+/**
+ * Returns the number of code points in the string, or Undef if the string is not well-formed UTF-8.
+ */
 lyric_runtime::Operand
 lyric_runtime::StringRef::stringLength() const
 {
-    if (m_rope.isEmpty())
-        return Operand::fromI64(static_cast<int64_t>(0));
-
-    try {
-
-        size_t length = 0;
-        auto chunks = m_rope.iterateChunks();
-        tempo_utils::RopeChunk<char> chunk;
-        while (chunks.getNext(chunk)) {
-            auto *it = chunk.data();
-            auto *end = it + chunk.size();
-            do {
-                utf8::next(it, end);
-                length++;
-            } while (it != end);
-        }
-        return Operand::fromI64(static_cast<tu_int64>(length));
-
-    } catch (utf8::not_enough_room &ex) {
+    const auto &stringIndex = getStringIndex();
+    if (!stringIndex.isValid())
         return Operand::undef();
-    } catch (utf8::invalid_code_point &ex) {
-        return Operand::undef();
-    }
+    return Operand::fromI64(static_cast<tu_int64>(stringIndex.getLength()));
 }
 
 std::string
@@ -288,6 +249,36 @@ lyric_runtime::StringRef::getStringSize() const
     return m_size;
 }
 
+/**
+ * Returns the code point index for the string contents, building the index on first use.
+ */
+const lyric_runtime::StringIndex &
+lyric_runtime::StringRef::getStringIndex() const
+{
+    if (m_index == nullptr) {
+        m_index = std::make_unique<StringIndex>(StringIndex::build(m_rope));
+    }
+    return *m_index;
+}
+
+bool
+lyric_runtime::StringRef::hasStringIndex() const
+{
+    return m_index != nullptr;
+}
+
+/**
+ * Sets the code point index for the string contents. This is used when the index can be derived from the
+ * indexes of the strings the contents were built from, so that the contents do not need to be decoded.
+ */
+void
+lyric_runtime::StringRef::setStringIndex(StringIndex index)
+{
+    TU_ASSERT (index.isValid());
+    TU_ASSERT (index.getSize() == m_size);
+    m_index = std::make_unique<StringIndex>(std::move(index));
+}
+
 void
 lyric_runtime::StringRef::setPermanent()
 {
@@ -41,49 +41,106 @@ lyric_runtime::process_arguments(
     return {};
 }
 
+static tempo_utils::Status
+capture_from_activation(
+    const lyric_object::ProcLexical &lexical,
+    lyric_runtime::CallCell &activation,
+    lyric_runtime::UpvalueCellPtr &cell)
+{
+    switch (lexical.lexical_target) {
+        case lyric_object::LEXICAL_ARGUMENT:
+            cell = activation.captureArgument(lexical.target_offset);
+            break;
+        case lyric_object::LEXICAL_LOCAL:
+            cell = activation.captureLocal(lexical.target_offset);
+            break;
+        default:
+            return lyric_runtime::InterpreterStatus::forCondition(
+                lyric_runtime::InterpreterCondition::kRuntimeInvariant, "invalid lexical target");
+    }
+    if (cell == nullptr)
+        return lyric_runtime::InterpreterStatus::forCondition(
+            lyric_runtime::InterpreterCondition::kRuntimeInvariant, "invalid lexical offset");
+    return {};
+}
+
 /**
- * import each lexical from the latest activation and insert the lexical into the frame.
+ * Captures the variable referenced by `lexical` as an upvalue cell. The variable is expected to be
+ * defined by the enclosing frame at `frameOffset` in the call stack of `currentCoro`, or to have been
+ * captured already by the enclosing frame if it is itself a closure, so in the common case capturing is
+ * a single frame lookup. Only if neither holds is the call stack searched for the activation.
+ *
+ * @param lexical The lexical to capture.
+ * @param currentCoro The current coroutine.
+ * @param segment The segment containing the proc which declares the lexical.
+ * @param frameOffset The offset of the enclosing frame in the call stack.
+ * @param cell Set to the upvalue cell on success.
+ * @return Status
+ */
+tempo_utils::Status
+lyric_runtime::capture_lexical(
+    const lyric_object::ProcLexical &lexical,
+    StackfulCoroutine *currentCoro,
+    BytecodeSegment *segment,
+    int frameOffset,
+    UpvalueCellPtr &cell)
+{
+    auto segmentIndex = segment->getSegmentIndex();
+
+    CallCell *enclosing;
+    TU_RETURN_IF_NOT_OK (currentCoro->peekCall(&enclosing, frameOffset));
+
+    if (enclosing->getCallSegment() == segmentIndex) {
+        // the enclosing frame is the activation which defines the variable
+        if (enclosing->getCallIndex() == lexical.activation_call)
+            return capture_from_activation(lexical, *enclosing, cell);
+
+        // the enclosing frame is a closure which has captured the same variable
+        const ProcMetadata *enclosingMetadata;
+        TU_RETURN_IF_NOT_OK (segment->getProcMetadata(enclosing->getProcOffset(), &enclosingMetadata));
+        auto enclosingLexicals = enclosingMetadata->getLexicals();
+        for (int i = 0; i < enclosingLexicals.size(); i++) {
+            const auto &enclosingLexical = enclosingLexicals[i];
+            if (enclosingLexical.activation_call == lexical.activation_call
+                && enclosingLexical.lexical_target == lexical.lexical_target
+                && enclosingLexical.target_offset == lexical.target_offset) {
+                cell = enclosing->captureLexical(i);
+                return {};
+            }
+        }
+    }
+
+    // otherwise search the remainder of the call stack for the activation
+    for (int offset = frameOffset - 1; -offset <= currentCoro->callStackSize(); offset--) {
+        CallCell *ancestor;
+        TU_RETURN_IF_NOT_OK (currentCoro->peekCall(&ancestor, offset));
+        if (ancestor->getCallSegment() != segmentIndex)     // lexical must exist in callee segment
+            continue;
+        if (ancestor->getCallIndex() != lexical.activation_call)    // frame does not match activation call
+            continue;
+        return capture_from_activation(lexical, *ancestor, cell);
+    }
+
+    return lyric_runtime::InterpreterStatus::forCondition(
+        lyric_runtime::InterpreterCondition::kRuntimeInvariant, "missing lexical");
+}
+
+/**
+ * Captures each lexical from the calling frame and binds the upvalue cell to the lexical in `frame`.
  */
 tempo_utils::Status
 lyric_runtime::import_lexicals_into_frame(
-    const lyric_object::ProcInfo &procInfo,
-    const StackfulCoroutine *currentCoro,
-    const BytecodeSegment *segment,
+    const ProcMetadata &procMetadata,
+    StackfulCoroutine *currentCoro,
+    BytecodeSegment *segment,
     CallCell &frame)
 {
-    std::vector<lyric_object::ProcLexical> lexicals;
-    TU_RETURN_IF_NOT_OK (lyric_object::parse_lexicals_table(procInfo, lexicals));
+    auto lexicals = procMetadata.getLexicals();
 
     for (int i = 0; i < lexicals.size(); i++) {
-        const auto &lexical = lexicals.at(i);
-
-        bool found = false;
-        for (auto iterator = currentCoro->callsBegin(); iterator != currentCoro->callsEnd(); iterator++) {
-            const auto &ancestor = *iterator;
-
-            if (ancestor.getCallSegment() != segment->getSegmentIndex())    // lexical must exist in callee segment
-                continue;
-            if (ancestor.getCallIndex() != lexical.activation_call)         // frame does not match activation call
-                continue;
-            switch (lexical.lexical_target) {
-                case lyric_object::LEXICAL_ARGUMENT:
-                    frame.setLexical(i, ancestor.getArgument(lexical.target_offset));
-                    break;
-                case lyric_object::LEXICAL_LOCAL:
-                    frame.setLexical(i, ancestor.getLocal(lexical.target_offset));
-                    break;
-                default:
-                    return lyric_runtime::InterpreterStatus::forCondition(
-                        lyric_runtime::InterpreterCondition::kRuntimeInvariant,
-                        "invalid lexical target at offset {}", i);
-            }
-            found = true;                       // we found the lexical, break loop early
-            break;
-        }
-        if (!found)
-            return lyric_runtime::InterpreterStatus::forCondition(
-                lyric_runtime::InterpreterCondition::kRuntimeInvariant,
-                "missing lexical");
+        UpvalueCellPtr cell;
+        TU_RETURN_IF_NOT_OK (capture_lexical(lexicals[i], currentCoro, segment, -1, cell));
+        frame.bindLexical(i, std::move(cell));
     }
 
     return {};
@@ -115,11 +172,11 @@ lyric_runtime::SubroutineManager::callProc(
     TU_ASSERT (segment != nullptr);
     TU_ASSERT (currentCoro != nullptr);
 
-    auto bytecode = segment->getBytecode();
-    lyric_object::ProcInfo procInfo;
-    status = lyric_object::parse_proc_info(bytecode, procOffset, procInfo);
+    const lyric_runtime::ProcMetadata *procMetadata;
+    status = segment->getProcMetadata(procOffset, &procMetadata);
     if (status.notOk())
         return false;
+    const auto &procInfo = procMetadata->getProcInfo();
 
     const BytecodeSegment *returnSP = currentCoro->peekSP();
     const lyric_object::BytecodeIterator returnIP = currentCoro->peekIP();
@@ -138,13 +195,13 @@ lyric_runtime::SubroutineManager::callProc(
 
     // if any lexicals are present then import them
     if (procInfo.num_lexicals > 0) {
-        status = import_lexicals_into_frame(procInfo, currentCoro, segment, frame);
+        status = import_lexicals_into_frame(*procMetadata, currentCoro, segment, frame);
         if (status.notOk())
             return false;
     }
 
     lyric_object::BytecodeIterator ip(procInfo.code);
-    currentCoro->pushCall(frame, ip, segment);               // push the activation onto the call stack
+    currentCoro->pushCall(std::move(frame), ip, segment);    // push the activation onto the call stack
     TU_LOG_V << "moved ip to " << ip;
 
     return true;
@@ -171,12 +228,12 @@ call_static(
         return false;
     }
 
-    auto bytecode = segment->getBytecode();
     tu_uint32 procOffset = call.getProcOffset();
-    lyric_object::ProcInfo procInfo;
-    status = lyric_object::parse_proc_info(bytecode, procOffset, procInfo);
+    const lyric_runtime::ProcMetadata *procMetadata;
+    status = segment->getProcMetadata(procOffset, &procMetadata);
     if (status.notOk())
         return false;
+    const auto &procInfo = procMetadata->getProcInfo();
 
     const lyric_runtime::BytecodeSegment *returnSP = currentCoro->peekSP();
     const lyric_object::BytecodeIterator returnIP = currentCoro->peekIP();
@@ -196,13 +253,13 @@ call_static(
 
     // if any lexicals are present then import them
     if (procInfo.num_lexicals > 0) {
-        status = lyric_runtime::import_lexicals_into_frame(procInfo, currentCoro, segment, frame);
+        status = lyric_runtime::import_lexicals_into_frame(*procMetadata, currentCoro, segment, frame);
         if (status.notOk())
             return false;
     }
 
     lyric_object::BytecodeIterator ip(procInfo.code);
-    currentCoro->pushCall(frame, ip, segment);               // push the activation onto the call stack
+    currentCoro->pushCall(std::move(frame), ip, segment);    // push the activation onto the call stack
     TU_LOG_V << "moved ip to " << ip;
 
     return true;
@@ -309,6 +366,7 @@ lyric_runtime::SubroutineManager::callStatic(
  * @param args
  * @param currentCoro
  * @param status
+ * @param callSite The inline cache for the call site, or nullptr to look it up by return IP.
  * @return
  */
 bool
@@ -317,7 +375,8 @@ lyric_runtime::SubroutineManager::callVirtual(
     tu_uint32 callAddress,
     std::vector<Operand> &args,
     StackfulCoroutine *currentCoro,
-    tempo_utils::Status &status)
+    tempo_utils::Status &status,
+    CallSiteCache *callSite)
 {
     TU_ASSERT (currentCoro != nullptr);
 
@@ -366,18 +425,30 @@ lyric_runtime::SubroutineManager::callVirtual(
         return false;
     }
 
-    // resolve address to a call descriptor
-    auto descriptor = m_segmentManager->resolveDescriptor(
-        sp, lyric_object::LinkageSection::Call, callAddress, status);
-    if (!descriptor.isValid())
-        return false;
+    // check the inline cache for the call site before performing the full method lookup
+    auto *cache = callSite != nullptr ? callSite : sp->getCallSiteCache(currentCoro->peekIP());
+    const VirtualMethod *method = nullptr;
+    if (cache != nullptr && cache->isBoundTo(lyric_object::LinkageSection::Call, callAddress)) {
+        method = cache->lookup(resolver);
+    }
 
-    // resolve the descriptor to a method
-    const auto *method = resolver->getMethod(descriptor);
     if (method == nullptr) {
-        status = InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
-            "failed to call method; missing method {}", descriptor.toString());
-        return false;
+        // resolve address to a call descriptor
+        auto descriptor = resolveCallSiteDescriptor(
+            sp, cache, lyric_object::LinkageSection::Call, callAddress, status);
+        if (!descriptor.isValid())
+            return false;
+
+        // resolve the descriptor to a method
+        method = resolver->getMethod(descriptor);
+        if (method == nullptr) {
+            status = InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+                "failed to call method; missing method {}", descriptor.toString());
+            return false;
+        }
+        if (cache != nullptr) {
+            cache->insert(resolver, nullptr, method);
+        }
     }
 
     auto *segment = method->getSegment();
@@ -385,11 +456,11 @@ lyric_runtime::SubroutineManager::callVirtual(
     tu_uint32 procOffset = method->getProcOffset();
     bool returnsValue = method->returnsValue();
 
-    auto bytecode = segment->getBytecode();
-    lyric_object::ProcInfo procInfo;
-    status = lyric_object::parse_proc_info(bytecode, procOffset, procInfo);
+    const lyric_runtime::ProcMetadata *procMetadata;
+    status = segment->getProcMetadata(procOffset, &procMetadata);
     if (status.notOk())
         return false;
+    const auto &procInfo = procMetadata->getProcInfo();
 
     const BytecodeSegment *returnSP = sp;
     const lyric_object::BytecodeIterator returnIP = currentCoro->peekIP();
@@ -408,13 +479,13 @@ lyric_runtime::SubroutineManager::callVirtual(
 
     // if any lexicals are present then import them
     if (procInfo.num_lexicals > 0) {
-        status = import_lexicals_into_frame(procInfo, currentCoro, segment, frame);
+        status = import_lexicals_into_frame(*procMetadata, currentCoro, segment, frame);
         if (status.notOk())
             return false;
     }
 
     lyric_object::BytecodeIterator ip(procInfo.code);
-    currentCoro->pushCall(frame, ip, segment);               // push the activation onto the call stack
+    currentCoro->pushCall(std::move(frame), ip, segment);    // push the activation onto the call stack
     TU_LOG_V << "moved ip to " << ip;
 
     return true;
@@ -429,6 +500,7 @@ lyric_runtime::SubroutineManager::callVirtual(
  * @param args
  * @param currentCoro
  * @param status
+ * @param callSite The inline cache for the call site, or nullptr to look it up by return IP.
  * @return
  */
 bool
@@ -437,7 +509,8 @@ lyric_runtime::SubroutineManager::callStub(
     tu_uint32 actionAddress,
     std::vector<Operand> &args,
     StackfulCoroutine *currentCoro,
-    tempo_utils::Status &status)
+    tempo_utils::Status &status,
+    CallSiteCache *callSite)
 {
     TU_ASSERT (currentCoro != nullptr);
 
@@ -486,18 +559,30 @@ lyric_runtime::SubroutineManager::callStub(
         return false;
     }
 
-    // resolve address to a call descriptor
-    auto descriptor = m_segmentManager->resolveDescriptor(
-        sp, lyric_object::LinkageSection::Action, actionAddress, status);
-    if (!descriptor.isValid())
-        return false;
+    // check the inline cache for the call site before performing the full method lookup
+    auto *cache = callSite != nullptr ? callSite : sp->getCallSiteCache(currentCoro->peekIP());
+    const VirtualMethod *method = nullptr;
+    if (cache != nullptr && cache->isBoundTo(lyric_object::LinkageSection::Action, actionAddress)) {
+        method = cache->lookup(resolver);
+    }
 
-    // resolve the descriptor to a method
-    const auto *method = resolver->getMethod(descriptor);
     if (method == nullptr) {
-        status = InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
-            "failed to call method; missing stub {}", descriptor.toString());
-        return false;
+        // resolve address to an action descriptor
+        auto descriptor = resolveCallSiteDescriptor(
+            sp, cache, lyric_object::LinkageSection::Action, actionAddress, status);
+        if (!descriptor.isValid())
+            return false;
+
+        // resolve the descriptor to a method
+        method = resolver->getMethod(descriptor);
+        if (method == nullptr) {
+            status = InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+                "failed to call method; missing stub {}", descriptor.toString());
+            return false;
+        }
+        if (cache != nullptr) {
+            cache->insert(resolver, nullptr, method);
+        }
     }
 
     auto *segment = method->getSegment();
@@ -505,11 +590,11 @@ lyric_runtime::SubroutineManager::callStub(
     tu_uint32 procOffset = method->getProcOffset();
     bool returnsValue = method->returnsValue();
 
-    auto bytecode = segment->getBytecode();
-    lyric_object::ProcInfo procInfo;
-    status = lyric_object::parse_proc_info(bytecode, procOffset, procInfo);
+    const lyric_runtime::ProcMetadata *procMetadata;
+    status = segment->getProcMetadata(procOffset, &procMetadata);
     if (status.notOk())
         return false;
+    const auto &procInfo = procMetadata->getProcInfo();
 
     const BytecodeSegment *returnSP = sp;
     const lyric_object::BytecodeIterator returnIP = currentCoro->peekIP();
@@ -528,13 +613,13 @@ lyric_runtime::SubroutineManager::callStub(
 
     // if any lexicals are present then import them
     if (procInfo.num_lexicals > 0) {
-        status = import_lexicals_into_frame(procInfo, currentCoro, segment, frame);
+        status = import_lexicals_into_frame(*procMetadata, currentCoro, segment, frame);
         if (status.notOk())
             return false;
     }
 
     lyric_object::BytecodeIterator ip(procInfo.code);
-    currentCoro->pushCall(frame, ip, segment);               // push the activation onto the call stack
+    currentCoro->pushCall(std::move(frame), ip, segment);    // push the activation onto the call stack
     TU_LOG_V << "moved ip to " << ip;
 
     return true;
@@ -547,7 +632,8 @@ lyric_runtime::SubroutineManager::callConcept(
     tu_uint32 actionAddress,
     std::vector<Operand> &args,
     StackfulCoroutine *currentCoro,
-    tempo_utils::Status &status) {
+    tempo_utils::Status &status,
+    CallSiteCache *callSite) {
     TU_ASSERT (currentCoro != nullptr);
 
     auto *sp = currentCoro->peekSP();
@@ -595,18 +681,39 @@ lyric_runtime::SubroutineManager::callConcept(
         return false;
     }
 
-    // resolve address to an action descriptor
-    auto actionDescriptor = m_segmentManager->resolveDescriptor(
-        sp, lyric_object::LinkageSection::Action, actionAddress, status);
-    if (!actionDescriptor.isValid())
+    // the resolved extension depends on both the receiver and the concept, so the concept descriptor
+    // entry is used as the auxiliary key for the inline cache
+    DescriptorEntry *conceptEntry;
+    if (!conceptDescriptor.getDescriptor(conceptEntry)) {
+        status = InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+            "cannot resolve extension; invalid concept descriptor");
         return false;
+    }
+
+    // check the inline cache for the call site before performing the full extension lookup
+    auto *cache = callSite != nullptr ? callSite : sp->getCallSiteCache(currentCoro->peekIP());
+    const VirtualMethod *method = nullptr;
+    if (cache != nullptr && cache->isBoundTo(lyric_object::LinkageSection::Action, actionAddress)) {
+        method = cache->lookup(resolver, conceptEntry);
+    }
 
-    // resolve the descriptor to a method
-    const auto *method = resolver->getExtension(conceptDescriptor, actionDescriptor);
     if (method == nullptr) {
-        status = InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
-            "failed to call extension; missing extension");
-        return false;
+        // resolve address to an action descriptor
+        auto actionDescriptor = resolveCallSiteDescriptor(
+            sp, cache, lyric_object::LinkageSection::Action, actionAddress, status);
+        if (!actionDescriptor.isValid())
+            return false;
+
+        // resolve the descriptor to a method
+        method = resolver->getExtension(conceptDescriptor, actionDescriptor);
+        if (method == nullptr) {
+            status = InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+                "failed to call extension; missing extension");
+            return false;
+        }
+        if (cache != nullptr) {
+            cache->insert(resolver, conceptEntry, method);
+        }
     }
 
     auto *segment = method->getSegment();
@@ -614,11 +721,11 @@ lyric_runtime::SubroutineManager::callConcept(
     const auto procOffset = method->getProcOffset();
     bool returnsValue = method->returnsValue();
 
-    auto bytecode = segment->getBytecode();
-    lyric_object::ProcInfo procInfo;
-    status = lyric_object::parse_proc_info(bytecode, procOffset, procInfo);
+    const lyric_runtime::ProcMetadata *procMetadata;
+    status = segment->getProcMetadata(procOffset, &procMetadata);
     if (status.notOk())
         return false;
+    const auto &procInfo = procMetadata->getProcInfo();
 
     const BytecodeSegment *returnSP = sp;
     const lyric_object::BytecodeIterator returnIP = currentCoro->peekIP();
@@ -637,13 +744,13 @@ lyric_runtime::SubroutineManager::callConcept(
 
     // if any lexicals are present then import them
     if (procInfo.num_lexicals > 0) {
-        status = import_lexicals_into_frame(procInfo, currentCoro, segment, frame);
+        status = import_lexicals_into_frame(*procMetadata, currentCoro, segment, frame);
         if (status.notOk())
             return false;
     }
 
     lyric_object::BytecodeIterator ip(procInfo.code);
-    currentCoro->pushCall(frame, ip, segment);               // push the activation onto the call stack
+    currentCoro->pushCall(std::move(frame), ip, segment);    // push the activation onto the call stack
     TU_LOG_V << "moved ip to " << ip;
 
     return true;
@@ -656,7 +763,8 @@ lyric_runtime::SubroutineManager::callExistential(
     tu_uint32 methodAddress,
     std::vector<Operand> &args,
     StackfulCoroutine *currentCoro,
-    tempo_utils::Status &status)
+    tempo_utils::Status &status,
+    CallSiteCache *callSite)
 {
     TU_ASSERT (receiver.isValid());
     TU_ASSERT (existentialDescriptor.isValid());
@@ -664,22 +772,42 @@ lyric_runtime::SubroutineManager::callExistential(
 
     auto *sp = currentCoro->peekSP();
 
-    auto *etable = m_segmentManager->resolveExistentialTable(existentialDescriptor, status);
-    if (etable == nullptr)
+    // the existential descriptor entry identifies the etable, so it is used as the inline cache key
+    DescriptorEntry *existentialEntry;
+    if (!existentialDescriptor.getDescriptor(existentialEntry)) {
+        status = InterpreterStatus::forCondition(
+            InterpreterCondition::kRuntimeInvariant, "invalid existential descriptor");
         return false;
+    }
 
-    // resolve address to a descriptor
-    auto callDescriptor = m_segmentManager->resolveDescriptor(
-        sp, lyric_object::LinkageSection::Call, methodAddress, status);
-    if (!callDescriptor.isValid())
-        return false;
+    // check the inline cache for the call site before resolving the etable
+    auto *cache = callSite != nullptr ? callSite : sp->getCallSiteCache(currentCoro->peekIP());
+    const VirtualMethod *method = nullptr;
+    if (cache != nullptr && cache->isBoundTo(lyric_object::LinkageSection::Call, methodAddress)) {
+        method = cache->lookup(existentialEntry);
+    }
 
-    // resolve the descriptor to an etable entry
-    const auto *method = etable->getMethod(callDescriptor);
     if (method == nullptr) {
-        status = InterpreterStatus::forCondition(
-            InterpreterCondition::kRuntimeInvariant, "missing method");
-        return false;
+        auto *etable = m_segmentManager->resolveExistentialTable(existentialDescriptor, status);
+        if (etable == nullptr)
+            return false;
+
+        // resolve address to a descriptor
+        auto callDescriptor = resolveCallSiteDescriptor(
+            sp, cache, lyric_object::LinkageSection::Call, methodAddress, status);
+        if (!callDescriptor.isValid())
+            return false;
+
+        // resolve the descriptor to an etable entry
+        method = etable->getMethod(callDescriptor);
+        if (method == nullptr) {
+            status = InterpreterStatus::forCondition(
+                InterpreterCondition::kRuntimeInvariant, "missing method");
+            return false;
+        }
+        if (cache != nullptr) {
+            cache->insert(existentialEntry, nullptr, method);
+        }
     }
 
     auto *segment = method->getSegment();
@@ -687,11 +815,11 @@ lyric_runtime::SubroutineManager::callExistential(
     const auto procOffset = method->getProcOffset();
     bool returnsValue = method->returnsValue();
 
-    auto bytecode = segment->getBytecode();
-    lyric_object::ProcInfo procInfo;
-    status = lyric_object::parse_proc_info(bytecode, procOffset, procInfo);
+    const lyric_runtime::ProcMetadata *procMetadata;
+    status = segment->getProcMetadata(procOffset, &procMetadata);
     if (status.notOk())
         return false;
+    const auto &procInfo = procMetadata->getProcInfo();
 
     const BytecodeSegment *returnSP = sp;
     const lyric_object::BytecodeIterator returnIP = currentCoro->peekIP();
@@ -710,13 +838,13 @@ lyric_runtime::SubroutineManager::callExistential(
 
     // if any lexicals are present then import them
     if (procInfo.num_lexicals > 0) {
-        status = import_lexicals_into_frame(procInfo, currentCoro, segment, frame);
+        status = import_lexicals_into_frame(*procMetadata, currentCoro, segment, frame);
         if (status.notOk())
             return false;
     }
 
     lyric_object::BytecodeIterator ip(procInfo.code);
-    currentCoro->pushCall(frame, ip, segment);               // push the activation onto the call stack
+    currentCoro->pushCall(std::move(frame), ip, segment);    // push the activation onto the call stack
     TU_LOG_V << "moved ip to " << ip;
 
     return true;
@@ -775,6 +903,36 @@ lyric_runtime::SubroutineManager::initStatic(
     return callProc(callIndex, segment, procOffset, args, returnsValue, currentCoro, status);
 }
 
+/**
+ * Resolves the descriptor for the specified call `address` in relation to `sp`. If a call site `cache`
+ * is specified and is bound to the address then the cached descriptor is returned, otherwise the
+ * descriptor is resolved by the segment manager and the cache is bound to the address.
+ *
+ * @param sp The segment containing the call site.
+ * @param cache The inline cache for the call site, or nullptr.
+ * @param section The linkage section of the descriptor.
+ * @param address The call address.
+ * @param status The status, set if the descriptor could not be resolved.
+ * @return The descriptor, or an invalid operand if resolution failed.
+ */
+lyric_runtime::Operand
+lyric_runtime::SubroutineManager::resolveCallSiteDescriptor(
+    BytecodeSegment *sp,
+    CallSiteCache *cache,
+    lyric_object::LinkageSection section,
+    tu_uint32 address,
+    tempo_utils::Status &status)
+{
+    if (cache != nullptr && cache->isBoundTo(section, address))
+        return cache->getDescriptor();
+
+    auto descriptor = m_segmentManager->resolveDescriptor(sp, section, address, status);
+    if (descriptor.isValid() && cache != nullptr) {
+        cache->bind(section, address, descriptor);
+    }
+    return descriptor;
+}
+
 bool
 lyric_runtime::SubroutineManager::returnToCaller(
     StackfulCoroutine *currentCoro,
@@ -789,32 +947,38 @@ lyric_runtime::SubroutineManager::returnToCaller(
         return false;
     }
 
-    // otherwise pop the top of the call stack and restore the *SP and *IP registers from the activation frame
-    CallCell frame;
-    status = currentCoro->popCall(frame);
+    // otherwise restore the *SP and *IP registers from the activation frame and drop the frame from the
+    // top of the call stack. the frame is dropped in place rather than moved out of the call stack.
+    const CallCell *frameptr;
+    status = currentCoro->peekCall(&frameptr);
     if (status.notOk())
         return false;
 
-    auto ip = frame.getReturnIP();
-    auto sp = m_segmentManager->getSegment(frame.getReturnSegment());
+    auto ip = frameptr->getReturnIP();
+    auto sp = m_segmentManager->getSegment(frameptr->getReturnSegment());
+    auto stackGuard = frameptr->getStackGuard();
+    auto returnsValue = frameptr->returnsValue();
+    status = currentCoro->dropCall();
+    if (status.notOk())
+        return false;
     currentCoro->transferControl(ip, sp);
 
     // drop leftover temporaries from the stack
-    if (currentCoro->dataStackSize() > frame.getStackGuard()) {
+    if (currentCoro->dataStackSize() > stackGuard) {
         // preserve the top most item as the return value if call returns a value
-        if (frame.returnsValue()) {
+        if (returnsValue) {
             Operand returnValue;
             status = currentCoro->popData(returnValue);
             if (status.notOk())
                 return false;
-            status = currentCoro->resizeDataStack(frame.getStackGuard());
+            status = currentCoro->resizeDataStack(stackGuard);
             if (status.notOk())
                 return false;
             status = currentCoro->pushData(returnValue);
             if (status.notOk())
                 return false;
         } else {
-            status = currentCoro->resizeDataStack(frame.getStackGuard());
+            status = currentCoro->resizeDataStack(stackGuard);
             if (status.notOk())
                 return false;
         }
@@ -13,7 +13,7 @@ lyric_runtime::AsyncHandle::AsyncHandle(uv_async_t *async, uv_close_cb cb)
 
 lyric_runtime::AsyncHandle::~AsyncHandle()
 {
-    close();
+    close(nullptr);
 }
 
 /**
@@ -48,12 +48,18 @@ lyric_runtime::AsyncHandle::sendSignal()
 /**
  * Closes the internal async handle and marks it for deletion. After this method has been called
  * `sendSignal` will do nothing, and `isPending` will return false.
+ *
+ * @param closeData If not nullptr, then the handle data is replaced with closeData before the handle
+ *     is closed, so that the close callback can locate the owner of the handle storage.
  */
 void
-lyric_runtime::AsyncHandle::close()
+lyric_runtime::AsyncHandle::close(void *closeData)
 {
     absl::MutexLock locker(m_lock.get());
     if (m_async) {
+        if (closeData != nullptr) {
+            m_async->data = closeData;
+        }
         uv_close((uv_handle_t *) m_async, m_cb);
         m_async = nullptr;
         m_pending = false;
@@ -87,36 +93,31 @@ lyric_runtime::Waiter::Waiter(uv_fs_t *req, std::shared_ptr<Promise> promise)
     m_waitee = req;
 }
 
-static void
-on_handle_close(uv_handle_t *handle)
+lyric_runtime::Waiter::Waiter(TimerEntry *timer, std::shared_ptr<Promise> promise)
+    : m_type(Type::Timer),
+      m_promise(std::move(promise))
 {
-    free(handle);
+    TU_NOTNULL (m_promise);
+    TU_NOTNULL (timer);
+    m_waitee = timer;
 }
 
-lyric_runtime::Waiter::~Waiter()
+lyric_runtime::Waiter::Waiter(FsBatch *batch, std::shared_ptr<Promise> promise)
+    : m_type(Type::Batch),
+      m_promise(std::move(promise))
 {
-    switch (m_type) {
-        case Type::Async: {
-            auto async = std::get<std::shared_ptr<AsyncHandle>>(m_waitee);
-            // close async handle if still pending, otherwise this is a no-op
-            async->close();
-            break;
-        }
-        case Type::Handle: {
-            auto *handle = std::get<uv_handle_t *>(m_waitee);
-            // close the handle and defer deallocation to the specified callback
-            uv_close(handle, on_handle_close);
-            break;
-        }
-        case Type::Req: {
-            auto *req = std::get<uv_fs_t *>(m_waitee);
-            // clean up the fs request immediately
-            uv_fs_req_cleanup(req);
-            break;
-        }
-        default:
-            TU_UNREACHABLE();
-    }
+    TU_NOTNULL (m_promise);
+    TU_NOTNULL (batch);
+    m_waitee = batch;
+}
+
+lyric_runtime::Waiter::Waiter(FsReadFile *fileRead, std::shared_ptr<Promise> promise)
+    : m_type(Type::ReadFile),
+      m_promise(std::move(promise))
+{
+    TU_NOTNULL (m_promise);
+    TU_NOTNULL (fileRead);
+    m_waitee = fileRead;
 }
 
 lyric_runtime::Waiter::Type
@@ -150,6 +151,30 @@ lyric_runtime::Waiter::peekReq() const
     return std::get<uv_fs_t *>(m_waitee);
 }
 
+const lyric_runtime::TimerEntry *
+lyric_runtime::Waiter::peekTimer() const
+{
+    if (static_cast<Type>(m_waitee.index()) != Type::Timer)
+        return nullptr;
+    return std::get<TimerEntry *>(m_waitee);
+}
+
+const lyric_runtime::FsBatch *
+lyric_runtime::Waiter::peekBatch() const
+{
+    if (static_cast<Type>(m_waitee.index()) != Type::Batch)
+        return nullptr;
+    return std::get<FsBatch *>(m_waitee);
+}
+
+const lyric_runtime::FsReadFile *
+lyric_runtime::Waiter::peekReadFile() const
+{
+    if (static_cast<Type>(m_waitee.index()) != Type::ReadFile)
+        return nullptr;
+    return std::get<FsReadFile *>(m_waitee);
+}
+
 bool
 lyric_runtime::Waiter::hasTask() const
 {
@@ -235,17 +260,26 @@ lyric_runtime::Waiter::complete(InterpreterState *state)
     systemScheduler->destroyWaiter(this);
 }
 
-lyric_runtime::SystemScheduler::SystemScheduler(uv_loop_t *loop)
+lyric_runtime::SystemScheduler::SystemScheduler(uv_loop_t *loop, OperandStackLayout operandStackLayout)
     : m_loop(loop),
+      m_operandStackLayout(operandStackLayout),
       m_readyQueue(nullptr),
       m_waitQueue(nullptr),
       m_doneQueue(nullptr),
       m_currentTask(nullptr),
       m_mainTask(nullptr),
-      m_waiters(nullptr)
+      m_waiters(nullptr),
+      m_tearingDown(false),
+      m_timerWheel(uv_now(loop)),
+      m_wheelTimer(nullptr),
+      m_wheelWakeup(0)
 {
     TU_ASSERT (m_loop != nullptr);
 
+    m_wheelTimer = (uv_timer_t *) m_handlePool.allocate();
+    uv_timer_init(m_loop, m_wheelTimer);
+    m_wheelTimer->data = this;
+
     m_mainTask = new Task(/* isMainTask= */ true, this);
     m_mainTask->setState(Task::State::Waiting);
 
@@ -268,10 +302,21 @@ lyric_runtime::SystemScheduler::~SystemScheduler()
         destroyTask(m_doneQueue);
     }
     // destroy all pending waiters
+    m_tearingDown = true;
     while (m_waiters) {
         destroyWaiter(m_waiters);
     }
 
+    // close the timer wheel handle
+    TU_ASSERT (m_timerWheel.isEmpty());
+    closeHandle((uv_handle_t *) m_wheelTimer);
+    m_wheelTimer = nullptr;
+
+    // run the loop once so the close callbacks return the handle storage to the pool before the pools
+    // are destroyed. fs requests still in flight were detached from their waiters, so their completion
+    // callbacks only free the request.
+    uv_run(m_loop, UV_RUN_NOWAIT);
+
     TU_ASSERT (m_readyQueue == nullptr);
     TU_ASSERT (m_waitQueue == nullptr);
     TU_ASSERT (m_waiters == nullptr);
@@ -283,6 +328,12 @@ lyric_runtime::SystemScheduler::systemLoop() const
     return m_loop;
 }
 
+lyric_runtime::OperandStackLayout
+lyric_runtime::SystemScheduler::getOperandStackLayout() const
+{
+    return m_operandStackLayout;
+}
+
 lyric_runtime::Task *
 lyric_runtime::SystemScheduler::mainTask() const
 {
@@ -489,10 +540,43 @@ lyric_runtime::on_async_complete(uv_async_t *async)
     waiter->complete(state);
 }
 
-static void
-on_async_close(uv_handle_t *async)
+void
+lyric_runtime::on_pooled_handle_close(uv_handle_t *handle)
+{
+    auto *scheduler = static_cast<SystemScheduler *>(handle->data);
+    scheduler->m_handlePool.release((uv_any_handle *) handle);
+}
+
+/**
+ * Allocate an async handle from the handle pool and initialize it with the specified callback.
+ */
+uv_async_t *
+lyric_runtime::SystemScheduler::allocateAsync(uv_async_cb cb)
 {
-    std::free(async);
+    auto *async = (uv_async_t *) m_handlePool.allocate();
+    uv_async_init(m_loop, async, cb);
+    return async;
+}
+
+/**
+ * Allocate a zeroed fs request from the request pool.
+ */
+uv_fs_t *
+lyric_runtime::SystemScheduler::allocateReq()
+{
+    auto *req = m_reqPool.allocate();
+    memset(req, 0, sizeof(uv_fs_t));
+    return req;
+}
+
+/**
+ * Close the handle. The handle storage is returned to the handle pool from the close callback.
+ */
+void
+lyric_runtime::SystemScheduler::closeHandle(uv_handle_t *handle)
+{
+    handle->data = this;
+    uv_close(handle, on_pooled_handle_close);
 }
 
 tempo_utils::Result<std::shared_ptr<lyric_runtime::AsyncHandle>>
@@ -504,12 +588,11 @@ lyric_runtime::SystemScheduler::registerAsync(
     TU_ASSERT (promise->getState() == Promise::State::Initial);
 
     // initialize the async handle
-    auto *handle = (uv_async_t *) malloc(sizeof(uv_async_t));
-    uv_async_init(m_loop, handle, on_async_complete);
-    auto async = std::make_shared<AsyncHandle>(handle, on_async_close);
+    auto *handle = allocateAsync(on_async_complete);
+    auto async = std::make_shared<AsyncHandle>(handle, on_pooled_handle_close);
 
     // allocate a new waiter
-    auto *waiter = new Waiter(async, promise);
+    auto *waiter = allocateWaiter(async, promise);
 
     // link the waiter to the promise and set the promise state to Pending
     promise->pending(waiter);
@@ -531,12 +614,11 @@ lyric_runtime::SystemScheduler::registerTarget(std::shared_ptr<Promise> promise)
     TU_ASSERT (promise->getState() == Promise::State::Initial);
 
     // initialize the async handle
-    auto *handle = (uv_async_t *) malloc(sizeof(uv_async_t));
-    uv_async_init(m_loop, handle, on_async_complete);
-    auto async = std::make_shared<AsyncHandle>(handle, on_async_close);
+    auto *handle = allocateAsync(on_async_complete);
+    auto async = std::make_shared<AsyncHandle>(handle, on_pooled_handle_close);
 
     // allocate a new waiter
-    auto *waiter = new Waiter(async, promise);
+    auto *waiter = allocateWaiter(async, promise);
 
     // link the waiter and the async handle to the promise and set the promise state to Target
     promise->target(async, waiter);
@@ -566,11 +648,10 @@ lyric_runtime::SystemScheduler::registerWorker(Task *workerTask, std::shared_ptr
     TU_ASSERT (promise->getState() == Promise::State::Initial);
 
     // initialize the async handle
-    auto *monitor = (uv_async_t *) malloc(sizeof(uv_async_t));
-    uv_async_init(m_loop, monitor, on_worker_complete);
+    auto *monitor = allocateAsync(on_worker_complete);
 
     // allocate a new waiter
-    auto *waiter = new Waiter((uv_handle_t *) monitor, promise);
+    auto *waiter = allocateWaiter((uv_handle_t *) monitor, promise);
 
     // link the waiter to the promise and set the promise state to Pending
     promise->pending(waiter);
@@ -588,34 +669,81 @@ lyric_runtime::SystemScheduler::registerWorker(Task *workerTask, std::shared_ptr
 }
 
 void
-lyric_runtime::on_timer_complete(uv_timer_t *timer)
+lyric_runtime::on_timer_complete(TimerEntry *timer, void *data)
 {
     auto *waiter = static_cast<Waiter *>(timer->data);
-    auto *state = static_cast<InterpreterState *>(timer->loop->data);
+    auto *scheduler = static_cast<SystemScheduler *>(data);
+    auto *state = static_cast<InterpreterState *>(scheduler->m_loop->data);
     waiter->complete(state);
 }
 
+void
+lyric_runtime::on_wheel_timer(uv_timer_t *timer)
+{
+    auto *scheduler = static_cast<SystemScheduler *>(timer->data);
+    scheduler->m_wheelWakeup = 0;
+    scheduler->m_timerWheel.advance(uv_now(timer->loop), on_timer_complete, scheduler);
+    scheduler->armWheelTimer();
+}
+
+/**
+ * Start the wheel timer so it fires when the timer wheel must next be advanced, or stop it if the wheel
+ * is empty. The wheel timer is only restarted if the wakeup tick has changed.
+ */
+void
+lyric_runtime::SystemScheduler::armWheelTimer()
+{
+    if (m_timerWheel.isEmpty()) {
+        uv_timer_stop(m_wheelTimer);
+        m_wheelWakeup = 0;
+        return;
+    }
+    auto wakeup = m_timerWheel.nextWakeup();
+    if (wakeup == m_wheelWakeup)
+        return;
+    auto now = uv_now(m_loop);
+    uv_timer_start(m_wheelTimer, on_wheel_timer, wakeup > now? wakeup - now : 0, 0);
+    m_wheelWakeup = wakeup;
+}
+
+/**
+ * Register a timer which completes the promise after the specified deadline. The timer is scheduled
+ * in the timer wheel with millisecond resolution, and timers which expire on the same tick are
+ * completed together.
+ *
+ * @param deadline The deadline in milliseconds, relative to the current loop time.
+ * @param promise The promise.
+ * @return Ok status.
+ */
 tempo_utils::Status
 lyric_runtime::SystemScheduler::registerTimer(tu_uint64 deadline, std::shared_ptr<Promise> promise)
 {
     TU_ASSERT (promise != nullptr);
     TU_ASSERT (promise->getState() == Promise::State::Initial);
 
-    // initialize the timer handle
-    auto *timer = (uv_timer_t *) malloc(sizeof(uv_timer_t));
-    uv_timer_init(m_loop, timer);
+    auto now = uv_now(m_loop);
+
+    // if the wheel is empty then move the wheel forward to the current loop time. this does not
+    // expire any timers, but ensures the next advance does not process the idle ticks.
+    if (m_timerWheel.isEmpty()) {
+        m_timerWheel.advance(now, on_timer_complete, this);
+    }
+
+    // allocate the timer entry
+    auto *timer = new (m_timerPool.allocate()) TimerEntry();
 
     // allocate a new waiter
-    auto *waiter = new Waiter((uv_handle_t *) timer, promise);
+    auto *waiter = allocateWaiter(timer, promise);
 
     // link the waiter to the promise and set the promise state to Pending
     promise->pending(waiter);
 
-    // link the waiter to the timer handle
+    // link the waiter to the timer entry
     timer->data = waiter;
 
-    // start the timer
-    uv_timer_start(timer, on_timer_complete, deadline, 0);
+    // schedule the timer and update the wheel timer if the timer is the earliest
+    m_timerWheel.insert(timer, now + deadline);
+    armWheelTimer();
 
     // attach waiter to the end of the global waiters list
     attachWaiter(waiter);
@@ -627,6 +755,12 @@ void
 lyric_runtime::on_read_complete(uv_fs_t *req)
 {
     auto *waiter = static_cast<Waiter *>(req->data);
+    // the waiter is detached if the scheduler was destroyed while the request was in flight
+    if (waiter == nullptr) {
+        uv_fs_req_cleanup(req);
+        std::free(req);
+        return;
+    }
     auto *state = static_cast<InterpreterState *>(req->loop->data);
     waiter->complete(state);
 }
@@ -637,23 +771,44 @@ lyric_runtime::SystemScheduler::registerRead(
     uv_buf_t buf,
     std::shared_ptr<Promise> promise,
     tu_int64 offset)
+{
+    return registerRead(file, &buf, 1, std::move(promise), offset);
+}
+
+/**
+ * Register a vectored read which fills each of the specified buffers in order. The buffers must stay
+ * valid until the promise is accepted.
+ *
+ * @param file The file to read from.
+ * @param bufs The array of buffers to read into.
+ * @param nbufs The number of buffers.
+ * @param promise The promise.
+ * @param offset The file offset to read from, or -1 to read from the current file position.
+ * @return Ok status if the read was scheduled, otherwise kRuntimeInvariant status.
+ */
+tempo_utils::Status
+lyric_runtime::SystemScheduler::registerRead(
+    uv_file file,
+    const uv_buf_t bufs[],
+    unsigned int nbufs,
+    std::shared_ptr<Promise> promise,
+    tu_int64 offset)
 {
     TU_ASSERT (promise != nullptr);
     TU_ASSERT (promise->getState() == Promise::State::Initial);
 
-    auto *req = (uv_fs_t *) malloc(sizeof(uv_fs_t));
-    memset(req, 0, sizeof(uv_fs_t));
+    auto *req = allocateReq();
 
-    auto ret = uv_fs_read(m_loop, req, file, &buf, 1, offset, on_read_complete);
+    auto ret = uv_fs_read(m_loop, req, file, bufs, nbufs, offset, on_read_complete);
     if (ret < 0) {
         uv_fs_req_cleanup(req);
-        free(req);
+        m_reqPool.release(req);
         return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
             "failed to schedule read: {}", uv_strerror(ret));
     }
 
     // allocate a new waiter
-    auto *waiter = new Waiter(req, promise);
+    auto *waiter = allocateWaiter(req, promise);
 
     // link the waiter to the promise and set the promise state to Pending
     promise->pending(waiter);
@@ -667,10 +822,57 @@ lyric_runtime::SystemScheduler::registerRead(
     return {};
 }
 
+/**
+ * Register a read of the entire contents of the file. The file is sized with fstat and read into a
+ * single buffer starting at offset 0, and the contents are available from the waiter when the promise
+ * is accepted.
+ *
+ * @param file The file to read.
+ * @param promise The promise.
+ * @return Ok status if the read was scheduled, otherwise kRuntimeInvariant status.
+ */
+tempo_utils::Status
+lyric_runtime::SystemScheduler::registerReadFile(uv_file file, std::shared_ptr<Promise> promise)
+{
+    TU_ASSERT (promise != nullptr);
+    TU_ASSERT (promise->getState() == Promise::State::Initial);
+
+    auto *fileRead = new FsReadFile(m_loop, file);
+
+    auto ret = uv_fs_fstat(m_loop, &fileRead->m_req, file, on_read_file_stat);
+    if (ret < 0) {
+        uv_fs_req_cleanup(&fileRead->m_req);
+        delete fileRead;
+        return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+            "failed to schedule read: {}", uv_strerror(ret));
+    }
+    fileRead->m_inFlight = true;
+
+    // allocate a new waiter
+    auto *waiter = allocateWaiter(fileRead, promise);
+
+    // link the waiter to the promise and set the promise state to Pending
+    promise->pending(waiter);
+
+    // link the waiter to the file read
+    fileRead->m_waiter = waiter;
+
+    // attach waiter to the end of the global waiters list
+    attachWaiter(waiter);
+
+    return {};
+}
+
 void
 lyric_runtime::on_write_complete(uv_fs_t *req)
 {
     auto *waiter = static_cast<Waiter *>(req->data);
+    // the waiter is detached if the scheduler was destroyed while the request was in flight
+    if (waiter == nullptr) {
+        uv_fs_req_cleanup(req);
+        std::free(req);
+        return;
+    }
     auto *state = static_cast<InterpreterState *>(req->loop->data);
     waiter->complete(state);
 }
@@ -686,19 +888,18 @@ lyric_runtime::SystemScheduler::registerWrite(
     TU_ASSERT (promise != nullptr);
     TU_ASSERT (promise->getState() == Promise::State::Initial);
 
-    auto *req = (uv_fs_t *) malloc(sizeof(uv_fs_t));
-    memset(req, 0, sizeof(uv_fs_t));
+    auto *req = allocateReq();
 
     auto ret = uv_fs_write(m_loop, req, file, bufs, nbufs, offset, on_write_complete);
     if (ret < 0) {
         uv_fs_req_cleanup(req);
-        free(req);
+        m_reqPool.release(req);
         return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
             "failed to schedule write: {}", uv_strerror(ret));
     }
 
     // allocate a new waiter
-    auto *waiter = new Waiter(req, promise);
+    auto *waiter = allocateWaiter(req, promise);
 
     // link the waiter to the promise and set the promise state to Pending
     promise->pending(waiter);
@@ -712,6 +913,79 @@ lyric_runtime::SystemScheduler::registerWrite(
     return {};
 }
 
+/**
+ * Register a batch of fs operations which are all submitted at once, and which complete the promise
+ * when every operation has finished. The result of each operation is available from the waiter when
+ * the promise is accepted. If an operation other than the first cannot be submitted then its result
+ * is set to the error and the remaining operations are still submitted.
+ *
+ * @param operations The fs operations.
+ * @param promise The promise.
+ * @return Ok status if the batch was scheduled, otherwise kRuntimeInvariant status.
+ */
+tempo_utils::Status
+lyric_runtime::SystemScheduler::registerBatch(
+    const std::vector<FsOperation> &operations,
+    std::shared_ptr<Promise> promise)
+{
+    TU_ASSERT (promise != nullptr);
+    TU_ASSERT (promise->getState() == Promise::State::Initial);
+
+    if (operations.empty())
+        return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+            "failed to schedule batch: no operations");
+
+    auto *batch = new FsBatch(static_cast<int>(operations.size()));
+
+    for (int i = 0; i < batch->m_numOperations; i++) {
+        const auto &op = operations[i];
+        auto *req = &batch->m_reqs[i];
+        memset(req, 0, sizeof(uv_fs_t));
+        req->data = batch;
+
+        int ret;
+        auto nbufs = static_cast<unsigned int>(op.bufs.size());
+        switch (op.kind) {
+            case FsOperation::Kind::Read:
+                ret = uv_fs_read(m_loop, req, op.file, op.bufs.data(), nbufs, op.offset, on_batch_complete);
+                break;
+            case FsOperation::Kind::Write:
+                ret = uv_fs_write(m_loop, req, op.file, op.bufs.data(), nbufs, op.offset, on_batch_complete);
+                break;
+            default:
+                ret = UV_EINVAL;
+                break;
+        }
+
+        if (ret < 0) {
+            uv_fs_req_cleanup(req);
+            // nothing is in flight if the first operation failed, so fail the whole batch
+            if (batch->m_numPending == 0) {
+                delete batch;
+                return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+                    "failed to schedule batch: {}", uv_strerror(ret));
+            }
+            batch->m_results[i] = ret;
+            continue;
+        }
+        batch->m_numPending++;
+    }
+
+    // allocate a new waiter
+    auto *waiter = allocateWaiter(batch, promise);
+
+    // link the waiter to the promise and set the promise state to Pending
+    promise->pending(waiter);
+
+    // link the waiter to the batch
+    batch->m_waiter = waiter;
+
+    // attach waiter to the end of the global waiters list
+    attachWaiter(waiter);
+
+    return {};
+}
+
 void
 lyric_runtime::SystemScheduler::attachWaiter(Waiter *waiter)
 {
@@ -770,7 +1044,112 @@ lyric_runtime::SystemScheduler::destroyWaiter(Waiter *waiter)
         }
     }
 
-    delete waiter;
+    // release the waitee, then destroy the waiter and return its storage to the pool
+    if (waiter->m_promise) {
+        waiter->m_promise->detachWaiter(waiter);
+    }
+    releaseWaitee(waiter);
+    waiter->~Waiter();
+    m_waiterPool.release(waiter);
+}
+
+/**
+ * Cancel the waiter without completing it. If a task is awaiting the waiter then the task is resumed,
+ * and the waiter is destroyed without invoking the promise accept callback. Only timer and async
+ * waiters can be cancelled, as fs requests and worker monitors are still referenced by libuv and by
+ * the worker task respectively.
+ *
+ * @param waiter The waiter.
+ * @return Ok status if the waiter was cancelled, otherwise kRuntimeInvariant status.
+ */
+tempo_utils::Status
+lyric_runtime::SystemScheduler::cancelWaiter(Waiter *waiter)
+{
+    TU_NOTNULL (waiter);
+
+    switch (waiter->m_type) {
+        case Waiter::Type::Timer:
+        case Waiter::Type::Async:
+            break;
+        default:
+            return InterpreterStatus::forCondition(InterpreterCondition::kRuntimeInvariant,
+                "waiter cannot be cancelled");
+    }
+
+    if (waiter->m_task != nullptr) {
+        waiter->m_task->resume();
+    }
+    destroyWaiter(waiter);
+    return {};
+}
+
+/**
+ * Release the handle, request or timer the waiter is waiting on. Handles are closed and their storage
+ * is returned to the handle pool from the close callback. An async handle is never reused while open,
+ * because a signal sent to the old waiter could otherwise complete the new waiter. Timers which have
+ * not expired are removed from the timer wheel.
+ *
+ * @param waiter The waiter.
+ */
+void
+lyric_runtime::SystemScheduler::releaseWaitee(Waiter *waiter)
+{
+    switch (waiter->m_type) {
+        case Waiter::Type::Async: {
+            auto &async = std::get<std::shared_ptr<AsyncHandle>>(waiter->m_waitee);
+            // close async handle if still pending, otherwise this is a no-op
+            async->close(this);
+            break;
+        }
+        case Waiter::Type::Handle: {
+            auto *handle = std::get<uv_handle_t *>(waiter->m_waitee);
+            closeHandle(handle);
+            break;
+        }
+        case Waiter::Type::Timer: {
+            auto *timer = std::get<TimerEntry *>(waiter->m_waitee);
+            // remove the timer if it has not expired, and stop the wheel timer if no timers remain
+            if (m_timerWheel.cancel(timer) && m_timerWheel.isEmpty()) {
+                armWheelTimer();
+            }
+            m_timerPool.release(timer);
+            break;
+        }
+        case Waiter::Type::Batch: {
+            auto *batch = std::get<FsBatch *>(waiter->m_waitee);
+            // if operations are still in flight then detach the batch, and the last completion deletes it
+            if (batch->m_numPending > 0) {
+                batch->m_waiter = nullptr;
+            } else {
+                delete batch;
+            }
+            break;
+        }
+        case Waiter::Type::ReadFile: {
+            auto *fileRead = std::get<FsReadFile *>(waiter->m_waitee);
+            // if the read is still in flight then detach it, and the completion deletes it
+            if (fileRead->m_inFlight) {
+                fileRead->m_waiter = nullptr;
+            } else {
+                delete fileRead;
+            }
+            break;
+        }
+        case Waiter::Type::Req: {
+            auto *req = std::get<uv_fs_t *>(waiter->m_waitee);
+            if (m_tearingDown) {
+                // the request may still be in flight on the threadpool, so detach it from the waiter
+                // and let the completion callback free the request
+                req->data = nullptr;
+            } else {
+                uv_fs_req_cleanup(req);
+                m_reqPool.release(req);
+            }
+            break;
+        }
+        default:
+            TU_UNREACHABLE();
+    }
 }
 
 lyric_runtime::Waiter *
@@ -787,6 +1166,12 @@ lyric_runtime::SystemScheduler::lastWaiter() const
     return m_waiters->m_prev;
 }
 
+const lyric_runtime::TimerWheel *
+lyric_runtime::SystemScheduler::timerWheel() const
+{
+    return &m_timerWheel;
+}
+
 /**
  * Pump the event loop one time then return immediately without blocking.
  *
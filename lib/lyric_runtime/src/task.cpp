@@ -6,6 +6,7 @@
 lyric_runtime::Task::Task(bool isMainTask, SystemScheduler *scheduler)
     : m_isMainTask(isMainTask),
       m_state(State::Initial),
+      m_coro(scheduler->getOperandStackLayout()),
       m_scheduler(scheduler),
       m_monitor(nullptr),
       m_prev(nullptr),
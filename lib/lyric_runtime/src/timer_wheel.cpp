@@ -0,0 +1,266 @@
+#include <limits>
+
+#include <lyric_runtime/timer_wheel.h>
+#include <tempo_utils/log_stream.h>
+
+static void
+init_slot(lyric_runtime::TimerLink *slot)
+{
+    slot->prev = slot;
+    slot->next = slot;
+}
+
+static bool
+slot_is_empty(const lyric_runtime::TimerLink *slot)
+{
+    return slot->next == slot;
+}
+
+static void
+link_tail(lyric_runtime::TimerLink *slot, lyric_runtime::TimerLink *link)
+{
+    link->prev = slot->prev;
+    link->next = slot;
+    slot->prev->next = link;
+    slot->prev = link;
+}
+
+static void
+unlink(lyric_runtime::TimerLink *link)
+{
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->prev = nullptr;
+    link->next = nullptr;
+}
+
+/**
+ * Move all links in the src slot to the dst slot. The dst slot must be empty.
+ */
+static void
+splice(lyric_runtime::TimerLink *src, lyric_runtime::TimerLink *dst)
+{
+    if (slot_is_empty(src)) {
+        init_slot(dst);
+        return;
+    }
+    dst->next = src->next;
+    dst->prev = src->prev;
+    dst->next->prev = dst;
+    dst->prev->next = dst;
+    init_slot(src);
+}
+
+lyric_runtime::TimerWheel::TimerWheel(tu_uint64 currentTick)
+    : m_currentTick(currentTick),
+      m_numTimers(0)
+{
+    for (auto &slot : m_root) {
+        init_slot(&slot);
+    }
+    for (auto &level : m_levels) {
+        for (auto &slot : level) {
+            init_slot(&slot);
+        }
+    }
+}
+
+bool
+lyric_runtime::TimerWheel::isEmpty() const
+{
+    return m_numTimers == 0;
+}
+
+int
+lyric_runtime::TimerWheel::numTimers() const
+{
+    return m_numTimers;
+}
+
+/**
+ * Returns the next tick which has not been processed by the wheel.
+ */
+tu_uint64
+lyric_runtime::TimerWheel::currentTick() const
+{
+    return m_currentTick;
+}
+
+/**
+ * Returns true if the entry is scheduled in a wheel, otherwise false.
+ */
+bool
+lyric_runtime::TimerWheel::isScheduled(const TimerEntry *entry)
+{
+    return entry->link.next != nullptr;
+}
+
+/**
+ * Schedule the entry to expire at the specified tick. If the expiry tick has already been processed
+ * then the entry expires on the current tick. It is a precondition that the entry is not scheduled.
+ *
+ * @param entry The timer entry.
+ * @param expires The expiry tick.
+ */
+void
+lyric_runtime::TimerWheel::insert(TimerEntry *entry, tu_uint64 expires)
+{
+    TU_NOTNULL (entry);
+    TU_ASSERT (!isScheduled(entry));
+    entry->expires = expires;
+    place(entry);
+    m_numTimers++;
+}
+
+/**
+ * Remove the entry from the wheel.
+ *
+ * @param entry The timer entry.
+ * @return true if the entry was scheduled, otherwise false.
+ */
+bool
+lyric_runtime::TimerWheel::cancel(TimerEntry *entry)
+{
+    TU_NOTNULL (entry);
+    if (!isScheduled(entry))
+        return false;
+    unlink(&entry->link);
+    m_numTimers--;
+    return true;
+}
+
+void
+lyric_runtime::TimerWheel::place(TimerEntry *entry)
+{
+    auto expires = entry->expires < m_currentTick? m_currentTick : entry->expires;
+    auto interval = expires - m_currentTick;
+
+    if (interval < kRootSize) {
+        link_tail(&m_root[expires & kRootMask], &entry->link);
+        return;
+    }
+
+    // timers beyond the range of the wheel are placed in the outermost level and are re-placed
+    // each time they are cascaded until they are in range
+    if (interval > kMaxInterval) {
+        expires = m_currentTick + kMaxInterval;
+        interval = kMaxInterval;
+    }
+
+    int level = 0;
+    while (interval >= (1ull << (kRootBits + (level + 1) * kLevelBits))) {
+        level++;
+    }
+    auto index = (expires >> (kRootBits + level * kLevelBits)) & kLevelMask;
+    link_tail(&m_levels[level][index], &entry->link);
+}
+
+/**
+ * Re-place all entries in the current slot of the specified level into the levels below.
+ *
+ * @return The index of the cascaded slot.
+ */
+int
+lyric_runtime::TimerWheel::cascade(int level)
+{
+    auto index = static_cast<int>((m_currentTick >> (kRootBits + level * kLevelBits)) & kLevelMask);
+    TimerLink cascaded;
+    splice(&m_levels[level][index], &cascaded);
+    while (!slot_is_empty(&cascaded)) {
+        auto *link = cascaded.next;
+        unlink(link);
+        place(reinterpret_cast<TimerEntry *>(link));
+    }
+    return index;
+}
+
+/**
+ * Returns the earliest tick at which the wheel must be advanced, which is either the tick of the next
+ * occupied root slot or the tick at which the next occupied outer slot is cascaded. Returns the maximum
+ * tick if the wheel is empty.
+ */
+tu_uint64
+lyric_runtime::TimerWheel::nextWakeup() const
+{
+    auto wakeup = std::numeric_limits<tu_uint64>::max();
+    if (m_numTimers == 0)
+        return wakeup;
+
+    // scan one full rotation of the root level starting at the current tick
+    for (int i = 0; i < kRootSize; i++) {
+        auto tick = m_currentTick + i;
+        if (!slot_is_empty(&m_root[tick & kRootMask])) {
+            wakeup = tick;
+            break;
+        }
+    }
+
+    // a slot in an outer level is cascaded when all levels below it wrap around, so find the first
+    // occupied slot in each level which is cascaded before the earliest wakeup found so far
+    for (int level = 0; level < kNumLevels; level++) {
+        auto shift = kRootBits + level * kLevelBits;
+        auto first = (m_currentTick + (1ull << shift) - 1) >> shift;
+        for (int i = 0; i < kLevelSize; i++) {
+            auto tick = (first + i) << shift;
+            if (tick >= wakeup)
+                break;
+            if (!slot_is_empty(&m_levels[level][(first + i) & kLevelMask])) {
+                wakeup = tick;
+                break;
+            }
+        }
+    }
+
+    return wakeup;
+}
+
+/**
+ * Advance the wheel through the specified tick, invoking the callback for each expired entry. An entry
+ * is unlinked before its callback is invoked, so the callback may release the entry storage, and may
+ * insert or cancel other entries.
+ *
+ * @param now The current tick.
+ * @param cb The callback invoked for each expired entry.
+ * @param cbData Data passed to the callback.
+ * @return The number of expired entries.
+ */
+int
+lyric_runtime::TimerWheel::advance(tu_uint64 now, TimerCallback cb, void *cbData)
+{
+    int numExpired = 0;
+
+    while (m_currentTick <= now) {
+        // skip ahead to the next tick which has entries or cascades an occupied slot. skipped ticks
+        // only cascade empty slots, so the placement invariant is preserved.
+        auto next = nextWakeup();
+        if (next > now) {
+            m_currentTick = now + 1;
+            break;
+        }
+        m_currentTick = next;
+
+        // if the root level wrapped around then cascade the outer levels, stopping at the first level
+        // which did not also wrap around
+        auto index = static_cast<int>(m_currentTick & kRootMask);
+        if (index == 0) {
+            for (int level = 0; level < kNumLevels; level++) {
+                if (cascade(level) != 0)
+                    break;
+            }
+        }
+
+        TimerLink expired;
+        splice(&m_root[index], &expired);
+        m_currentTick++;
+
+        while (!slot_is_empty(&expired)) {
+            auto *entry = reinterpret_cast<TimerEntry *>(expired.next);
+            unlink(&entry->link);
+            m_numTimers--;
+            numExpired++;
+            cb(entry, cbData);
+        }
+    }
+
+    return numExpired;
+}
@@ -39,6 +39,29 @@ lyric_runtime::TypeEntry::getTypeDef() const
     return type.getTypeDef();
 }
 
+bool
+lyric_runtime::TypeEntry::hasDisplay() const
+{
+    return !m_display.empty();
+}
+
+/**
+ * Returns the ancestor display of the type, or an empty span if the display has not been set. The
+ * display always contains at least the descriptor of the type itself, at the last position.
+ */
+std::span<lyric_runtime::DescriptorEntry * const>
+lyric_runtime::TypeEntry::getDisplay() const
+{
+    return m_display;
+}
+
+void
+lyric_runtime::TypeEntry::setDisplay(std::vector<DescriptorEntry *> &&display)
+{
+    TU_ASSERT (!display.empty());
+    m_display = std::move(display);
+}
+
 lyric_runtime::TypeTable::TypeTable(BytecodeSegment *segment)
     : m_segment(segment),
       m_numTypes(INVALID_ADDRESS_U32),
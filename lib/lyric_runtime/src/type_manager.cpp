@@ -204,40 +204,82 @@ resolve_super_type(
     return {};
 }
 
-tempo_utils::Result<lyric_runtime::TypeComparison>
-lyric_runtime::TypeManager::compareTypes(const Operand &lhs, const Operand &rhs)
+/**
+ * Resolves the ancestor display of the type specified by `typeEntry`. The display is built from the
+ * display of the super type the first time the type is resolved, and is stored in the type entry so
+ * later resolutions return immediately.
+ *
+ * @param typeEntry The type entry.
+ * @param display Set to the display of the type.
+ * @return Status
+ */
+tempo_utils::Status
+lyric_runtime::TypeManager::resolveDisplay(TypeEntry *typeEntry, std::span<DescriptorEntry * const> &display)
 {
-    Operand ld;
-    Operand rd;
+    if (typeEntry->hasDisplay()) {
+        display = typeEntry->getDisplay();
+        return {};
+    }
+
+    auto type = Operand::fromType(typeEntry);
+
+    Operand descriptor;
+    TU_RETURN_IF_NOT_OK (resolve_type_to_descriptor(type, descriptor, m_segmentManager));
+    DescriptorEntry *descriptorEntry;
+    if (!descriptor.getDescriptor(descriptorEntry))
+        return InterpreterStatus::forCondition(
+            InterpreterCondition::kRuntimeInvariant, "invalid type descriptor");
+
     Operand superType;
+    TU_RETURN_IF_NOT_OK (resolve_super_type(type, superType, m_segmentManager));
+
+    std::vector<DescriptorEntry *> entries;
+    if (superType.isValid()) {
+        TypeEntry *superEntry;
+        if (!superType.getType(superEntry))
+            return InterpreterStatus::forCondition(
+                InterpreterCondition::kRuntimeInvariant, "invalid super type");
+        std::span<DescriptorEntry * const> superDisplay;
+        TU_RETURN_IF_NOT_OK (resolveDisplay(superEntry, superDisplay));
+        entries.reserve(superDisplay.size() + 1);
+        entries.assign(superDisplay.begin(), superDisplay.end());
+    }
+    entries.push_back(descriptorEntry);
 
-    TU_RETURN_IF_NOT_OK (resolve_type_to_descriptor(lhs, ld, m_segmentManager));
-    if (!ld.isValid())
+    typeEntry->setDisplay(std::move(entries));
+    display = typeEntry->getDisplay();
+    return {};
+}
+
+/**
+ * Compares the types `lhs` and `rhs` using their ancestor displays. If the descriptor of rhs is at depth
+ * N in its display, then lhs extends rhs exactly when the descriptor at depth N in the display of lhs is
+ * the descriptor of rhs, so once both displays have been resolved the comparison is constant time.
+ *
+ * @param lhs The type to compare.
+ * @param rhs The type to compare against.
+ * @return EQUAL if the types are the same, EXTENDS if lhs is a subtype of rhs, otherwise DISJOINT.
+ */
+tempo_utils::Result<lyric_runtime::TypeComparison>
+lyric_runtime::TypeManager::compareTypes(const Operand &lhs, const Operand &rhs)
+{
+    TypeEntry *lhsEntry;
+    if (!lhs.getType(lhsEntry))
         return InterpreterStatus::forCondition(
             InterpreterCondition::kRuntimeInvariant, "invalid lhs descriptor");
-
-    TU_RETURN_IF_NOT_OK (resolve_type_to_descriptor(rhs, rd, m_segmentManager));
-    if (!rd.isValid())
+    TypeEntry *rhsEntry;
+    if (!rhs.getType(rhsEntry))
         return InterpreterStatus::forCondition(
             InterpreterCondition::kRuntimeInvariant, "invalid rhs descriptor");
 
-    // if lhs and rhs are equal, then the comparison result is equal
-    if (ld.isSameAs(rd))
-        return TypeComparison::EQUAL;
-
-    // if an ancestor of lhs equals rhs, then the comparison result is extends
-    TU_RETURN_IF_NOT_OK (resolve_super_type(lhs, superType, m_segmentManager));
+    std::span<DescriptorEntry * const> lhsDisplay;
+    TU_RETURN_IF_NOT_OK (resolveDisplay(lhsEntry, lhsDisplay));
+    std::span<DescriptorEntry * const> rhsDisplay;
+    TU_RETURN_IF_NOT_OK (resolveDisplay(rhsEntry, rhsDisplay));
 
-    while (superType.isValid()) {
-        TU_RETURN_IF_NOT_OK (resolve_type_to_descriptor(superType, ld, m_segmentManager));
-        if (!ld.isValid())
-            return InterpreterStatus::forCondition(
-                InterpreterCondition::kRuntimeInvariant, "type comparison has invalid lhs");
-        if (ld.isSameAs(rd))
-            return TypeComparison::EXTENDS;
-        auto curr = superType;
-        TU_RETURN_IF_NOT_OK (resolve_super_type(curr, superType, m_segmentManager));
-    }
+    auto depth = rhsDisplay.size() - 1;
+    if (depth < lhsDisplay.size() && lhsDisplay[depth] == rhsDisplay[depth])
+        return lhsDisplay.size() == rhsDisplay.size()? TypeComparison::EQUAL : TypeComparison::EXTENDS;
 
     // otherwise lhs is not a subtype of rhs
     return TypeComparison::DISJOINT;
@@ -0,0 +1,38 @@
+
+#include <lyric_runtime/mark_stack.h>
+#include <lyric_runtime/upvalue_cell.h>
+
+lyric_runtime::UpvalueCell::UpvalueCell(const Operand &value)
+    : m_value(value),
+      m_markEpoch(0)
+{
+}
+
+lyric_runtime::Operand
+lyric_runtime::UpvalueCell::getValue() const
+{
+    return m_value;
+}
+
+void
+lyric_runtime::UpvalueCell::setValue(const Operand &value)
+{
+    m_value = value;
+}
+
+/**
+ * Marks the value held by the cell as reachable. A cell may be shared by many closures, so during a mark
+ * phase the cell records the epoch of the active mark stack and is only traced once per mark phase. Cells
+ * are not heap instances, so recording the epoch means there is no reachable flag to clear afterwards.
+ */
+void
+lyric_runtime::UpvalueCell::setReachable() const
+{
+    auto *markStack = MarkStack::active();
+    if (markStack != nullptr) {
+        if (m_markEpoch == markStack->getEpoch())
+            return;
+        m_markEpoch = markStack->getEpoch();
+    }
+    m_value.setReachable();
+}
@@ -1,4 +1,6 @@
 
+#include <algorithm>
+
 #include <lyric_runtime/bytecode_segment.h>
 #include <lyric_runtime/virtual_table.h>
 #include <tempo_utils/log_stream.h>
@@ -400,11 +402,13 @@ lyric_runtime::VirtualTable::VirtualTable(
       m_allocator(allocator),
       m_members(std::move(members)),
       m_methods(std::move(methods)),
-      m_impls(std::move(impls))
+      m_impls(std::move(impls)),
+      m_layoutStart(0)
 {
     TU_NOTNULL (m_segment);
     TU_NOTNULL (m_descriptor);
     TU_NOTNULL (m_type);
+    flatten();
 }
 
 lyric_runtime::VirtualTable::VirtualTable(
@@ -425,12 +429,76 @@ lyric_runtime::VirtualTable::VirtualTable(
       m_initializer(initializer),
       m_members(std::move(members)),
       m_methods(std::move(methods)),
-      m_impls(std::move(impls))
+      m_impls(std::move(impls)),
+      m_layoutStart(0)
 {
     TU_NOTNULL (m_segment);
     TU_NOTNULL (m_descriptor);
     TU_NOTNULL (m_type);
     TU_ASSERT (m_initializer.isValid());
+    flatten();
+}
+
+/**
+ * Links the member and method slots of the table. The slot arrays start out sharing the chunks of the
+ * parent table, so an inherited member or method occupies the same slot in every descendant table. Each
+ * member is placed in the slot equal to its layout offset. Each method defined by this table either
+ * replaces the slot of the method it overrides or is appended as a new slot. The slot is recorded in the
+ * descriptor entry, so after linking, resolving a member or method through its descriptor is a single
+ * array load with no hash lookup.
+ */
+void
+lyric_runtime::VirtualTable::flatten()
+{
+    if (m_parent != nullptr) {
+        m_memberSlots = m_parent->m_memberSlots;
+        m_methodSlots = m_parent->m_methodSlots;
+        m_memberOverflow = m_parent->m_memberOverflow;
+        m_methodOverflow = m_parent->m_methodOverflow;
+        m_layoutStart = m_parent->getLayoutTotal();
+    }
+
+    // place each member at its layout offset. members are appended in layout order, so sort the members
+    // defined by this table by layout offset first.
+    std::vector<std::pair<const OperandIdentity *,const VirtualMember *>> members;
+    members.reserve(m_members.size());
+    for (const auto &entry : m_members) {
+        members.emplace_back(&entry.first, &entry.second);
+    }
+    std::sort(members.begin(), members.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.second->getLayoutOffset() < rhs.second->getLayoutOffset();
+    });
+
+    for (const auto &[key, member] : members) {
+        DescriptorEntry *descriptor;
+        auto layoutOffset = member->getLayoutOffset();
+        if (!key->operand.getDescriptor(descriptor) || layoutOffset != m_memberSlots.size()) {
+            m_memberOverflow[*key] = member;
+            continue;
+        }
+        m_memberSlots.append(descriptor, member);
+        if (descriptor->getSlot() == INVALID_ADDRESS_U32) {
+            descriptor->setSlot(layoutOffset);
+        } else if (descriptor->getSlot() != layoutOffset) {
+            m_memberOverflow[*key] = member;
+        }
+    }
+
+    for (const auto &entry : m_methods) {
+        DescriptorEntry *descriptor;
+        if (!entry.first.operand.getDescriptor(descriptor)) {
+            m_methodOverflow[entry.first] = &entry.second;
+            continue;
+        }
+        auto slot = descriptor->getSlot();
+        if (slot == INVALID_ADDRESS_U32) {
+            descriptor->setSlot(m_methodSlots.append(descriptor, &entry.second));
+        } else if (m_methodSlots.getKey(slot) == descriptor) {
+            m_methodSlots.set(slot, descriptor, &entry.second);     // override the inherited method
+        } else {
+            m_methodOverflow[entry.first] = &entry.second;
+        }
+    }
 }
 
 lyric_runtime::BytecodeSegment *
@@ -498,21 +566,13 @@ lyric_runtime::VirtualTable::getDescriptorIndex() const
 uint32_t
 lyric_runtime::VirtualTable::getLayoutStart() const
 {
-    uint32_t size = 0;
-    for (auto *curr = m_parent; curr != nullptr; curr = curr->m_parent) {
-        size += curr->m_members.size();
-    }
-    return size;
+    return m_layoutStart;
 }
 
 uint32_t
 lyric_runtime::VirtualTable::getLayoutTotal() const
 {
-    uint32_t size = 0;
-    for (auto *curr = this; curr != nullptr; curr = curr->m_parent) {
-        size += curr->m_members.size();
-    }
-    return size;
+    return m_layoutStart + m_members.size();
 }
 
 lyric_runtime::NativeFunc
@@ -538,25 +598,35 @@ lyric_runtime::VirtualTable::getInitializer() const
 const lyric_runtime::VirtualMember *
 lyric_runtime::VirtualTable::getMember(const Operand &descriptor) const
 {
-    for (auto *curr = this; curr != nullptr; curr = curr->m_parent) {
-        if (curr->m_members.contains(descriptor)) {
-            const auto &member = curr->m_members.at(descriptor);
-            return &member;     // return pointer to the virtual member entry
-        }
+    DescriptorEntry *entry;
+    if (descriptor.getDescriptor(entry)) {
+        auto slot = entry->getSlot();
+        if (m_memberSlots.getKey(slot) == entry)
+            return m_memberSlots.getValue(slot);    // return pointer to the virtual member entry
     }
-    return nullptr;
+    if (m_memberOverflow.empty())
+        return nullptr;
+    auto overflow = m_memberOverflow.find(descriptor);
+    if (overflow == m_memberOverflow.cend())
+        return nullptr;
+    return overflow->second;
 }
 
 const lyric_runtime::VirtualMethod *
 lyric_runtime::VirtualTable::getMethod(const Operand &descriptor) const
 {
-    for (auto *curr = this; curr != nullptr; curr = curr->m_parent) {
-        if (curr->m_methods.contains(descriptor)) {
-            const auto &method = curr->m_methods.at(descriptor);
-            return &method;     // return pointer to the virtual method entry
-        }
+    DescriptorEntry *entry;
+    if (descriptor.getDescriptor(entry)) {
+        auto slot = entry->getSlot();
+        if (m_methodSlots.getKey(slot) == entry)
+            return m_methodSlots.getValue(slot);    // return pointer to the virtual method entry
     }
-    return nullptr;
+    if (m_methodOverflow.empty())
+        return nullptr;
+    auto overflow = m_methodOverflow.find(descriptor);
+    if (overflow == m_methodOverflow.cend())
+        return nullptr;
+    return overflow->second;
 }
 
 const lyric_runtime::VirtualMethod *
@@ -567,4 +637,87 @@ lyric_runtime::VirtualTable::getExtension(const Operand &conceptDescriptor, cons
 
     const auto &impl = m_impls.at(conceptDescriptor);
     return impl.getMethod(callDescriptor);
-}
\ No newline at end of file
+}
+
+/**
+ * Returns the slot number of the member specified by `descriptor`, or INVALID_ADDRESS_U32 if the
+ * member is not present in the table or any ancestor table. The slot number of a member is its layout
+ * offset, which is the same in the parent table and in every descendant table.
+ *
+ * @param descriptor The field descriptor.
+ * @return The member slot number.
+ */
+tu_uint32
+lyric_runtime::VirtualTable::getMemberSlot(const Operand &descriptor) const
+{
+    auto *member = getMember(descriptor);
+    if (member == nullptr)
+        return INVALID_ADDRESS_U32;
+    return member->getLayoutOffset();
+}
+
+const lyric_runtime::VirtualMember *
+lyric_runtime::VirtualTable::getMemberAt(tu_uint32 slot) const
+{
+    return m_memberSlots.getValue(slot);
+}
+
+tu_uint32
+lyric_runtime::VirtualTable::numMemberSlots() const
+{
+    return m_memberSlots.size();
+}
+
+/**
+ * Returns the slot number of the method specified by `descriptor`, or INVALID_ADDRESS_U32 if the
+ * method is not present in the table or any ancestor table, or if the method could not be assigned a
+ * slot. An overriding method occupies the same slot as the method it overrides.
+ *
+ * @param descriptor The call descriptor.
+ * @return The method slot number.
+ */
+tu_uint32
+lyric_runtime::VirtualTable::getMethodSlot(const Operand &descriptor) const
+{
+    DescriptorEntry *entry;
+    if (!descriptor.getDescriptor(entry))
+        return INVALID_ADDRESS_U32;
+    auto slot = entry->getSlot();
+    if (m_methodSlots.getKey(slot) != entry)
+        return INVALID_ADDRESS_U32;
+    return slot;
+}
+
+const lyric_runtime::VirtualMethod *
+lyric_runtime::VirtualTable::getMethodAt(tu_uint32 slot) const
+{
+    return m_methodSlots.getValue(slot);
+}
+
+tu_uint32
+lyric_runtime::VirtualTable::numMethodSlots() const
+{
+    return m_methodSlots.size();
+}
+
+/**
+ * Returns true if the member `slot` is stored in storage shared with the `other` table rather than in
+ * a copy, which is the case for inherited members unless the table appended to the same chunk.
+ */
+bool
+lyric_runtime::VirtualTable::sharesMemberSlot(const VirtualTable *other, tu_uint32 slot) const
+{
+    TU_ASSERT (other != nullptr);
+    return m_memberSlots.sharesChunk(other->m_memberSlots, slot);
+}
+
+/**
+ * Returns true if the method `slot` is stored in storage shared with the `other` table rather than in
+ * a copy, which is the case for inherited methods unless the table overrode or appended to the same chunk.
+ */
+bool
+lyric_runtime::VirtualTable::sharesMethodSlot(const VirtualTable *other, tu_uint32 slot) const
+{
+    TU_ASSERT (other != nullptr);
+    return m_methodSlots.sharesChunk(other->m_methodSlots, slot);
+}
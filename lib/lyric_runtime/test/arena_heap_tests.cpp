@@ -0,0 +1,109 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <lyric_runtime/arena_heap.h>
+#include <lyric_runtime/base_ref.h>
+
+class ArenaHeap : public ::testing::Test {};
+
+class TestRef : public lyric_runtime::BaseRef {
+public:
+    TestRef() : BaseRef(nullptr) {};
+    std::string toString() const override { return "TestRef"; };
+};
+
+class DestructorRef : public lyric_runtime::BaseRef {
+public:
+    explicit DestructorRef(int *numDestroyed) : BaseRef(nullptr), m_numDestroyed(numDestroyed) {};
+    ~DestructorRef() override { (*m_numDestroyed)++; };
+    std::string toString() const override { return "DestructorRef"; };
+private:
+    int *m_numDestroyed;
+};
+
+TEST_F (ArenaHeap, AllocateSmallInstancesFromArena)
+{
+    auto heap = lyric_runtime::ArenaHeap::create();
+
+    auto *ptr1 = heap->allocateMemory(24);
+    auto *ptr2 = heap->allocateMemory(24);
+    auto *ptr3 = heap->allocateMemory(100);
+    ASSERT_NE (ptr1, ptr2);
+    ASSERT_EQ (0, reinterpret_cast<std::uintptr_t>(ptr1) % lyric_runtime::kMaxInstanceAlignment);
+    ASSERT_EQ (0, reinterpret_cast<std::uintptr_t>(ptr2) % lyric_runtime::kMaxInstanceAlignment);
+    ASSERT_EQ (0, reinterpret_cast<std::uintptr_t>(ptr3) % lyric_runtime::kMaxInstanceAlignment);
+
+    // each size class is allocated from its own page of a shared arena
+    ASSERT_EQ (1, heap->numArenas());
+    ASSERT_EQ (0, heap->numLargeInstances());
+}
+
+TEST_F (ArenaHeap, SizeClassesShareArenas)
+{
+    auto heap = lyric_runtime::ArenaHeap::create();
+    ASSERT_EQ (0, heap->numArenas());
+
+    for (std::size_t i = 0; i < lyric_runtime::kNumArenaSizeClasses; i++) {
+        heap->allocateMemory((i + 1) * lyric_runtime::kArenaSizeClassGranularity);
+    }
+    auto numExpected = (lyric_runtime::kNumArenaSizeClasses + lyric_runtime::kNumArenaPages - 1)
+        / lyric_runtime::kNumArenaPages;
+    ASSERT_EQ (numExpected, heap->numArenas());
+}
+
+TEST_F (ArenaHeap, AllocateLargeInstanceFromGlobalAllocator)
+{
+    auto heap = lyric_runtime::ArenaHeap::create();
+
+    heap->allocateMemory(lyric_runtime::kMaxArenaInstanceSize + 1);
+    ASSERT_EQ (0, heap->numArenas());
+    ASSERT_EQ (1, heap->numLargeInstances());
+}
+
+TEST_F (ArenaHeap, ReuseStorageOfSweptInstance)
+{
+    auto heap = lyric_runtime::ArenaHeap::create();
+
+    auto *storage = heap->allocateMemory(sizeof(TestRef));
+    auto *instance = new (storage) TestRef();
+    heap->insertInstance(instance);
+    ASSERT_EQ (1, heap->numInstances());
+
+    heap->clearReachable();
+    heap->deleteUnreachable();
+    ASSERT_EQ (0, heap->numInstances());
+
+    ASSERT_EQ (storage, heap->allocateMemory(sizeof(TestRef)));
+    ASSERT_EQ (1, heap->numArenas());
+}
+
+TEST_F (ArenaHeap, PermanentInstanceIsNotSwept)
+{
+    auto heap = lyric_runtime::ArenaHeap::create();
+
+    auto *storage = heap->allocateMemory(sizeof(TestRef));
+    auto *instance = new (storage) TestRef();
+    heap->insertPermanentInstance(instance);
+    ASSERT_EQ (0, heap->numInstances());
+    ASSERT_EQ (1, heap->numPermanentInstances());
+
+    heap->clearReachable();
+    heap->deleteUnreachable();
+    ASSERT_EQ (1, heap->numPermanentInstances());
+    ASSERT_NE (storage, heap->allocateMemory(sizeof(TestRef)));
+}
+
+TEST_F (ArenaHeap, DestroyLiveInstancesWhenHeapIsDestroyed)
+{
+    int numDestroyed = 0;
+    auto heap = lyric_runtime::ArenaHeap::create();
+
+    auto *small = new (heap->allocateMemory(sizeof(DestructorRef))) DestructorRef(&numDestroyed);
+    heap->insertInstance(small);
+    auto *permanent = new (heap->allocateMemory(sizeof(DestructorRef))) DestructorRef(&numDestroyed);
+    heap->insertPermanentInstance(permanent);
+    ASSERT_EQ (1, heap->numInstances());
+
+    heap.reset();
+    ASSERT_EQ (2, numDestroyed);
+}
@@ -0,0 +1,109 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <lyric_bootstrap/bootstrap_loader.h>
+#include <lyric_runtime/bytes_ref.h>
+#include <lyric_runtime/interpreter_state.h>
+#include <lyric_runtime/static_loader.h>
+#include <tempo_utils/file_reader.h>
+#include <tempo_utils/memory_bytes.h>
+
+class BytesRef : public ::testing::Test {
+protected:
+    lyric_common::ModuleLocation testmodLocation;
+    lyric_object::LyricObject testmodObject;
+    std::shared_ptr<lyric_runtime::StaticLoader> staticLoader;
+    std::shared_ptr<lyric_runtime::InterpreterState> state;
+
+    void SetUp() override {
+        staticLoader = std::make_shared<lyric_runtime::StaticLoader>();
+        testmodLocation = lyric_common::ModuleLocation::fromString("test:///testmod");
+        tempo_utils::FileReader reader(TESTMOD_OBJECT_PATH);
+        TU_RAISE_IF_NOT_OK (reader.getStatus());
+        testmodObject = lyric_object::LyricObject(reader.getBytes());
+        staticLoader->insertModule(testmodLocation, testmodObject);
+        auto systemLoader = std::make_shared<lyric_bootstrap::BootstrapLoader>();
+        TU_ASSIGN_OR_RAISE (state, lyric_runtime::InterpreterState::create(systemLoader, staticLoader));
+        TU_RAISE_IF_NOT_OK (state->load(testmodLocation));
+    }
+};
+
+TEST_F (BytesRef, WrapSharedBytesWithoutCopying)
+{
+    auto *heapManager = state->heapManager();
+    auto payload = tempo_utils::MemoryBytes::copy("hello, world!");
+    auto cell = heapManager->allocateBytes(payload);
+
+    lyric_runtime::BytesRef *bytes;
+    ASSERT_TRUE (cell.getBytes(bytes));
+    ASSERT_TRUE (bytes->isShared());
+    ASSERT_EQ (payload->getSize(), bytes->getBytesSize());
+    ASSERT_EQ (payload->getData(), bytes->getSharedSpan().data());
+    ASSERT_EQ (payload.get(), bytes->toImmutableBytes().get());
+}
+
+TEST_F (BytesRef, SliceSharedBytesWithoutCopying)
+{
+    auto *heapManager = state->heapManager();
+    auto payload = tempo_utils::MemoryBytes::copy("hello, world!");
+    auto cell = heapManager->allocateBytes(payload, 7, 5);
+
+    lyric_runtime::BytesRef *bytes;
+    ASSERT_TRUE (cell.getBytes(bytes));
+    auto contents = bytes->getBytes();
+    ASSERT_EQ ("world", std::string(contents.cbegin(), contents.cend()));
+    tu_int64 i64;
+    ASSERT_TRUE (bytes->byteAt(0).getI64(i64));
+    ASSERT_EQ ('w', i64);
+    ASSERT_FALSE (bytes->byteAt(5).getI64(i64));
+
+    auto slice = bytes->toImmutableBytes();
+    ASSERT_EQ (5, slice->getSize());
+    ASSERT_EQ (payload->getData() + 7, slice->getData());
+}
+
+TEST_F (BytesRef, CompareSharedBytesWithRopeBytes)
+{
+    auto *heapManager = state->heapManager();
+    auto payload = tempo_utils::MemoryBytes::copy("hello, world!");
+
+    lyric_runtime::BytesRef *shared, *rope, *prefix;
+    ASSERT_TRUE (heapManager->allocateBytes(payload).getBytes(shared));
+    ASSERT_TRUE (heapManager->allocateBytes(payload->getSpan()).getBytes(rope));
+    ASSERT_TRUE (heapManager->allocateBytes(payload, 0, 5).getBytes(prefix));
+    ASSERT_FALSE (rope->isShared());
+
+    ASSERT_EQ (0, shared->compare(rope));
+    ASSERT_EQ (0, rope->compare(shared));
+    ASSERT_EQ (-1, prefix->compare(shared));
+    ASSERT_EQ (1, shared->compare(prefix));
+    ASSERT_EQ (-1, prefix->compare(rope));
+}
+
+TEST_F (BytesRef, StartsWithSharedReceiver)
+{
+    auto *heapManager = state->heapManager();
+    auto payload = tempo_utils::MemoryBytes::copy("hello, world!");
+
+    lyric_runtime::BytesRef *shared, *sharedPrefix, *ropePrefix, *sharedSuffix, *rope;
+    ASSERT_TRUE (heapManager->allocateBytes(payload).getBytes(shared));
+    ASSERT_TRUE (heapManager->allocateBytes(payload, 0, 5).getBytes(sharedPrefix));
+    ASSERT_TRUE (heapManager->allocateBytes(payload->getSpan().subspan(0, 7)).getBytes(ropePrefix));
+    ASSERT_TRUE (heapManager->allocateBytes(payload, 7, 5).getBytes(sharedSuffix));
+    ASSERT_TRUE (heapManager->allocateBytes(payload->getSpan()).getBytes(rope));
+    ASSERT_TRUE (shared->isShared());
+    ASSERT_FALSE (ropePrefix->isShared());
+
+    // shared receiver with shared and rope prefixes
+    ASSERT_TRUE (shared->startsWith(sharedPrefix));
+    ASSERT_TRUE (shared->startsWith(ropePrefix));
+    ASSERT_TRUE (shared->startsWith(rope));
+    ASSERT_FALSE (shared->startsWith(sharedSuffix));
+    ASSERT_FALSE (sharedPrefix->startsWith(shared));
+
+    // rope receiver with a shared prefix
+    ASSERT_TRUE (rope->startsWith(sharedPrefix));
+    ASSERT_TRUE (rope->startsWith(shared));
+    ASSERT_FALSE (ropePrefix->startsWith(shared));
+    ASSERT_FALSE (rope->startsWith(sharedSuffix));
+}
@@ -0,0 +1,89 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <lyric_runtime/call_site_cache.h>
+#include <lyric_runtime/virtual_table.h>
+
+class CallSiteCache : public ::testing::Test {};
+
+TEST_F (CallSiteCache, LookupMissesWhenEmpty)
+{
+    lyric_runtime::CallSiteCache cache;
+    int receiver;
+    ASSERT_FALSE (cache.isBoundTo(lyric_object::LinkageSection::Call, 1));
+    ASSERT_TRUE (cache.lookup(&receiver) == nullptr);
+    ASSERT_EQ (0, cache.numEntries());
+    ASSERT_FALSE (cache.isMegamorphic());
+}
+
+TEST_F (CallSiteCache, InsertPolymorphicEntries)
+{
+    lyric_runtime::CallSiteCache cache;
+    cache.bind(lyric_object::LinkageSection::Call, 1, lyric_runtime::Operand::nil());
+    ASSERT_TRUE (cache.isBoundTo(lyric_object::LinkageSection::Call, 1));
+
+    int receiver1, receiver2, aux;
+    lyric_runtime::VirtualMethod method1, method2, method3;
+    cache.insert(&receiver1, nullptr, &method1);
+    cache.insert(&receiver2, nullptr, &method2);
+    cache.insert(&receiver1, &aux, &method3);
+
+    ASSERT_EQ (3, cache.numEntries());
+    ASSERT_EQ (&method1, cache.lookup(&receiver1));
+    ASSERT_EQ (&method2, cache.lookup(&receiver2));
+    ASSERT_EQ (&method3, cache.lookup(&receiver1, &aux));
+    ASSERT_TRUE (cache.lookup(&receiver2, &aux) == nullptr);
+}
+
+TEST_F (CallSiteCache, BecomesMegamorphicWhenFull)
+{
+    lyric_runtime::CallSiteCache cache;
+    cache.bind(lyric_object::LinkageSection::Call, 1, lyric_runtime::Operand::nil());
+
+    int receivers[lyric_runtime::kMaxCallSiteEntries + 1];
+    lyric_runtime::VirtualMethod method;
+    for (int i = 0; i < lyric_runtime::kMaxCallSiteEntries + 1; i++) {
+        cache.insert(&receivers[i], nullptr, &method);
+    }
+
+    ASSERT_TRUE (cache.isMegamorphic());
+    ASSERT_EQ (lyric_runtime::kMaxCallSiteEntries, cache.numEntries());
+    ASSERT_EQ (&method, cache.lookup(&receivers[0]));
+    ASSERT_TRUE (cache.lookup(&receivers[lyric_runtime::kMaxCallSiteEntries]) == nullptr);
+}
+
+TEST_F (CallSiteCache, RebindingToDifferentAddressDiscardsEntries)
+{
+    lyric_runtime::CallSiteCache cache;
+    cache.bind(lyric_object::LinkageSection::Call, 1, lyric_runtime::Operand::nil());
+
+    int receiver;
+    lyric_runtime::VirtualMethod method;
+    cache.insert(&receiver, nullptr, &method);
+    ASSERT_EQ (&method, cache.lookup(&receiver));
+
+    cache.bind(lyric_object::LinkageSection::Call, 2, lyric_runtime::Operand::nil());
+    ASSERT_FALSE (cache.isBoundTo(lyric_object::LinkageSection::Call, 1));
+    ASSERT_TRUE (cache.isBoundTo(lyric_object::LinkageSection::Call, 2));
+    ASSERT_EQ (0, cache.numEntries());
+    ASSERT_TRUE (cache.lookup(&receiver) == nullptr);
+}
+
+TEST_F (CallSiteCache, RebindingToDifferentSectionDiscardsEntries)
+{
+    lyric_runtime::CallSiteCache cache;
+    cache.bind(lyric_object::LinkageSection::Call, 1, lyric_runtime::Operand::nil());
+
+    int receiver;
+    lyric_runtime::VirtualMethod method;
+    cache.insert(&receiver, nullptr, &method);
+
+    // the same address in a different section refers to a different descriptor
+    ASSERT_FALSE (cache.isBoundTo(lyric_object::LinkageSection::Action, 1));
+
+    cache.bind(lyric_object::LinkageSection::Action, 1, lyric_runtime::Operand::nil());
+    ASSERT_FALSE (cache.isBoundTo(lyric_object::LinkageSection::Call, 1));
+    ASSERT_TRUE (cache.isBoundTo(lyric_object::LinkageSection::Action, 1));
+    ASSERT_EQ (0, cache.numEntries());
+    ASSERT_TRUE (cache.lookup(&receiver) == nullptr);
+}
@@ -0,0 +1,178 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <lyric_bootstrap/bootstrap_loader.h>
+#include <lyric_runtime/arena_heap.h>
+#include <lyric_runtime/base_ref.h>
+#include <lyric_runtime/gc_heap.h>
+#include <lyric_runtime/heap_manager.h>
+#include <lyric_runtime/interpreter_state.h>
+#include <lyric_runtime/static_loader.h>
+#include <lyric_runtime/upvalue_cell.h>
+#include <tempo_test/status_matchers.h>
+#include <tempo_utils/file_reader.h>
+
+class GCHeap : public ::testing::Test {};
+
+class NodeRef : public lyric_runtime::BaseRef {
+public:
+    NodeRef() : BaseRef(nullptr) {};
+    std::string toString() const override { return "NodeRef"; };
+    std::vector<lyric_runtime::Operand> edges;
+protected:
+    void setMembersReachable() override {
+        for (const auto &edge : edges) {
+            edge.setReachable();
+        }
+    };
+};
+
+class CapturingRef : public lyric_runtime::BaseRef {
+public:
+    CapturingRef() : BaseRef(nullptr) {};
+    std::string toString() const override { return "CapturingRef"; };
+    std::vector<lyric_runtime::UpvalueCellPtr> upvalues;
+protected:
+    void setMembersReachable() override {
+        for (const auto &upvalue : upvalues) {
+            upvalue->setReachable();
+        }
+    };
+};
+
+template <typename T>
+static T *
+allocate_instance(lyric_runtime::AbstractHeap *heap)
+{
+    auto *instance = new (heap->allocateMemory(sizeof(T))) T();
+    heap->insertInstance(instance);
+    return instance;
+}
+
+static void
+link_nodes(NodeRef *from, NodeRef *to)
+{
+    from->edges.push_back(lyric_runtime::Operand::fromRef(to));
+}
+
+TEST_F (GCHeap, MarkTerminatesForCyclicGraph)
+{
+    auto heap = lyric_runtime::GCHeap::create();
+
+    // a reachable cycle and an unreachable cycle
+    auto *a = allocate_instance<NodeRef>(heap.get());
+    auto *b = allocate_instance<NodeRef>(heap.get());
+    link_nodes(a, b);
+    link_nodes(b, a);
+    link_nodes(a, a);
+    auto *c = allocate_instance<NodeRef>(heap.get());
+    auto *d = allocate_instance<NodeRef>(heap.get());
+    link_nodes(c, d);
+    link_nodes(d, c);
+    ASSERT_EQ (4, heap->numInstances());
+
+    auto *handle = heap->createHandle(a);
+    heap->clearReachable();
+    heap->deleteUnreachable();
+    ASSERT_EQ (2, heap->numInstances());
+    ASSERT_TRUE (a->isReachable());
+    ASSERT_TRUE (b->isReachable());
+
+    heap->decrementHandle(handle);
+    heap->clearReachable();
+    heap->deleteUnreachable();
+    ASSERT_EQ (0, heap->numInstances());
+}
+
+TEST_F (GCHeap, MarkDeepChainWithoutRecursion)
+{
+    auto heap = lyric_runtime::GCHeap::create();
+
+    // a chain long enough to overflow the native stack if marking recursed once per edge
+    constexpr int kChainLength = 500000;
+    auto *head = allocate_instance<NodeRef>(heap.get());
+    auto *tail = head;
+    for (int i = 1; i < kChainLength; i++) {
+        auto *node = allocate_instance<NodeRef>(heap.get());
+        link_nodes(tail, node);
+        tail = node;
+    }
+    link_nodes(tail, head);
+
+    auto *handle = heap->createHandle(head);
+    heap->clearReachable();
+    heap->deleteUnreachable();
+    ASSERT_EQ (kChainLength, heap->numInstances());
+    ASSERT_TRUE (tail->isReachable());
+
+    heap->decrementHandle(handle);
+    heap->clearReachable();
+    heap->deleteUnreachable();
+    ASSERT_EQ (0, heap->numInstances());
+}
+
+TEST_F (GCHeap, MarkSelfCapturingClosure)
+{
+    auto heap = lyric_runtime::GCHeap::create();
+
+    // the closure captures a cell which holds the closure itself, and a second closure shares the cell
+    auto *closure = allocate_instance<CapturingRef>(heap.get());
+    auto cell = std::make_shared<lyric_runtime::UpvalueCell>(lyric_runtime::Operand::fromRef(closure));
+    closure->upvalues.push_back(cell);
+    auto *sibling = allocate_instance<CapturingRef>(heap.get());
+    sibling->upvalues.push_back(cell);
+    sibling->upvalues.push_back(cell);
+    cell.reset();
+
+    auto *handle = heap->createHandle(sibling);
+    heap->clearReachable();
+    heap->deleteUnreachable();
+    ASSERT_EQ (2, heap->numInstances());
+    ASSERT_TRUE (closure->isReachable());
+
+    heap->decrementHandle(handle);
+    heap->clearReachable();
+    heap->deleteUnreachable();
+    ASSERT_EQ (0, heap->numInstances());
+}
+
+TEST_F (GCHeap, CollectWhenAllocationBudgetIsExceeded)
+{
+    auto staticLoader = std::make_shared<lyric_runtime::StaticLoader>();
+    auto testmodLocation = lyric_common::ModuleLocation::fromString("test:///testmod");
+    tempo_utils::FileReader reader(TESTMOD_OBJECT_PATH);
+    TU_RAISE_IF_NOT_OK (reader.getStatus());
+    staticLoader->insertModule(testmodLocation, lyric_object::LyricObject(reader.getBytes()));
+
+    auto heap = lyric_runtime::ArenaHeap::create();
+    lyric_runtime::InterpreterStateOptions options;
+    options.heap = heap;
+    options.gcAllocationBudget = 16;
+    options.gcMaxPauseMicros = 0;
+    std::shared_ptr<lyric_runtime::InterpreterState> state;
+    TU_ASSIGN_OR_RAISE (state, lyric_runtime::InterpreterState::create(
+        std::make_shared<lyric_bootstrap::BootstrapLoader>(), staticLoader, options));
+    ASSERT_THAT (state->load(testmodLocation), tempo_test::IsOk());
+
+    auto *heapManager = state->heapManager();
+    ASSERT_THAT (heapManager->collectGarbage(), tempo_test::IsOk());
+    auto baseline = heap->numInstances();
+
+    auto kept = heapManager->allocateString("kept", /* isPermanent= */ false);
+    auto handle = state->createHandle(kept);
+
+    // allocating within the budget does not trigger a collection
+    for (int i = 0; i < 8; i++) {
+        heapManager->allocateString("garbage", /* isPermanent= */ false);
+    }
+    ASSERT_THAT (heapManager->collectGarbageStep(), tempo_test::IsOk());
+    ASSERT_EQ (baseline + 9, heap->numInstances());
+
+    // exceeding the budget collects the unreachable instances but not the instance held by the handle
+    for (int i = 0; i < 8; i++) {
+        heapManager->allocateString("garbage", /* isPermanent= */ false);
+    }
+    ASSERT_THAT (heapManager->collectGarbageStep(), tempo_test::IsOk());
+    ASSERT_FALSE (heap->isSweeping());
+    ASSERT_EQ (baseline + 1, heap->numInstances());
+}
@@ -0,0 +1,173 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <lyric_assembler/call_symbol.h>
+#include <lyric_assembler/object_root.h>
+#include <lyric_assembler/object_state.h>
+#include <lyric_bootstrap/bootstrap_loader.h>
+#include <lyric_runtime/bytecode_interpreter.h>
+#include <lyric_runtime/interpreter_executor.h>
+#include <lyric_runtime/interpreter_state.h>
+#include <lyric_runtime/static_loader.h>
+#include <tempo_test/status_matchers.h>
+#include <tempo_utils/file_reader.h>
+
+class InterpreterExecutor : public ::testing::Test {
+protected:
+    lyric_common::ModuleLocation testmodLocation;
+    lyric_object::LyricObject testmodObject;
+
+    void SetUp() override {
+        testmodLocation = lyric_common::ModuleLocation::fromString("test:///testmod");
+        tempo_utils::FileReader reader(TESTMOD_OBJECT_PATH);
+        TU_RAISE_IF_NOT_OK (reader.getStatus());
+        testmodObject = lyric_object::LyricObject(reader.getBytes());
+    }
+
+    std::shared_ptr<lyric_runtime::InterpreterState> createState() {
+        return createState(testmodLocation, testmodObject);
+    }
+
+    std::shared_ptr<lyric_runtime::InterpreterState> createState(
+        const lyric_common::ModuleLocation &location,
+        const lyric_object::LyricObject &object)
+    {
+        auto staticLoader = std::make_shared<lyric_runtime::StaticLoader>();
+        staticLoader->insertModule(location, object);
+        auto systemLoader = std::make_shared<lyric_bootstrap::BootstrapLoader>();
+        std::shared_ptr<lyric_runtime::InterpreterState> state;
+        TU_ASSIGN_OR_RAISE (state, lyric_runtime::InterpreterState::create(systemLoader, staticLoader));
+        TU_RAISE_IF_NOT_OK (state->load(location));
+        return state;
+    }
+
+    // builds a module whose entry counts down from the specified number of iterations in a tight loop
+    // which contains no calls, so the loop is only interrupted at its backward branch
+    lyric_object::LyricObject buildCountdownModule(tu_int64 numIterations) {
+        auto location = lyric_common::ModuleLocation::fromString("/countdown");
+        auto origin = lyric_common::ModuleLocation::fromString("countdown://");
+        auto localModuleCache = lyric_importer::ModuleCache::create(
+            std::make_shared<lyric_runtime::StaticLoader>());
+        auto systemModuleCache = lyric_importer::ModuleCache::create(
+            std::make_shared<lyric_bootstrap::BootstrapLoader>());
+        auto shortcutResolver = std::make_shared<lyric_importer::ShortcutResolver>();
+        lyric_assembler::ObjectStateOptions options;
+        lyric_assembler::ObjectState objectState(location, origin, localModuleCache, systemModuleCache,
+            shortcutResolver, options);
+
+        lyric_assembler::ObjectRoot *objectRoot;
+        TU_ASSIGN_OR_RAISE (objectRoot, objectState.defineRoot());
+        auto *entryCall = objectRoot->entryCall();
+        auto *fragment = entryCall->callProc()->procFragment();
+
+        TU_RAISE_IF_NOT_OK (fragment->immediateI64(numIterations));
+        lyric_assembler::JumpLabel topOfLoop;
+        TU_ASSIGN_OR_RAISE (topOfLoop, fragment->appendLabel());
+        TU_RAISE_IF_NOT_OK (fragment->immediateI64(1));
+        TU_RAISE_IF_NOT_OK (fragment->subtract());
+        TU_RAISE_IF_NOT_OK (fragment->dupValue());
+        lyric_assembler::JumpTarget loopJump;
+        TU_ASSIGN_OR_RAISE (loopJump, fragment->jumpIfNotZero());
+        TU_RAISE_IF_NOT_OK (fragment->patchTarget(loopJump, topOfLoop));
+        TU_RAISE_IF_NOT_OK (fragment->popValue());
+        TU_RAISE_IF_NOT_OK (fragment->returnToCaller());
+        TU_RAISE_IF_STATUS (entryCall->finalizeCall());
+
+        lyric_object::LyricObject object;
+        TU_ASSIGN_OR_RAISE (object, objectState.toObject());
+        return object;
+    }
+};
+
+TEST_F (InterpreterExecutor, RunManyStatesOnWorkerPool)
+{
+    lyric_runtime::ExecutorOptions options;
+    options.numWorkers = 4;
+    lyric_runtime::InterpreterExecutor executor(options);
+    ASSERT_THAT (executor.start(), tempo_test::IsOk());
+
+    std::vector<std::shared_ptr<lyric_runtime::InterpreterState>> states;
+    std::vector<std::future<lyric_runtime::ExecutorResult>> futures;
+    for (int i = 0; i < 64; i++) {
+        auto state = createState();
+        std::future<lyric_runtime::ExecutorResult> future;
+        ASSERT_THAT (executor.submit(state, future), tempo_test::IsOk());
+        states.push_back(std::move(state));
+        futures.push_back(std::move(future));
+    }
+
+    for (auto &future : futures) {
+        auto result = future.get();
+        ASSERT_TRUE (result.isResult());
+        ASSERT_EQ (tempo_utils::StatusCode::kOk, result.getResult().statusCode);
+    }
+
+    ASSERT_EQ (0, executor.numOutstanding());
+    ASSERT_THAT (executor.shutdown(), tempo_test::IsOk());
+}
+
+TEST_F (InterpreterExecutor, SubmitFailsWhenNotRunning)
+{
+    lyric_runtime::InterpreterExecutor executor;
+    std::future<lyric_runtime::ExecutorResult> future;
+    ASSERT_THAT (executor.submit(createState(), future),
+        tempo_test::IsCondition(lyric_runtime::InterpreterCondition::kRuntimeInvariant));
+}
+
+TEST_F (InterpreterExecutor, PreemptTightBackwardLoop)
+{
+    auto countdownLocation = lyric_common::ModuleLocation::fromString("test:///countdown");
+    auto countdownState = createState(countdownLocation, buildCountdownModule(1000000));
+    lyric_runtime::BytecodeInterpreter countdownInterp(countdownState);
+
+    // the loop is preempted once its quantum is exhausted, well before it completes
+    lyric_runtime::InterpreterExit interpreterExit;
+    auto yieldResult = countdownInterp.runQuantum(1, interpreterExit);
+    ASSERT_THAT (yieldResult, tempo_test::IsResult());
+    ASSERT_EQ (lyric_runtime::InterpreterYield::Preempted, yieldResult.getResult());
+    auto instructionCount = countdownInterp.getInstructionCounter();
+    ASSERT_LT (instructionCount, 1000);
+
+    // another program runs to completion on the same thread while the loop is preempted
+    lyric_runtime::BytecodeInterpreter otherInterp(createState());
+    lyric_runtime::InterpreterExit otherExit;
+    auto otherResult = otherInterp.runQuantum(1, otherExit);
+    ASSERT_THAT (otherResult, tempo_test::IsResult());
+    ASSERT_EQ (lyric_runtime::InterpreterYield::Halted, otherResult.getResult());
+    ASSERT_EQ (tempo_utils::StatusCode::kOk, otherExit.statusCode);
+
+    // the loop resumes where it left off and is preempted again
+    yieldResult = countdownInterp.runQuantum(1, interpreterExit);
+    ASSERT_THAT (yieldResult, tempo_test::IsResult());
+    ASSERT_EQ (lyric_runtime::InterpreterYield::Preempted, yieldResult.getResult());
+    ASSERT_GT (countdownInterp.getInstructionCounter(), instructionCount);
+}
+
+TEST_F (InterpreterExecutor, TightLoopDoesNotStarveOtherStatesOnWorker)
+{
+    lyric_runtime::ExecutorOptions options;
+    options.numWorkers = 1;
+    options.slicesPerQuantum = 1;
+    lyric_runtime::InterpreterExecutor executor(options);
+    ASSERT_THAT (executor.start(), tempo_test::IsOk());
+
+    auto countdownLocation = lyric_common::ModuleLocation::fromString("test:///countdown");
+    auto countdownState = createState(countdownLocation, buildCountdownModule(1000000));
+    std::future<lyric_runtime::ExecutorResult> countdownFuture;
+    ASSERT_THAT (executor.submit(countdownState, countdownFuture), tempo_test::IsOk());
+
+    auto otherState = createState();
+    std::future<lyric_runtime::ExecutorResult> otherFuture;
+    ASSERT_THAT (executor.submit(otherState, otherFuture), tempo_test::IsOk());
+
+    // the other state completes while the loop still occupies the only worker
+    auto otherResult = otherFuture.get();
+    ASSERT_TRUE (otherResult.isResult());
+    ASSERT_EQ (tempo_utils::StatusCode::kOk, otherResult.getResult().statusCode);
+    ASSERT_EQ (std::future_status::timeout, countdownFuture.wait_for(std::chrono::seconds(0)));
+
+    auto countdownResult = countdownFuture.get();
+    ASSERT_TRUE (countdownResult.isResult());
+    ASSERT_EQ (tempo_utils::StatusCode::kOk, countdownResult.getResult().statusCode);
+    ASSERT_THAT (executor.shutdown(), tempo_test::IsOk());
+}
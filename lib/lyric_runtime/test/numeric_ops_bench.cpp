@@ -0,0 +1,83 @@
+#include <chrono>
+#include <iostream>
+
+#include <lyric_runtime/internal/compare_ops.h>
+#include <lyric_runtime/internal/numeric_ops.h>
+#include <lyric_runtime/operand.h>
+#include <tempo_utils/log_stream.h>
+
+/**
+ * Micro-benchmark for the arithmetic and comparison ops. I64 and F64 operands take the same-type fast
+ * path, while U64 operands (which share the I64 encoding layout) take the generic path, so the ratio
+ * between the timings approximates the cost of the generic operand conversion.
+ */
+
+constexpr int kNumIterations = 10000000;
+
+template<class MakeOperand>
+static double
+time_binary_op(
+    const char *name,
+    MakeOperand &&makeOperand,
+    tempo_utils::Status (*op)(
+        lyric_runtime::HeapManager *,
+        const lyric_runtime::Operand &,
+        const lyric_runtime::Operand &,
+        lyric_runtime::Operand &))
+{
+    auto acc = makeOperand(0);
+    auto incr = makeOperand(1);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kNumIterations; i++) {
+        lyric_runtime::Operand result;
+        TU_RAISE_IF_NOT_OK (op(nullptr, acc, incr, result));
+        acc = std::move(result);
+    }
+    auto elapsed = std::chrono::duration<double,std::nano>(std::chrono::steady_clock::now() - start);
+    auto nsPerOp = elapsed.count() / kNumIterations;
+    std::cout << name << ": " << nsPerOp << " ns/op" << std::endl;
+    return nsPerOp;
+}
+
+template<class MakeOperand>
+static double
+time_compare(const char *name, MakeOperand &&makeOperand)
+{
+    auto lhs = makeOperand(1);
+    auto rhs = makeOperand(2);
+    tu_int64 sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kNumIterations; i++) {
+        lyric_runtime::Operand result;
+        TU_RAISE_IF_NOT_OK (lyric_runtime::internal::compare(lhs, rhs, result));
+        tu_int64 cmp;
+        result.getI64(cmp);
+        sum += cmp;
+    }
+    auto elapsed = std::chrono::duration<double,std::nano>(std::chrono::steady_clock::now() - start);
+    auto nsPerOp = elapsed.count() / kNumIterations;
+    std::cout << name << ": " << nsPerOp << " ns/op (checksum " << sum << ")" << std::endl;
+    return nsPerOp;
+}
+
+int
+main(int argc, char *argv[])
+{
+    auto fromI64 = [](tu_int64 v) { return lyric_runtime::Operand::fromI64(v); };
+    auto fromU64 = [](tu_int64 v) { return lyric_runtime::Operand::fromU64(v); };
+    auto fromF64 = [](tu_int64 v) { return lyric_runtime::Operand::fromF64(v); };
+
+    auto addI64 = time_binary_op("add I64 (fast path)", fromI64, lyric_runtime::internal::add);
+    auto addF64 = time_binary_op("add F64 (fast path)", fromF64, lyric_runtime::internal::add);
+    auto addU64 = time_binary_op("add U64 (generic path)", fromU64, lyric_runtime::internal::add);
+    auto mulI64 = time_binary_op("mul I64 (fast path)", fromI64, lyric_runtime::internal::mul);
+    auto mulU64 = time_binary_op("mul U64 (generic path)", fromU64, lyric_runtime::internal::mul);
+    auto cmpI64 = time_compare("compare I64 (fast path)", fromI64);
+    auto cmpU64 = time_compare("compare U64 (generic path)", fromU64);
+
+    std::cout << std::endl;
+    std::cout << "add speedup: " << addU64 / addI64 << "x (I64), " << addU64 / addF64 << "x (F64)" << std::endl;
+    std::cout << "mul speedup: " << mulU64 / mulI64 << "x" << std::endl;
+    std::cout << "compare speedup: " << cmpU64 / cmpI64 << "x" << std::endl;
+    return 0;
+}
@@ -1,8 +1,11 @@
+#include <limits>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include <lyric_bootstrap/bootstrap_loader.h>
 #include <lyric_runtime/internal/numeric_ops.h>
+#include <lyric_runtime/interpreter_result.h>
 #include <lyric_runtime/interpreter_state.h>
 #include <lyric_runtime/operand.h>
 #include <lyric_runtime/static_loader.h>
@@ -41,4 +44,73 @@ TEST_F (NumericOps, Add)
     tu_int32 i32;
     ASSERT_TRUE (result.getI32(i32));
     ASSERT_EQ (303, i32);
-}
\ No newline at end of file
+}
+
+TEST_F (NumericOps, AddI64)
+{
+    auto lhs = lyric_runtime::Operand::fromI64(101);
+    auto rhs = lyric_runtime::Operand::fromI64(-202);
+    lyric_runtime::Operand result;
+    ASSERT_THAT (lyric_runtime::internal::add(heapManager, lhs, rhs, result), tempo_test::IsOk());
+    tu_int64 i64;
+    ASSERT_TRUE (result.getI64(i64));
+    ASSERT_EQ (-101, i64);
+}
+
+TEST_F (NumericOps, AddI64OutsideStackRange)
+{
+    auto lhs = lyric_runtime::Operand::fromI64(std::numeric_limits<tu_int64>::max() - 1);
+    auto rhs = lyric_runtime::Operand::fromI64(1);
+    lyric_runtime::Operand result;
+    ASSERT_THAT (lyric_runtime::internal::add(heapManager, lhs, rhs, result), tempo_test::IsOk());
+    tu_int64 i64;
+    ASSERT_TRUE (result.getI64(i64));
+    ASSERT_EQ (std::numeric_limits<tu_int64>::max(), i64);
+}
+
+TEST_F (NumericOps, AddI64OverflowFails)
+{
+    auto lhs = lyric_runtime::Operand::fromI64(std::numeric_limits<tu_int64>::max());
+    auto rhs = lyric_runtime::Operand::fromI64(1);
+    lyric_runtime::Operand result;
+    ASSERT_THAT (lyric_runtime::internal::add(heapManager, lhs, rhs, result),
+        tempo_test::IsCondition(lyric_runtime::InterpreterCondition::kRuntimeInvariant));
+}
+
+TEST_F (NumericOps, MulI64OverflowFails)
+{
+    auto lhs = lyric_runtime::Operand::fromI64(std::numeric_limits<tu_int64>::min());
+    auto rhs = lyric_runtime::Operand::fromI64(-1);
+    lyric_runtime::Operand result;
+    ASSERT_THAT (lyric_runtime::internal::mul(heapManager, lhs, rhs, result),
+        tempo_test::IsCondition(lyric_runtime::InterpreterCondition::kRuntimeInvariant));
+}
+
+TEST_F (NumericOps, DivI64ByZeroFails)
+{
+    auto lhs = lyric_runtime::Operand::fromI64(1);
+    auto rhs = lyric_runtime::Operand::fromI64(0);
+    lyric_runtime::Operand result;
+    ASSERT_THAT (lyric_runtime::internal::div(heapManager, lhs, rhs, result),
+        tempo_test::IsCondition(lyric_runtime::InterpreterCondition::kRuntimeInvariant));
+}
+
+TEST_F (NumericOps, SubF64)
+{
+    auto lhs = lyric_runtime::Operand::fromF64(1.5);
+    auto rhs = lyric_runtime::Operand::fromF64(4.0);
+    lyric_runtime::Operand result;
+    ASSERT_THAT (lyric_runtime::internal::sub(heapManager, lhs, rhs, result), tempo_test::IsOk());
+    double f64;
+    ASSERT_TRUE (result.getF64(f64));
+    ASSERT_EQ (-2.5, f64);
+}
+
+TEST_F (NumericOps, AddMismatchedOperandsFails)
+{
+    auto lhs = lyric_runtime::Operand::fromI64(1);
+    auto rhs = lyric_runtime::Operand::fromF64(1.0);
+    lyric_runtime::Operand result;
+    ASSERT_THAT (lyric_runtime::internal::add(heapManager, lhs, rhs, result),
+        tempo_test::IsCondition(lyric_runtime::InterpreterCondition::kInvalidDataStackV2));
+}
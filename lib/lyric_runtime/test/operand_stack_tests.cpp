@@ -120,3 +120,94 @@ TEST_F (OperandStack, PushAndDropMultipleOperands)
 
     ASSERT_EQ (0, stack.getDepth());
 }
+
+TEST_F (OperandStack, SlottedPushAndPeekMultipleOperands)
+{
+    lyric_runtime::OperandStack stack(8192, lyric_runtime::OperandStackLayout::Slotted);
+    const tu_uint32 count = 10;
+
+    for (tu_uint32 i = 0; i < count; ++i) {
+        auto value = lyric_runtime::Operand::fromU32(i);
+        ASSERT_THAT (stack.pushOperand(value), tempo_test::IsOk());
+    }
+    ASSERT_EQ (count, stack.getDepth());
+
+    for (tu_uint32 i = 0; i < count; ++i) {
+        lyric_runtime::Operand top;
+        ASSERT_THAT (stack.peekOperand(top, i), tempo_test::IsOk());
+        tu_uint32 out;
+        ASSERT_TRUE (top.getU32(out));
+        ASSERT_EQ (count - 1 - i, out);
+    }
+
+    ASSERT_EQ (count, stack.getDepth());
+}
+
+TEST_F (OperandStack, SlottedDropOperandAtOffset)
+{
+    lyric_runtime::OperandStack stack(8192, lyric_runtime::OperandStackLayout::Slotted);
+
+    for (tu_uint32 i = 0; i < 5; ++i) {
+        auto value = lyric_runtime::Operand::fromU32(i);
+        ASSERT_THAT (stack.pushOperand(value), tempo_test::IsOk());
+    }
+    ASSERT_THAT (stack.dropOperand(2), tempo_test::IsOk());
+    ASSERT_EQ (4, stack.getDepth());
+
+    std::vector<lyric_runtime::Operand> values;
+    ASSERT_THAT (stack.popOperands(4, values), tempo_test::IsOk());
+    std::vector<tu_uint32> expected = {0, 1, 3, 4};
+    for (int i = 0; i < 4; ++i) {
+        tu_uint32 out;
+        ASSERT_TRUE (values.at(i).getU32(out));
+        ASSERT_EQ (expected.at(i), out);
+    }
+    ASSERT_TRUE (stack.isEmpty());
+}
+
+TEST_F (OperandStack, SlottedStackOverflowFails)
+{
+    lyric_runtime::OperandStack stack(4 * sizeof(lyric_runtime::Operand),
+        lyric_runtime::OperandStackLayout::Slotted);
+
+    for (tu_uint32 i = 0; i < 4; ++i) {
+        ASSERT_THAT (stack.pushOperand(lyric_runtime::Operand::nil()), tempo_test::IsOk());
+    }
+    ASSERT_FALSE (stack.pushOperand(lyric_runtime::Operand::nil()).isOk());
+    ASSERT_EQ (0, stack.getBytesAvailable());
+}
+
+TEST_F (OperandStack, PopOperandsReusesWindow)
+{
+    lyric_runtime::OperandStack stack;
+
+    std::vector<lyric_runtime::Operand> window;
+    window.reserve(8);
+    auto *storage = window.data();
+
+    for (tu_uint32 round = 0; round < 3; ++round) {
+        for (tu_uint32 i = 0; i < 4; ++i) {
+            ASSERT_THAT (stack.pushOperand(lyric_runtime::Operand::fromU32(round + i)), tempo_test::IsOk());
+        }
+        ASSERT_THAT (stack.popOperands(4, window), tempo_test::IsOk());
+        ASSERT_EQ (4, window.size());
+        ASSERT_EQ (storage, window.data());
+        for (tu_uint32 i = 0; i < 4; ++i) {
+            tu_uint32 out;
+            ASSERT_TRUE (window.at(i).getU32(out));
+            ASSERT_EQ (round + i, out);
+        }
+        ASSERT_TRUE (stack.isEmpty());
+    }
+}
+
+TEST_F (OperandStack, PopTooManyOperandsLeavesStackUnchanged)
+{
+    lyric_runtime::OperandStack stack;
+    ASSERT_THAT (stack.pushOperand(lyric_runtime::Operand::nil()), tempo_test::IsOk());
+    ASSERT_THAT (stack.pushOperand(lyric_runtime::Operand::nil()), tempo_test::IsOk());
+
+    std::vector<lyric_runtime::Operand> values;
+    ASSERT_FALSE (stack.popOperands(3, values).isOk());
+    ASSERT_EQ (2, stack.getDepth());
+}
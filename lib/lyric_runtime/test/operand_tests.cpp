@@ -195,12 +195,15 @@ TEST_F (Operand, RoundtripU64)
     ASSERT_EQ (in, out);
 }
 
-TEST_F (Operand, ConversionFromU64FailsWhenOutOfRange)
+TEST_F (Operand, RoundtripWideU64)
 {
     tu_uint64 in = std::numeric_limits<tu_uint64>::max();
     auto value = lyric_runtime::Operand::fromU64(in);
-    ASSERT_FALSE (value.isValid());
-    ASSERT_EQ (lyric_runtime::OperandType::Invalid, value.getType());
+    ASSERT_EQ (lyric_runtime::OperandType::UInt64, value.getType());
+    ASSERT_EQ (lyric_runtime::OverlayType::WideValue, value.getOverlay());
+    tu_uint64 out;
+    ASSERT_TRUE (value.getU64(out));
+    ASSERT_EQ (in, out);
 }
 
 TEST_F (Operand, RoundtripPositiveI64)
@@ -225,20 +228,36 @@ TEST_F (Operand, RoundtripNegativeI64)
     ASSERT_EQ (in, out);
 }
 
-TEST_F (Operand, ConversionFromI64FailsWhenTooLarge)
+TEST_F (Operand, RoundtripWidePositiveI64)
 {
     tu_int64 in = std::numeric_limits<tu_int64>::max();
     auto value = lyric_runtime::Operand::fromI64(in);
-    ASSERT_FALSE (value.isValid());
-    ASSERT_EQ (lyric_runtime::OperandType::Invalid, value.getType());
+    ASSERT_EQ (lyric_runtime::OperandType::Int64, value.getType());
+    ASSERT_EQ (lyric_runtime::OverlayType::WideValue, value.getOverlay());
+    tu_int64 out;
+    ASSERT_TRUE (value.getI64(out));
+    ASSERT_EQ (in, out);
 }
 
-TEST_F (Operand, ConversionFromI64FailsWhenTooSmall)
+TEST_F (Operand, RoundtripWideNegativeI64)
 {
     tu_int64 in = std::numeric_limits<tu_int64>::min();
     auto value = lyric_runtime::Operand::fromI64(in);
-    ASSERT_FALSE (value.isValid());
-    ASSERT_EQ (lyric_runtime::OperandType::Invalid, value.getType());
+    ASSERT_EQ (lyric_runtime::OperandType::Int64, value.getType());
+    ASSERT_EQ (lyric_runtime::OverlayType::WideValue, value.getOverlay());
+    tu_int64 out;
+    ASSERT_TRUE (value.getI64(out));
+    ASSERT_EQ (in, out);
+}
+
+TEST_F (Operand, ParseWideValue)
+{
+    auto value = lyric_runtime::Operand::fromI64(std::numeric_limits<tu_int64>::min());
+    auto bytes = value.getBytes();
+    ASSERT_EQ (16, bytes.size());
+    ASSERT_EQ (16, lyric_runtime::Operand::parseSize(bytes.back()));
+    auto parsed = lyric_runtime::Operand::parse(bytes);
+    ASSERT_TRUE (parsed.isEqualTo(value));
 }
 
 TEST_F (Operand, RoundtripChar32)
@@ -281,6 +300,17 @@ TEST_F (Operand, RoundtripFloat64)
     ASSERT_EQ (in, out);
 }
 
+TEST_F (Operand, RoundtripWideFloat64)
+{
+    double in = 1.0e300;
+    auto value = lyric_runtime::Operand::fromF64(in);
+    ASSERT_EQ (lyric_runtime::OperandType::Float64, value.getType());
+    ASSERT_EQ (lyric_runtime::OverlayType::WideValue, value.getOverlay());
+    double out;
+    ASSERT_TRUE (value.getF64(out));
+    ASSERT_EQ (in, out);
+}
+
 TEST_F (Operand, RoundtripFloat64PositiveZero)
 {
     double in = 0.0;
@@ -0,0 +1,145 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <lyric_object/bytecode_builder.h>
+#include <lyric_runtime/predecoded_proc.h>
+#include <tempo_test/status_matchers.h>
+
+class PredecodedProc : public ::testing::Test {};
+
+TEST_F (PredecodedProc, DecodeStraightLineCode)
+{
+    lyric_object::BytecodeBuilder builder;
+    ASSERT_THAT (builder.loadI64(42), tempo_test::IsOk());
+    ASSERT_THAT (builder.popValue(), tempo_test::IsOk());
+    auto code = builder.getBytecode();
+
+    lyric_runtime::PredecodedProc proc(code);
+    ASSERT_TRUE (proc.isComplete());
+    ASSERT_EQ (2, proc.numOps());
+
+    auto *op1 = proc.getOp(0);
+    ASSERT_TRUE (op1 != nullptr);
+    ASSERT_EQ (lyric_object::Opcode::OP_I64, op1->op.opcode);
+    ASSERT_EQ (42, op1->op.operands.immediate_i64.i64);
+    ASSERT_EQ (lyric_runtime::INVALID_ADDRESS_U32, op1->target);
+
+    auto *op2 = proc.getOp(op1->next);
+    ASSERT_TRUE (op2 != nullptr);
+    ASSERT_EQ (lyric_object::Opcode::OP_POP, op2->op.opcode);
+    ASSERT_EQ (code.size(), op2->next);
+
+    // offsets which do not point to the start of an instruction are not fetchable
+    ASSERT_TRUE (proc.getOp(1) == nullptr);
+    ASSERT_TRUE (proc.getOp(code.size()) == nullptr);
+}
+
+TEST_F (PredecodedProc, PrecomputeJumpTarget)
+{
+    lyric_object::BytecodeBuilder builder;
+    tu_uint16 loopLabel;
+    ASSERT_THAT (builder.makeLabel(loopLabel), tempo_test::IsOk());
+    ASSERT_THAT (builder.loadNil(), tempo_test::IsOk());
+    ASSERT_THAT (builder.popValue(), tempo_test::IsOk());
+    ASSERT_THAT (builder.jumpTo(loopLabel), tempo_test::IsOk());
+    auto code = builder.getBytecode();
+
+    lyric_runtime::PredecodedProc proc(code);
+    ASSERT_TRUE (proc.isComplete());
+    ASSERT_EQ (3, proc.numOps());
+
+    auto *op1 = proc.getOp(0);
+    auto *op2 = proc.getOp(op1->next);
+    auto *op3 = proc.getOp(op2->next);
+    ASSERT_TRUE (op3 != nullptr);
+    ASSERT_EQ (lyric_object::Opcode::OP_JUMP, op3->op.opcode);
+    ASSERT_EQ (loopLabel, op3->target);
+
+    // the jump target is mapped to the index of the op in the predecoded stream
+    auto ops = proc.getOps();
+    ASSERT_EQ (3, ops.size());
+    ASSERT_EQ (0, op3->targetIndex);
+    ASSERT_EQ (op1, &ops[op3->targetIndex]);
+    ASSERT_EQ (lyric_runtime::INVALID_ADDRESS_U32, op1->targetIndex);
+}
+
+TEST_F (PredecodedProc, TruncatedCodeIsIncomplete)
+{
+    lyric_object::BytecodeBuilder builder;
+    ASSERT_THAT (builder.loadNil(), tempo_test::IsOk());
+    ASSERT_THAT (builder.loadI64(42), tempo_test::IsOk());
+    auto code = builder.getBytecode();
+    code.resize(code.size() - 4);
+
+    lyric_runtime::PredecodedProc proc(code);
+    ASSERT_FALSE (proc.isComplete());
+    ASSERT_EQ (1, proc.numOps());
+    ASSERT_TRUE (proc.getOp(1) == nullptr);
+}
+
+TEST_F (PredecodedProc, FuseSuperinstructions)
+{
+    lyric_object::BytecodeBuilder builder;
+    tu_uint16 patchOffset;
+    ASSERT_THAT (builder.loadLocal(0), tempo_test::IsOk());
+    ASSERT_THAT (builder.loadLocal(1), tempo_test::IsOk());
+    ASSERT_THAT (builder.writeOpcode(lyric_object::Opcode::OP_CMP), tempo_test::IsOk());
+    ASSERT_THAT (builder.jumpIfLessThan(patchOffset), tempo_test::IsOk());
+    tu_uint16 targetLabel;
+    ASSERT_THAT (builder.makeLabel(targetLabel), tempo_test::IsOk());
+    ASSERT_THAT (builder.patch(patchOffset, targetLabel), tempo_test::IsOk());
+    ASSERT_THAT (builder.loadI64(1), tempo_test::IsOk());
+    ASSERT_THAT (builder.dupValue(), tempo_test::IsOk());
+    ASSERT_THAT (builder.storeLocal(0), tempo_test::IsOk());
+    auto code = builder.getBytecode();
+
+    lyric_runtime::PredecodedProc proc(code);
+    ASSERT_TRUE (proc.isComplete());
+    ASSERT_EQ (7, proc.numOps());
+    ASSERT_EQ (3, proc.numSuperinstructions());
+
+    auto *load1 = proc.getOp(0);
+    ASSERT_EQ (lyric_runtime::Superinstruction::LoadLocalPair, load1->fused);
+    auto *load2 = proc.getOp(load1->next);
+    ASSERT_EQ (load2->next, load1->fusedNext);
+
+    // the second load is not fused because it is followed by CMP
+    ASSERT_EQ (lyric_runtime::Superinstruction::None, load2->fused);
+
+    auto *cmp = proc.getOp(load2->next);
+    ASSERT_EQ (lyric_runtime::Superinstruction::CompareBranch, cmp->fused);
+    auto *branch = proc.getOp(cmp->next);
+    ASSERT_EQ (branch->next, cmp->fusedNext);
+    ASSERT_EQ (targetLabel, branch->target);
+    ASSERT_EQ (4, branch->targetIndex);
+
+    auto *i64 = proc.getOp(branch->next);
+    ASSERT_EQ (lyric_runtime::Superinstruction::None, i64->fused);
+    auto *dup = proc.getOp(i64->next);
+    ASSERT_EQ (lyric_runtime::Superinstruction::DupStoreLocal, dup->fused);
+    ASSERT_EQ (code.size(), dup->fusedNext);
+}
+
+TEST_F (PredecodedProc, AssignCallSiteCaches)
+{
+    lyric_object::BytecodeBuilder builder;
+    ASSERT_THAT (builder.callVirtual(1, 0), tempo_test::IsOk());
+    ASSERT_THAT (builder.callStatic(2, 0), tempo_test::IsOk());
+    ASSERT_THAT (builder.callExistential(3, 0), tempo_test::IsOk());
+    auto code = builder.getBytecode();
+
+    lyric_runtime::PredecodedProc proc(code);
+    ASSERT_TRUE (proc.isComplete());
+    ASSERT_EQ (3, proc.numOps());
+    ASSERT_EQ (2, proc.numCallSites());
+
+    // dispatched calls each get a distinct inline cache, static calls are not cached
+    auto *callVirtual = proc.getOp(0);
+    auto *callStatic = proc.getOp(callVirtual->next);
+    auto *callExistential = proc.getOp(callStatic->next);
+    ASSERT_TRUE (callVirtual->callSite != nullptr);
+    ASSERT_TRUE (callStatic->callSite == nullptr);
+    ASSERT_TRUE (callExistential->callSite != nullptr);
+    ASSERT_NE (callVirtual->callSite, callExistential->callSite);
+    ASSERT_FALSE (callVirtual->callSite->isBoundTo(lyric_object::LinkageSection::Call, 1));
+}
@@ -0,0 +1,161 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <lyric_runtime/bytecode_segment.h>
+#include <lyric_runtime/proc_metadata.h>
+#include <tempo_test/result_matchers.h>
+#include <tempo_test/status_matchers.h>
+
+#include "base_runtime_fixture.h"
+
+class ProcMetadata : public BaseRuntimeFixture {
+protected:
+    std::unique_ptr<lyric_runtime::BytecodeSegment> segment;
+
+    void compileSegment(const std::string &code) {
+        auto compileModuleResult = tester->compileModule(code);
+        ASSERT_THAT (compileModuleResult, tempo_test::IsResult());
+        auto object = compileModuleResult.getResult().getModule();
+        ASSERT_TRUE (object.isValid());
+        segment = std::make_unique<lyric_runtime::BytecodeSegment>(0, false,
+            lyric_common::ModuleLocation::fromString("/test"), object, lyric_common::ModuleLocation{}, nullptr);
+    }
+};
+
+static const char *kTestCode = R"(
+    def makeAdder(n: I64): Function1[I64,I64] {
+      val m: I64 = n
+      lambda (p: I64): I64 {
+        p + m
+      }
+    }
+    var x: String = ""
+    try {
+        try {
+            raise Internal{message="something failed"}
+        } catch {
+            when ex: Internal { x = "inner" }
+        }
+        raise Internal{message="something else failed"}
+    } catch {
+        when ex: Internal { x = "outer" }
+        when ex: Unknown { x = "unknown" }
+    }
+    makeAdder(3).Apply(2)
+)";
+
+TEST_F (ProcMetadata, CachedMetadataMatchesParseForCalls)
+{
+    ASSERT_NO_FATAL_FAILURE (compileSegment(kTestCode));
+    auto object = segment->getObject();
+
+    int numLexicals = 0;
+    for (int i = 0; i < object.numCalls(); i++) {
+        auto call = object.getCall(i);
+        if (call.isDeclOnly())
+            continue;
+
+        lyric_object::ProcInfo procInfo;
+        ASSERT_THAT (lyric_object::parse_proc_info(segment->getBytecode(), call.getProcOffset(), procInfo),
+            tempo_test::IsOk());
+        std::vector<lyric_object::ProcLexical> lexicals;
+        ASSERT_THAT (lyric_object::parse_lexicals_table(procInfo, lexicals), tempo_test::IsOk());
+
+        const lyric_runtime::ProcMetadata *procMetadata;
+        ASSERT_THAT (segment->getProcMetadata(call.getProcOffset(), &procMetadata), tempo_test::IsOk());
+        ASSERT_EQ (procInfo.num_arguments, procMetadata->numArguments());
+        ASSERT_EQ (procInfo.num_locals, procMetadata->numLocals());
+        ASSERT_EQ (procInfo.num_lexicals, procMetadata->numLexicals());
+        ASSERT_EQ (procInfo.code.data(), procMetadata->getCode().data());
+        ASSERT_EQ (procInfo.code.size(), procMetadata->getCode().size());
+
+        auto cachedLexicals = procMetadata->getLexicals();
+        ASSERT_EQ (lexicals.size(), cachedLexicals.size());
+        for (int j = 0; j < lexicals.size(); j++) {
+            ASSERT_EQ (lexicals[j].activation_call, cachedLexicals[j].activation_call);
+            ASSERT_EQ (lexicals[j].target_offset, cachedLexicals[j].target_offset);
+            ASSERT_EQ (lexicals[j].lexical_target, cachedLexicals[j].lexical_target);
+        }
+        numLexicals += lexicals.size();
+
+        // the metadata is decoded once and returned from the cache thereafter
+        const lyric_runtime::ProcMetadata *cachedMetadata;
+        ASSERT_THAT (segment->getProcMetadata(call.getProcOffset(), &cachedMetadata), tempo_test::IsOk());
+        ASSERT_EQ (procMetadata, cachedMetadata);
+    }
+
+    // the closure imports a lexical from the enclosing proc
+    ASSERT_LT (0, numLexicals);
+}
+
+TEST_F (ProcMetadata, CachedHandlersMatchParseForRaises)
+{
+    ASSERT_NO_FATAL_FAILURE (compileSegment(kTestCode));
+    auto object = segment->getObject();
+
+    int numChecks = 0;
+    for (int i = 0; i < object.numCalls(); i++) {
+        auto call = object.getCall(i);
+        if (call.isDeclOnly())
+            continue;
+
+        lyric_object::ProcInfo procInfo;
+        ASSERT_THAT (lyric_object::parse_proc_info(segment->getBytecode(), call.getProcOffset(), procInfo),
+            tempo_test::IsOk());
+        lyric_object::TrailerInfo trailerInfo;
+        ASSERT_THAT (lyric_object::parse_proc_trailer(procInfo, trailerInfo), tempo_test::IsOk());
+        std::vector<lyric_object::ProcCheck> checks;
+        ASSERT_THAT (lyric_object::parse_checks_table(trailerInfo, checks), tempo_test::IsOk());
+        std::vector<lyric_object::ProcException> exceptions;
+        ASSERT_THAT (lyric_object::parse_exceptions_table(trailerInfo, exceptions), tempo_test::IsOk());
+
+        const lyric_runtime::ProcMetadata *procMetadata;
+        ASSERT_THAT (segment->getProcMetadata(call.getProcOffset(), &procMetadata), tempo_test::IsOk());
+
+        auto cachedChecks = procMetadata->getChecks();
+        ASSERT_EQ (checks.size(), cachedChecks.size());
+        for (int j = 0; j < checks.size(); j++) {
+            ASSERT_EQ (checks[j].interval_offset, cachedChecks[j].interval_offset);
+            ASSERT_EQ (checks[j].interval_size, cachedChecks[j].interval_size);
+            ASSERT_EQ (checks[j].first_exception, cachedChecks[j].first_exception);
+            ASSERT_EQ (checks[j].num_exceptions, cachedChecks[j].num_exceptions);
+            ASSERT_EQ (checks[j].exception_local, cachedChecks[j].exception_local);
+        }
+        auto cachedExceptions = procMetadata->getExceptions();
+        ASSERT_EQ (exceptions.size(), cachedExceptions.size());
+        for (int j = 0; j < exceptions.size(); j++) {
+            ASSERT_EQ (exceptions[j].exception_type, cachedExceptions[j].exception_type);
+            ASSERT_EQ (exceptions[j].catch_offset, cachedExceptions[j].catch_offset);
+            ASSERT_EQ (exceptions[j].catch_size, cachedExceptions[j].catch_size);
+        }
+        numChecks += checks.size();
+
+        // at every offset the handlers match a scan of the checks in table order, which is how a raise
+        // searches for a matching handler
+        tu_uint32 endOffset = procInfo.code.size();
+        for (const auto &check : checks) {
+            endOffset = std::max(endOffset, check.interval_offset + check.interval_size + 1);
+        }
+        for (tu_uint32 offset = 0; offset < endOffset; offset++) {
+            std::vector<lyric_runtime::ProcHandler> expected;
+            for (const auto &check : checks) {
+                if (offset < check.interval_offset || check.interval_offset + check.interval_size <= offset)
+                    continue;
+                for (int j = 0; j < check.num_exceptions; j++) {
+                    const auto &exception = exceptions.at(check.first_exception + j);
+                    expected.push_back({exception.exception_type, exception.catch_offset, check.exception_local});
+                }
+            }
+            auto handlers = procMetadata->findHandlers(offset);
+            ASSERT_EQ (expected.size(), handlers.size()) << "at offset " << offset;
+            for (int j = 0; j < expected.size(); j++) {
+                ASSERT_EQ (expected[j].exception_type, handlers[j].exception_type);
+                ASSERT_EQ (expected[j].catch_offset, handlers[j].catch_offset);
+                ASSERT_EQ (expected[j].exception_local, handlers[j].exception_local);
+            }
+        }
+    }
+
+    // the nested try blocks produce a check for each block
+    ASSERT_LE (2, numChecks);
+}
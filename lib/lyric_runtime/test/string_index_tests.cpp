@@ -0,0 +1,79 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <lyric_runtime/string_index.h>
+
+class StringIndex : public ::testing::Test {};
+
+static lyric_runtime::StringIndex
+build_index(std::string_view s)
+{
+    return lyric_runtime::StringIndex::build(tempo_utils::Rope<char>(s.cbegin(), s.cend()));
+}
+
+TEST_F (StringIndex, BuildLocatesCheckpointsInMixedContents)
+{
+    // code points of one to four bytes, with the byte offset of each code point
+    const char *pieces[] = {"a", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80"};
+    std::string s;
+    std::vector<tu_int32> offsets;
+    for (int i = 0; i < 1000; i++) {
+        offsets.push_back(static_cast<tu_int32>(s.size()));
+        s.append(pieces[(i * 7 / 3) % 4]);
+    }
+
+    // split the contents across chunks in the middle of a multibyte sequence
+    auto split = offsets[500] + 1;
+    tempo_utils::Rope<char> head(s.cbegin(), s.cbegin() + split);
+    auto rope = head.append(tempo_utils::Rope<char>(s.cbegin() + split, s.cend()));
+
+    for (const auto &index : {build_index(s), lyric_runtime::StringIndex::build(rope)}) {
+        ASSERT_TRUE (index.isValid());
+        ASSERT_FALSE (index.isAscii());
+        ASSERT_EQ (1000, index.getLength());
+        ASSERT_EQ (static_cast<tu_int32>(s.size()), index.getSize());
+        for (tu_int32 i = 0; i < index.getLength(); i++) {
+            lyric_runtime::StringCheckpoint checkpoint;
+            tu_int32 end;
+            ASSERT_TRUE (index.locate(i, checkpoint, end));
+            ASSERT_EQ (i / lyric_runtime::kStringIndexStride * lyric_runtime::kStringIndexStride, checkpoint.index);
+            ASSERT_EQ (offsets[checkpoint.index], checkpoint.offset);
+        }
+    }
+}
+
+TEST_F (StringIndex, BuildRejectsInvalidContents)
+{
+    ASSERT_FALSE (build_index("abc\xC3\xA9\xC3").isValid());
+    ASSERT_FALSE (build_index("abc\xC3\xA9\xFF\xC3\xA9").isValid());
+    ASSERT_FALSE (build_index("\xE2\x82").isValid());
+}
+
+TEST_F (StringIndex, ConcatManyShortPiecesKeepsIndexSparse)
+{
+    // each piece is a single two-byte code point followed by an ascii character
+    auto piece = build_index("\xC3\xA9x");
+    ASSERT_TRUE (piece.isValid());
+    ASSERT_FALSE (piece.isAscii());
+    ASSERT_EQ (1, piece.numCheckpoints());
+
+    constexpr int kNumPieces = 10000;
+    lyric_runtime::StringIndex index;
+    for (int i = 0; i < kNumPieces; i++) {
+        index = lyric_runtime::StringIndex::concat(index, piece);
+    }
+    ASSERT_EQ (2 * kNumPieces, index.getLength());
+    ASSERT_EQ (3 * kNumPieces, index.getSize());
+    ASSERT_GE (2 * index.getLength() / lyric_runtime::kStringIndexStride + 1, index.numCheckpoints());
+
+    // every code point is still within a stride of its checkpoint
+    for (tu_int32 i = 0; i < index.getLength(); i++) {
+        lyric_runtime::StringCheckpoint checkpoint;
+        tu_int32 end;
+        ASSERT_TRUE (index.locate(i, checkpoint, end));
+        ASSERT_LE (checkpoint.index, i);
+        ASSERT_LT (i - checkpoint.index, lyric_runtime::kStringIndexStride);
+        ASSERT_EQ (checkpoint.index / 2 * 3 + checkpoint.index % 2 * 2, checkpoint.offset);
+        ASSERT_LE (end - checkpoint.offset, lyric_runtime::kStringIndexMaxSpan);
+    }
+}
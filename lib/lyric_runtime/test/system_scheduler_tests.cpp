@@ -1,4 +1,7 @@
 
+#include <csignal>
+#include <filesystem>
+#include <fstream>
 #include <thread>
 
 #include <gmock/gmock.h>
@@ -7,6 +10,7 @@
 #include <lyric_test/matchers.h>
 #include <tempo_test/result_matchers.h>
 #include <tempo_test/status_matchers.h>
+#include <tempo_utils/file_utilities.h>
 
 #include "base_runtime_fixture.h"
 
@@ -118,7 +122,7 @@ TEST_F (SystemScheduler, RegisterTimer)
 
     auto *waiter = systemScheduler->firstWaiter();
     ASSERT_TRUE (waiter != nullptr);
-    ASSERT_EQ (lyric_runtime::Waiter::Type::Handle, waiter->getType());
+    ASSERT_EQ (lyric_runtime::Waiter::Type::Timer, waiter->getType());
     ASSERT_TRUE (waiter->hasPromise());
 
     uv_run(loop, UV_RUN_DEFAULT);
@@ -128,6 +132,246 @@ TEST_F (SystemScheduler, RegisterTimer)
     ASSERT_THAT (result, OperandBool(true));
 }
 
+void on_timer_accept(lyric_runtime::Promise *promise, const lyric_runtime::Waiter *, lyric_runtime::InterpreterState *)
+{
+    promise->complete(lyric_runtime::Operand::fromBool(true));
+}
+
+TEST_F (SystemScheduler, RegisterManyTimers)
+{
+    auto *systemScheduler = state->systemScheduler();
+    auto *loop = systemScheduler->systemLoop();
+
+    std::vector<std::shared_ptr<lyric_runtime::Promise>> promises;
+    for (int i = 0; i < 1000; i++) {
+        auto promise = lyric_runtime::Promise::create(on_timer_accept);
+        ASSERT_THAT (systemScheduler->registerTimer(i % 50, promise), tempo_test::IsOk());
+        promises.push_back(promise);
+    }
+    ASSERT_EQ (1000, systemScheduler->timerWheel()->numTimers());
+
+    uv_run(loop, UV_RUN_DEFAULT);
+
+    for (const auto &promise : promises) {
+        ASSERT_EQ (lyric_runtime::Promise::State::Completed, promise->getState());
+    }
+    ASSERT_TRUE (systemScheduler->timerWheel()->isEmpty());
+    ASSERT_TRUE (systemScheduler->firstWaiter() == nullptr);
+}
+
+TEST_F (SystemScheduler, CancelTimer)
+{
+    auto *systemScheduler = state->systemScheduler();
+    auto *loop = systemScheduler->systemLoop();
+
+    auto cancelled = lyric_runtime::Promise::create(on_timer_accept);
+    ASSERT_THAT (systemScheduler->registerTimer(10000, cancelled), tempo_test::IsOk());
+    auto completed = lyric_runtime::Promise::create(on_timer_accept);
+    ASSERT_THAT (systemScheduler->registerTimer(10, completed), tempo_test::IsOk());
+    ASSERT_EQ (2, systemScheduler->timerWheel()->numTimers());
+
+    ASSERT_THAT (cancelled->cancel(systemScheduler), tempo_test::IsOk());
+    ASSERT_EQ (lyric_runtime::Promise::State::Cancelled, cancelled->getState());
+    ASSERT_EQ (1, systemScheduler->timerWheel()->numTimers());
+
+    // the loop exits once the remaining timer completes, rather than waiting for the cancelled timer
+    uv_run(loop, UV_RUN_DEFAULT);
+
+    ASSERT_EQ (lyric_runtime::Promise::State::Completed, completed->getState());
+    ASSERT_EQ (lyric_runtime::Promise::State::Cancelled, cancelled->getState());
+    ASSERT_TRUE (systemScheduler->timerWheel()->isEmpty());
+    ASSERT_THAT (cancelled->cancel(systemScheduler),
+        tempo_test::IsCondition(lyric_runtime::InterpreterCondition::kRuntimeInvariant));
+}
+
+class SystemSchedulerFs : public SystemScheduler {
+protected:
+    std::filesystem::path path;
+    std::string contents;
+    uv_file file = -1;
+
+    void SetUp() override {
+        SystemScheduler::SetUp();
+        path = std::filesystem::temp_directory_path() / tempo_utils::generate_name("system_scheduler_XXXXXXXX");
+        for (int i = 0; i < 10000; i++) {
+            contents.append("line " + std::to_string(i) + "\n");
+        }
+        std::ofstream out(path, std::ios::binary);
+        out << contents;
+        out.close();
+        uv_fs_t req;
+        file = uv_fs_open(nullptr, &req, path.c_str(), O_RDONLY, 0, nullptr);
+        uv_fs_req_cleanup(&req);
+        ASSERT_LE (0, file);
+    }
+
+    void TearDown() override {
+        uv_fs_t req;
+        uv_fs_close(nullptr, &req, file, nullptr);
+        uv_fs_req_cleanup(&req);
+        std::filesystem::remove(path);
+        SystemScheduler::TearDown();
+    }
+};
+
+TEST_F (SystemSchedulerFs, RegisterReadFile)
+{
+    auto *systemScheduler = state->systemScheduler();
+    auto *loop = systemScheduler->systemLoop();
+
+    std::string read;
+    auto promise = lyric_runtime::Promise::create(
+        [&](lyric_runtime::Promise *promise, const lyric_runtime::Waiter *waiter, lyric_runtime::InterpreterState *) {
+            auto *fileRead = waiter->peekReadFile();
+            ASSERT_EQ (0, fileRead->getResult());
+            auto data = fileRead->getData();
+            read = std::string(reinterpret_cast<const char *>(data.get()), fileRead->getSize());
+            promise->complete(lyric_runtime::Operand::fromBool(true));
+        });
+    ASSERT_THAT (systemScheduler->registerReadFile(file, promise), tempo_test::IsOk());
+
+    uv_run(loop, UV_RUN_DEFAULT);
+
+    ASSERT_EQ (lyric_runtime::Promise::State::Completed, promise->getState());
+    ASSERT_EQ (contents, read);
+}
+
+TEST_F (SystemSchedulerFs, RegisterReadFileFailsForFileLargerThanMaxSize)
+{
+    auto *systemScheduler = state->systemScheduler();
+    auto *loop = systemScheduler->systemLoop();
+
+    // extend the file past the maximum size, the file is sparse so no space is actually consumed
+    std::filesystem::resize_file(path, lyric_runtime::kMaxReadFileSize + 1);
+
+    int result = 0;
+    std::shared_ptr<const tempo_utils::ImmutableBytes> bytes;
+    auto promise = lyric_runtime::Promise::create(
+        [&](lyric_runtime::Promise *promise, const lyric_runtime::Waiter *waiter, lyric_runtime::InterpreterState *) {
+            auto *fileRead = waiter->peekReadFile();
+            result = fileRead->getResult();
+            bytes = fileRead->getBytes();
+            promise->complete(lyric_runtime::Operand::fromBool(true));
+        });
+    ASSERT_THAT (systemScheduler->registerReadFile(file, promise), tempo_test::IsOk());
+
+    uv_run(loop, UV_RUN_DEFAULT);
+
+    ASSERT_EQ (lyric_runtime::Promise::State::Completed, promise->getState());
+    ASSERT_EQ (UV_EFBIG, result);
+    ASSERT_TRUE (bytes == nullptr);
+}
+
+TEST_F (SystemSchedulerFs, RegisterReadFileReadsPipeUntilEndOfFile)
+{
+    auto *systemScheduler = state->systemScheduler();
+    auto *loop = systemScheduler->systemLoop();
+
+    // fstat reports a size of zero for a pipe, so the pipe must be read until end of file. the contents
+    // are written several times over so the read buffer must grow.
+    uv_file fds[2];
+    ASSERT_EQ (0, uv_pipe(fds, 0, 0));
+    // the writer gets EPIPE rather than a signal if the read end is closed early
+    signal(SIGPIPE, SIG_IGN);
+    std::string expected;
+    for (int i = 0; i < 4; i++) {
+        expected.append(contents);
+    }
+    std::thread writer([&]() {
+        uv_fs_t req;
+        auto buf = uv_buf_init(expected.data(), static_cast<unsigned int>(expected.size()));
+        while (buf.len > 0) {
+            auto ret = uv_fs_write(nullptr, &req, fds[1], &buf, 1, -1, nullptr);
+            uv_fs_req_cleanup(&req);
+            if (ret <= 0)
+                break;
+            buf.base += ret;
+            buf.len -= ret;
+        }
+        uv_fs_close(nullptr, &req, fds[1], nullptr);
+        uv_fs_req_cleanup(&req);
+    });
+
+    int result = -1;
+    std::string read;
+    auto promise = lyric_runtime::Promise::create(
+        [&](lyric_runtime::Promise *promise, const lyric_runtime::Waiter *waiter, lyric_runtime::InterpreterState *) {
+            auto *fileRead = waiter->peekReadFile();
+            result = fileRead->getResult();
+            auto bytes = fileRead->getBytes();
+            if (bytes != nullptr) {
+                read = std::string(reinterpret_cast<const char *>(bytes->getData()), bytes->getSize());
+            }
+            promise->complete(lyric_runtime::Operand::fromBool(true));
+        });
+    auto status = systemScheduler->registerReadFile(fds[0], promise);
+    if (status.isOk()) {
+        uv_run(loop, UV_RUN_DEFAULT);
+    }
+
+    // close the read end before joining, so the writer is not blocked forever on a full pipe if the
+    // read failed before draining it
+    uv_fs_t req;
+    uv_fs_close(nullptr, &req, fds[0], nullptr);
+    uv_fs_req_cleanup(&req);
+    writer.join();
+
+    ASSERT_THAT (status, tempo_test::IsOk());
+    ASSERT_EQ (lyric_runtime::Promise::State::Completed, promise->getState());
+    ASSERT_EQ (0, result);
+    ASSERT_EQ (expected, read);
+}
+
+TEST_F (SystemSchedulerFs, RegisterBatch)
+{
+    auto *systemScheduler = state->systemScheduler();
+    auto *loop = systemScheduler->systemLoop();
+
+    // read the file as 100 chunks of two buffers each, all outstanding at once
+    constexpr int kNumChunks = 100;
+    auto chunkSize = contents.size() / kNumChunks;
+    std::string read(chunkSize * kNumChunks, '\0');
+    std::vector<lyric_runtime::FsOperation> operations;
+    for (int i = 0; i < kNumChunks; i++) {
+        auto *base = read.data() + i * chunkSize;
+        auto half = static_cast<unsigned int>(chunkSize / 2);
+        std::vector<uv_buf_t> bufs = {
+            uv_buf_init(base, half),
+            uv_buf_init(base + half, static_cast<unsigned int>(chunkSize - half)),
+        };
+        operations.push_back(lyric_runtime::FsOperation::read(file, std::move(bufs), i * chunkSize));
+    }
+
+    int numCompleted = 0;
+    auto promise = lyric_runtime::Promise::create(
+        [&](lyric_runtime::Promise *promise, const lyric_runtime::Waiter *waiter, lyric_runtime::InterpreterState *) {
+            auto *batch = waiter->peekBatch();
+            ASSERT_EQ (kNumChunks, batch->numOperations());
+            ASSERT_EQ (0, batch->numPending());
+            ASSERT_FALSE (batch->hasError());
+            for (int i = 0; i < batch->numOperations(); i++) {
+                ASSERT_EQ (static_cast<tu_int64>(chunkSize), batch->getResult(i));
+            }
+            numCompleted++;
+            promise->complete(lyric_runtime::Operand::fromBool(true));
+        });
+    ASSERT_THAT (systemScheduler->registerBatch(operations, promise), tempo_test::IsOk());
+
+    uv_run(loop, UV_RUN_DEFAULT);
+
+    ASSERT_EQ (1, numCompleted);
+    ASSERT_EQ (lyric_runtime::Promise::State::Completed, promise->getState());
+    ASSERT_EQ (contents.substr(0, read.size()), read);
+}
+
+TEST_F (SystemSchedulerFs, RegisterEmptyBatchFails)
+{
+    auto *systemScheduler = state->systemScheduler();
+    auto promise = lyric_runtime::Promise::create();
+    ASSERT_THAT (systemScheduler->registerBatch({}, promise),
+        tempo_test::IsCondition(lyric_runtime::InterpreterCondition::kRuntimeInvariant));
+}
+
 class AllOfOps : public lyric_runtime::PromiseOperations {
 public:
     void onPartial(
@@ -0,0 +1,63 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <lyric_runtime/internal/text_kernels.h>
+
+class TextKernels : public ::testing::Test {};
+
+TEST_F (TextKernels, MismatchBytesSpansVectorWidths)
+{
+    std::string lhs(100, 'a');
+    for (size_t i = 0; i < lhs.size(); i++) {
+        std::string rhs = lhs;
+        rhs[i] = 'b';
+        ASSERT_EQ (i, lyric_runtime::internal::mismatch_bytes(lhs.data(), rhs.data(), lhs.size()));
+    }
+    ASSERT_EQ (lhs.size(), lyric_runtime::internal::mismatch_bytes(lhs.data(), lhs.data(), lhs.size()));
+}
+
+TEST_F (TextKernels, AsciiPrefixAndCodePoints)
+{
+    std::string s = std::string(40, 'x') + "h\xC3\xA9llo w\xC3\xB6rld";
+    ASSERT_EQ (41, lyric_runtime::internal::ascii_prefix_length(s.data(), s.size()));
+    ASSERT_EQ (51, lyric_runtime::internal::count_code_points(s.data(), s.size()));
+}
+
+TEST_F (TextKernels, FindByteAndBytes)
+{
+    std::string s = std::string(70, '.') + "needle" + std::string(30, '.');
+    ASSERT_EQ (70, lyric_runtime::internal::find_byte(s.data(), s.size(), 'n'));
+    ASSERT_EQ (70, lyric_runtime::internal::find_bytes(s.data(), s.size(), "needle", 6));
+    ASSERT_EQ (lyric_runtime::internal::kNotFound,
+        lyric_runtime::internal::find_bytes(s.data(), s.size(), "needles", 7));
+    ASSERT_EQ (0, lyric_runtime::internal::find_bytes(s.data(), s.size(), "", 0));
+}
+
+TEST_F (TextKernels, CompareRopesOrdersPrefixFirst)
+{
+    std::string abc("abc");
+    std::string abcd("abcd");
+    tempo_utils::Rope<char> shorter(abc.cbegin(), abc.cend());
+    tempo_utils::Rope<char> longer(abcd.cbegin(), abcd.cend());
+    ASSERT_EQ (-1, lyric_runtime::internal::compare_ropes(shorter, longer));
+    ASSERT_EQ (1, lyric_runtime::internal::compare_ropes(longer, shorter));
+    ASSERT_EQ (0, lyric_runtime::internal::compare_ropes(longer, longer));
+}
+
+TEST_F (TextKernels, CompareBytesToRopeAcrossChunks)
+{
+    std::string hello("hello, ");
+    std::string world("world!");
+    tempo_utils::Rope<char> head(hello.cbegin(), hello.cend());
+    auto rope = head.append(tempo_utils::Rope<char>(world.cbegin(), world.cend()));
+
+    std::string s("hello, world!");
+    ASSERT_EQ (0, lyric_runtime::internal::compare_bytes_to_rope(s.data(), s.size(), rope));
+    ASSERT_EQ (-1, lyric_runtime::internal::compare_bytes_to_rope(s.data(), 7, rope));
+    ASSERT_EQ (-1, lyric_runtime::internal::compare_bytes_to_rope(s.data(), 9, rope));
+    ASSERT_EQ (1, lyric_runtime::internal::compare_bytes_to_rope(s.data(), s.size(), head));
+    std::string t("hello, wprld!");
+    ASSERT_EQ (1, lyric_runtime::internal::compare_bytes_to_rope(t.data(), t.size(), rope));
+    ASSERT_EQ (1, lyric_runtime::internal::compare_bytes_to_rope(s.data(), s.size(), tempo_utils::Rope<char>()));
+    ASSERT_EQ (0, lyric_runtime::internal::compare_bytes_to_rope(s.data(), 0, tempo_utils::Rope<char>()));
+}
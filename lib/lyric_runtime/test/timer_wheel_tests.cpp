@@ -0,0 +1,94 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <lyric_runtime/timer_wheel.h>
+
+class TimerWheel : public ::testing::Test {};
+
+struct Expired {
+    tu_uint64 now = 0;
+    std::vector<std::pair<lyric_runtime::TimerEntry *,tu_uint64>> entries;
+};
+
+static void
+on_expired(lyric_runtime::TimerEntry *entry, void *data)
+{
+    auto *expired = static_cast<Expired *>(data);
+    expired->entries.emplace_back(entry, expired->now);
+}
+
+static void
+advance_to(lyric_runtime::TimerWheel &wheel, Expired &expired, tu_uint64 now)
+{
+    expired.now = now;
+    wheel.advance(now, on_expired, &expired);
+}
+
+TEST_F (TimerWheel, TimerExpiresOnItsTick)
+{
+    lyric_runtime::TimerWheel wheel(1000);
+    lyric_runtime::TimerEntry entry;
+    wheel.insert(&entry, 1010);
+    ASSERT_TRUE (lyric_runtime::TimerWheel::isScheduled(&entry));
+    ASSERT_EQ (1010, wheel.nextWakeup());
+
+    Expired expired;
+    advance_to(wheel, expired, 1009);
+    ASSERT_TRUE (expired.entries.empty());
+    advance_to(wheel, expired, 1010);
+    ASSERT_EQ (1, expired.entries.size());
+    ASSERT_EQ (&entry, expired.entries[0].first);
+    ASSERT_FALSE (lyric_runtime::TimerWheel::isScheduled(&entry));
+    ASSERT_TRUE (wheel.isEmpty());
+}
+
+TEST_F (TimerWheel, CancelledTimerDoesNotExpire)
+{
+    lyric_runtime::TimerWheel wheel(0);
+    lyric_runtime::TimerEntry entry1, entry2;
+    wheel.insert(&entry1, 5);
+    wheel.insert(&entry2, 5);
+    ASSERT_EQ (2, wheel.numTimers());
+
+    ASSERT_TRUE (wheel.cancel(&entry1));
+    ASSERT_FALSE (wheel.cancel(&entry1));
+    ASSERT_EQ (1, wheel.numTimers());
+
+    Expired expired;
+    advance_to(wheel, expired, 10);
+    ASSERT_EQ (1, expired.entries.size());
+    ASSERT_EQ (&entry2, expired.entries[0].first);
+}
+
+TEST_F (TimerWheel, DistantTimersCascadeToTheirTick)
+{
+    lyric_runtime::TimerWheel wheel(7);
+    std::vector<tu_uint64> deadlines = {300, 16384, 70000, 1048576 + 3, 5000000, 100000000};
+    std::vector<lyric_runtime::TimerEntry> entries(deadlines.size());
+    for (size_t i = 0; i < deadlines.size(); i++) {
+        wheel.insert(&entries[i], 7 + deadlines[i]);
+    }
+
+    Expired expired;
+    while (!wheel.isEmpty()) {
+        advance_to(wheel, expired, wheel.nextWakeup());
+    }
+
+    ASSERT_EQ (deadlines.size(), expired.entries.size());
+    for (const auto &[entry, now] : expired.entries) {
+        ASSERT_EQ (entry->expires, now);
+    }
+}
+
+TEST_F (TimerWheel, ExpiredDeadlineFiresOnNextAdvance)
+{
+    lyric_runtime::TimerWheel wheel(100);
+    Expired expired;
+    advance_to(wheel, expired, 200);
+
+    lyric_runtime::TimerEntry entry;
+    wheel.insert(&entry, 50);
+    ASSERT_EQ (201, wheel.nextWakeup());
+    advance_to(wheel, expired, 201);
+    ASSERT_EQ (1, expired.entries.size());
+}
@@ -0,0 +1,145 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <lyric_bootstrap/bootstrap_helpers.h>
+#include <lyric_bootstrap/bootstrap_loader.h>
+#include <lyric_runtime/interpreter_state.h>
+#include <lyric_runtime/static_loader.h>
+#include <lyric_runtime/virtual_table.h>
+
+class VirtualTable : public ::testing::Test {
+protected:
+    std::shared_ptr<lyric_runtime::InterpreterState> state;
+    lyric_runtime::BytecodeSegment *segment;
+    std::unique_ptr<lyric_runtime::DescriptorTable> fields;
+    std::unique_ptr<lyric_runtime::DescriptorTable> calls;
+
+    void SetUp() override {
+        auto staticLoader = std::make_shared<lyric_runtime::StaticLoader>();
+        auto systemLoader = std::make_shared<lyric_bootstrap::BootstrapLoader>();
+        TU_ASSIGN_OR_RAISE (state, lyric_runtime::InterpreterState::create(systemLoader, staticLoader));
+        segment = state->segmentManager()->getOrLoadSegment(lyric_bootstrap::preludeLocation(), true);
+        ASSERT_TRUE (segment != nullptr);
+
+        // descriptor tables private to the test, so slots are not assigned by vtables linked by the runtime
+        fields = std::make_unique<lyric_runtime::DescriptorTable>(segment, lyric_object::LinkageSection::Field);
+        calls = std::make_unique<lyric_runtime::DescriptorTable>(segment, lyric_object::LinkageSection::Call);
+    }
+
+    lyric_runtime::Operand field(tu_uint32 index) {
+        return lyric_runtime::Operand::fromDescriptor(fields->lookupDescriptor(index));
+    }
+    lyric_runtime::Operand call(tu_uint32 index) {
+        return lyric_runtime::Operand::fromDescriptor(calls->lookupDescriptor(index));
+    }
+    lyric_runtime::VirtualMember member(tu_uint32 index, tu_uint32 layoutOffset) {
+        return lyric_runtime::VirtualMember(segment, index, layoutOffset);
+    }
+    lyric_runtime::VirtualMethod method(tu_uint32 index) {
+        return lyric_runtime::VirtualMethod(segment, index, index, true);
+    }
+
+    std::unique_ptr<lyric_runtime::VirtualTable> makeTable(
+        const lyric_runtime::VirtualTable *parent,
+        absl::flat_hash_map<lyric_runtime::OperandIdentity,lyric_runtime::VirtualMember> &members,
+        absl::flat_hash_map<lyric_runtime::OperandIdentity,lyric_runtime::VirtualMethod> &methods)
+    {
+        absl::flat_hash_map<lyric_runtime::OperandIdentity,lyric_runtime::ImplTable> impls;
+        return std::make_unique<lyric_runtime::VirtualTable>(segment,
+            calls->lookupDescriptor(0), segment->lookupType(0), parent, nullptr, members, methods, impls);
+    }
+};
+
+TEST_F (VirtualTable, InheritedSlotsAreStableInDescendants)
+{
+    absl::flat_hash_map<lyric_runtime::OperandIdentity,lyric_runtime::VirtualMember> parentMembers;
+    parentMembers.try_emplace(field(0), member(0, 0));
+    parentMembers.try_emplace(field(1), member(1, 1));
+    absl::flat_hash_map<lyric_runtime::OperandIdentity,lyric_runtime::VirtualMethod> parentMethods;
+    parentMethods.try_emplace(call(1), method(1));
+    parentMethods.try_emplace(call(2), method(2));
+    auto parent = makeTable(nullptr, parentMembers, parentMethods);
+
+    absl::flat_hash_map<lyric_runtime::OperandIdentity,lyric_runtime::VirtualMember> childMembers;
+    childMembers.try_emplace(field(2), member(2, 2));
+    absl::flat_hash_map<lyric_runtime::OperandIdentity,lyric_runtime::VirtualMethod> childMethods;
+    childMethods.try_emplace(call(1), method(3));
+    childMethods.try_emplace(call(4), method(4));
+    auto child = makeTable(parent.get(), childMembers, childMethods);
+
+    // members are slotted by layout offset
+    ASSERT_EQ (2, parent->numMemberSlots());
+    ASSERT_EQ (3, child->numMemberSlots());
+    ASSERT_EQ (1, child->getMemberSlot(field(1)));
+    ASSERT_EQ (2, child->getMemberSlot(field(2)));
+    ASSERT_EQ (parent->getMember(field(0)), child->getMember(field(0)));
+    ASSERT_EQ (child->getMember(field(2)), child->getMemberAt(2));
+    ASSERT_TRUE (parent->getMember(field(2)) == nullptr);
+    ASSERT_EQ (lyric_runtime::INVALID_ADDRESS_U32, parent->getMemberSlot(field(2)));
+
+    // the override replaces the inherited slot and the new method is appended
+    ASSERT_EQ (2, parent->numMethodSlots());
+    ASSERT_EQ (3, child->numMethodSlots());
+    auto overrideSlot = parent->getMethodSlot(call(1));
+    ASSERT_EQ (overrideSlot, child->getMethodSlot(call(1)));
+    ASSERT_EQ (1, parent->getMethodAt(overrideSlot)->getCallIndex());
+    ASSERT_EQ (3, child->getMethodAt(overrideSlot)->getCallIndex());
+    ASSERT_EQ (3, child->getMethod(call(1))->getCallIndex());
+    ASSERT_EQ (parent->getMethod(call(2)), child->getMethod(call(2)));
+    ASSERT_EQ (2, child->getMethodSlot(call(4)));
+    ASSERT_TRUE (parent->getMethod(call(4)) == nullptr);
+}
+
+TEST_F (VirtualTable, DescendantSharesInheritedSlotStorage)
+{
+    auto numInherited = lyric_runtime::kSlotChunkSize * 2;
+    ASSERT_LE (numInherited + 1, static_cast<tu_uint32>(segment->getObject().numFields()));
+
+    absl::flat_hash_map<lyric_runtime::OperandIdentity,lyric_runtime::VirtualMember> parentMembers;
+    for (tu_uint32 i = 0; i < numInherited; i++) {
+        parentMembers.try_emplace(field(i), member(i, i));
+    }
+    absl::flat_hash_map<lyric_runtime::OperandIdentity,lyric_runtime::VirtualMethod> parentMethods;
+    auto parent = makeTable(nullptr, parentMembers, parentMethods);
+
+    absl::flat_hash_map<lyric_runtime::OperandIdentity,lyric_runtime::VirtualMember> childMembers;
+    childMembers.try_emplace(field(numInherited), member(numInherited, numInherited));
+    absl::flat_hash_map<lyric_runtime::OperandIdentity,lyric_runtime::VirtualMethod> childMethods;
+    auto child = makeTable(parent.get(), childMembers, childMethods);
+
+    // the full chunks of the parent are shared rather than copied into the child
+    ASSERT_EQ (numInherited + 1, child->numMemberSlots());
+    for (tu_uint32 i = 0; i < numInherited; i++) {
+        ASSERT_TRUE (child->sharesMemberSlot(parent.get(), i));
+        ASSERT_EQ (parent->getMemberAt(i), child->getMemberAt(i));
+    }
+    ASSERT_FALSE (child->sharesMemberSlot(parent.get(), numInherited));
+}
+
+TEST_F (VirtualTable, OverrideCopiesOnlyTheAffectedChunk)
+{
+    auto numInherited = lyric_runtime::kSlotChunkSize * 2;
+    ASSERT_LE (numInherited, static_cast<tu_uint32>(segment->getObject().numCalls()));
+
+    absl::flat_hash_map<lyric_runtime::OperandIdentity,lyric_runtime::VirtualMember> parentMembers;
+    absl::flat_hash_map<lyric_runtime::OperandIdentity,lyric_runtime::VirtualMethod> parentMethods;
+    for (tu_uint32 i = 0; i < numInherited; i++) {
+        parentMethods.try_emplace(call(i), method(i));
+    }
+    auto parent = makeTable(nullptr, parentMembers, parentMethods);
+
+    auto overrideSlot = parent->getMethodSlot(call(0));
+    ASSERT_NE (lyric_runtime::INVALID_ADDRESS_U32, overrideSlot);
+
+    absl::flat_hash_map<lyric_runtime::OperandIdentity,lyric_runtime::VirtualMember> childMembers;
+    absl::flat_hash_map<lyric_runtime::OperandIdentity,lyric_runtime::VirtualMethod> childMethods;
+    childMethods.try_emplace(call(0), method(numInherited));
+    auto child = makeTable(parent.get(), childMembers, childMethods);
+
+    ASSERT_EQ (numInherited, child->numMethodSlots());
+    ASSERT_FALSE (child->sharesMethodSlot(parent.get(), overrideSlot));
+    auto untouchedSlot = (overrideSlot + lyric_runtime::kSlotChunkSize) % numInherited;
+    ASSERT_TRUE (child->sharesMethodSlot(parent.get(), untouchedSlot));
+    ASSERT_EQ (numInherited, child->getMethod(call(0))->getCallIndex());
+    ASSERT_EQ (0, parent->getMethod(call(0))->getCallIndex());
+}